@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_EXPR_BATCH_H_
+#define LSP_PLUG_IN_EXPR_BATCH_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/expr/types.h>
+#include <lsp-plug.in/expr/Resolver.h>
+
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/lltl/pphash.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        /**
+         * Set of variables bound to the arrays of floating-point values (lanes) for
+         * the batch evaluation of expressions. Variables which are not bound to arrays
+         * are resolved by the underlying resolver and have the same value for all lanes.
+         *
+         * When used as a regular resolver, array variables are resolved as the value
+         * of the currently selected lane.
+         */
+        class Batch: public Resolver
+        {
+            private:
+                Batch & operator = (const Batch &);
+
+            public:
+                typedef struct array_t
+                {
+                    LSPString           name;       // Name of variable
+                    const float        *f32;        // Single-precision data, NULL if not used
+                    const double       *f64;        // Double-precision data, NULL if not used
+                } array_t;
+
+            protected:
+                Resolver                               *pResolver;
+                lltl::parray<array_t>                   vArrays;    // List of all arrays
+                lltl::pphash<LSPString, array_t>        hArrays;    // Index of arrays by name
+                size_t                                  nLane;      // Current lane
+
+            protected:
+                array_t            *create(const LSPString *name);
+                void                do_destroy();
+
+            public:
+                explicit Batch();
+                explicit Batch(Resolver *r);
+                virtual ~Batch();
+
+            public:
+                virtual status_t    resolve(value_t *value, const char *name, size_t num_indexes = 0, const ssize_t *indexes = NULL);
+                virtual status_t    resolve(value_t *value, const LSPString *name, size_t num_indexes = 0, const ssize_t *indexes = NULL);
+
+            public:
+                /**
+                 * Bind variable to the array of single-precision values
+                 * @param name name of variable
+                 * @param data array of values, should contain at least as many elements
+                 *   as the number of lanes being evaluated
+                 * @return status of operation
+                 */
+                status_t            set(const char *name, const float *data);
+                status_t            set(const LSPString *name, const float *data);
+
+                /**
+                 * Bind variable to the array of double-precision values
+                 * @param name name of variable
+                 * @param data array of values, should contain at least as many elements
+                 *   as the number of lanes being evaluated
+                 * @return status of operation
+                 */
+                status_t            set(const char *name, const double *data);
+                status_t            set(const LSPString *name, const double *data);
+
+                /**
+                 * Unbind variable from the array
+                 * @param name name of variable
+                 * @return status of operation
+                 */
+                status_t            unset(const char *name);
+                status_t            unset(const LSPString *name);
+
+                /**
+                 * Unbind all variables
+                 */
+                void                clear();
+
+                /**
+                 * Lookup for the array bound to the variable
+                 * @param name name of variable
+                 * @param num_indexes number of indexes
+                 * @param indexes array of indexes
+                 * @return pointer to the array descriptor or NULL if variable is not bound
+                 */
+                const array_t      *lookup(const LSPString *name, size_t num_indexes = 0, const ssize_t *indexes = NULL);
+
+                /**
+                 * Get number of bound arrays
+                 * @return number of bound arrays
+                 */
+                inline size_t       size() const                    { return vArrays.size(); }
+
+                /**
+                 * Get current lane
+                 * @return current lane
+                 */
+                inline size_t       lane() const                    { return nLane; }
+
+                /**
+                 * Select lane used for resolving array variables as scalar values
+                 * @param lane lane index
+                 */
+                inline void         set_lane(size_t lane)           { nLane = lane; }
+
+                /**
+                 * Get variable resolver
+                 * @return variable resolver
+                 */
+                inline Resolver    *resolver()                      { return pResolver; }
+
+                /**
+                 * Set variable resolver
+                 * @param resolver variable resolver
+                 */
+                inline void         set_resolver(Resolver *resolver) { pResolver = resolver; }
+        };
+
+    } /* namespace expr */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_EXPR_BATCH_H_ */
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_EXPR_BYTECODE_H_
+#define LSP_PLUG_IN_EXPR_BYTECODE_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/expr/types.h>
+#include <lsp-plug.in/expr/evaluator.h>
+
+#include <lsp-plug.in/lltl/darray.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        struct expr_t;
+        class Batch;
+
+        /**
+         * Flat register-based representation of the expression tree. The tree is
+         * lowered into the linear sequence of instructions operating on the register
+         * file, constant sub-expressions are folded at compile time. The bytecode
+         * produces exactly the same results as the tree evaluator but does not perform
+         * recursive calls and per-node dispatch.
+         *
+         * The register file is owned by the bytecode, so the same bytecode can not
+         * be executed concurrently by several threads.
+         */
+        class Bytecode
+        {
+            private:
+                Bytecode & operator = (const Bytecode &);
+
+            protected:
+                enum opcode_t
+                {
+                    OP_CONST,           // reg = const[arg]
+                    OP_RESOLVE,         // reg = env.resolve(name, count indexes starting at slot arg)
+                    OP_LOAD,            // reg = env.resolve_bound(arg)
+                    OP_NOENV,           // if (env == NULL) { reg = UNDEF; goto target; }
+                    OP_INDEX,           // index[arg] = int(reg)
+                    OP_JUMP,            // goto target
+                    OP_BRANCH,          // if (!bool(reg)) goto target, if not boolean: reg = UNDEF, goto arg
+                    OP_GUARD,           // guard(reg), goto target on skip
+                    OP_GUARD_NUM,       // guard_numeric(reg) with inline check for numbers, goto target on skip
+                    OP_UNARY,           // reg = unary(reg)
+                    OP_BINARY,          // reg = binary(reg, reg+1)
+                    OP_BINARY_K,        // reg = binary(reg, const[arg])
+                    OP_ARITH,           // reg = reg <kind> reg+1, inline numeric path
+                    OP_ARITH_K,         // reg = reg <kind> const[arg], inline numeric path, guard included
+                    OP_CMP,             // reg = reg <kind> reg+1, inline numeric path
+                    OP_CMP_K            // reg = reg <kind> const[arg], inline numeric path
+                };
+
+                enum lane_opcode_t
+                {
+                    LOP_LOAD_F32,       // lanes[reg] = f32[]
+                    LOP_LOAD_F64,       // lanes[reg] = f64[]
+                    LOP_CALC,           // lanes[reg] = lanes[reg] <kind> lanes[reg+1]
+                    LOP_CALC_K,         // lanes[reg] = lanes[src] <kind> k
+                    LOP_RCALC_K,        // lanes[reg] = k <kind> lanes[src]
+                    LOP_NOT,            // lanes[reg] = ~int(lanes[reg])
+                    LOP_NSIGN           // lanes[reg] = -lanes[reg]
+                };
+
+                enum lane_kind_t
+                {
+                    LK_NONE,            // Register holds scalar value_t
+                    LK_FLOAT,           // Register holds floating-point lanes
+                    LK_BOOL             // Register holds boolean lanes
+                };
+
+                typedef struct lane_instr_t
+                {
+                    uint16_t            op;         // Operation code
+                    uint16_t            kind;       // Operation kind
+                    uint32_t            reg;        // Target register
+                    uint32_t            src;        // Source register
+                    double              k;          // Constant operand
+                    const float        *f32;        // Single-precision source
+                    const double       *f64;        // Double-precision source
+                } lane_instr_t;
+
+                typedef struct instr_t
+                {
+                    uint16_t            op;         // Operation code
+                    uint16_t            kind;       // Operation kind for specialized instructions
+                    uint32_t            reg;        // Target register
+                    uint32_t            count;      // Number of indexes for variable resolving
+                    size_t              arg;        // Additional argument
+                    size_t              target;     // Jump target
+                    union
+                    {
+                        const LSPString    *name;       // Name of variable
+                        guard_t             guard;      // Guard function
+                        unary_t             unary;      // Unary function
+                        binary_t            binary;     // Binary function
+                    };
+                } instr_t;
+
+            protected:
+                lltl::darray<instr_t>       vCode;      // Instructions
+                lltl::darray<value_t>       vConst;     // Constant pool
+                value_t                    *vRegs;      // Register file
+                ssize_t                    *vIndex;     // Index slots for variable resolving
+                eval_env_t                 *pEnv;       // Environment the variables are bound to
+                size_t                      nRegs;      // Number of registers
+                size_t                      nIndex;     // Number of index slots
+                lltl::darray<lane_instr_t>  vLaneCode;  // Instructions for batch evaluation
+                double                     *vLanes;     // Lane registers for batch evaluation
+                uint8_t                    *vLaneKinds; // Kinds of registers for batch evaluation
+
+            protected:
+                static bool         has_resolve(const expr_t *expr);
+                static bool         is_numeric(const value_t *v);
+
+                instr_t            *emit(opcode_t op, size_t reg);
+                ssize_t             add_const(const value_t *v);
+                void                use_reg(size_t reg);
+                void                do_destroy();
+
+                status_t            compile(const expr_t *expr, size_t reg);
+                status_t            compile_const(const value_t *v, size_t reg);
+                status_t            compile_resolve(const expr_t *expr, size_t reg);
+                status_t            compile_ternary(const expr_t *expr, size_t reg);
+                status_t            compile_logic(const expr_t *expr, guard_t guard, size_t reg);
+                status_t            compile_binary(const expr_t *expr, size_t reg);
+                status_t            compile_unary(const expr_t *expr, size_t reg);
+
+                static status_t     fold(const expr_t *expr, value_t *value);
+                static status_t     calc_arith(size_t kind, value_t *value, value_t *right);
+
+                lane_instr_t       *emit_lane(lane_opcode_t op, size_t reg);
+                status_t            plan_lanes(Batch *batch);
+                status_t            plan_lane_binary(size_t kind, size_t reg, value_t *right);
+                void                run_lanes(size_t first, size_t count);
+                status_t            execute_lanes(double *f64, float *f32, size_t count, Batch *batch);
+
+            public:
+                explicit Bytecode();
+                ~Bytecode();
+
+            public:
+                /**
+                 * Compile the expression tree. The previously compiled code is discarded.
+                 * The bytecode does not reference the expression tree but may reference
+                 * names of variables stored in the tree, so the tree should not be destroyed
+                 * until the bytecode is destroyed.
+                 *
+                 * @param expr expression tree
+                 * @return status of operation
+                 */
+                status_t            compile(const expr_t *expr);
+
+                /**
+                 * Execute the compiled bytecode
+                 * @param result the pointer to store the result, should not hold any data
+                 * @param env environment to resolve variables, may be NULL
+                 * @return status of operation
+                 */
+                status_t            execute(value_t *result, eval_env_t *env);
+
+                /**
+                 * Execute the compiled bytecode over multiple lanes. Variables bound to arrays
+                 * in the batch take their value from the corresponding lane, other variables
+                 * are resolved once by the underlying resolver of the batch. Numeric operations
+                 * over lanes are performed in tight loops, expressions that involve other types
+                 * of data in lanes (strings, branches depending on lanes) fall back to the
+                 * scalar evaluation of each lane.
+                 *
+                 * Results that can not be represented as floating-point values are stored as NaN.
+                 *
+                 * @param dst destination buffer to store results
+                 * @param count number of lanes
+                 * @param batch batch of variables bound to arrays
+                 * @return status of operation
+                 */
+                status_t            execute(double *dst, size_t count, Batch *batch);
+
+                /**
+                 * Execute the compiled bytecode over multiple lanes
+                 * @param dst destination buffer to store results
+                 * @param count number of lanes
+                 * @param batch batch of variables bound to arrays
+                 * @return status of operation
+                 */
+                status_t            execute(float *dst, size_t count, Batch *batch);
+
+                /**
+                 * Bind names of non-indexed variables to the slots of the environment.
+                 * Bound variables are resolved without lookup by name when the bytecode
+                 * is executed with the same environment.
+                 *
+                 * @param env environment to bind, NULL to drop all bindings
+                 * @return status of operation
+                 */
+                status_t            bind(eval_env_t *env);
+
+                /**
+                 * Get the environment the variables are bound to
+                 * @return environment the variables are bound to
+                 */
+                inline eval_env_t  *bound() const       { return pEnv; }
+
+                /**
+                 * Destroy the compiled bytecode
+                 */
+                void                destroy();
+
+                /**
+                 * Get number of instructions
+                 * @return number of instructions
+                 */
+                inline size_t       size() const        { return vCode.size(); }
+
+                /**
+                 * Get number of registers used by the bytecode
+                 * @return number of registers
+                 */
+                inline size_t       registers() const   { return nRegs; }
+
+                /**
+                 * Check that the bytecode is a constant value which does not depend on variables
+                 * @return true if the bytecode is a constant value
+                 */
+                bool                constant() const;
+        };
+
+    } /* namespace expr */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_EXPR_BYTECODE_H_ */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_EXPR_CONTEXT_H_
+#define LSP_PLUG_IN_EXPR_CONTEXT_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/expr/Resolver.h>
+#include <lsp-plug.in/expr/Expression.h>
+
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/lltl/pphash.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        /**
+         * Dependency-tracking evaluation context. The context listens for changes of
+         * variables in the attached resolvers and marks as dirty only those results of
+         * the tracked expressions which depend on the changed variable. Tracked expressions
+         * return cached results until they become dirty.
+         *
+         * Indexed variables are reported by resolvers with the full name like 'v_1_2',
+         * so changes of such variables also invalidate the expressions depending on
+         * 'v_1' and 'v'.
+         */
+        class Context: public IResolverListener
+        {
+            private:
+                Context & operator = (const Context &);
+
+                friend class Expression;
+
+            protected:
+                typedef lltl::parray<Expression>                    list_t;
+
+            protected:
+                lltl::parray<Expression>                vExpr;      // Tracked expressions
+                lltl::parray<Resolver>                  vResolvers; // Attached resolvers
+                lltl::pphash<LSPString, list_t>         hDeps;      // Expressions by dependency name
+
+            protected:
+                status_t            index(Expression *expr);
+                void                unindex(Expression *expr);
+                void                invalidate(const LSPString *name);
+
+            public:
+                explicit Context();
+                virtual ~Context();
+
+            public:
+                virtual void        changed(Resolver *resolver, const LSPString *name);
+                virtual void        detached(Resolver *resolver);
+
+            public:
+                /**
+                 * Start listening for changes of variables of the resolver
+                 * @param resolver resolver to attach
+                 * @return status of operation
+                 */
+                status_t            attach(Resolver *resolver);
+
+                /**
+                 * Stop listening for changes of variables of the resolver
+                 * @param resolver resolver to detach
+                 * @return status of operation
+                 */
+                status_t            detach(Resolver *resolver);
+
+                /**
+                 * Start tracking the expression. The expression is removed from the
+                 * previous context if it was tracked by another one.
+                 *
+                 * @param expr expression to track
+                 * @return status of operation
+                 */
+                status_t            add(Expression *expr);
+
+                /**
+                 * Stop tracking the expression
+                 * @param expr expression to stop tracking
+                 * @return status of operation
+                 */
+                status_t            remove(Expression *expr);
+
+                /**
+                 * Stop tracking all expressions and detach from all resolvers
+                 */
+                void                clear();
+
+                /**
+                 * Notify the context about the change of the variable
+                 * @param name name of the variable, NULL if any variable may have been changed
+                 */
+                void                changed(const LSPString *name);
+
+                /**
+                 * Notify the context about the change of the variable
+                 * @param name name of the variable in UTF-8 encoding
+                 * @return status of operation
+                 */
+                status_t            changed(const char *name);
+
+                /**
+                 * Mark all tracked expressions as dirty
+                 */
+                void                invalidate_all();
+
+                /**
+                 * Get number of tracked expressions
+                 * @return number of tracked expressions
+                 */
+                inline size_t       size() const            { return vExpr.size(); }
+        };
+
+    } /* namespace expr */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_EXPR_CONTEXT_H_ */
@@ -37,13 +37,19 @@ namespace lsp
     namespace expr
     {
         struct expr_t;
+        struct parse_tree_t;
         class Tokenizer;
+        class Bytecode;
+        class Context;
+        class Batch;
         
         class Expression
         {
             private:
                 Expression & operator = (const Expression &);
 
+                friend class Context;
+
             public:
                 enum expr_flags
                 {
@@ -56,23 +62,37 @@ namespace lsp
                 typedef struct root_t
                 {
                     expr_t                     *expr;
+                    Bytecode                   *code;
                     value_t                     result;
+                    size_t                     *deps;       // Indexes of dependencies of the expression
+                    size_t                      ndeps;      // Number of dependencies
+                    bool                        dirty;      // Result should be re-evaluated
                 } root_t;
 
             protected:
                 Resolver                   *pResolver;
+                Context                    *pContext;
+                parse_tree_t               *pTree;      // Shared parse tree, NULL if the tree is owned
                 lltl::darray<root_t>        vRoots;
                 lltl::parray<LSPString>     vDependencies;
 
             protected:
+                static void         replace_with_value(expr_t *expr, const value_t *value);
+                static void         replace_with_child(expr_t *expr, expr_t *child);
+
                 void                destroy_all_data();
+                status_t            execute(root_t *r);
+                status_t            evaluate_root(root_t *r);
                 status_t            prepend_string(expr_t **expr, const LSPString *str, bool force);
                 status_t            parse_substitution(expr_t **expr, Tokenizer *t);
                 status_t            parse_regular(io::IInSequence *seq, size_t flags);
                 status_t            parse_string(io::IInSequence *seq, size_t flags);
                 status_t            post_process();
-                status_t            scan_dependencies(expr_t *expr);
-                status_t            add_dependency(const LSPString *str);
+                status_t            attach_tree(parse_tree_t *tree);
+                void                publish_tree(const LSPString *text, size_t flags);
+                status_t            scan_dependencies(root_t *root, expr_t *expr);
+                status_t            optimize(expr_t *expr);
+                status_t            add_dependency(root_t *root, const LSPString *str);
 
             public:
                 explicit Expression();
@@ -83,7 +103,11 @@ namespace lsp
 
             public:
                 /**
-                 * Parse the expression
+                 * Parse the expression. Previously parsed data is discarded. Parsed trees of
+                 * expressions passed as strings are shared through the process-wide cache,
+                 * so parsing of the same text is performed only once while at least one
+                 * expression holds it.
+                 *
                  * @param expr string containing expression
                  * @param charset character set, may be NULL for default character set
                  * @param flags additional flags
@@ -92,7 +116,9 @@ namespace lsp
                 status_t    parse(const char *expr, const char *charset = NULL, size_t flags = FLAG_NONE);
 
                 /**
-                 * Parse the expression
+                 * Parse the expression. Previously parsed data is discarded. Parsed trees
+                 * are shared through the process-wide cache.
+                 *
                  * @param expr string containing expression
                  * @param flags additional flags
                  * @return status of operation
@@ -100,7 +126,7 @@ namespace lsp
                 status_t    parse(const LSPString *expr, size_t flags = FLAG_NONE);
 
                 /**
-                 * Parse the expression
+                 * Parse the expression. Previously parsed data is discarded.
                  * @param seq character input sequence
                  * @param flags additional flags
                  * @return status of operation
@@ -114,20 +140,50 @@ namespace lsp
                 inline bool     valid() const { return vRoots.size() > 0; };
 
                 /**
-                 * Evaluate all the expressions
+                 * Evaluate all the expressions. If the expression is tracked by the
+                 * evaluation context, only results marked as dirty are re-evaluated.
+                 *
                  * @param result pointer to return value of the zero-indexed expression
                  * @return status of operation
                  */
                 status_t        evaluate(value_t *result = NULL);
 
                 /**
-                 * Evaluate the specific expression
+                 * Evaluate the specific expression. If the expression is tracked by the
+                 * evaluation context, the cached result is returned when it is not dirty.
+                 *
                  * @param index expression index
                  * @param result pointer to return value of the specified expression
                  * @return status of operation
                  */
                 status_t        evaluate(size_t idx, value_t *result = NULL);
 
+                /**
+                 * Evaluate the zero-indexed expression over multiple lanes. Variables bound to arrays
+                 * in the batch take their value from the corresponding lane, other variables are
+                 * resolved by the underlying resolver of the batch. Results that can not be
+                 * represented as floating-point values are stored as NaN. Cached results of the
+                 * expression are not affected.
+                 *
+                 * @param batch batch of variables bound to arrays
+                 * @param dst destination buffer to store results
+                 * @param count number of lanes
+                 * @return status of operation
+                 */
+                status_t        evaluate_batch(Batch *batch, double *dst, size_t count);
+                status_t        evaluate_batch(Batch *batch, float *dst, size_t count);
+
+                /**
+                 * Evaluate the specific expression over multiple lanes
+                 * @param idx expression index
+                 * @param batch batch of variables bound to arrays
+                 * @param dst destination buffer to store results
+                 * @param count number of lanes
+                 * @return status of operation
+                 */
+                status_t        evaluate_batch(size_t idx, Batch *batch, double *dst, size_t count);
+                status_t        evaluate_batch(size_t idx, Batch *batch, float *dst, size_t count);
+
                 /**
                  * Get number of results
                  * @return number of results
@@ -152,7 +208,38 @@ namespace lsp
                  * Sett variable resolver
                  * @param resolver variable resolver
                  */
-                inline void     set_resolver(Resolver *resolver) { pResolver = resolver; }
+                inline void     set_resolver(Resolver *resolver) { pResolver = resolver; invalidate(); }
+
+                /**
+                 * Get evaluation context that tracks changes of dependencies
+                 * @return evaluation context or NULL if the expression is not tracked
+                 */
+                inline Context *context() { return pContext; }
+
+                /**
+                 * Mark all results as dirty
+                 */
+                void            invalidate();
+
+                /**
+                 * Mark results that depend on the variable as dirty
+                 * @param name name of the variable
+                 * @return true if at least one result has been marked as dirty
+                 */
+                bool            invalidate(const LSPString *name);
+
+                /**
+                 * Check that at least one result should be re-evaluated
+                 * @return true if at least one result is dirty
+                 */
+                bool            dirty() const;
+
+                /**
+                 * Check that the specific result should be re-evaluated
+                 * @param idx the result index
+                 * @return true if the result is dirty
+                 */
+                bool            dirty(size_t idx) const;
 
                 /**
                  * Get number of dependencies
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_EXPR_FORMATTEMPLATE_H_
+#define LSP_PLUG_IN_EXPR_FORMATTEMPLATE_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/IInSequence.h>
+#include <lsp-plug.in/io/IOutSequence.h>
+#include <lsp-plug.in/expr/Parameters.h>
+
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        struct fmt_spec_t;
+
+        /**
+         * Pre-parsed format string. The template is tokenized once into the list
+         * of literal and specifier segments, so the repeated formatting is just
+         * an append loop. The syntax is the same as for the expr::format() call.
+         * The template uses internal buffers while formatting, so it should not
+         * be shared between threads without synchronization.
+         */
+        class FormatTemplate
+        {
+            private:
+                FormatTemplate & operator = (const FormatTemplate &);
+
+            protected:
+                typedef struct segment_t
+                {
+                    LSPString           text;       // Literal text
+                    fmt_spec_t         *spec;       // Format specifier, NULL for literal segment
+                } segment_t;
+
+            protected:
+                lltl::parray<segment_t> vSegments;
+
+            protected:
+                status_t                add_literal(LSPString *text);
+                status_t                add_specifier(const fmt_spec_t *spec);
+
+            public:
+                explicit FormatTemplate();
+                ~FormatTemplate();
+
+            public:
+                /**
+                 * Parse the format string
+                 * @param fmt format string (UTF-8 character sequence)
+                 * @return status of operation
+                 */
+                status_t                parse(const char *fmt);
+
+                /**
+                 * Parse the format string
+                 * @param fmt format string
+                 * @return status of operation
+                 */
+                status_t                parse(const LSPString *fmt);
+
+                /**
+                 * Parse the format string
+                 * @param fmt format string sequence
+                 * @return status of operation
+                 */
+                status_t                parse(io::IInSequence *fmt);
+
+                /**
+                 * Destroy the parsed template
+                 */
+                void                    clear();
+
+                /**
+                 * Format the set of parameters and store the result to the string.
+                 * The previous contents of the string are replaced, the capacity is kept.
+                 *
+                 * @param out output string
+                 * @param r parameters
+                 * @return status of operation
+                 */
+                status_t                format(LSPString *out, const Parameters *r);
+
+                /**
+                 * Format the set of parameters and append the result to the string
+                 *
+                 * @param out output string
+                 * @param r parameters
+                 * @return status of operation
+                 */
+                status_t                append(LSPString *out, const Parameters *r);
+
+                /**
+                 * Format the set of parameters and output the result to the sequence
+                 *
+                 * @param out output sequence
+                 * @param r parameters
+                 * @return status of operation
+                 */
+                status_t                format(io::IOutSequence *out, const Parameters *r);
+
+                /**
+                 * Get number of segments in the template
+                 * @return number of segments
+                 */
+                inline size_t           segments() const    { return vSegments.size(); }
+        };
+    }
+}
+
+#endif /* LSP_PLUG_IN_EXPR_FORMATTEMPLATE_H_ */
@@ -34,6 +34,8 @@ namespace lsp
          * Implements list of optionally named parameters which then can be used for string formatting.
          * Parameters may have duplicate names. From set of named parameters with the same name the parameter
          * with the least index will be visible by the name.
+         * The name index is updated by the modifying methods only, so lookups by name do not
+         * modify the object and may be performed concurrently.
          */
         class Parameters: public Resolver
         {
@@ -44,16 +46,30 @@ namespace lsp
                 typedef struct param_t
                 {
                     value_t                 value;
+                    size_t                  hash;
+                    size_t                  index;      // Position in the list, valid while the name index is valid
                     ssize_t                 len;
                     lsp_wchar_t             name[];
                 } param_t;
 
             protected:
                 lltl::parray<param_t>   vParams;
+                param_t               **vIndex;         // Open-addressing hash index of visible named parameters
+                size_t                  nIndexCap;      // Capacity of the index, power of two
+                size_t                  nIndexSize;     // Number of parameters in the index
+                size_t                  nShadowed;      // Number of named parameters hidden by parameters with the same name
+                bool                    bIndexed;       // The index is valid
 
             protected:
-                param_t            *lookup_by_name(const LSPString *name);
-                param_t            *lookup_by_name(const LSPString *name, size_t *idx);
+                param_t            *lookup_by_name(const LSPString *name) const;
+                param_t            *lookup_by_name(const LSPString *name, size_t *idx) const;
+                size_t              index_slot(const lsp_wchar_t *name, size_t len, size_t hash) const;
+                bool                rebuild_index();
+                void                invalidate_index();
+                void                update_positions(size_t first);
+                void                index_param(param_t *p, size_t index);
+                void                unindex_param(param_t *p, size_t index);
+                void                erase_slot(size_t slot);
                 static param_t     *allocate();
                 static param_t     *allocate(const lsp_wchar_t *name, ssize_t len);
                 static param_t     *clone(const param_t *src);
@@ -65,6 +81,7 @@ namespace lsp
                 status_t            drop_value(size_t index, value_type_t type, param_t **out);
                 status_t            drop_value(const char *name, value_type_t type, param_t **out);
                 status_t            drop_value(const LSPString *name, value_type_t type, param_t **out);
+                void                do_modified(const LSPString *name);
 
             protected:
                 /**
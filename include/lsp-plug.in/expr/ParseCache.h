@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_EXPR_PARSECACHE_H_
+#define LSP_PLUG_IN_EXPR_PARSECACHE_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/lltl/darray.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        struct expr_t;
+
+        /**
+         * Parsed and optimized expression trees shared between expressions
+         */
+        typedef struct parse_tree_t
+        {
+            LSPString                   key;        // Source text prefixed with parse flags
+            lltl::parray<expr_t>        roots;      // Root expressions, immutable
+            lltl::parray<LSPString>     deps;       // Dependencies of root expressions collected before optimization
+            lltl::darray<size_t>        ndeps;      // Number of dependencies of each root expression
+            size_t                      refs;       // Number of references, guarded by the cache lock
+        } parse_tree_t;
+
+        /**
+         * Process-wide thread-safe cache of parsed expression trees keyed by the source
+         * text and parse flags. The cache holds only the trees that are referenced by
+         * at least one expression: the tree is destroyed when the last reference is
+         * released. Trees stored in the cache are never modified.
+         */
+        class ParseCache
+        {
+            private:
+                ParseCache & operator = (const ParseCache &);
+
+            protected:
+                static bool             make_key(LSPString *key, const LSPString *text, size_t flags);
+                static void             destroy(parse_tree_t *tree);
+                static void             destroy_deps(parse_tree_t *tree);
+                static bool             copy_deps(parse_tree_t *tree, const LSPString * const *deps, const size_t *ndeps, size_t count);
+
+            public:
+                /**
+                 * Lookup for the shared tree and acquire the reference to it
+                 * @param text source text of the expression
+                 * @param flags parse flags
+                 * @return pointer to the shared tree or NULL if there is no such tree
+                 */
+                static parse_tree_t    *acquire(const LSPString *text, size_t flags);
+
+                /**
+                 * Publish the parsed tree. On success the cache takes ownership of
+                 * root expressions and the caller gets the reference to the shared tree.
+                 *
+                 * @param text source text of the expression
+                 * @param flags parse flags
+                 * @param roots root expressions to publish
+                 * @param count number of root expressions
+                 * @param deps dependencies of all root expressions in scan order, the cache stores copies
+                 * @param ndeps number of dependencies of each root expression, count elements
+                 * @return pointer to the shared tree or NULL if the tree has not been published
+                 *   and the caller still owns the root expressions
+                 */
+                static parse_tree_t    *publish(const LSPString *text, size_t flags, expr_t * const *roots, size_t count,
+                                                const LSPString * const *deps, const size_t *ndeps);
+
+                /**
+                 * Release the reference to the shared tree
+                 * @param tree tree to release
+                 */
+                static void             release(parse_tree_t *tree);
+
+                /**
+                 * Get number of trees stored in the cache
+                 * @return number of trees stored in the cache
+                 */
+                static size_t           size();
+        };
+
+    } /* namespace expr */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_EXPR_PARSECACHE_H_ */
@@ -25,10 +25,41 @@
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/expr/types.h>
 
+#include <lsp-plug.in/lltl/parray.h>
+
 namespace lsp
 {
     namespace expr
     {
+        class Resolver;
+
+        /**
+         * Listener of changes of variables provided by the resolver
+         */
+        class IResolverListener
+        {
+            private:
+                IResolverListener & operator = (const IResolverListener &);
+
+            public:
+                explicit IResolverListener();
+                virtual ~IResolverListener();
+
+            public:
+                /**
+                 * Called when the value of the variable has been changed
+                 * @param resolver resolver that holds the variable
+                 * @param name name of the variable, NULL if any variable may have been changed
+                 */
+                virtual void    changed(Resolver *resolver, const LSPString *name);
+
+                /**
+                 * Called when the resolver is destroyed and the listener becomes detached from it
+                 * @param resolver resolver being destroyed
+                 */
+                virtual void    detached(Resolver *resolver);
+        };
+
         /**
          * This is a class that resolves the actual value by the variable name.
          * By default, it resolves all values as NULLs
@@ -39,6 +70,27 @@ namespace lsp
             private:
                 Resolver & operator = (const Resolver &);
 
+            protected:
+                lltl::parray<IResolverListener>     vListeners;
+
+            protected:
+                /**
+                 * Notify all listeners about the change of the variable
+                 * @param name name of the variable, NULL if any variable may have been changed
+                 */
+                void                notify(const LSPString *name);
+
+                /**
+                 * Form the name of the indexed variable: the name is followed by the
+                 * underscore-separated list of indexes, for example "arr_1_2"
+                 * @param dst string to store the name
+                 * @param name array variable name
+                 * @param num_indexes number of indexes in array
+                 * @param indexes pointer to array containing all index values
+                 * @return true on success, false if there is not enough memory
+                 */
+                static bool         indexed_name(LSPString *dst, const LSPString *name, size_t num_indexes, const ssize_t *indexes);
+
             public:
                 explicit Resolver();
                 virtual ~Resolver();
@@ -63,6 +115,41 @@ namespace lsp
                  * @return status of operation
                  */
                 virtual status_t resolve(value_t *value, const LSPString *name, size_t num_indexes = 0, const ssize_t *indexes = NULL);
+
+                /**
+                 * Bind the variable name to the slot. The slot can be used later for resolving
+                 * the variable without lookup by name. The slot remains valid for the whole
+                 * lifetime of the resolver. By default, binding is not supported.
+                 *
+                 * @param name variable name
+                 * @return non-negative slot identifier or negative error code
+                 */
+                virtual ssize_t  bind(const LSPString *name);
+
+                /**
+                 * Resolve variable bound to the slot
+                 * @param value pointer to value to store the data
+                 * @param slot slot identifier returned by the bind() method
+                 * @return status of operation, STATUS_NOT_FOUND if variable is not defined
+                 */
+                virtual status_t resolve_bound(value_t *value, size_t slot);
+
+            public:
+                /**
+                 * Add listener of variable changes. Resolvers that do not track
+                 * changes of their variables never notify listeners.
+                 *
+                 * @param listener listener to add
+                 * @return status of operation, STATUS_ALREADY_EXISTS if listener is already added
+                 */
+                status_t        add_listener(IResolverListener *listener);
+
+                /**
+                 * Remove listener of variable changes
+                 * @param listener listener to remove
+                 * @return status of operation, STATUS_NOT_FOUND if there is no such listener
+                 */
+                status_t        remove_listener(IResolverListener *listener);
         };
     
     } /* namespace calc */
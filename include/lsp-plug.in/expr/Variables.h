@@ -26,6 +26,7 @@
 #include <lsp-plug.in/runtime/LSPString.h>
 #include <lsp-plug.in/expr/Resolver.h>
 #include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/lltl/pphash.h>
 
 namespace lsp
 {
@@ -41,14 +42,21 @@ namespace lsp
                 {
                     LSPString                   name;
                     value_t                     value;
+                    ssize_t                     slot;       // Binding slot, negative if variable is not bound
+                    bool                        defined;    // Bound variables are kept undefined after unset
                 } variable_t;
 
             protected:
-                Resolver                   *pResolver;
-                lltl::parray<variable_t>    vVars;
+                Resolver                               *pResolver;
+                lltl::parray<variable_t>                vVars;      // List of all variables
+                lltl::pphash<LSPString, variable_t>     hVars;      // Index of variables by name
+                lltl::parray<variable_t>                vSlots;     // Bound variables
 
             protected:
+                variable_t         *create(const LSPString *name);
                 status_t            add(const LSPString *name, const value_t *value);
+                status_t            store(const LSPString *name, const value_t *value);
+                void                do_destroy();
 
             public:
                 explicit Variables();
@@ -58,6 +66,8 @@ namespace lsp
             public:
                 virtual status_t    resolve(value_t *value, const char *name, size_t num_indexes = 0, const ssize_t *indexes = NULL);
                 virtual status_t    resolve(value_t *value, const LSPString *name, size_t num_indexes = 0, const ssize_t *indexes = NULL);
+                virtual ssize_t     bind(const LSPString *name);
+                virtual status_t    resolve_bound(value_t *value, size_t slot);
 
             public:
                 status_t            set_int(const char *name, ssize_t value);
@@ -79,8 +89,17 @@ namespace lsp
                 status_t            unset(const char *name, value_t *value = NULL);
                 status_t            unset(const LSPString *name, value_t *value = NULL);
 
+                /**
+                 * Remove all variables. Bound variables become undefined but their slots remain valid.
+                 */
                 void                clear();
 
+                /**
+                 * Get number of defined variables
+                 * @return number of defined variables
+                 */
+                size_t              size() const;
+
                 /**
                  * Get variable resolver
                  * @return variable resolver
@@ -36,6 +36,89 @@ namespace lsp
 
         typedef status_t (* evaluator_t)(value_t *value, const expr_t *expr, eval_env_t *env);
 
+        /**
+         * Guard for the left operand of the binary operation: converts the operand
+         * and decides whether the right operand should be evaluated at all
+         * @param value the left operand, becomes the result if the guard skips the operation
+         * @return STATUS_OK if the right operand should be evaluated, STATUS_SKIP if the value
+         *   already holds the result, error code otherwise (the value is destroyed)
+         */
+        typedef status_t (* guard_t)(value_t *value);
+
+        /**
+         * Unary operation performed in-place
+         * @param value the operand and the result
+         * @return status of operation, on error the value is destroyed
+         */
+        typedef status_t (* unary_t)(value_t *value);
+
+        /**
+         * Binary operation performed on the guarded left operand
+         * @param value the left operand and the result
+         * @param right the right operand, always destroyed after the call
+         * @return status of operation, on error the value is destroyed
+         */
+        typedef status_t (* binary_t)(value_t *value, value_t *right);
+
+        status_t guard_numeric(value_t *value);
+        status_t guard_int(value_t *value);
+        status_t guard_float(value_t *value);
+        status_t guard_power(value_t *value);
+        status_t guard_bool(value_t *value);
+        status_t guard_or(value_t *value);
+        status_t guard_and(value_t *value);
+        status_t guard_string(value_t *value);
+        status_t guard_ternary(value_t *value);
+
+        status_t calc_add(value_t *value, value_t *right);
+        status_t calc_sub(value_t *value, value_t *right);
+        status_t calc_mul(value_t *value, value_t *right);
+        status_t calc_div(value_t *value, value_t *right);
+        status_t calc_iadd(value_t *value, value_t *right);
+        status_t calc_isub(value_t *value, value_t *right);
+        status_t calc_imul(value_t *value, value_t *right);
+        status_t calc_idiv(value_t *value, value_t *right);
+        status_t calc_imod(value_t *value, value_t *right);
+        status_t calc_fmod(value_t *value, value_t *right);
+        status_t calc_power(value_t *value, value_t *right);
+        status_t calc_bit_or(value_t *value, value_t *right);
+        status_t calc_bit_and(value_t *value, value_t *right);
+        status_t calc_bit_xor(value_t *value, value_t *right);
+        status_t calc_xor(value_t *value, value_t *right);
+        status_t calc_select(value_t *value, value_t *right);
+        status_t calc_strcat(value_t *value, value_t *right);
+        status_t calc_strrep(value_t *value, value_t *right);
+
+        status_t calc_cmp(value_t *value, value_t *right);
+        status_t calc_cmp_eq(value_t *value, value_t *right);
+        status_t calc_cmp_ne(value_t *value, value_t *right);
+        status_t calc_cmp_lt(value_t *value, value_t *right);
+        status_t calc_cmp_gt(value_t *value, value_t *right);
+        status_t calc_cmp_le(value_t *value, value_t *right);
+        status_t calc_cmp_ge(value_t *value, value_t *right);
+
+        status_t calc_icmp(value_t *value, value_t *right);
+        status_t calc_icmp_eq(value_t *value, value_t *right);
+        status_t calc_icmp_ne(value_t *value, value_t *right);
+        status_t calc_icmp_lt(value_t *value, value_t *right);
+        status_t calc_icmp_gt(value_t *value, value_t *right);
+        status_t calc_icmp_le(value_t *value, value_t *right);
+        status_t calc_icmp_ge(value_t *value, value_t *right);
+
+        status_t calc_neg(value_t *value);
+        status_t calc_not(value_t *value);
+        status_t calc_nsign(value_t *value);
+        status_t calc_exists(value_t *value);
+        status_t calc_db(value_t *value);
+        status_t calc_strupper(value_t *value);
+        status_t calc_strlower(value_t *value);
+        status_t calc_strlen(value_t *value);
+        status_t calc_strrev(value_t *value);
+        status_t calc_int_cast(value_t *value);
+        status_t calc_float_cast(value_t *value);
+        status_t calc_string_cast(value_t *value);
+        status_t calc_bool_cast(value_t *value);
+
 
         status_t eval_ternary(value_t *value, const expr_t *expr, eval_env_t *env);
         status_t eval_xor(value_t *value, const expr_t *expr, eval_env_t *env);
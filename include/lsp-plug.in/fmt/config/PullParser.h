@@ -24,6 +24,7 @@
 
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/StringPool.h>
 #include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/io/Path.h>
 #include <lsp-plug.in/io/IInSequence.h>
@@ -50,6 +51,8 @@ namespace lsp
                 LSPString               sKey;
                 LSPString               sValue;
                 size_t                  nFlags;
+                StringPool             *pPool;          // Pool for interning of parameter names
+                const LSPString        *pName;          // Interned name of current parameter
 
             protected:
                 bool                skip_spaces(size_t &off);
@@ -58,6 +61,7 @@ namespace lsp
                 status_t            read_value(size_t &off);
                 status_t            parse_line();
                 status_t            commit_param();
+                status_t            parse_value(param_t *p);
 
                 static status_t     parse_int32(const LSPString *str, int32_t *dst);
                 static status_t     parse_uint32(const LSPString *str, uint32_t *dst);
@@ -155,6 +159,26 @@ namespace lsp
                  * @return NULL if there is no current event
                  */
                 status_t           current(param_t *ev) const;
+
+                /**
+                 * Set the pool for interning of parameter names. The pool should
+                 * remain valid while the parser is in use.
+                 * @param pool string pool, NULL to disable interning
+                 */
+                inline void         set_pool(StringPool *pool)  { pPool = pool;     }
+
+                /**
+                 * Get the pool for interning of parameter names
+                 * @return string pool or NULL if interning is disabled
+                 */
+                inline StringPool  *pool() const                { return pPool;     }
+
+                /**
+                 * Get the interned name of the current parameter, the interned names
+                 * can be compared by pointer
+                 * @return interned name or NULL if there is no pool or no current event
+                 */
+                const LSPString    *interned_name() const;
         };
     
     } /* namespace config */
@@ -28,6 +28,7 @@
 #include <lsp-plug.in/io/Path.h>
 #include <lsp-plug.in/fmt/json/token.h>
 #include <lsp-plug.in/fmt/json/Tokenizer.h>
+#include <lsp-plug.in/runtime/StringPool.h>
 #include <lsp-plug.in/lltl/darray.h>
 
 namespace lsp
@@ -73,11 +74,14 @@ namespace lsp
                 state_t                 sState;
                 event_t                 sCurrent;
                 lltl::darray<state_t>   sStack;
+                StringPool             *pPool;          // Pool for interning of property names
+                const LSPString        *pName;          // Interned name of current property, stored instead of sCurrent.sValue
 
             protected:
                 status_t            read_root();
                 status_t            read_array();
                 status_t            read_object();
+                status_t            read_property(token_t tok);
                 status_t            read_primitive(token_t tok);
 
                 inline status_t     push_state(pmode_t state);
@@ -250,6 +254,26 @@ namespace lsp
                  * @return status of operation
                  */
                 status_t    skip_current();
+
+                /**
+                 * Set the pool for interning of property names. The pool should
+                 * remain valid while the parser is in use.
+                 * @param pool string pool, NULL to disable interning
+                 */
+                inline void set_pool(StringPool *pool)  { pPool = pool;     }
+
+                /**
+                 * Get the pool for interning of property names
+                 * @return string pool or NULL if interning is disabled
+                 */
+                inline StringPool *pool() const         { return pPool;     }
+
+                /**
+                 * Get the interned name of the property for the current JE_PROPERTY event,
+                 * the interned names can be compared by pointer
+                 * @return interned name or NULL if there is no pool or current event is not JE_PROPERTY
+                 */
+                const LSPString *interned_name() const;
         };
     
     } /* namespace json */
@@ -25,6 +25,7 @@
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/runtime/LSPString.h>
 #include <lsp-plug.in/io/IInSequence.h>
+#include <lsp-plug.in/io/InSequenceReader.h>
 #include <lsp-plug.in/fmt/json/token.h>
 
 namespace lsp
@@ -41,6 +42,7 @@ namespace lsp
 
             protected:
                 io::IInSequence        *pIn;
+                io::InSequenceReader    sReader;
                 lsp_swchar_t            cCurrent;
                 token_t                 enToken;
                 LSPString               sValue;
@@ -109,6 +111,13 @@ namespace lsp
                  */
                 inline const LSPString *text_value() const  { return &sValue; }
 
+                /**
+                 * Move current token value to the string without copying. The contents
+                 * of the destination string are dropped, text_value() becomes empty.
+                 * @param dst destination string
+                 */
+                void                    take_text_value(LSPString *dst);
+
                 /**
                  * Get floating-point value of the token
                  * @return floating-point value of the token
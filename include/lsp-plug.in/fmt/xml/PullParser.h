@@ -26,9 +26,11 @@
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/io/IInStream.h>
 #include <lsp-plug.in/io/IInSequence.h>
+#include <lsp-plug.in/io/InSequenceReader.h>
 #include <lsp-plug.in/io/Path.h>
 #include <lsp-plug.in/fmt/xml/const.h>
 #include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/runtime/StringPool.h>
 
 namespace lsp
 {
@@ -64,6 +66,7 @@ namespace lsp
 
             protected:
                 io::IInSequence        *pIn;
+                io::InSequenceReader    sReader;
                 size_t                  nWFlags;
                 status_t                nToken;
                 parse_state_t           nState;
@@ -86,9 +89,11 @@ namespace lsp
                 LSPString               sPublic;        // Public literal
                 lltl::parray<LSPString> vTags;
                 lltl::parray<LSPString> vAtts;
+                StringPool             *pPool;          // Pool for interning of names
+                const LSPString        *pName;          // Interned name of current token
 
             protected:
-                static void         drop_list(lltl::parray<LSPString> *list);
+                void                drop_list(lltl::parray<LSPString> *list);
 
                 inline lsp_swchar_t getch();
                 inline void         ungetch(lsp_swchar_t c);
@@ -278,6 +283,30 @@ namespace lsp
                  * @return document type system literal or NULL if not present
                  */
                 inline const            LSPString *sys_literal() const { return (nFlags & XF_DOCTYPE_SYS) ? &sSystem: NULL; }
+
+                /**
+                 * Set the pool for interning of tag, attribute and processing instruction
+                 * names. The pool should remain valid while the parser is in use. When the
+                 * pool is set, the parser keeps the interned names of open elements and
+                 * attributes instead of own copies. The pool can not be changed while
+                 * some element is open.
+                 * @param pool string pool, NULL to disable interning
+                 * @return status of operation, STATUS_BAD_STATE if some element is open
+                 */
+                status_t                set_pool(StringPool *pool);
+
+                /**
+                 * Get the pool for interning of names
+                 * @return string pool or NULL if interning is disabled
+                 */
+                inline StringPool      *pool() const                { return pPool;     }
+
+                /**
+                 * Return interned name of current property, tag or processing instruction,
+                 * the interned names can be compared by pointer
+                 * @return interned name or NULL if there is no pool or current token has no name
+                 */
+                const LSPString        *interned_name() const;
         };
     
     } /* namespace xml */
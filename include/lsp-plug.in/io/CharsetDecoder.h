@@ -48,6 +48,7 @@ namespace lsp
                 lsp_wchar_t    *cBuffer;        // Temporary buffer for storing UTF-16 code points
                 lsp_wchar_t    *cBufHead;       // Character buffer head
                 lsp_wchar_t    *cBufTail;       // Character buffer tail
+                native_charset_t enNative;      // Built-in decoder
 
 #if defined(PLATFORM_WINDOWS)
                 lsp_utf16_t    *xBuffer;        // Additional translation buffer
@@ -61,6 +62,7 @@ namespace lsp
 
                 inline size_t   prepare_buffer();
                 ssize_t         decode_buffer();
+                status_t        decode_native();
 
             public:
                 explicit CharsetDecoder();
@@ -109,6 +111,22 @@ namespace lsp
                  */
                 ssize_t     fetch(IOutSequence *out, size_t count = 0);
 
+                /**
+                 * Borrow the decoded characters without copying them, the characters
+                 * are not consumed until skip() is called
+                 * @param buf pointer to store the address of decoded characters
+                 * @return number of characters available, zero if more data should be filled
+                 *         or negative error code
+                 */
+                ssize_t     borrow(const lsp_wchar_t **buf);
+
+                /**
+                 * Skip decoded characters
+                 * @param count number of characters to skip
+                 * @return number of characters skipped or negative error code
+                 */
+                ssize_t     skip(size_t count);
+
                 /**
                  * Fill the internal byte buffer with additional data for decoding
                  * @param buf source buffer with data
@@ -48,6 +48,7 @@ namespace lsp
                 lsp_wchar_t    *cBuffer;        // Temporary buffer for storing UTF-16 code points
                 lsp_wchar_t    *cBufHead;       // Character buffer head
                 lsp_wchar_t    *cBufTail;       // Character buffer tail
+                native_charset_t enNative;      // Built-in encoder
 
 #if defined(PLATFORM_WINDOWS)
                 lsp_utf16_t    *xBuffer;        // Additional translation buffer
@@ -61,6 +62,7 @@ namespace lsp
 
                 inline size_t   prepare_buffer();
                 ssize_t         encode_buffer();
+                status_t        encode_native();
 
             public:
                 explicit CharsetEncoder();
@@ -75,6 +75,17 @@ namespace lsp
                  */
                 virtual status_t    read_line(LSPString *s, bool force = false);
 
+                /**
+                 * Borrow the window of characters available for reading without copying them.
+                 * The characters are not consumed, the caller should call skip() to consume
+                 * the processed characters. The window remains valid until the next call of
+                 * any other method of the sequence.
+                 * @param buf pointer to store the address of the first character of the window
+                 * @return number of characters in the window or negative error code,
+                 *        -STATUS_NOT_SUPPORTED if sequence does not support borrowing
+                 */
+                virtual ssize_t     borrow(const lsp_wchar_t **buf);
+
                 /**
                  * Skip amount of characters
                  * @param count number of characters to skip
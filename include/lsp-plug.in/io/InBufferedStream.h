@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INBUFFEREDSTREAM_H_
+#define LSP_PLUG_IN_IO_INBUFFEREDSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/io/IInStream.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/File.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Input stream that reads the wrapped stream by large blocks and serves
+         * small reads from the aligned buffer. Reads that are not less than the
+         * block size bypass the buffer and go directly to the wrapped stream.
+         */
+        class InBufferedStream: public IInStream
+        {
+            protected:
+                IInStream      *pIS;            // Input stream
+                size_t          nWrapFlags;     // Wrap flags
+                uint8_t        *pBuffer;        // Aligned buffer
+                void           *pData;          // Allocated data
+                size_t          nBufSize;       // Block size
+                size_t          nHead;          // Read position in the buffer
+                size_t          nTail;          // Amount of data in the buffer
+
+            private:
+                InBufferedStream & operator = (const InBufferedStream &);
+
+            protected:
+                status_t        fill(size_t count);
+
+            public:
+                /**
+                 * Create buffered input stream
+                 * @param buf_size the block size, zero for the default block size
+                 */
+                explicit InBufferedStream(size_t buf_size = 0);
+                virtual ~InBufferedStream();
+
+            public:
+                /** Wrap stdio file descriptor. The Reader should be in closed state.
+                 *
+                 * @param fd file descriptor
+                 * @param close close file descriptor on close()
+                 * @return status of operation
+                 */
+                status_t wrap(FILE *fd, bool close);
+
+                /** Wrap native file descriptor. The Reader should be in closed state.
+                 *
+                 * @param fd file descriptor
+                 * @param close close file descriptor on close()
+                 * @return status of operation
+                 */
+                status_t wrap_native(fhandle_t fd, bool close);
+
+                /** Wrap file descriptor. The Reader should be in closed state.
+                 *
+                 * @param fd file descriptor
+                 * @param flags wrapping flags
+                 * @return status of operation
+                 */
+                status_t wrap(File *fd, size_t flags);
+
+                /** Wrap input stream
+                 *
+                 * @param is input stream
+                 * @param flags wrapping flags
+                 * @return status of operation
+                 */
+                status_t wrap(IInStream *is, size_t flags = 0);
+
+                /** Open input stream associated with file. The Reader should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const char *path);
+
+                /** Open input stream associated with file. The Reader should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const LSPString *path);
+
+                /** Open input stream associated with file. The Reader should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const Path *path);
+
+                /**
+                 * Get the block size of the stream
+                 * @return block size in bytes
+                 */
+                inline size_t       buffer_size() const     { return nBufSize; }
+
+                /**
+                 * Get the amount of data stored in the buffer and available for read without
+                 * accessing the wrapped stream
+                 * @return amount of buffered data in bytes
+                 */
+                inline size_t       buffered() const        { return nTail - nHead; }
+
+                /**
+                 * Read data without advancing the read position. At most buffer_size() bytes
+                 * can be peeked at once.
+                 *
+                 * @param dst target buffer to store data
+                 * @param count number of bytes to peek
+                 * @return number of bytes actually peeked or negative error code
+                 */
+                ssize_t             peek(void *dst, size_t count);
+
+                /**
+                 * Return the recently read data back to the stream. Only the data that still
+                 * resides in the buffer can be returned.
+                 *
+                 * @param count number of bytes to return
+                 * @return status of operation, STATUS_OVERFLOW if there is not enough data in the buffer
+                 */
+                status_t            unread(size_t count);
+
+            public:
+                virtual wssize_t    avail();
+
+                virtual wssize_t    position();
+
+                virtual ssize_t     read(void *dst, size_t count);
+
+                virtual ssize_t     read_byte();
+
+                virtual wssize_t    seek(wsize_t position);
+
+                virtual wssize_t    skip(wsize_t amount);
+
+                virtual status_t    close();
+        };
+    
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INBUFFEREDSTREAM_H_ */
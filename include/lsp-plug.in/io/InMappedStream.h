@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INMAPPEDSTREAM_H_
+#define LSP_PLUG_IN_IO_INMAPPEDSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/MappedFile.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Input stream over the read-only memory mapping of the file.
+         * Reads are served directly from the mapping, the whole contents
+         * are additionally available as a contiguous byte span by data()
+         * and size() methods without any copying.
+         *
+         * Reading the stream crashes the process with SIGBUS if the file gets
+         * truncated by another process while mapped, see MappedFile. Use
+         * InFileStream for files that may be modified concurrently.
+         */
+        class InMappedStream: public InMemoryStream
+        {
+            protected:
+                MappedFile      sFile;
+
+            private:
+                InMappedStream & operator = (const InMappedStream &);
+
+            public:
+                explicit InMappedStream();
+                virtual ~InMappedStream();
+
+            public:
+                /** Map the file and open the stream. The stream should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const char *path);
+
+                /** Map the file and open the stream. The stream should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const LSPString *path);
+
+                /** Map the file and open the stream. The stream should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const Path *path);
+
+                /**
+                 * Get the size of the mapped file
+                 * @return size of the mapped file in bytes
+                 */
+                inline size_t size() const      { return nSize; }
+
+            public:
+                virtual status_t    close();
+        };
+    
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INMAPPEDSTREAM_H_ */
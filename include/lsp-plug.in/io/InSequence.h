@@ -48,6 +48,7 @@ namespace lsp
                 InSequence & operator = (const InSequence &);
 
                 lsp_swchar_t read_internal();
+                ssize_t     borrow_internal(const lsp_wchar_t **buf);
 
             public:
                 explicit InSequence();
@@ -121,6 +122,8 @@ namespace lsp
 
                 virtual status_t    read_line(LSPString *s, bool force = false);
 
+                virtual ssize_t     borrow(const lsp_wchar_t **buf);
+
                 virtual ssize_t     skip(size_t count);
 
                 virtual status_t    close();
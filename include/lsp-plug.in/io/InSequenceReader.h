@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INSEQUENCEREADER_H_
+#define LSP_PLUG_IN_IO_INSEQUENCEREADER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/io/IInSequence.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Lightweight character reader for tokenizers. Scans the windows borrowed
+         * from the input sequence and falls back to IInSequence::read() if the sequence
+         * does not support borrowing. The consumed characters are committed to the
+         * sequence when the next window is borrowed or when commit() is called, so
+         * the sequence should not be accessed directly until commit() is called.
+         */
+        class InSequenceReader
+        {
+            private:
+                InSequenceReader(const InSequenceReader &);
+                InSequenceReader & operator = (const InSequenceReader &);
+
+            protected:
+                IInSequence            *pIn;
+                const lsp_wchar_t      *pStart;         // Start of the borrowed window
+                const lsp_wchar_t      *pHead;          // Current position in the borrowed window
+                const lsp_wchar_t      *pTail;          // End of the borrowed window
+                bool                    bDirect;        // Sequence does not support borrowing
+
+            protected:
+                lsp_swchar_t            fill();
+
+            public:
+                explicit InSequenceReader(IInSequence *in = NULL);
+                ~InSequenceReader();
+
+            public:
+                /**
+                 * Get the input sequence
+                 * @return input sequence
+                 */
+                inline IInSequence     *sequence() const    { return pIn; }
+
+                /**
+                 * Set the input sequence, the borrowed window of the previous
+                 * sequence is dropped without commit
+                 * @param in input sequence
+                 */
+                void                    wrap(IInSequence *in);
+
+                /**
+                 * Read single character
+                 * @return code of single character or negative error code
+                 */
+                inline lsp_swchar_t     read()              { return (pHead < pTail) ? *(pHead++) : fill(); }
+
+                /**
+                 * Consume the read characters from the input sequence and drop
+                 * the borrowed window
+                 * @return status of operation
+                 */
+                status_t                commit();
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INSEQUENCEREADER_H_ */
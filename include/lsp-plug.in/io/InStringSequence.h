@@ -63,6 +63,8 @@ namespace lsp
 
                 virtual status_t        read_line(LSPString *s, bool force = false);
 
+                virtual ssize_t         borrow(const lsp_wchar_t **buf);
+
                 virtual ssize_t         skip(size_t count);
 
                 virtual status_t        close();
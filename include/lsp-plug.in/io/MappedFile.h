@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_MAPPEDFILE_H_
+#define LSP_PLUG_IN_IO_MAPPEDFILE_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/Path.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Read-only memory mapping of the whole file. The contents of the file
+         * are available as a contiguous byte span until the mapping is closed.
+         * Pages are loaded on demand and shared with the system page cache.
+         *
+         * The mapping is shared with the file, so changes made to the file by
+         * other processes become visible through the mapping. If the file gets
+         * truncated while mapped, accessing the pages past the new end of file
+         * raises SIGBUS on POSIX systems instead of returning an error. Files
+         * that may be rewritten or truncated concurrently (for example, presets
+         * and configuration files re-saved by other instances) should be read
+         * with InFileStream instead.
+         */
+        class MappedFile
+        {
+            protected:
+                uint8_t        *pData;
+                size_t          nSize;
+                bool            bOpened;
+            #if defined(PLATFORM_WINDOWS)
+                void           *hMapping;
+            #endif /* PLATFORM_WINDOWS */
+
+            private:
+                MappedFile(const MappedFile &);
+                MappedFile & operator = (const MappedFile &);
+
+            public:
+                explicit MappedFile();
+                ~MappedFile();
+
+            public:
+                /** Map the file into memory. The mapping should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const char *path);
+
+                /** Map the file into memory. The mapping should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const LSPString *path);
+
+                /** Map the file into memory. The mapping should be in closed state.
+                 *
+                 * @param path file location path
+                 * @return status of operation
+                 */
+                status_t open(const Path *path);
+
+                /**
+                 * Unmap the file, all pointers obtained by data() become invalid
+                 * @return status of operation
+                 */
+                status_t close();
+
+                /**
+                 * Check that the file is mapped
+                 * @return true if the file is mapped
+                 */
+                inline bool opened() const          { return bOpened; }
+
+                /**
+                 * Get the mapped contents, may be NULL for empty file
+                 * @return pointer to the first byte of the file
+                 */
+                inline const uint8_t *data() const  { return pData; }
+
+                /**
+                 * Get the size of mapped contents
+                 * @return size of mapped contents in bytes
+                 */
+                inline size_t size() const          { return nSize; }
+        };
+    
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_MAPPEDFILE_H_ */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_OUTBUFFEREDSTREAM_H_
+#define LSP_PLUG_IN_IO_OUTBUFFEREDSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/io/IOutStream.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/File.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Output stream that collects small writes in the aligned buffer and
+         * passes them to the wrapped stream by large blocks. Writes that are not
+         * less than the block size bypass the buffer.
+         */
+        class OutBufferedStream: public IOutStream
+        {
+            protected:
+                IOutStream     *pOS;            // Output stream
+                size_t          nWrapFlags;     // Wrap flags
+                uint8_t        *pBuffer;        // Aligned buffer
+                void           *pData;          // Allocated data
+                size_t          nBufSize;       // Block size
+                size_t          nFill;          // Amount of data in the buffer
+
+            private:
+                OutBufferedStream & operator = (const OutBufferedStream &);
+
+            protected:
+                status_t            flush_buffer();
+
+            public:
+                /**
+                 * Create buffered output stream
+                 * @param buf_size the block size, zero for the default block size
+                 */
+                explicit OutBufferedStream(size_t buf_size = 0);
+                virtual ~OutBufferedStream();
+
+            public:
+                status_t            open(const char *path, size_t mode);
+                status_t            open(const LSPString *path, size_t mode);
+                status_t            open(const io::Path *path, size_t mode);
+
+                status_t            wrap(FILE *fd, bool close);
+                status_t            wrap_native(fhandle_t fd, bool close);
+                status_t            wrap(File *fd, size_t flags = 0);
+                status_t            wrap(IOutStream *os, size_t flags = 0);
+
+                /**
+                 * Get the block size of the stream
+                 * @return block size in bytes
+                 */
+                inline size_t       buffer_size() const     { return nBufSize; }
+
+                /**
+                 * Get the amount of data stored in the buffer and not yet passed
+                 * to the wrapped stream
+                 * @return amount of buffered data in bytes
+                 */
+                inline size_t       buffered() const        { return nFill; }
+
+            public:
+                virtual wssize_t    position();
+
+                virtual ssize_t     write(const void *buf, size_t count);
+
+                virtual ssize_t     writeb(int v);
+
+                virtual wssize_t    seek(wsize_t position);
+
+                virtual status_t    flush();
+
+                virtual status_t    close();
+        };
+    
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_OUTBUFFEREDSTREAM_H_ */
@@ -78,6 +78,27 @@ namespace lsp
 
 #endif /* PLATFORM_WINDOWS */
 
+    /**
+     * Character sets that have built-in codecs and do not require
+     * system conversion facilities like iconv or WinAPI
+     */
+    enum native_charset_t
+    {
+        NCS_NONE,           // No built-in codec is available
+        NCS_UTF8,           // UTF-8
+        NCS_UTF16LE,        // UTF-16 little-endian
+        NCS_UTF16BE,        // UTF-16 big-endian
+        NCS_ASCII,          // 7-bit ASCII
+        NCS_LATIN1          // ISO-8859-1
+    };
+
+    /**
+     * Get the built-in codec for the character set
+     * @param charset character set name, NULL (system character set) is never handled natively
+     * @return built-in codec or NCS_NONE if there is no built-in codec for the character set
+     */
+    native_charset_t        native_charset(const char *charset);
+
     /**
      * Read UTF-16 codepoint from the NULL-terminated UTF-16 string, replace invalid
      * code sequence by 0xfffd code point
@@ -134,6 +155,30 @@ namespace lsp
     void                    write_utf16be_codepoint(lsp_utf16_t **str, lsp_utf32_t cp);
     inline void             write_utf16_codepoint(lsp_utf16_t **str, lsp_utf32_t cp) { return __IF_LEBE(write_utf16le_codepoint, write_utf16be_codepoint)(str, cp); }
 
+    /**
+     * Convert the leading run of non-zero 7-bit ASCII characters to UTF-32 code points
+     * in native byte order. The conversion stops at the first byte that requires UTF-8
+     * decoding. Long runs are processed with vector instructions if available.
+     *
+     * @param dst destination buffer of at least n code points
+     * @param src source buffer
+     * @param n number of bytes in the source buffer
+     * @return number of converted characters
+     */
+    size_t                  ascii_to_utf32(lsp_utf32_t *dst, const char *src, size_t n);
+
+    /**
+     * Convert the leading run of code points below 0x80 stored in native byte order
+     * to 7-bit ASCII characters. The conversion stops at the first code point that
+     * requires UTF-8 encoding. Long runs are processed with vector instructions if available.
+     *
+     * @param dst destination buffer of at least n bytes
+     * @param src source buffer
+     * @param n number of code points in the source buffer
+     * @return number of converted characters
+     */
+    size_t                  utf32_to_ascii(char *dst, const lsp_utf32_t *src, size_t n);
+
     /**
      * Encode NULL-terminated UTF-8 string to NULL-terminated UTF-16 string
      * @param str string to encode
@@ -56,7 +56,7 @@ namespace lsp
                     task->nState    = ITask::TS_RUNNING;
                     task->nCode     = 0;
                     task->nCode     = task->run();
-                    task->nState    = ITask::TS_COMPLETED;
+                    task->complete();
                 }
 
             private:
@@ -24,12 +24,24 @@
 
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/ipc/IRunnable.h>
 
 namespace lsp
 {
     namespace ipc
     {
+        class ITask;
+        class IExecutor;
+        class Semaphore;
+
+        /**
+         * Callback that is called when the task becomes completed
+         * @param task the completed task
+         * @param arg argument passed to ITask::on_complete
+         */
+        typedef void (* task_callback_t)(ITask *task, void *arg);
+
         class ITask: public IRunnable
         {
             public:
@@ -41,6 +53,13 @@ namespace lsp
                     TS_COMPLETED
                 };
 
+            private:
+                typedef struct waiter_t
+                {
+                    Semaphore      *pSem;           // Semaphore to signal
+                    waiter_t       *pNext;          // Next waiter in the list
+                } waiter_t;
+
             protected:
                 // Task linking
                 ITask      *pNext;
@@ -49,11 +68,28 @@ namespace lsp
                 // Task state
                 volatile task_state_t    nState;
 
+                // Completion handling
+                atomic_t            nLock;          // Lock that protects completion data
+                waiter_t           *pWaiters;       // List of waiting threads
+                task_callback_t     pCallback;      // Completion callback
+                void               *pCbArg;         // Completion callback argument
+                ITask              *pThen;          // Continuation task
+                IExecutor          *pThenExecutor;  // Executor for continuation task
+
                 // Executor service
                 friend class IExecutor;
 
                 static inline bool successful(int code)     { return code == STATUS_OK; };
 
+            private:
+                void                lock();
+                void                unlock();
+                void                complete();
+                static void         submit_then(ITask *task, IExecutor *executor);
+                bool                add_waiter(waiter_t *w);
+                bool                remove_waiter(waiter_t *w);
+                static ssize_t      wait_for(ITask * const *tasks, size_t count, bool timed, wsize_t millis);
+
             public:
                 ITask();
                 virtual ~ITask();
@@ -115,6 +151,83 @@ namespace lsp
                     nState      = TS_IDLE;
                     return true;
                 }
+
+                /** Block the caller thread until the task becomes completed
+                 *
+                 * @return true if task has been completed
+                 */
+                bool wait();
+
+                /** Block the caller thread until the task becomes completed
+                 *
+                 * @param millis maximum amount of milliseconds to wait
+                 * @return true if task has been completed, false on timeout
+                 */
+                bool wait(wsize_t millis);
+
+                /** Set callback that will be called by the executor thread once
+                 * the task becomes completed. The callback is called only once,
+                 * if the task is already completed, it is called immediately
+                 * by the caller thread. The callback is called after the task
+                 * has been marked completed and the waiting threads have been
+                 * released, so it should not access the task if the owner may
+                 * destroy the task right after waiting for it
+                 *
+                 * @param callback callback to call
+                 * @param arg argument to pass to the callback
+                 * @return true if callback has been set, false if another callback
+                 *   is already pending
+                 */
+                bool on_complete(task_callback_t callback, void *arg);
+
+                /** Set continuation task that will be submitted to the specified
+                 * executor once this task becomes completed. The continuation may
+                 * have its own continuation, this allows to build chains of tasks.
+                 * If the task is already completed, the continuation is submitted
+                 * immediately. If the executor keeps refusing the idle continuation
+                 * on completion, the continuation is completed with STATUS_CANCELLED
+                 * code so the threads waiting for it are not blocked forever
+                 *
+                 * @param task continuation task
+                 * @param executor executor to submit continuation task to
+                 * @return true if continuation has been set or submitted
+                 */
+                bool then(ITask *task, IExecutor *executor);
+
+            public:
+                /** Wait until all tasks become completed
+                 *
+                 * @param tasks list of tasks
+                 * @param count number of tasks in the list
+                 * @return true if all tasks have been completed
+                 */
+                static bool wait_all(ITask * const *tasks, size_t count);
+
+                /** Wait until all tasks become completed
+                 *
+                 * @param tasks list of tasks
+                 * @param count number of tasks in the list
+                 * @param millis maximum amount of milliseconds to wait
+                 * @return true if all tasks have been completed, false on timeout
+                 */
+                static bool wait_all(ITask * const *tasks, size_t count, wsize_t millis);
+
+                /** Wait until any of tasks becomes completed
+                 *
+                 * @param tasks list of tasks
+                 * @param count number of tasks in the list
+                 * @return index of completed task or negative value on error
+                 */
+                static ssize_t wait_any(ITask * const *tasks, size_t count);
+
+                /** Wait until any of tasks becomes completed
+                 *
+                 * @param tasks list of tasks
+                 * @param count number of tasks in the list
+                 * @param millis maximum amount of milliseconds to wait
+                 * @return index of completed task or negative value on timeout
+                 */
+                static ssize_t wait_any(ITask * const *tasks, size_t count, wsize_t millis);
         };
 
     } /* namespace ipc */
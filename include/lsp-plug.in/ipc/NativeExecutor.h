@@ -25,6 +25,7 @@
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/ipc/Semaphore.h>
 #include <lsp-plug.in/ipc/IExecutor.h>
 #include <lsp-plug.in/ipc/ITask.h>
 
@@ -39,6 +40,8 @@ namespace lsp
                 ITask              *pHead;
                 ITask              *pTail;
                 atomic_t            nLock;
+                Semaphore           sWakeup;        // Signals the thread about new tasks or shutdown
+                volatile bool       bShutdown;
 
                 static status_t     execute(void *params);
                 void    run();
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IPC_SEMAPHORE_H_
+#define LSP_PLUG_IN_IPC_SEMAPHORE_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <synchapi.h>
+#elif defined(PLATFORM_LINUX)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <errno.h>
+#else
+    #include <pthread.h>
+    #include <errno.h>
+#endif
+
+namespace lsp
+{
+    namespace ipc
+    {
+        /**
+         * Counting semaphore that allows threads to block until another
+         * thread signals them instead of polling for events
+         */
+        class Semaphore
+        {
+            private:
+#if defined(PLATFORM_WINDOWS)
+                HANDLE                      hSem;       // Semaphore object
+#elif defined(PLATFORM_LINUX)
+                volatile atomic_t           nCount;     // Number of pending signals shifted left by one, bit 0 marks sleeping threads
+                volatile atomic_t           nWaiters;   // Number of waiting threads, accessed by waiting threads only
+#else
+                pthread_mutex_t             sMutex;     // Mutex that protects the counter
+                pthread_cond_t              sCond;      // Condition to wait for
+                size_t                      nCount;     // Number of pending signals
+#endif
+
+            private:
+                Semaphore & operator = (const Semaphore & m);       // Deny copying
+
+#if defined(PLATFORM_LINUX)
+                bool                        wait_signal(const struct timespec *timeout);
+                void                        remove_waiter();
+#endif
+
+            public:
+                explicit Semaphore();
+                ~Semaphore();
+
+            public:
+                /** Increment the counter of the semaphore and wake up
+                 * one of the waiting threads. The semaphore may be destroyed
+                 * by the woken thread even before this method returns
+                 *
+                 * @return true on success
+                 */
+                bool post();
+
+                /** Wait until the counter of the semaphore becomes positive
+                 * and decrement it
+                 *
+                 * @return true on success
+                 */
+                bool wait();
+
+                /** Wait until the counter of the semaphore becomes positive
+                 * and decrement it, but not longer than specified
+                 *
+                 * @param millis maximum amount of milliseconds to wait
+                 * @return true on success, false on timeout
+                 */
+                bool wait(wsize_t millis);
+
+                /** Decrement the counter of the semaphore if it is positive
+                 * without blocking
+                 *
+                 * @return true if counter was decremented
+                 */
+                bool try_wait();
+        };
+
+    } /* namespace ipc */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IPC_SEMAPHORE_H_ */
@@ -30,6 +30,7 @@
     #include <processthreadsapi.h>
 #else
     #include <pthread.h>
+    #include <sched.h>
 #endif /* PLATFORM_WINDOWS */
 
 #include <lsp-plug.in/ipc/IRunnable.h>
@@ -132,6 +133,11 @@ namespace lsp
                  */
                 static status_t sleep(wsize_t millis);
 
+                /**
+                 * Give up the rest of time slice of the current thread to other threads
+                 */
+                static void yield();
+
                 /**
                  * Return the current thread
                  * @return current thread or NULL if current thread is not an instance of ipc::Thread class
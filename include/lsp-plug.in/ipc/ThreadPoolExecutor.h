@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IPC_THREADPOOLEXECUTOR_H_
+#define LSP_PLUG_IN_IPC_THREADPOOLEXECUTOR_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/ipc/Semaphore.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/ITask.h>
+
+namespace lsp
+{
+    namespace ipc
+    {
+        /**
+         * Executor service that runs tasks on a pool of worker threads.
+         * Each worker owns its own task queue, idle workers steal tasks
+         * from the queues of other workers.
+         */
+        class ThreadPoolExecutor: public IExecutor
+        {
+            private:
+                typedef struct worker_t
+                {
+                    ThreadPoolExecutor *pExecutor;      // Owning executor
+                    Thread             *pThread;        // Worker thread
+                    size_t              nIndex;         // Index of worker in the pool
+                    Mutex               sLock;          // Lock that protects the queue
+                    ITask              *pHead;          // Head of the task queue
+                    ITask              *pTail;          // Tail of the task queue
+                } worker_t;
+
+            private:
+                worker_t          **vWorkers;           // List of workers
+                size_t              nWorkers;           // Number of workers
+                size_t              nThreads;           // Requested number of threads
+                volatile atomic_t   nNext;              // Round-robin counter for submission
+                volatile atomic_t   nPending;           // Number of submitted but not completed tasks
+                volatile bool       bShutdown;          // Shutdown flag, modified under the pool lock
+                Mutex               sPoolLock;          // Protects the list of workers and shutdown flag from submit()
+                Semaphore           sWakeup;            // Signals workers about new tasks or shutdown
+
+            private:
+                static status_t     execute(void *params);
+                void                run(worker_t *w);
+                worker_t           *current_worker();
+                ITask              *dequeue(worker_t *w);
+                ITask              *steal(worker_t *w);
+                void                wakeup_all();
+                void                destroy();
+
+            private:
+                ThreadPoolExecutor &operator = (const ThreadPoolExecutor &src); // Deny copying
+
+            public:
+                /** Create thread pool executor
+                 *
+                 * @param threads number of worker threads, zero means the number of CPU cores
+                 */
+                explicit ThreadPoolExecutor(size_t threads = 0);
+                virtual ~ThreadPoolExecutor();
+
+            public:
+                /** Start all worker threads
+                 *
+                 * @return status of operation
+                 */
+                status_t start();
+
+                /** Get number of worker threads
+                 *
+                 * @return number of worker threads
+                 */
+                inline size_t threads() const       { return nWorkers; }
+
+                /** Submit task for execution. The method blocks only for
+                 * the short time needed to link task into the queue, so the
+                 * submission never fails because of contention. Tasks submitted
+                 * from outside of the pool are rejected after shutdown() has started
+                 *
+                 * @param task task to execute
+                 * @return true if task was submitted, false if task is not idle
+                 *   or executor is not running
+                 */
+                virtual bool submit(ITask *task);
+
+                /** Wait until all submitted tasks are complete and stop
+                 * all worker threads
+                 */
+                virtual void shutdown();
+        };
+    } /* namespace ipc */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IPC_THREADPOOLEXECUTOR_H_ */
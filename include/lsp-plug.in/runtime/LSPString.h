@@ -31,34 +31,113 @@
 
 namespace lsp
 {
+    class LSPString;
+
+    /**
+     * Scratch buffer for conversion of strings into external encodings. The buffer
+     * is owned by the caller, the data written by LSPString::to_* methods remains
+     * valid until the next conversion into the same buffer or until the buffer is
+     * cleared or destroyed. The buffer can be reused for many strings, keeping one
+     * buffer per thread avoids allocations and does not require any synchronization.
+     */
+    class LSPStringScratch
+    {
+        private:
+            friend class LSPString;
+
+            LSPStringScratch(const LSPStringScratch &);
+            LSPStringScratch & operator = (const LSPStringScratch &);
+
+        protected:
+            size_t      nOffset;        // Number of bytes used
+            size_t      nLength;        // Capacity in bytes
+            char       *pData;          // Data
+
+        protected:
+            bool        append(const void *p, size_t n);
+            bool        resize(size_t n);
+            bool        grow(size_t n);
+
+        public:
+            explicit LSPStringScratch();
+            ~LSPStringScratch();
+
+        public:
+            /**
+             * Get the data of the last conversion
+             * @return pointer to the data, may be NULL if there was no conversion
+             */
+            inline const char  *data() const       { return pData;     }
+
+            /**
+             * Get the size of the last conversion including terminating zero characters
+             * @return size in bytes
+             */
+            inline size_t       size() const        { return nOffset;   }
+
+            /**
+             * Get the amount of memory allocated by the buffer
+             * @return capacity in bytes
+             */
+            inline size_t       capacity() const    { return nLength;   }
+
+            /**
+             * Reset the buffer but keep the allocated memory
+             */
+            inline void         clear()             { nOffset = 0;      }
+
+            /**
+             * Release the allocated memory
+             */
+            void                truncate();
+
+            /**
+             * Reserve the memory for the conversion
+             * @param size number of bytes to reserve
+             * @return true on success
+             */
+            bool                reserve(size_t size);
+    };
+
     /**
      * String class
      */
     class LSPString
     {
+        private:
+            LSPString(const LSPString &);
+            LSPString & operator = (const LSPString &);
+
         protected:
-            typedef struct buffer_t
+            typedef struct buffer_t: public LSPStringScratch
             {
-                size_t      nOffset;
-                size_t      nLength;
-                char       *pData;
+                buffer_t   *pPrev;          // Previous buffer in the list of allocated buffers
+                buffer_t   *pNext;          // Next buffer in the list of allocated buffers
             } buffer_t;
 
+            enum constants_t
+            {
+                INLINE_CAPACITY     = 16    // Number of characters stored without heap allocation
+            };
+
         protected:
             size_t              nLength;
             size_t              nCapacity;
-            lsp_wchar_t        *pData;
+            lsp_wchar_t        *pData;      // Points to vInline for short strings
             mutable size_t      nHash;
             mutable buffer_t   *pTemp;
+            lsp_wchar_t         vInline[INLINE_CAPACITY];
+
+            static buffer_t    *pTempList;  // List of temporary buffers of all strings
 
         protected:
+            inline bool     is_inline() const   { return pData == vInline; }
             bool            size_reserve(size_t size);
             inline bool     cap_reserve(size_t size);
             inline bool     cap_grow(size_t delta);
             void            drop_temp();
-            bool            append_temp(const char *p, size_t n) const;
-            bool            resize_temp(size_t n) const;
-            bool            grow_temp(size_t n) const;
+            LSPStringScratch   *temp() const;
+            static void        *detach(LSPStringScratch *buf, void *ptr, size_t *bytes);
 
             static inline lsp_wchar_t *xmalloc(size_t size)                                 { return reinterpret_cast<lsp_wchar_t *>(::malloc(size * sizeof(lsp_wchar_t))); }
             static inline lsp_wchar_t *xrealloc(lsp_wchar_t * ptr, size_t size)             { return reinterpret_cast<lsp_wchar_t *>(::realloc(ptr, size * sizeof(lsp_wchar_t))); };
@@ -73,12 +152,42 @@ namespace lsp
             static int xcmp(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n);
 #endif /* ARCH_LE */
             static int xcasecmp(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n);
+            static inline lsp_wchar_t xlower(lsp_wchar_t c);
+            static size_t xmismatch(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n);
+            static size_t xmismatch_nocase(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n);
+            static ssize_t xfind(const lsp_wchar_t *s, size_t n, lsp_wchar_t ch);
+            static ssize_t xrfind(const lsp_wchar_t *s, size_t n, lsp_wchar_t ch);
+            static ssize_t xsearch(const lsp_wchar_t *s, size_t n, const lsp_wchar_t *p, size_t m);
+            static ssize_t xrsearch(const lsp_wchar_t *s, size_t n, const lsp_wchar_t *p, size_t m);
             static inline void acopy(lsp_wchar_t *dst, const char *src, size_t n);
 
         public:
             explicit LSPString();
             ~LSPString();
 
+#if __cplusplus >= 201103L
+            /** Move constructor: take data from another string and empty that string
+             *
+             * @param src source string
+             */
+            inline LSPString(LSPString && src): nLength(0), nCapacity(0), pData(NULL), nHash(0), pTemp(NULL)
+            {
+                take(&src);
+            }
+
+            /** Move assignment: take data from another string and empty that string
+             *
+             * @param src source string
+             * @return reference to self
+             */
+            inline LSPString & operator = (LSPString && src)
+            {
+                if (&src != this)
+                    take(&src);
+                return *this;
+            }
+#endif /* __cplusplus */
+
         public:
             /** Get the length of the string
              *
@@ -309,6 +418,47 @@ namespace lsp
             inline size_t temporal_size() const     { return (pTemp != NULL) ? pTemp->nOffset : 0; };
             inline size_t temporal_capacity() const { return (pTemp != NULL) ? pTemp->nLength : 0; };
 
+            /**
+             * Convert the string into the caller-supplied scratch buffer. Unlike get_* methods,
+             * these methods do not use the temporary buffer of the string, so the same string
+             * can be converted by several threads simultaneously, each thread using own buffer.
+             *
+             * @param buf the scratch buffer to store the result
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @param charset character set for the native encoding
+             * @return pointer to the data stored in the scratch buffer or NULL on error
+             */
+            const char *to_utf8(LSPStringScratch *buf, ssize_t first, ssize_t last) const;
+            inline const char *to_utf8(LSPStringScratch *buf, ssize_t first) const { return to_utf8(buf, first, nLength); }
+            inline const char *to_utf8(LSPStringScratch *buf) const { return to_utf8(buf, 0, nLength); }
+
+            const lsp_utf16_t *to_utf16(LSPStringScratch *buf, ssize_t first, ssize_t last) const;
+            inline const lsp_utf16_t *to_utf16(LSPStringScratch *buf, ssize_t first) const { return to_utf16(buf, first, nLength); }
+            inline const lsp_utf16_t *to_utf16(LSPStringScratch *buf) const { return to_utf16(buf, 0, nLength); }
+
+            const char *to_ascii(LSPStringScratch *buf, ssize_t first, ssize_t last) const;
+            inline const char *to_ascii(LSPStringScratch *buf, ssize_t first) const { return to_ascii(buf, first, nLength); }
+            inline const char *to_ascii(LSPStringScratch *buf) const { return to_ascii(buf, 0, nLength); }
+
+            const char *to_native(LSPStringScratch *buf, ssize_t first, ssize_t last, const char *charset = NULL) const;
+            inline const char *to_native(LSPStringScratch *buf, ssize_t first, const char *charset = NULL) const { return to_native(buf, first, nLength, charset); }
+            inline const char *to_native(LSPStringScratch *buf, const char *charset = NULL) const { return to_native(buf, 0, nLength, charset); }
+
+            /**
+             * Release the temporary buffer allocated by get_* methods
+             */
+            void release_temp() const;
+
+            /**
+             * Release memory of temporary buffers allocated by get_* methods of all strings.
+             * The caller should ensure that no other thread calls get_* methods and
+             * no pointers returned by get_* methods are in use.
+             *
+             * @return number of bytes released
+             */
+            static size_t release_all_temp();
+
             /**
              * Find number of matching characters from one string to another
              */
@@ -562,6 +712,15 @@ namespace lsp
              * @return hash code
              */
             size_t  hash() const;
+
+            /**
+             * Compute the hash code of the character sequence, gives the same
+             * result as hash() for the string with the same contents
+             * @param s pointer to the characters
+             * @param n number of characters
+             * @return hash code
+             */
+            static size_t hash(const lsp_wchar_t *s, size_t n);
     };
     
     // LLTL specialization for String class
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_LSPSTRINGBUILDER_H_
+#define LSP_PLUG_IN_RUNTIME_LSPSTRINGBUILDER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    /**
+     * String builder for assembly of large strings. The data is stored in the list
+     * of chunks, so append and prepend operations never move the data written before.
+     * The chunks grow proportionally to the size of the data, so the number of chunks
+     * remains logarithmic. The final string is assembled by the single flatten call.
+     */
+    class LSPStringBuilder
+    {
+        private:
+            LSPStringBuilder(const LSPStringBuilder &);
+            LSPStringBuilder & operator = (const LSPStringBuilder &);
+
+        protected:
+            typedef struct chunk_t
+            {
+                size_t          nSize;      // Number of characters stored in the chunk
+                size_t          nCapacity;  // Capacity of the chunk
+                lsp_wchar_t    *vData;      // Chunk data, allocated together with the chunk
+            } chunk_t;
+
+            enum constants_t
+            {
+                CHUNK_SIZE      = 0x400     // Minimum number of characters in the chunk
+            };
+
+        protected:
+            lltl::parray<chunk_t>   vHead;      // Chunks filled by prepend, data at the end of chunk, last chunk is the first one
+            lltl::parray<chunk_t>   vTail;      // Chunks filled by append, data at the beginning of chunk
+            size_t                  nLength;    // Overall length
+
+        protected:
+            lsp_wchar_t    *append_space(size_t n);
+            lsp_wchar_t    *prepend_space(size_t n);
+            static chunk_t *alloc_chunk(size_t size);
+            static void     drop_chunks(lltl::parray<chunk_t> *list);
+
+        public:
+            explicit LSPStringBuilder();
+            ~LSPStringBuilder();
+
+        public:
+            /**
+             * Get the length of the string
+             * @return length of the string
+             */
+            inline size_t   length() const      { return nLength;           }
+
+            /**
+             * Check that the string is empty
+             * @return true if the string is empty
+             */
+            inline bool     is_empty() const    { return nLength <= 0;      }
+
+            /**
+             * Clear the contents and release the allocated memory
+             */
+            void            clear();
+
+            /**
+             * Exchange contents with another builder
+             * @param dst builder to exchange contents
+             */
+            void            swap(LSPStringBuilder *dst);
+
+        public:
+            /**
+             * Append data to the end of the string
+             * @return true on success, false if there is not enough memory
+             */
+            bool            append(lsp_wchar_t ch);
+            inline bool     append(char ch)                                     { return append(lsp_wchar_t(uint8_t(ch)));  }
+            bool            append(const lsp_wchar_t *arr, size_t n);
+            bool            append(const LSPString *src);
+            bool            append(const LSPString *src, ssize_t first);
+            bool            append(const LSPString *src, ssize_t first, ssize_t last);
+            bool            append_ascii(const char *arr, size_t n);
+            inline bool     append_ascii(const char *arr)                       { return append_ascii(arr, ::strlen(arr));  }
+            bool            append_utf8(const char *arr, size_t n);
+            inline bool     append_utf8(const char *arr)                        { return append_utf8(arr, ::strlen(arr));   }
+
+            /**
+             * Prepend data to the beginning of the string
+             * @return true on success, false if there is not enough memory
+             */
+            bool            prepend(lsp_wchar_t ch);
+            inline bool     prepend(char ch)                                    { return prepend(lsp_wchar_t(uint8_t(ch))); }
+            bool            prepend(const lsp_wchar_t *arr, size_t n);
+            bool            prepend(const LSPString *src);
+            bool            prepend(const LSPString *src, ssize_t first);
+            bool            prepend(const LSPString *src, ssize_t first, ssize_t last);
+            bool            prepend_ascii(const char *arr, size_t n);
+            inline bool     prepend_ascii(const char *arr)                      { return prepend_ascii(arr, ::strlen(arr)); }
+            bool            prepend_utf8(const char *arr, size_t n);
+            inline bool     prepend_utf8(const char *arr)                       { return prepend_utf8(arr, ::strlen(arr));  }
+
+        public:
+            /**
+             * Store the contents of the builder to the string
+             * @param dst destination string
+             * @return true on success, false if there is not enough memory
+             */
+            bool            flatten(LSPString *dst) const;
+
+            /**
+             * Append the contents of the builder to the string
+             * @param dst destination string
+             * @return true on success, false if there is not enough memory
+             */
+            bool            append_to(LSPString *dst) const;
+    };
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_LSPSTRINGBUILDER_H_ */
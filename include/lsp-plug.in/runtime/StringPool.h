@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_STRINGPOOL_H_
+#define LSP_PLUG_IN_RUNTIME_STRINGPOOL_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    /**
+     * Pool of interned strings. The pool stores only one copy of each string,
+     * so the strings returned by the pool can be compared by pointer. The returned
+     * strings remain valid and unchanged until the pool is cleared or destroyed.
+     * The pool is not thread-safe.
+     */
+    class StringPool
+    {
+        private:
+            StringPool(const StringPool &);
+            StringPool & operator = (const StringPool &);
+
+        protected:
+            lltl::parray<LSPString>     vItems;     // Interned strings
+            LSPString                 **vIndex;     // Hash index, open addressing
+            size_t                      nIndexCap;  // Capacity of the index, power of two
+
+        protected:
+            size_t                  index_slot(const lsp_wchar_t *s, size_t n, size_t hash) const;
+            bool                    grow_index();
+            const LSPString        *intern(const lsp_wchar_t *s, size_t n, size_t hash);
+
+        public:
+            explicit StringPool();
+            ~StringPool();
+
+        public:
+            /**
+             * Get number of strings in the pool
+             * @return number of strings in the pool
+             */
+            inline size_t           size() const            { return vItems.size();     }
+
+            /**
+             * Get the interned string by index
+             * @param index index of the string
+             * @return interned string or NULL if index is out of range
+             */
+            inline const LSPString *get(size_t index) const { return vItems.get(index); }
+
+            /**
+             * Remove all strings from the pool, all previously returned pointers become invalid
+             */
+            void                    clear();
+
+        public:
+            /**
+             * Get the interned copy of the string, add the string to the pool if it is missing
+             * @param s string to intern
+             * @param n number of characters
+             * @return pointer to the interned string or NULL if there is not enough memory
+             */
+            const LSPString        *intern(const lsp_wchar_t *s, size_t n);
+            const LSPString        *intern(const LSPString *s);
+            const LSPString        *intern_ascii(const char *s, size_t n);
+            inline const LSPString *intern_ascii(const char *s)    { return intern_ascii(s, ::strlen(s));  }
+            const LSPString        *intern_utf8(const char *s, size_t n);
+            inline const LSPString *intern_utf8(const char *s)     { return intern_utf8(s, ::strlen(s));   }
+
+            /**
+             * Find the interned copy of the string without modifying the pool
+             * @param s string to find
+             * @param n number of characters
+             * @return pointer to the interned string or NULL if string is not in the pool
+             */
+            const LSPString        *lookup(const lsp_wchar_t *s, size_t n) const;
+            const LSPString        *lookup(const LSPString *s) const;
+            const LSPString        *lookup_ascii(const char *s) const;
+    };
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_STRINGPOOL_H_ */
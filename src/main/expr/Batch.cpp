@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/expr/Batch.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        Batch::Batch()
+        {
+            pResolver       = NULL;
+            nLane           = 0;
+        }
+
+        Batch::Batch(Resolver *r)
+        {
+            pResolver       = r;
+            nLane           = 0;
+        }
+
+        Batch::~Batch()
+        {
+            do_destroy();
+        }
+
+        void Batch::do_destroy()
+        {
+            for (size_t i=0, n=vArrays.size(); i<n; ++i)
+            {
+                array_t *a = vArrays.uget(i);
+                if (a != NULL)
+                    delete a;
+            }
+            vArrays.flush();
+            hArrays.flush();
+        }
+
+        void Batch::clear()
+        {
+            do_destroy();
+        }
+
+        Batch::array_t *Batch::create(const LSPString *name)
+        {
+            array_t *a = hArrays.get(name);
+            if (a != NULL)
+                return a;
+
+            if ((a = new array_t) == NULL)
+                return NULL;
+            a->f32      = NULL;
+            a->f64      = NULL;
+
+            if (a->name.set(name))
+            {
+                if (vArrays.add(a))
+                {
+                    if (hArrays.create(&a->name, a))
+                        return a;
+                    vArrays.pop();
+                }
+            }
+
+            delete a;
+            return NULL;
+        }
+
+        status_t Batch::set(const char *name, const float *data)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            LSPString key;
+            if (!key.set_utf8(name))
+                return STATUS_NO_MEM;
+            return set(&key, data);
+        }
+
+        status_t Batch::set(const LSPString *name, const float *data)
+        {
+            if ((name == NULL) || (data == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            array_t *a  = create(name);
+            if (a == NULL)
+                return STATUS_NO_MEM;
+            a->f32      = data;
+            a->f64      = NULL;
+
+            return STATUS_OK;
+        }
+
+        status_t Batch::set(const char *name, const double *data)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            LSPString key;
+            if (!key.set_utf8(name))
+                return STATUS_NO_MEM;
+            return set(&key, data);
+        }
+
+        status_t Batch::set(const LSPString *name, const double *data)
+        {
+            if ((name == NULL) || (data == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            array_t *a  = create(name);
+            if (a == NULL)
+                return STATUS_NO_MEM;
+            a->f32      = NULL;
+            a->f64      = data;
+
+            return STATUS_OK;
+        }
+
+        status_t Batch::unset(const char *name)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            LSPString key;
+            if (!key.set_utf8(name))
+                return STATUS_NO_MEM;
+            return unset(&key);
+        }
+
+        status_t Batch::unset(const LSPString *name)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            array_t *a = hArrays.get(name);
+            if (a == NULL)
+                return STATUS_NOT_FOUND;
+
+            hArrays.remove(&a->name, NULL);
+            vArrays.qpremove(a);
+            delete a;
+
+            return STATUS_OK;
+        }
+
+        const Batch::array_t *Batch::lookup(const LSPString *name, size_t num_indexes, const ssize_t *indexes)
+        {
+            if (num_indexes <= 0)
+                return hArrays.get(name);
+
+            // Form the name of indexed variable the same way as expr::Variables does
+            LSPString key;
+            if (!indexed_name(&key, name, num_indexes, indexes))
+                return NULL;
+
+            return hArrays.get(&key);
+        }
+
+        status_t Batch::resolve(value_t *value, const char *name, size_t num_indexes, const ssize_t *indexes)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            LSPString key;
+            if (!key.set_utf8(name))
+                return STATUS_NO_MEM;
+
+            return resolve(value, &key, num_indexes, indexes);
+        }
+
+        status_t Batch::resolve(value_t *value, const LSPString *name, size_t num_indexes, const ssize_t *indexes)
+        {
+            const array_t *a = lookup(name, num_indexes, indexes);
+            if (a == NULL)
+            {
+                if (pResolver == NULL)
+                    return STATUS_NOT_FOUND;
+                return pResolver->resolve(value, name, num_indexes, indexes);
+            }
+
+            if (value != NULL)
+            {
+                value->type     = VT_FLOAT;
+                value->v_float  = (a->f64 != NULL) ? a->f64[nLane] : a->f32[nLane];
+            }
+
+            return STATUS_OK;
+        }
+
+    } /* namespace expr */
+} /* namespace lsp */
@@ -0,0 +1,1367 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/expr/Batch.h>
+#include <lsp-plug.in/expr/Bytecode.h>
+#include <lsp-plug.in/expr/parser.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+// Number of lanes processed by each lane instruction at once
+#define LANE_CHUNK          256
+
+namespace lsp
+{
+    namespace expr
+    {
+        enum op_kind_t
+        {
+            K_NONE,
+
+            K_ADD,
+            K_SUB,
+            K_MUL,
+            K_DIV,
+            K_POW,          // Used only by lane instructions
+
+            K_CMP,
+            K_CMP_EQ,
+            K_CMP_NE,
+            K_CMP_LT,
+            K_CMP_GT,
+            K_CMP_LE,
+            K_CMP_GE
+        };
+
+        typedef struct binary_op_t
+        {
+            evaluator_t     eval;
+            guard_t         guard;
+            binary_t        calc;
+            op_kind_t       kind;
+        } binary_op_t;
+
+        typedef struct unary_op_t
+        {
+            evaluator_t     eval;
+            unary_t         calc;
+        } unary_op_t;
+
+        static const binary_op_t binary_ops[] =
+        {
+            { eval_add,         guard_numeric,  calc_add,       K_ADD       },
+            { eval_sub,         guard_numeric,  calc_sub,       K_SUB       },
+            { eval_mul,         guard_numeric,  calc_mul,       K_MUL       },
+            { eval_div,         guard_numeric,  calc_div,       K_DIV       },
+            { eval_iadd,        guard_int,      calc_iadd,      K_NONE      },
+            { eval_isub,        guard_int,      calc_isub,      K_NONE      },
+            { eval_imul,        guard_int,      calc_imul,      K_NONE      },
+            { eval_idiv,        guard_int,      calc_idiv,      K_NONE      },
+            { eval_imod,        guard_int,      calc_imod,      K_NONE      },
+            { eval_fmod,        guard_float,    calc_fmod,      K_NONE      },
+            { eval_power,       guard_power,    calc_power,     K_NONE      },
+            { eval_bit_or,      guard_int,      calc_bit_or,    K_NONE      },
+            { eval_bit_and,     guard_int,      calc_bit_and,   K_NONE      },
+            { eval_bit_xor,     guard_int,      calc_bit_xor,   K_NONE      },
+            { eval_xor,         guard_bool,     calc_xor,       K_NONE      },
+            { eval_strcat,      guard_string,   calc_strcat,    K_NONE      },
+            { eval_strrep,      guard_string,   calc_strrep,    K_NONE      },
+
+            { eval_cmp,         NULL,           calc_cmp,       K_CMP       },
+            { eval_cmp_eq,      NULL,           calc_cmp_eq,    K_CMP_EQ    },
+            { eval_cmp_ne,      NULL,           calc_cmp_ne,    K_CMP_NE    },
+            { eval_cmp_lt,      NULL,           calc_cmp_lt,    K_CMP_LT    },
+            { eval_cmp_gt,      NULL,           calc_cmp_gt,    K_CMP_GT    },
+            { eval_cmp_le,      NULL,           calc_cmp_le,    K_CMP_LE    },
+            { eval_cmp_ge,      NULL,           calc_cmp_ge,    K_CMP_GE    },
+            { eval_icmp,        NULL,           calc_icmp,      K_NONE      },
+            { eval_icmp_eq,     NULL,           calc_icmp_eq,   K_NONE      },
+            { eval_icmp_ne,     NULL,           calc_icmp_ne,   K_NONE      },
+            { eval_icmp_lt,     NULL,           calc_icmp_lt,   K_NONE      },
+            { eval_icmp_gt,     NULL,           calc_icmp_gt,   K_NONE      },
+            { eval_icmp_le,     NULL,           calc_icmp_le,   K_NONE      },
+            { eval_icmp_ge,     NULL,           calc_icmp_ge,   K_NONE      },
+
+            { NULL,             NULL,           NULL,           K_NONE      }
+        };
+
+        static const unary_op_t unary_ops[] =
+        {
+            { eval_neg,         calc_neg            },
+            { eval_not,         calc_not            },
+            { eval_nsign,       calc_nsign          },
+            { eval_exists,      calc_exists         },
+            { eval_db,          calc_db             },
+            { eval_strupper,    calc_strupper       },
+            { eval_strlower,    calc_strlower       },
+            { eval_strlen,      calc_strlen         },
+            { eval_strrev,      calc_strrev         },
+            { eval_int_cast,    calc_int_cast       },
+            { eval_float_cast,  calc_float_cast     },
+            { eval_string_cast, calc_string_cast    },
+            { eval_bool_cast,   calc_bool_cast      },
+
+            { NULL,             NULL                }
+        };
+
+        static inline bool fast_arith(size_t kind, value_t *value, const value_t *right)
+        {
+            if ((value->type == VT_INT) && (right->type == VT_INT))
+            {
+                switch (kind)
+                {
+                    case K_ADD: value->v_int   += right->v_int; break;
+                    case K_SUB: value->v_int   -= right->v_int; break;
+                    case K_MUL: value->v_int   *= right->v_int; break;
+                    default:
+                        if (right->v_int != 0)
+                            value->v_int   /= right->v_int;
+                        else
+                            value->type     = VT_UNDEF;
+                        break;
+                }
+                return true;
+            }
+
+            double a, b;
+            if (value->type == VT_INT)
+                a           = double(value->v_int);
+            else if (value->type == VT_FLOAT)
+                a           = value->v_float;
+            else
+                return false;
+
+            if (right->type == VT_INT)
+                b           = double(right->v_int);
+            else if (right->type == VT_FLOAT)
+                b           = right->v_float;
+            else
+                return false;
+
+            switch (kind)
+            {
+                case K_ADD: value->v_float  = a + b; break;
+                case K_SUB: value->v_float  = a - b; break;
+                case K_MUL: value->v_float  = a * b; break;
+                default:    value->v_float  = a / b; break;
+            }
+            value->type     = VT_FLOAT;
+
+            return true;
+        }
+
+        static inline bool fast_compare(size_t kind, value_t *value, const value_t *right)
+        {
+            ssize_t c;
+            if ((value->type == VT_INT) && (right->type == VT_INT))
+                c   = (value->v_int < right->v_int) ? -1 :
+                      (value->v_int > right->v_int) ? 1 : 0;
+            else
+            {
+                double a, b;
+                if (value->type == VT_INT)
+                    a           = double(value->v_int);
+                else if (value->type == VT_FLOAT)
+                    a           = value->v_float;
+                else
+                    return false;
+
+                if (right->type == VT_INT)
+                    b           = double(right->v_int);
+                else if (right->type == VT_FLOAT)
+                    b           = right->v_float;
+                else
+                    return false;
+
+                c   = (a < b) ? -1 : (a > b) ? 1 : 0;
+            }
+
+            switch (kind)
+            {
+                case K_CMP_EQ:  value->v_bool   = (c == 0); break;
+                case K_CMP_NE:  value->v_bool   = (c != 0); break;
+                case K_CMP_LT:  value->v_bool   = (c < 0);  break;
+                case K_CMP_GT:  value->v_bool   = (c > 0);  break;
+                case K_CMP_LE:  value->v_bool   = (c <= 0); break;
+                case K_CMP_GE:  value->v_bool   = (c >= 0); break;
+                default:
+                    value->type     = VT_INT;
+                    value->v_int    = c;
+                    return true;
+            }
+            value->type     = VT_BOOL;
+
+            return true;
+        }
+
+        static inline void copy_const(value_t *dst, const value_t *src)
+        {
+            // Strings are the only values that own resources and should be cloned
+            if (src->type != VT_STRING)
+                *dst        = *src;
+            else
+                init_value(dst, src);
+        }
+
+        static inline bool numeric_value(double *dst, const value_t *v)
+        {
+            if (v->type == VT_FLOAT)
+                *dst        = v->v_float;
+            else if (v->type == VT_INT)
+                *dst        = double(v->v_int);
+            else
+                return false;
+            return true;
+        }
+
+        static inline double lane_value(value_t *v)
+        {
+            if ((cast_float(v) == STATUS_OK) && (v->type == VT_FLOAT))
+                return v->v_float;
+            return NAN;
+        }
+
+        static inline size_t swap_compare(size_t kind)
+        {
+            switch (kind)
+            {
+                case K_CMP_LT:  return K_CMP_GT;
+                case K_CMP_GT:  return K_CMP_LT;
+                case K_CMP_LE:  return K_CMP_GE;
+                case K_CMP_GE:  return K_CMP_LE;
+                default:        break;
+            }
+            return kind;
+        }
+
+        Bytecode::Bytecode()
+        {
+            vRegs       = NULL;
+            vIndex      = NULL;
+            pEnv        = NULL;
+            nRegs       = 0;
+            nIndex      = 0;
+            vLanes      = NULL;
+            vLaneKinds  = NULL;
+        }
+
+        Bytecode::~Bytecode()
+        {
+            do_destroy();
+        }
+
+        void Bytecode::destroy()
+        {
+            do_destroy();
+        }
+
+        void Bytecode::do_destroy()
+        {
+            for (size_t i=0, n=vConst.size(); i<n; ++i)
+                destroy_value(vConst.uget(i));
+            vConst.flush();
+            vCode.flush();
+
+            if (vRegs != NULL)
+            {
+                for (size_t i=0; i<nRegs; ++i)
+                    destroy_value(&vRegs[i]);
+                ::free(vRegs);
+                vRegs       = NULL;
+            }
+            if (vIndex != NULL)
+            {
+                ::free(vIndex);
+                vIndex      = NULL;
+            }
+            if (vLanes != NULL)
+            {
+                ::free(vLanes);
+                vLanes      = NULL;
+            }
+            if (vLaneKinds != NULL)
+            {
+                ::free(vLaneKinds);
+                vLaneKinds  = NULL;
+            }
+            vLaneCode.flush();
+
+            pEnv        = NULL;
+            nRegs       = 0;
+            nIndex      = 0;
+        }
+
+        bool Bytecode::constant() const
+        {
+            if (vCode.size() != 1)
+                return false;
+            return vCode.uget(0)->op == OP_CONST;
+        }
+
+        bool Bytecode::has_resolve(const expr_t *expr)
+        {
+            if (expr == NULL)
+                return false;
+
+            switch (expr->type)
+            {
+                case ET_RESOLVE:
+                    return true;
+                case ET_CALC:
+                    return has_resolve(expr->calc.cond) ||
+                           has_resolve(expr->calc.left) ||
+                           has_resolve(expr->calc.right);
+                default:
+                    break;
+            }
+
+            return false;
+        }
+
+        bool Bytecode::is_numeric(const value_t *v)
+        {
+            return (v->type == VT_INT) || (v->type == VT_FLOAT);
+        }
+
+        Bytecode::instr_t *Bytecode::emit(opcode_t op, size_t reg)
+        {
+            instr_t *i  = vCode.add();
+            if (i == NULL)
+                return NULL;
+
+            i->op       = op;
+            i->kind     = K_NONE;
+            i->reg      = reg;
+            i->count    = 0;
+            i->arg      = 0;
+            i->target   = 0;
+            i->name     = NULL;
+
+            return i;
+        }
+
+        ssize_t Bytecode::add_const(const value_t *v)
+        {
+            value_t tmp;
+            if (init_value(&tmp, v) != STATUS_OK)
+                return -STATUS_NO_MEM;
+
+            ssize_t index = vConst.size();
+            if (vConst.add(&tmp) == NULL)
+            {
+                destroy_value(&tmp);
+                return -STATUS_NO_MEM;
+            }
+
+            return index;
+        }
+
+        void Bytecode::use_reg(size_t reg)
+        {
+            if (nRegs <= reg)
+                nRegs       = reg + 1;
+        }
+
+        status_t Bytecode::fold(const expr_t *expr, value_t *value)
+        {
+            if (expr->type == ET_VALUE)
+                return init_value(value, &expr->value);
+            if (has_resolve(expr))
+                return STATUS_SKIP;
+
+            // The expression does not depend on variables, evaluate it now
+            init_value(value);
+            status_t res = expr->eval(value, expr, NULL);
+            if (res != STATUS_OK)
+            {
+                destroy_value(value);
+                return STATUS_SKIP;
+            }
+
+            return res;
+        }
+
+        status_t Bytecode::compile_const(const value_t *v, size_t reg)
+        {
+            ssize_t k   = add_const(v);
+            if (k < 0)
+                return -k;
+
+            instr_t *i  = emit(OP_CONST, reg);
+            if (i == NULL)
+                return STATUS_NO_MEM;
+            i->arg      = k;
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::compile_resolve(const expr_t *expr, size_t reg)
+        {
+            status_t res;
+            size_t count    = expr->resolve.count;
+            size_t slot     = nIndex;
+            nIndex         += count;
+
+            // Skip evaluation of indexes if there is no environment
+            size_t noenv    = vCode.size();
+            if (emit(OP_NOENV, reg) == NULL)
+                return STATUS_NO_MEM;
+
+            // Evaluate indexes
+            for (size_t j=0; j<count; ++j)
+            {
+                if ((res = compile(expr->resolve.items[j], reg + 1)) != STATUS_OK)
+                    return res;
+
+                instr_t *i  = emit(OP_INDEX, reg + 1);
+                if (i == NULL)
+                    return STATUS_NO_MEM;
+                i->arg      = slot + j;
+            }
+
+            // Resolve the value
+            instr_t *i  = emit(OP_RESOLVE, reg);
+            if (i == NULL)
+                return STATUS_NO_MEM;
+            i->count    = count;
+            i->arg      = slot;
+            i->name     = expr->resolve.name;
+
+            vCode.uget(noenv)->target   = vCode.size();
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::compile_ternary(const expr_t *expr, size_t reg)
+        {
+            status_t res;
+            if ((res = compile(expr->calc.cond, reg)) != STATUS_OK)
+                return res;
+
+            size_t branch   = vCode.size();
+            if (emit(OP_BRANCH, reg) == NULL)
+                return STATUS_NO_MEM;
+
+            // Positive branch
+            if ((res = compile(expr->calc.left, reg)) != STATUS_OK)
+                return res;
+            size_t jump     = vCode.size();
+            if (emit(OP_JUMP, reg) == NULL)
+                return STATUS_NO_MEM;
+
+            // Negative branch
+            vCode.uget(branch)->target  = vCode.size();
+            if ((res = compile(expr->calc.right, reg)) != STATUS_OK)
+                return res;
+
+            vCode.uget(jump)->target    = vCode.size();
+            vCode.uget(branch)->arg     = vCode.size();
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::compile_logic(const expr_t *expr, guard_t guard, size_t reg)
+        {
+            status_t res;
+            if ((res = compile(expr->calc.left, reg)) != STATUS_OK)
+                return res;
+
+            size_t skip     = vCode.size();
+            instr_t *i      = emit(OP_GUARD, reg);
+            if (i == NULL)
+                return STATUS_NO_MEM;
+            i->guard        = guard;
+
+            // The guard leaves boolean value in the register, so we can overwrite it
+            if ((res = compile(expr->calc.right, reg)) != STATUS_OK)
+                return res;
+            if ((i = emit(OP_UNARY, reg)) == NULL)
+                return STATUS_NO_MEM;
+            i->unary        = calc_bool_cast;
+
+            vCode.uget(skip)->target    = vCode.size();
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::compile_binary(const expr_t *expr, size_t reg)
+        {
+            const binary_op_t *op = binary_ops;
+            for ( ; op->eval != NULL; ++op)
+                if (op->eval == expr->eval)
+                    break;
+            if (op->eval == NULL)
+                return STATUS_CORRUPTED;
+
+            // Compute left operand
+            status_t res = compile(expr->calc.left, reg);
+            if (res != STATUS_OK)
+                return res;
+
+            // Fetch constant right operand
+            ssize_t k   = -1;
+            value_t v;
+            res         = fold(expr->calc.right, &v);
+            if (res == STATUS_OK)
+            {
+                k           = add_const(&v);
+                destroy_value(&v);
+                if (k < 0)
+                    return -k;
+            }
+            else if (res != STATUS_SKIP)
+                return res;
+
+            instr_t *i;
+            size_t skip = 0;
+
+            // Arithmetic operation with constant operand has fused guard
+            if ((op->kind >= K_ADD) && (op->kind <= K_DIV) && (k >= 0))
+            {
+                if ((i = emit(OP_ARITH_K, reg)) == NULL)
+                    return STATUS_NO_MEM;
+                i->kind     = op->kind;
+                i->arg      = k;
+                return STATUS_OK;
+            }
+
+            // Emit the guard
+            if (op->guard != NULL)
+            {
+                skip        = vCode.size();
+                if ((i = emit((op->guard == guard_numeric) ? OP_GUARD_NUM : OP_GUARD, reg)) == NULL)
+                    return STATUS_NO_MEM;
+                i->guard    = op->guard;
+            }
+
+            // Emit the operation
+            if (k >= 0)
+            {
+                if ((i = emit((op->kind >= K_CMP) ? OP_CMP_K : OP_BINARY_K, reg)) == NULL)
+                    return STATUS_NO_MEM;
+                i->arg      = k;
+            }
+            else
+            {
+                if ((res = compile(expr->calc.right, reg + 1)) != STATUS_OK)
+                    return res;
+
+                opcode_t code = (op->kind >= K_CMP) ? OP_CMP :
+                                (op->kind >= K_ADD) ? OP_ARITH :
+                                OP_BINARY;
+                if ((i = emit(code, reg)) == NULL)
+                    return STATUS_NO_MEM;
+            }
+            i->kind     = op->kind;
+            i->binary   = op->calc;
+
+            if (op->guard != NULL)
+                vCode.uget(skip)->target    = vCode.size();
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::compile_unary(const expr_t *expr, size_t reg)
+        {
+            status_t res = compile(expr->calc.left, reg);
+            if ((res != STATUS_OK) || (expr->eval == eval_psign))
+                return res;
+
+            const unary_op_t *op = unary_ops;
+            for ( ; op->eval != NULL; ++op)
+                if (op->eval == expr->eval)
+                    break;
+            if (op->eval == NULL)
+                return STATUS_CORRUPTED;
+
+            instr_t *i  = emit(OP_UNARY, reg);
+            if (i == NULL)
+                return STATUS_NO_MEM;
+            i->unary    = op->calc;
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::compile(const expr_t *expr, size_t reg)
+        {
+            if (expr == NULL)
+                return STATUS_CORRUPTED;
+
+            use_reg(reg);
+            switch (expr->type)
+            {
+                case ET_VALUE:
+                    return compile_const(&expr->value, reg);
+                case ET_RESOLVE:
+                    return compile_resolve(expr, reg);
+                case ET_CALC:
+                    break;
+                default:
+                    return STATUS_CORRUPTED;
+            }
+
+            // Try to fold the constant expression
+            value_t v;
+            status_t res = fold(expr, &v);
+            if (res == STATUS_OK)
+            {
+                res     = compile_const(&v, reg);
+                destroy_value(&v);
+                return res;
+            }
+            else if (res != STATUS_SKIP)
+                return res;
+
+            // Lower the operation
+            if (expr->eval == eval_ternary)
+                return compile_ternary(expr, reg);
+            else if (expr->eval == eval_or)
+                return compile_logic(expr, guard_or, reg);
+            else if (expr->eval == eval_and)
+                return compile_logic(expr, guard_and, reg);
+            else if (expr->calc.right != NULL)
+                return compile_binary(expr, reg);
+
+            return compile_unary(expr, reg);
+        }
+
+        status_t Bytecode::compile(const expr_t *expr)
+        {
+            do_destroy();
+            if (expr == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res = compile(expr, 0);
+            if (res == STATUS_OK)
+            {
+                vRegs       = reinterpret_cast<value_t *>(::malloc(nRegs * sizeof(value_t)));
+                if (vRegs != NULL)
+                {
+                    for (size_t i=0; i<nRegs; ++i)
+                        init_value(&vRegs[i]);
+                }
+                else
+                    res         = STATUS_NO_MEM;
+            }
+            if ((res == STATUS_OK) && (nIndex > 0))
+            {
+                vIndex      = reinterpret_cast<ssize_t *>(::malloc(nIndex * sizeof(ssize_t)));
+                if (vIndex == NULL)
+                    res         = STATUS_NO_MEM;
+            }
+
+            if (res != STATUS_OK)
+                do_destroy();
+
+            return res;
+        }
+
+        status_t Bytecode::bind(eval_env_t *env)
+        {
+            for (size_t j=0, n=vCode.size(); j<n; ++j)
+            {
+                instr_t *i  = vCode.uget(j);
+                if (((i->op != OP_RESOLVE) && (i->op != OP_LOAD)) || (i->count > 0))
+                    continue;
+
+                // Unbind the variable
+                i->op       = OP_RESOLVE;
+                if (env == NULL)
+                    continue;
+
+                // Bind the variable if the environment supports it
+                ssize_t slot = env->bind(i->name);
+                if (slot >= 0)
+                {
+                    i->op       = OP_LOAD;
+                    i->arg      = slot;
+                }
+                else if (slot == -STATUS_NO_MEM)
+                {
+                    bind(NULL);
+                    return STATUS_NO_MEM;
+                }
+            }
+
+            pEnv        = env;
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::calc_arith(size_t kind, value_t *value, value_t *right)
+        {
+            switch (kind)
+            {
+                case K_ADD: return calc_add(value, right);
+                case K_SUB: return calc_sub(value, right);
+                case K_MUL: return calc_mul(value, right);
+                default:    break;
+            }
+            return calc_div(value, right);
+        }
+
+        status_t Bytecode::execute(value_t *result, eval_env_t *env)
+        {
+            const size_t n      = vCode.size();
+            if (n <= 0)
+                return STATUS_BAD_STATE;
+
+            const instr_t *code = vCode.array();
+            const value_t *k    = vConst.array();
+            value_t *regs       = vRegs;
+            status_t res        = STATUS_OK;
+            value_t tmp;
+
+            for (size_t ip = 0; ip < n; )
+            {
+                const instr_t *i    = &code[ip++];
+                value_t *v          = &regs[i->reg];
+
+                switch (i->op)
+                {
+                    case OP_CONST:
+                        copy_const(v, &k[i->arg]);
+                        break;
+
+                    case OP_NOENV:
+                        if (env == NULL)
+                        {
+                            v->type     = VT_UNDEF;
+                            v->v_str    = NULL;
+                            ip          = i->target;
+                        }
+                        break;
+
+                    case OP_INDEX:
+                        res = cast_int(v);
+                        if (res == STATUS_OK)
+                            vIndex[i->arg]  = v->v_int;
+                        destroy_value(v);
+                        break;
+
+                    case OP_RESOLVE:
+                        if (i->count <= 0)
+                        {
+                            res = env->resolve(v, i->name, 0, NULL);
+                            if (res == STATUS_NOT_FOUND)
+                            {
+                                v->type     = VT_UNDEF;
+                                v->v_str    = NULL;
+                                res         = STATUS_OK;
+                            }
+                        }
+                        else
+                            res = env->resolve(v, i->name, i->count, &vIndex[i->arg]);
+                        break;
+
+                    case OP_LOAD:
+                        res = (env == pEnv) ?
+                            env->resolve_bound(v, i->arg) :
+                            env->resolve(v, i->name, 0, NULL);
+                        if (res == STATUS_NOT_FOUND)
+                        {
+                            v->type     = VT_UNDEF;
+                            v->v_str    = NULL;
+                            res         = STATUS_OK;
+                        }
+                        break;
+
+                    case OP_JUMP:
+                        ip      = i->target;
+                        break;
+
+                    case OP_BRANCH:
+                        if (guard_ternary(v) != STATUS_OK)
+                            ip      = i->arg;
+                        else if (!v->v_bool)
+                            ip      = i->target;
+                        break;
+
+                    case OP_GUARD_NUM:
+                        if (is_numeric(v))
+                            break;
+                        // fall through
+                    case OP_GUARD:
+                        res = i->guard(v);
+                        if (res == STATUS_SKIP)
+                        {
+                            ip      = i->target;
+                            res     = STATUS_OK;
+                        }
+                        break;
+
+                    case OP_UNARY:
+                        res = i->unary(v);
+                        break;
+
+                    case OP_BINARY:
+                        res = i->binary(v, &v[1]);
+                        break;
+
+                    case OP_BINARY_K:
+                        copy_const(&tmp, &k[i->arg]);
+                        res = i->binary(v, &tmp);
+                        break;
+
+                    case OP_ARITH:
+                        if (!fast_arith(i->kind, v, &v[1]))
+                            res = i->binary(v, &v[1]);
+                        break;
+
+                    case OP_ARITH_K:
+                        if (fast_arith(i->kind, v, &k[i->arg]))
+                            break;
+
+                        res = guard_numeric(v);
+                        if (res == STATUS_OK)
+                        {
+                            copy_const(&tmp, &k[i->arg]);
+                            res = calc_arith(i->kind, v, &tmp);
+                        }
+                        else if (res == STATUS_SKIP)
+                            res     = STATUS_OK;
+                        break;
+
+                    case OP_CMP:
+                        if (!fast_compare(i->kind, v, &v[1]))
+                            res = i->binary(v, &v[1]);
+                        break;
+
+                    case OP_CMP_K:
+                        if (fast_compare(i->kind, v, &k[i->arg]))
+                            break;
+
+                        copy_const(&tmp, &k[i->arg]);
+                        res = i->binary(v, &tmp);
+                        break;
+
+                    default:
+                        res = STATUS_CORRUPTED;
+                        break;
+                }
+
+                if (res != STATUS_OK)
+                    break;
+            }
+
+            // Release registers on error
+            if (res != STATUS_OK)
+            {
+                for (size_t i=0; i<nRegs; ++i)
+                    destroy_value(&regs[i]);
+                return res;
+            }
+
+            // Move the result out of the register file
+            *result         = regs[0];
+            regs[0].type    = VT_UNDEF;
+            regs[0].v_str   = NULL;
+
+            return STATUS_OK;
+        }
+
+        Bytecode::lane_instr_t *Bytecode::emit_lane(lane_opcode_t op, size_t reg)
+        {
+            lane_instr_t *i = vLaneCode.add();
+            if (i == NULL)
+                return NULL;
+
+            i->op       = op;
+            i->kind     = K_NONE;
+            i->reg      = reg;
+            i->src      = reg;
+            i->k        = 0.0;
+            i->f32      = NULL;
+            i->f64      = NULL;
+
+            return i;
+        }
+
+        status_t Bytecode::plan_lane_binary(size_t kind, size_t reg, value_t *right)
+        {
+            uint8_t *kinds      = vLaneKinds;
+            value_t *left       = &vRegs[reg];
+            uint8_t lk          = kinds[reg];
+            uint8_t rk          = (right != NULL) ? LK_NONE : kinds[reg + 1];
+            if (right == NULL)
+                right               = &left[1];
+
+            // Boolean lanes are not numbers
+            if ((lk == LK_BOOL) || (rk == LK_BOOL))
+                return STATUS_SKIP;
+
+            lane_instr_t *i;
+            if ((lk == LK_FLOAT) && (rk == LK_FLOAT))
+            {
+                if ((i = emit_lane(LOP_CALC, reg)) != NULL)
+                    i->src  = reg + 1;
+            }
+            else if (lk == LK_FLOAT)
+            {
+                double k;
+                if (!numeric_value(&k, right))
+                    return STATUS_SKIP;
+                if ((i = emit_lane(LOP_CALC_K, reg)) != NULL)
+                    i->k    = k;
+            }
+            else
+            {
+                double k;
+                if (!numeric_value(&k, left))
+                    return STATUS_SKIP;
+                if ((kind >= K_CMP) || (kind == K_ADD) || (kind == K_MUL))
+                {
+                    // Operation is commutative or can be swapped
+                    kind    = swap_compare(kind);
+                    i       = emit_lane(LOP_CALC_K, reg);
+                }
+                else
+                    i       = emit_lane(LOP_RCALC_K, reg);
+                if (i != NULL)
+                {
+                    i->src  = reg + 1;
+                    i->k    = k;
+                }
+            }
+            if (i == NULL)
+                return STATUS_NO_MEM;
+            i->kind     = kind;
+
+            // Numeric scalar values do not hold any resources
+            left->type      = VT_UNDEF;
+            left->v_str     = NULL;
+            right->type     = VT_UNDEF;
+            right->v_str    = NULL;
+            kinds[reg]      = (kind >= K_CMP) ? LK_BOOL : LK_FLOAT;
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::plan_lanes(Batch *batch)
+        {
+            const size_t n      = vCode.size();
+            const instr_t *code = vCode.array();
+            const value_t *k    = vConst.array();
+            value_t *regs       = vRegs;
+            uint8_t *kinds      = vLaneKinds;
+            Resolver *parent    = batch->resolver();
+            status_t res        = STATUS_OK;
+            value_t tmp;
+
+            vLaneCode.clear();
+            for (size_t i=0; i<nRegs; ++i)
+                kinds[i]            = LK_NONE;
+
+            // Simulate the execution: scalar values are computed immediately,
+            // operations over lanes are recorded to the lane code
+            for (size_t ip = 0; ip < n; )
+            {
+                const instr_t *i    = &code[ip++];
+                value_t *v          = &regs[i->reg];
+                uint8_t *kv         = &kinds[i->reg];
+
+                switch (i->op)
+                {
+                    case OP_CONST:
+                        *kv     = LK_NONE;
+                        copy_const(v, &k[i->arg]);
+                        break;
+
+                    case OP_NOENV:
+                        // The batch is always present
+                        break;
+
+                    case OP_INDEX:
+                        // Indexes that differ between lanes can not be processed in batch
+                        if (*kv != LK_NONE)
+                        {
+                            res     = STATUS_SKIP;
+                            break;
+                        }
+                        res = cast_int(v);
+                        if (res == STATUS_OK)
+                            vIndex[i->arg]  = v->v_int;
+                        destroy_value(v);
+                        break;
+
+                    case OP_RESOLVE:
+                    case OP_LOAD:
+                    {
+                        size_t count        = (i->op == OP_RESOLVE) ? i->count : 0;
+                        const ssize_t *idx  = (count > 0) ? &vIndex[i->arg] : NULL;
+                        const Batch::array_t *a = batch->lookup(i->name, count, idx);
+                        if (a != NULL)
+                        {
+                            lane_instr_t *li = emit_lane((a->f64 != NULL) ? LOP_LOAD_F64 : LOP_LOAD_F32, i->reg);
+                            if (li == NULL)
+                            {
+                                res     = STATUS_NO_MEM;
+                                break;
+                            }
+                            li->f32     = a->f32;
+                            li->f64     = a->f64;
+                            *kv         = LK_FLOAT;
+                            v->type     = VT_UNDEF;
+                            v->v_str    = NULL;
+                            break;
+                        }
+
+                        *kv     = LK_NONE;
+                        res     = (parent != NULL) ? parent->resolve(v, i->name, count, idx) : STATUS_NOT_FOUND;
+                        if ((res == STATUS_NOT_FOUND) && (count <= 0))
+                        {
+                            v->type     = VT_UNDEF;
+                            v->v_str    = NULL;
+                            res         = STATUS_OK;
+                        }
+                        break;
+                    }
+
+                    case OP_JUMP:
+                        ip      = i->target;
+                        break;
+
+                    case OP_BRANCH:
+                        // Branches that differ between lanes can not be processed in batch
+                        if (*kv != LK_NONE)
+                            res     = STATUS_SKIP;
+                        else if (guard_ternary(v) != STATUS_OK)
+                            ip      = i->arg;
+                        else if (!v->v_bool)
+                            ip      = i->target;
+                        break;
+
+                    case OP_GUARD_NUM:
+                        if ((*kv == LK_FLOAT) || ((*kv == LK_NONE) && (is_numeric(v))))
+                            break;
+                        // fall through
+                    case OP_GUARD:
+                        if (*kv != LK_NONE)
+                        {
+                            // Floating-point lanes pass numeric guards unchanged
+                            if ((*kv == LK_FLOAT) &&
+                                ((i->guard == guard_numeric) || (i->guard == guard_float) || (i->guard == guard_power)))
+                                break;
+                            res     = STATUS_SKIP;
+                            break;
+                        }
+
+                        res = i->guard(v);
+                        if (res == STATUS_SKIP)
+                        {
+                            ip      = i->target;
+                            res     = STATUS_OK;
+                        }
+                        break;
+
+                    case OP_UNARY:
+                        if (*kv == LK_NONE)
+                            res = i->unary(v);
+                        else if (*kv == LK_BOOL)
+                            res = STATUS_SKIP;
+                        else if (i->unary == calc_neg)
+                            res = (emit_lane(LOP_NOT, i->reg) != NULL) ? STATUS_OK : STATUS_NO_MEM;
+                        else if (i->unary == calc_nsign)
+                            res = (emit_lane(LOP_NSIGN, i->reg) != NULL) ? STATUS_OK : STATUS_NO_MEM;
+                        else if (i->unary != calc_float_cast)
+                            res = STATUS_SKIP;
+                        break;
+
+                    case OP_BINARY:
+                        if ((*kv == LK_NONE) && (kv[1] == LK_NONE))
+                            res = i->binary(v, &v[1]);
+                        else if (i->binary == calc_power)
+                            res = plan_lane_binary(K_POW, i->reg, NULL);
+                        else
+                            res = STATUS_SKIP;
+                        break;
+
+                    case OP_BINARY_K:
+                        copy_const(&tmp, &k[i->arg]);
+                        if (*kv == LK_NONE)
+                            res = i->binary(v, &tmp);
+                        else
+                        {
+                            res = (i->binary == calc_power) ? plan_lane_binary(K_POW, i->reg, &tmp) : STATUS_SKIP;
+                            destroy_value(&tmp);
+                        }
+                        break;
+
+                    case OP_ARITH:
+                        if ((*kv != LK_NONE) || (kv[1] != LK_NONE))
+                            res = plan_lane_binary(i->kind, i->reg, NULL);
+                        else if (!fast_arith(i->kind, v, &v[1]))
+                            res = i->binary(v, &v[1]);
+                        break;
+
+                    case OP_ARITH_K:
+                        if (*kv != LK_NONE)
+                        {
+                            copy_const(&tmp, &k[i->arg]);
+                            res = plan_lane_binary(i->kind, i->reg, &tmp);
+                            destroy_value(&tmp);
+                            break;
+                        }
+                        if (fast_arith(i->kind, v, &k[i->arg]))
+                            break;
+
+                        res = guard_numeric(v);
+                        if (res == STATUS_OK)
+                        {
+                            copy_const(&tmp, &k[i->arg]);
+                            res = calc_arith(i->kind, v, &tmp);
+                        }
+                        else if (res == STATUS_SKIP)
+                            res     = STATUS_OK;
+                        break;
+
+                    case OP_CMP:
+                        if ((*kv != LK_NONE) || (kv[1] != LK_NONE))
+                            res = (i->kind != K_CMP) ? plan_lane_binary(i->kind, i->reg, NULL) : STATUS_SKIP;
+                        else if (!fast_compare(i->kind, v, &v[1]))
+                            res = i->binary(v, &v[1]);
+                        break;
+
+                    case OP_CMP_K:
+                        if (*kv != LK_NONE)
+                        {
+                            if (i->kind == K_CMP)
+                            {
+                                res     = STATUS_SKIP;
+                                break;
+                            }
+                            copy_const(&tmp, &k[i->arg]);
+                            res = plan_lane_binary(i->kind, i->reg, &tmp);
+                            destroy_value(&tmp);
+                            break;
+                        }
+                        if (fast_compare(i->kind, v, &k[i->arg]))
+                            break;
+
+                        copy_const(&tmp, &k[i->arg]);
+                        res = i->binary(v, &tmp);
+                        break;
+
+                    default:
+                        res = STATUS_CORRUPTED;
+                        break;
+                }
+
+                if (res != STATUS_OK)
+                    break;
+            }
+
+            // Scalar result is kept in the register file, other registers should be released
+            for (size_t i=(res == STATUS_OK) ? 1 : 0; i<nRegs; ++i)
+                destroy_value(&regs[i]);
+
+            return res;
+        }
+
+        void Bytecode::run_lanes(size_t first, size_t count)
+        {
+            const lane_instr_t *code    = vLaneCode.array();
+
+            for (size_t ip=0, n=vLaneCode.size(); ip < n; ++ip)
+            {
+                const lane_instr_t *i   = &code[ip];
+                double *a               = &vLanes[i->reg * LANE_CHUNK];
+                const double *b         = &vLanes[i->src * LANE_CHUNK];
+                const double k          = i->k;
+
+                switch (i->op)
+                {
+                    case LOP_LOAD_F32:
+                    {
+                        const float *src = &i->f32[first];
+                        for (size_t j=0; j<count; ++j)
+                            a[j]    = src[j];
+                        break;
+                    }
+
+                    case LOP_LOAD_F64:
+                    {
+                        const double *src = &i->f64[first];
+                        for (size_t j=0; j<count; ++j)
+                            a[j]    = src[j];
+                        break;
+                    }
+
+                    case LOP_NOT:
+                        for (size_t j=0; j<count; ++j)
+                            a[j]    = double(~ssize_t(b[j]));
+                        break;
+
+                    case LOP_NSIGN:
+                        for (size_t j=0; j<count; ++j)
+                            a[j]    = -b[j];
+                        break;
+
+                    case LOP_CALC:
+                        switch (i->kind)
+                        {
+                            case K_ADD:     for (size_t j=0; j<count; ++j) a[j] = a[j] + b[j]; break;
+                            case K_SUB:     for (size_t j=0; j<count; ++j) a[j] = a[j] - b[j]; break;
+                            case K_MUL:     for (size_t j=0; j<count; ++j) a[j] = a[j] * b[j]; break;
+                            case K_DIV:     for (size_t j=0; j<count; ++j) a[j] = a[j] / b[j]; break;
+                            case K_POW:     for (size_t j=0; j<count; ++j) a[j] = ::pow(a[j], b[j]); break;
+                            case K_CMP_EQ:  for (size_t j=0; j<count; ++j) a[j] = ((a[j] < b[j]) || (a[j] > b[j])) ? 0.0 : 1.0; break;
+                            case K_CMP_NE:  for (size_t j=0; j<count; ++j) a[j] = ((a[j] < b[j]) || (a[j] > b[j])) ? 1.0 : 0.0; break;
+                            case K_CMP_LT:  for (size_t j=0; j<count; ++j) a[j] = (a[j] < b[j]) ? 1.0 : 0.0; break;
+                            case K_CMP_GT:  for (size_t j=0; j<count; ++j) a[j] = (a[j] > b[j]) ? 1.0 : 0.0; break;
+                            case K_CMP_LE:  for (size_t j=0; j<count; ++j) a[j] = (a[j] > b[j]) ? 0.0 : 1.0; break;
+                            case K_CMP_GE:  for (size_t j=0; j<count; ++j) a[j] = (a[j] < b[j]) ? 0.0 : 1.0; break;
+                            default: break;
+                        }
+                        break;
+
+                    case LOP_CALC_K:
+                        switch (i->kind)
+                        {
+                            case K_ADD:     for (size_t j=0; j<count; ++j) a[j] = b[j] + k; break;
+                            case K_SUB:     for (size_t j=0; j<count; ++j) a[j] = b[j] - k; break;
+                            case K_MUL:     for (size_t j=0; j<count; ++j) a[j] = b[j] * k; break;
+                            case K_DIV:     for (size_t j=0; j<count; ++j) a[j] = b[j] / k; break;
+                            case K_POW:     for (size_t j=0; j<count; ++j) a[j] = ::pow(b[j], k); break;
+                            case K_CMP_EQ:  for (size_t j=0; j<count; ++j) a[j] = ((b[j] < k) || (b[j] > k)) ? 0.0 : 1.0; break;
+                            case K_CMP_NE:  for (size_t j=0; j<count; ++j) a[j] = ((b[j] < k) || (b[j] > k)) ? 1.0 : 0.0; break;
+                            case K_CMP_LT:  for (size_t j=0; j<count; ++j) a[j] = (b[j] < k) ? 1.0 : 0.0; break;
+                            case K_CMP_GT:  for (size_t j=0; j<count; ++j) a[j] = (b[j] > k) ? 1.0 : 0.0; break;
+                            case K_CMP_LE:  for (size_t j=0; j<count; ++j) a[j] = (b[j] > k) ? 0.0 : 1.0; break;
+                            case K_CMP_GE:  for (size_t j=0; j<count; ++j) a[j] = (b[j] < k) ? 0.0 : 1.0; break;
+                            default: break;
+                        }
+                        break;
+
+                    case LOP_RCALC_K:
+                        switch (i->kind)
+                        {
+                            case K_SUB:     for (size_t j=0; j<count; ++j) a[j] = k - b[j]; break;
+                            case K_DIV:     for (size_t j=0; j<count; ++j) a[j] = k / b[j]; break;
+                            case K_POW:     for (size_t j=0; j<count; ++j) a[j] = ::pow(k, b[j]); break;
+                            default: break;
+                        }
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+        }
+
+        status_t Bytecode::execute_lanes(double *f64, float *f32, size_t count, Batch *batch)
+        {
+            if (vCode.size() <= 0)
+                return STATUS_BAD_STATE;
+            if (((f64 == NULL) && (f32 == NULL)) || (batch == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (count <= 0)
+                return STATUS_OK;
+
+            // Allocate lane registers
+            if (vLanes == NULL)
+            {
+                vLanes      = static_cast<double *>(::malloc(nRegs * LANE_CHUNK * sizeof(double)));
+                if (vLanes == NULL)
+                    return STATUS_NO_MEM;
+            }
+            if (vLaneKinds == NULL)
+            {
+                vLaneKinds  = static_cast<uint8_t *>(::malloc(nRegs * sizeof(uint8_t)));
+                if (vLaneKinds == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            status_t res        = plan_lanes(batch);
+            if (res == STATUS_OK)
+            {
+                // Scalar result does not depend on lanes
+                if (vLaneKinds[0] == LK_NONE)
+                {
+                    double v    = lane_value(&vRegs[0]);
+                    destroy_value(&vRegs[0]);
+
+                    if (f64 != NULL)
+                    {
+                        for (size_t j=0; j<count; ++j)
+                            f64[j]  = v;
+                    }
+                    else
+                    {
+                        for (size_t j=0; j<count; ++j)
+                            f32[j]  = v;
+                    }
+                    return STATUS_OK;
+                }
+
+                // Process lanes by chunks
+                const double *r = vLanes;
+                for (size_t first=0; first < count; first += LANE_CHUNK)
+                {
+                    size_t n    = lsp_min(count - first, size_t(LANE_CHUNK));
+                    run_lanes(first, n);
+
+                    if (f64 != NULL)
+                    {
+                        for (size_t j=0; j<n; ++j)
+                            f64[first + j]  = r[j];
+                    }
+                    else
+                    {
+                        for (size_t j=0; j<n; ++j)
+                            f32[first + j]  = r[j];
+                    }
+                }
+
+                return STATUS_OK;
+            }
+            else if (res != STATUS_SKIP)
+                return res;
+
+            // Fall back to the scalar evaluation of each lane
+            value_t v;
+            for (size_t j=0; j<count; ++j)
+            {
+                batch->set_lane(j);
+                if ((res = execute(&v, batch)) != STATUS_OK)
+                    return res;
+
+                if (f64 != NULL)
+                    f64[j]      = lane_value(&v);
+                else
+                    f32[j]      = lane_value(&v);
+                destroy_value(&v);
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t Bytecode::execute(double *dst, size_t count, Batch *batch)
+        {
+            return execute_lanes(dst, NULL, count, batch);
+        }
+
+        status_t Bytecode::execute(float *dst, size_t count, Batch *batch)
+        {
+            return execute_lanes(NULL, dst, count, batch);
+        }
+
+    } /* namespace expr */
+} /* namespace lsp */
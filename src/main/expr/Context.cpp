@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/expr/Context.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        Context::Context()
+        {
+        }
+
+        Context::~Context()
+        {
+            clear();
+        }
+
+        void Context::clear()
+        {
+            // Detach from resolvers
+            for (size_t i=0, n=vResolvers.size(); i<n; ++i)
+            {
+                Resolver *r = vResolvers.uget(i);
+                r->remove_listener(this);
+            }
+            vResolvers.flush();
+
+            // Release expressions
+            for (size_t i=0, n=vExpr.size(); i<n; ++i)
+            {
+                Expression *expr = vExpr.uget(i);
+                expr->pContext  = NULL;
+            }
+            vExpr.flush();
+
+            // Drop the index
+            lltl::parray<list_t> lists;
+            hDeps.values(&lists);
+            hDeps.flush();
+            for (size_t i=0, n=lists.size(); i<n; ++i)
+            {
+                list_t *list = lists.uget(i);
+                if (list != NULL)
+                    delete list;
+            }
+            lists.flush();
+        }
+
+        status_t Context::attach(Resolver *resolver)
+        {
+            if (resolver == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (vResolvers.index_of(resolver) >= 0)
+                return STATUS_ALREADY_EXISTS;
+
+            if (!vResolvers.add(resolver))
+                return STATUS_NO_MEM;
+
+            status_t res = resolver->add_listener(this);
+            if (res != STATUS_OK)
+            {
+                vResolvers.pop();
+                return res;
+            }
+
+            // Values of variables may differ from previously seen ones
+            invalidate_all();
+            return STATUS_OK;
+        }
+
+        status_t Context::detach(Resolver *resolver)
+        {
+            if (resolver == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (!vResolvers.premove(resolver))
+                return STATUS_NOT_FOUND;
+
+            return resolver->remove_listener(this);
+        }
+
+        void Context::detached(Resolver *resolver)
+        {
+            vResolvers.premove(resolver);
+        }
+
+        status_t Context::add(Expression *expr)
+        {
+            if (expr == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (expr->pContext == this)
+                return STATUS_OK;
+            if (expr->pContext != NULL)
+                expr->pContext->remove(expr);
+
+            if (!vExpr.add(expr))
+                return STATUS_NO_MEM;
+
+            status_t res = index(expr);
+            if (res != STATUS_OK)
+            {
+                unindex(expr);
+                vExpr.pop();
+                return res;
+            }
+
+            // The cached result may be outdated at this moment
+            expr->pContext  = this;
+            expr->invalidate();
+
+            return STATUS_OK;
+        }
+
+        status_t Context::remove(Expression *expr)
+        {
+            if (expr == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (expr->pContext != this)
+                return STATUS_NOT_FOUND;
+
+            unindex(expr);
+            vExpr.qpremove(expr);
+            expr->pContext  = NULL;
+
+            return STATUS_OK;
+        }
+
+        status_t Context::index(Expression *expr)
+        {
+            for (size_t i=0, n=expr->vDependencies.size(); i<n; ++i)
+            {
+                const LSPString *dep = expr->vDependencies.uget(i);
+                list_t *list = hDeps.get(dep);
+                if (list == NULL)
+                {
+                    if ((list = new list_t()) == NULL)
+                        return STATUS_NO_MEM;
+                    if (!hDeps.create(dep, list))
+                    {
+                        delete list;
+                        return STATUS_NO_MEM;
+                    }
+                }
+                else if (list->index_of(expr) >= 0)
+                    continue;
+
+                if (!list->add(expr))
+                    return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        void Context::unindex(Expression *expr)
+        {
+            for (size_t i=0, n=expr->vDependencies.size(); i<n; ++i)
+            {
+                const LSPString *dep = expr->vDependencies.uget(i);
+                list_t *list = hDeps.get(dep);
+                if (list == NULL)
+                    continue;
+
+                list->qpremove(expr);
+                if (list->size() > 0)
+                    continue;
+
+                hDeps.remove(dep, NULL);
+                delete list;
+            }
+        }
+
+        void Context::invalidate(const LSPString *name)
+        {
+            list_t *list = hDeps.get(name);
+            if (list == NULL)
+                return;
+
+            for (size_t i=0, n=list->size(); i<n; ++i)
+            {
+                Expression *expr = list->uget(i);
+                expr->invalidate(name);
+            }
+        }
+
+        void Context::invalidate_all()
+        {
+            for (size_t i=0, n=vExpr.size(); i<n; ++i)
+            {
+                Expression *expr = vExpr.uget(i);
+                expr->invalidate();
+            }
+        }
+
+        void Context::changed(Resolver *resolver, const LSPString *name)
+        {
+            changed(name);
+        }
+
+        void Context::changed(const LSPString *name)
+        {
+            if (name == NULL)
+            {
+                invalidate_all();
+                return;
+            }
+
+            invalidate(name);
+
+            // Indexed variables are named like 'name_index1_index2', invalidate all base names.
+            // The key is local to the call: notifications may arrive from several resolvers
+            LSPString key;
+            for (ssize_t idx = name->rindex_of('_'); idx > 0; idx = name->rindex_of(idx - 1, '_'))
+            {
+                if (!key.set(name, 0, idx))
+                {
+                    invalidate_all();
+                    return;
+                }
+                invalidate(&key);
+            }
+        }
+
+        status_t Context::changed(const char *name)
+        {
+            if (name == NULL)
+            {
+                invalidate_all();
+                return STATUS_OK;
+            }
+
+            LSPString tmp;
+            if (!tmp.set_utf8(name))
+                return STATUS_NO_MEM;
+
+            changed(&tmp);
+            return STATUS_OK;
+        }
+
+    } /* namespace expr */
+} /* namespace lsp */
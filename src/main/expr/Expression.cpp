@@ -22,7 +22,10 @@
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/expr/parser.h>
 #include <lsp-plug.in/expr/evaluator.h>
+#include <lsp-plug.in/expr/Bytecode.h>
 #include <lsp-plug.in/expr/Expression.h>
+#include <lsp-plug.in/expr/Context.h>
+#include <lsp-plug.in/expr/ParseCache.h>
 #include <lsp-plug.in/expr/Tokenizer.h>
 
 namespace lsp
@@ -32,27 +35,39 @@ namespace lsp
         Expression::Expression()
         {
             pResolver       = NULL;
+            pContext        = NULL;
+            pTree           = NULL;
         }
         
         Expression::Expression(Resolver *res)
         {
             pResolver       = res;
+            pContext        = NULL;
+            pTree           = NULL;
         }
         
         Expression::~Expression()
         {
+            if (pContext != NULL)
+                pContext->remove(this);
             destroy_all_data();
             pResolver       = NULL;
         }
 
         void Expression::destroy()
         {
+            if (pContext != NULL)
+                pContext->remove(this);
             destroy_all_data();
             pResolver       = NULL;
         }
 
         void Expression::destroy_all_data()
         {
+            // Dependencies are about to be lost, drop them from the context index
+            if (pContext != NULL)
+                pContext->unindex(this);
+
             for (size_t i=0, n=vDependencies.size(); i<n; ++i)
             {
                 LSPString *dep = vDependencies.uget(i);
@@ -64,14 +79,29 @@ namespace lsp
             for (size_t i=0, n=vRoots.size(); i<n; ++i)
             {
                 root_t *r = vRoots.uget(i);
-                if (r->expr != NULL)
+                if (r->code != NULL)
                 {
-                    parse_destroy(r->expr);
-                    r->expr = NULL;
+                    delete r->code;
+                    r->code = NULL;
                 }
+                if ((r->expr != NULL) && (pTree == NULL))
+                    parse_destroy(r->expr);
+                r->expr = NULL;
                 destroy_value(&r->result);
+                if (r->deps != NULL)
+                {
+                    ::free(r->deps);
+                    r->deps = NULL;
+                }
             }
             vRoots.flush();
+
+            // Release the shared tree
+            if (pTree != NULL)
+            {
+                ParseCache::release(pTree);
+                pTree   = NULL;
+            }
         }
 
         status_t Expression::result(value_t *result, size_t idx)
@@ -85,22 +115,49 @@ namespace lsp
             return copy_value(result, &r->result);
         }
 
+        status_t Expression::execute(root_t *r)
+        {
+            // Re-bind variables if the resolver has been changed
+            if (r->code->bound() != pResolver)
+            {
+                status_t res = r->code->bind(pResolver);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return r->code->execute(&r->result, pResolver);
+        }
+
+        status_t Expression::evaluate_root(root_t *r)
+        {
+            // Tracked expression keeps valid result until any of dependencies changes
+            if ((pContext != NULL) && (!r->dirty))
+                return STATUS_OK;
+
+            status_t res = STATUS_BAD_STATE;
+            destroy_value(&r->result);
+            if (r->code != NULL)
+                res     = execute(r);
+            else if (r->expr != NULL)
+                res     = r->expr->eval(&r->result, r->expr, pResolver);
+            else
+            {
+                r->result.type  = VT_UNDEF;
+                r->result.v_str = NULL;
+                res             = STATUS_OK;
+            }
+
+            r->dirty    = (res != STATUS_OK);
+            return res;
+        }
+
         status_t Expression::evaluate(value_t *result)
         {
             status_t res = STATUS_BAD_STATE;
 
             for (size_t i=0, n=vRoots.size(); i<n; ++i)
             {
-                root_t *r = vRoots.uget(i);
-                if (r->expr != NULL)
-                    res     = r->expr->eval(&r->result, r->expr, pResolver);
-                else
-                {
-                    r->result.type  = VT_UNDEF;
-                    r->result.v_str = NULL;
-                    res             = STATUS_OK;
-                }
-
+                res = evaluate_root(vRoots.uget(i));
                 if (res != STATUS_OK)
                     break;
             }
@@ -118,40 +175,131 @@ namespace lsp
             if (r == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            status_t res = STATUS_BAD_STATE;
-            if (r->expr != NULL)
-                res     = r->expr->eval(&r->result, r->expr, pResolver);
-            else
-            {
-                r->result.type  = VT_UNDEF;
-                r->result.v_str = NULL;
-                res             = STATUS_OK;
-            }
-
             // Store the result if ALL is OK
+            status_t res = evaluate_root(r);
             if ((res == STATUS_OK) && (result != NULL))
-                *result     = r->result;
+                res         = copy_value(result, &r->result);
 
             return res;
         }
+
+        status_t Expression::evaluate_batch(Batch *batch, double *dst, size_t count)
+        {
+            return evaluate_batch(size_t(0), batch, dst, count);
+        }
+
+        status_t Expression::evaluate_batch(Batch *batch, float *dst, size_t count)
+        {
+            return evaluate_batch(size_t(0), batch, dst, count);
+        }
+
+        status_t Expression::evaluate_batch(size_t idx, Batch *batch, double *dst, size_t count)
+        {
+            root_t *r = vRoots.get(idx);
+            if ((r == NULL) || (batch == NULL) || (dst == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (r->code == NULL)
+                return STATUS_BAD_STATE;
+
+            return r->code->execute(dst, count, batch);
+        }
+
+        status_t Expression::evaluate_batch(size_t idx, Batch *batch, float *dst, size_t count)
+        {
+            root_t *r = vRoots.get(idx);
+            if ((r == NULL) || (batch == NULL) || (dst == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (r->code == NULL)
+                return STATUS_BAD_STATE;
+
+            return r->code->execute(dst, count, batch);
+        }
+
+        void Expression::invalidate()
+        {
+            for (size_t i=0, n=vRoots.size(); i<n; ++i)
+                vRoots.uget(i)->dirty   = true;
+        }
+
+        bool Expression::invalidate(const LSPString *name)
+        {
+            // Find the dependency
+            ssize_t idx = -1;
+            for (size_t i=0, n=vDependencies.size(); i<n; ++i)
+            {
+                const LSPString *dep = vDependencies.uget(i);
+                if (dep->equals(name))
+                {
+                    idx     = i;
+                    break;
+                }
+            }
+            if (idx < 0)
+                return false;
+
+            // Mark all results that depend on it as dirty
+            bool marked = false;
+            for (size_t i=0, n=vRoots.size(); i<n; ++i)
+            {
+                root_t *r = vRoots.uget(i);
+                for (size_t j=0; j<r->ndeps; ++j)
+                {
+                    if (r->deps[j] == size_t(idx))
+                    {
+                        r->dirty    = true;
+                        marked      = true;
+                        break;
+                    }
+                }
+            }
+
+            return marked;
+        }
+
+        bool Expression::dirty() const
+        {
+            for (size_t i=0, n=vRoots.size(); i<n; ++i)
+            {
+                if (vRoots.uget(i)->dirty)
+                    return true;
+            }
+            return false;
+        }
+
+        bool Expression::dirty(size_t idx) const
+        {
+            const root_t *r = vRoots.get(idx);
+            return (r != NULL) ? r->dirty : false;
+        }
     
         status_t Expression::parse(const char *expr, const char *charset, size_t flags)
         {
-            io::InStringSequence is;
+            if (expr == NULL)
+                return STATUS_BAD_ARGUMENTS;
 
-            status_t res = is.wrap(expr, "UTF-8");
-            if (res == STATUS_OK)
-                res = parse(&is, flags);
-            if (res == STATUS_OK)
-                res = is.close();
-            else
-                is.close();
+            LSPString tmp;
+            if (!tmp.set_utf8(expr))
+                return STATUS_NO_MEM;
 
-            return res;
+            return parse(&tmp, flags);
         }
 
         status_t Expression::parse(const LSPString *expr, size_t flags)
         {
+            if (expr == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            // Try to use the shared tree first
+            destroy_all_data();
+            parse_tree_t *tree = ParseCache::acquire(expr, flags);
+            if (tree != NULL)
+            {
+                status_t res = attach_tree(tree);
+                if (res != STATUS_OK)
+                    destroy_all_data();
+                return res;
+            }
+
             io::InStringSequence is;
 
             status_t res = is.wrap(expr);
@@ -162,9 +310,70 @@ namespace lsp
             else
                 is.close();
 
+            // Share the parsed tree with other expressions
+            if (res == STATUS_OK)
+                publish_tree(expr, flags);
+
             return res;
         }
 
+        status_t Expression::attach_tree(parse_tree_t *tree)
+        {
+            pTree           = tree;
+
+            for (size_t i=0, n=tree->roots.size(); i<n; ++i)
+            {
+                root_t *root    = vRoots.add();
+                if (root == NULL)
+                    return STATUS_NO_MEM;
+
+                root->expr          = tree->roots.uget(i);
+                root->code          = NULL;
+                root->result.type   = VT_UNDEF;
+                root->result.v_str  = NULL;
+                root->deps          = NULL;
+                root->ndeps         = 0;
+                root->dirty         = true;
+            }
+
+            // Restore dependencies collected before the shared tree has been optimized
+            for (size_t i=0, k=0, n=vRoots.size(); i<n; ++i)
+            {
+                root_t *root    = vRoots.uget(i);
+                for (size_t j=0, m=*(tree->ndeps.uget(i)); j<m; ++j, ++k)
+                {
+                    status_t res = add_dependency(root, tree->deps.uget(k));
+                    if (res != STATUS_OK)
+                        return res;
+                }
+            }
+
+            return post_process();
+        }
+
+        void Expression::publish_tree(const LSPString *text, size_t flags)
+        {
+            lltl::parray<expr_t> roots;
+            lltl::parray<LSPString> deps;
+            lltl::darray<size_t> ndeps;
+            for (size_t i=0, n=vRoots.size(); i<n; ++i)
+            {
+                root_t *root    = vRoots.uget(i);
+                if (!roots.add(root->expr))
+                    return;
+                if (!ndeps.add(&root->ndeps))
+                    return;
+                for (size_t j=0; j<root->ndeps; ++j)
+                {
+                    if (!deps.add(vDependencies.uget(root->deps[j])))
+                        return;
+                }
+            }
+
+            // Cache takes ownership of trees on success
+            pTree   = ParseCache::publish(text, flags, roots.array(), roots.size(), deps.array(), ndeps.array());
+        }
+
         status_t Expression::parse_regular(io::IInSequence *seq, size_t flags)
         {
             status_t res = STATUS_OK;
@@ -182,8 +391,12 @@ namespace lsp
 
                 // Parse expression
                 root->expr          = NULL;
+                root->code          = NULL;
                 root->result.type   = VT_UNDEF;
                 root->result.v_str  = NULL;
+                root->deps          = NULL;
+                root->ndeps         = 0;
+                root->dirty         = true;
                 res                 = parse_expression(&root->expr, &t, TF_GET);
                 if (res != STATUS_OK)
                     break;
@@ -377,8 +590,12 @@ namespace lsp
             else
             {
                 root->expr          = expr;
+                root->code          = NULL;
                 root->result.type   = VT_UNDEF;
                 root->result.v_str  = NULL;
+                root->deps          = NULL;
+                root->ndeps         = 0;
+                root->dirty         = true;
             }
 
             return res;
@@ -387,6 +604,7 @@ namespace lsp
         status_t Expression::parse(io::IInSequence *seq, size_t flags)
         {
             status_t res = STATUS_OK;
+            destroy_all_data();
 
             if (flags & FLAG_STRING)
                 res = parse_string(seq, flags & (~FLAG_STRING));
@@ -404,44 +622,212 @@ namespace lsp
 
         status_t Expression::post_process()
         {
-            // Scan for dependencies
+            // Scan for dependencies and optimize the tree
             for (size_t i=0, n=vRoots.size(); i<n; ++i)
             {
                 root_t *root = vRoots.uget(i);
                 if (root == NULL)
                     continue;
 
-                status_t res = scan_dependencies(root->expr);
+                // Shared trees are already optimized and should not be modified,
+                // their dependencies are restored by attach_tree()
+                if (pTree != NULL)
+                    continue;
+                status_t res = scan_dependencies(root, root->expr);
+                if (res == STATUS_OK)
+                    res = optimize(root->expr);
                 if (res != STATUS_OK)
                     return res;
             }
 
+            // Compile expressions into bytecode
+            for (size_t i=0, n=vRoots.size(); i<n; ++i)
+            {
+                root_t *root = vRoots.uget(i);
+                if ((root == NULL) || (root->expr == NULL))
+                    continue;
+
+                Bytecode *code = new Bytecode();
+                if (code == NULL)
+                    return STATUS_NO_MEM;
+
+                status_t res = code->compile(root->expr);
+                if (res == STATUS_OK)
+                    res = code->bind(pResolver);
+                if (res != STATUS_OK)
+                {
+                    delete code;
+                    return res;
+                }
+                root->code  = code;
+            }
+
+            // Update the index of dependencies in the evaluation context
+            return (pContext != NULL) ? pContext->index(this) : STATUS_OK;
+        }
+
+        void Expression::replace_with_value(expr_t *expr, const value_t *value)
+        {
+            expr_t *cond    = expr->calc.cond;
+            expr_t *left    = expr->calc.left;
+            expr_t *right   = expr->calc.right;
+
+            expr->eval      = eval_value;
+            expr->type      = ET_VALUE;
+            expr->value     = *value;
+
+            parse_destroy(cond);
+            parse_destroy(left);
+            parse_destroy(right);
+        }
+
+        void Expression::replace_with_child(expr_t *expr, expr_t *child)
+        {
+            expr_t *cond    = (expr->calc.cond != child) ? expr->calc.cond : NULL;
+            expr_t *left    = (expr->calc.left != child) ? expr->calc.left : NULL;
+            expr_t *right   = (expr->calc.right != child) ? expr->calc.right : NULL;
+
+            // Move the child into the node and release the child's storage
+            *expr           = *child;
+            ::free(child);
+
+            parse_destroy(cond);
+            parse_destroy(left);
+            parse_destroy(right);
+        }
+
+        status_t Expression::optimize(expr_t *expr)
+        {
+            if (expr == NULL)
+                return STATUS_OK;
+
+            status_t res;
+            switch (expr->type)
+            {
+                case ET_VALUE:
+                    return STATUS_OK;
+                case ET_RESOLVE:
+                {
+                    for (size_t i=0; i<expr->resolve.count; ++i)
+                    {
+                        if ((res = optimize(expr->resolve.items[i])) != STATUS_OK)
+                            return res;
+                    }
+                    return STATUS_OK;
+                }
+                case ET_CALC:
+                    break;
+                default:
+                    return STATUS_CORRUPTED;
+            }
+
+            // Optimize operands first
+            if ((res = optimize(expr->calc.cond)) != STATUS_OK)
+                return res;
+            if ((res = optimize(expr->calc.left)) != STATUS_OK)
+                return res;
+            if ((res = optimize(expr->calc.right)) != STATUS_OK)
+                return res;
+
+            // Unary plus does nothing
+            if (expr->eval == eval_psign)
+            {
+                replace_with_child(expr, expr->calc.left);
+                return STATUS_OK;
+            }
+
+            bool c_const    = (expr->calc.cond == NULL) || (expr->calc.cond->type == ET_VALUE);
+            bool l_const    = (expr->calc.left == NULL) || (expr->calc.left->type == ET_VALUE);
+            bool r_const    = (expr->calc.right == NULL) || (expr->calc.right->type == ET_VALUE);
+
+            // All operands are constant: fold the expression. If the evaluation fails,
+            // keep the expression as is to report the error at the evaluation stage.
+            value_t value;
+            init_value(&value);
+            if ((c_const) && (l_const) && (r_const))
+            {
+                if (expr->eval(&value, expr, NULL) == STATUS_OK)
+                    replace_with_value(expr, &value);
+                return STATUS_OK;
+            }
+
+            // Constant condition of the ternary operator: eliminate the dead branch
+            if ((expr->eval == eval_ternary) && (c_const))
+            {
+                if ((res = init_value(&value, &expr->calc.cond->value)) != STATUS_OK)
+                    return res;
+                if (guard_ternary(&value) != STATUS_OK)
+                    replace_with_value(expr, &value);
+                else
+                    replace_with_child(expr, (value.v_bool) ? expr->calc.left : expr->calc.right);
+                return STATUS_OK;
+            }
+
+            // Constant left operand of the logical operator: short-circuit the expression
+            if (((expr->eval == eval_or) || (expr->eval == eval_and)) && (l_const))
+            {
+                if ((res = init_value(&value, &expr->calc.left->value)) != STATUS_OK)
+                    return res;
+                res = (expr->eval == eval_or) ? guard_or(&value) : guard_and(&value);
+                if (res == STATUS_SKIP)
+                    replace_with_value(expr, &value);
+                else if (res == STATUS_OK)
+                {
+                    // The result is the right operand converted to boolean
+                    parse_destroy(expr->calc.left);
+                    expr->eval          = eval_bool_cast;
+                    expr->calc.left     = expr->calc.right;
+                    expr->calc.right    = NULL;
+                }
+            }
+
             return STATUS_OK;
         }
 
-        status_t Expression::add_dependency(const LSPString *str)
+        status_t Expression::add_dependency(root_t *root, const LSPString *str)
         {
             // Already have such dependency?
+            size_t idx = vDependencies.size();
             for (size_t i=0, n=vDependencies.size(); i<n; ++i)
             {
                 LSPString *dep = vDependencies.uget(i);
                 if (dep->equals(str))
-                    return STATUS_OK;
+                {
+                    idx     = i;
+                    break;
+                }
             }
 
             // Add new dependency
-            LSPString *dep = str->clone();
-            if (dep == NULL)
-                return STATUS_NO_MEM;
+            if (idx >= vDependencies.size())
+            {
+                LSPString *dep = str->clone();
+                if (dep == NULL)
+                    return STATUS_NO_MEM;
+                if (!vDependencies.add(dep))
+                {
+                    delete dep;
+                    return STATUS_NO_MEM;
+                }
+            }
 
-            if (vDependencies.add(dep))
-                return STATUS_OK;
+            // Bind dependency to the root expression
+            for (size_t i=0; i<root->ndeps; ++i)
+            {
+                if (root->deps[i] == idx)
+                    return STATUS_OK;
+            }
 
-            delete dep;
-            return STATUS_NO_MEM;
+            size_t *deps = static_cast<size_t *>(::realloc(root->deps, (root->ndeps + 1) * sizeof(size_t)));
+            if (deps == NULL)
+                return STATUS_NO_MEM;
+            deps[root->ndeps++] = idx;
+            root->deps          = deps;
+
+            return STATUS_OK;
         }
 
-        status_t Expression::scan_dependencies(expr_t *expr)
+        status_t Expression::scan_dependencies(root_t *root, expr_t *expr)
         {
             if (expr == NULL)
                 return STATUS_OK;
@@ -452,21 +838,21 @@ namespace lsp
                     return STATUS_OK;
                 case ET_CALC:
                 {
-                    status_t res = scan_dependencies(expr->calc.cond);
+                    status_t res = scan_dependencies(root, expr->calc.cond);
                     if (res == STATUS_OK)
-                        res = scan_dependencies(expr->calc.left);
+                        res = scan_dependencies(root, expr->calc.left);
                     if (res == STATUS_OK)
-                        res = scan_dependencies(expr->calc.right);
+                        res = scan_dependencies(root, expr->calc.right);
                     return res;
                 }
                 case ET_RESOLVE:
                 {
-                    status_t res = add_dependency(expr->resolve.name);
+                    status_t res = add_dependency(root, expr->resolve.name);
                     if (res != STATUS_OK)
                         return res;
                     for (size_t i=0; i<expr->resolve.count; ++i)
                     {
-                        res = scan_dependencies(expr->resolve.items[i]);
+                        res = scan_dependencies(root, expr->resolve.items[i]);
                         if (res != STATUS_OK)
                             break;
                     }
@@ -29,17 +29,33 @@ namespace lsp
         
         Parameters::Parameters()
         {
+            vIndex          = NULL;
+            nIndexCap       = 0;
+            nIndexSize      = 0;
+            nShadowed       = 0;
+            bIndexed        = false;
         }
         
         Parameters::~Parameters()
         {
             destroy_params(vParams);
+            if (vIndex != NULL)
+            {
+                ::free(vIndex);
+                vIndex          = NULL;
+            }
         }
 
         void Parameters::modified()
         {
         }
 
+        void Parameters::do_modified(const LSPString *name)
+        {
+            notify(name);
+            modified();
+        }
+
         Parameters *Parameters::clone() const
         {
             Parameters *res = new Parameters();
@@ -58,14 +74,20 @@ namespace lsp
                 return;
 
             vParams.swap(&src->vParams);
-            src->modified();
-            this->modified();
+            lsp::swap(vIndex, src->vIndex);
+            lsp::swap(nIndexCap, src->nIndexCap);
+            lsp::swap(nIndexSize, src->nIndexSize);
+            lsp::swap(nShadowed, src->nShadowed);
+            lsp::swap(bIndexed, src->bIndexed);
+            src->do_modified(NULL);
+            this->do_modified(NULL);
         }
 
         void Parameters::clear()
         {
             destroy_params(vParams);
-            modified();
+            rebuild_index();
+            do_modified(NULL);
         }
 
         status_t Parameters::resolve(value_t *value, const char *name, size_t num_indexes, const ssize_t *indexes)
@@ -80,26 +102,211 @@ namespace lsp
             return resolve(value, &key, num_indexes, indexes);
         }
 
-        Parameters::param_t *Parameters::lookup_by_name(const LSPString *name)
+        size_t Parameters::index_slot(const lsp_wchar_t *name, size_t len, size_t hash) const
+        {
+            size_t mask = nIndexCap - 1;
+            size_t slot = (hash ^ (hash >> 15)) & mask;
+
+            // The index is never filled more than by half, so there always is an empty slot
+            for (param_t *p; (p = vIndex[slot]) != NULL; slot = (slot + 1) & mask)
+            {
+                if ((p->hash == hash) && (size_t(p->len) == len) &&
+                    (::memcmp(p->name, name, len * sizeof(lsp_wchar_t)) == 0))
+                    break;
+            }
+
+            return slot;
+        }
+
+        void Parameters::invalidate_index()
+        {
+            bIndexed        = false;
+            nIndexSize      = 0;
+            nShadowed       = 0;
+        }
+
+        bool Parameters::rebuild_index()
         {
+            invalidate_index();
+
+            // Estimate the capacity of the index
+            size_t cap = 16;
+            while (cap < (vParams.size() + 1) * 2)
+                cap   <<= 1;
+
+            if (cap != nIndexCap)
+            {
+                param_t **index = reinterpret_cast<param_t **>(::realloc(vIndex, cap * sizeof(param_t *)));
+                if (index == NULL)
+                    return false;
+                vIndex          = index;
+                nIndexCap       = cap;
+            }
+            ::memset(vIndex, 0, nIndexCap * sizeof(param_t *));
+
+            // Parameters with lesser index take the slot first
             for (size_t i=0, n=vParams.size(); i<n; ++i)
             {
                 param_t *p = vParams.uget(i);
-                if ((p != NULL) && (p->len >= 0) && (name->equals(p->name, p->len)))
-                    return p;
+                if (p == NULL)
+                    continue;
+                p->index        = i;
+                if (p->len < 0)
+                    continue;
+
+                size_t slot = index_slot(p->name, p->len, p->hash);
+                if (vIndex[slot] != NULL)
+                    ++nShadowed;
+                else
+                {
+                    vIndex[slot]    = p;
+                    ++nIndexSize;
+                }
             }
-            return NULL;
+
+            bIndexed        = true;
+            return true;
         }
 
-        ssize_t Parameters::get_index(const LSPString *name) const
+        void Parameters::update_positions(size_t first)
         {
+            for (size_t i=first, n=vParams.size(); i<n; ++i)
+                vParams.uget(i)->index  = i;
+        }
+
+        void Parameters::index_param(param_t *p, size_t index)
+        {
+            // Retry to build the index if it previously has failed
+            if ((!bIndexed) || ((nIndexSize + nShadowed + 1) * 2 > nIndexCap))
+            {
+                rebuild_index();
+                return;
+            }
+
+            update_positions(index);
+            if (p->len < 0)
+                return;
+
+            size_t slot = index_slot(p->name, p->len, p->hash);
+            param_t *q  = vIndex[slot];
+            if (q == NULL)
+            {
+                vIndex[slot]    = p;
+                ++nIndexSize;
+                return;
+            }
+
+            // Parameter with the same name already is present, the new one takes
+            // the slot only if it has been inserted before the current one
+            ++nShadowed;
+            if (q->index > index)
+                vIndex[slot]    = p;
+        }
+
+        void Parameters::unindex_param(param_t *p, size_t index)
+        {
+            // Retry to build the index if it previously has failed
+            if (!bIndexed)
+            {
+                rebuild_index();
+                return;
+            }
+
+            update_positions(index);
+            if (p->len < 0)
+                return;
+
+            size_t slot = index_slot(p->name, p->len, p->hash);
+            param_t *q  = vIndex[slot];
+            if (q != p)
+            {
+                // The parameter has been hidden by another one
+                if (q != NULL)
+                    --nShadowed;
+                return;
+            }
+
+            // Find the next visible parameter with the same name, it could
+            // be placed only after the removed one
+            if (nShadowed > 0)
+            {
+                for (size_t i=index, n=vParams.size(); i<n; ++i)
+                {
+                    q = vParams.uget(i);
+                    if ((q != NULL) && (q->hash == p->hash) && (q->len == p->len) &&
+                        (::memcmp(q->name, p->name, p->len * sizeof(lsp_wchar_t)) == 0))
+                    {
+                        vIndex[slot]    = q;
+                        --nShadowed;
+                        return;
+                    }
+                }
+            }
+
+            erase_slot(slot);
+            --nIndexSize;
+        }
+
+        void Parameters::erase_slot(size_t slot)
+        {
+            // Backward shift deletion for the linear probing
+            size_t mask     = nIndexCap - 1;
+            vIndex[slot]    = NULL;
+
+            for (size_t i = (slot + 1) & mask; ; i = (i + 1) & mask)
+            {
+                param_t *p      = vIndex[i];
+                if (p == NULL)
+                    break;
+
+                // Keep the item if its home slot is cyclically within (slot, i]
+                size_t home     = (p->hash ^ (p->hash >> 15)) & mask;
+                bool keep       = (slot <= i) ?
+                    ((slot < home) && (home <= i)) :
+                    ((slot < home) || (home <= i));
+                if (keep)
+                    continue;
+
+                vIndex[slot]    = p;
+                vIndex[i]       = NULL;
+                slot            = i;
+            }
+        }
+
+        Parameters::param_t *Parameters::lookup_by_name(const LSPString *name) const
+        {
+            size_t index;
+            return lookup_by_name(name, &index);
+        }
+
+        Parameters::param_t *Parameters::lookup_by_name(const LSPString *name, size_t *idx) const
+        {
+            if (bIndexed)
+            {
+                param_t *p = vIndex[index_slot(name->characters(), name->length(), name->hash())];
+                if (p != NULL)
+                    *idx = p->index;
+                return p;
+            }
+
+            // Fall back to the linear search if there was not enough memory for the index
             for (size_t i=0, n=vParams.size(); i<n; ++i)
             {
-                const param_t *p = vParams.uget(i);
+                param_t *p = vParams.uget(i);
                 if ((p != NULL) && (p->len >= 0) && (name->equals(p->name, p->len)))
-                    return i;
+                {
+                    *idx = i;
+                    return p;
+                }
             }
-            return -STATUS_NOT_FOUND;
+            return NULL;
+        }
+
+        ssize_t Parameters::get_index(const LSPString *name) const
+        {
+            size_t index;
+            param_t *p = lookup_by_name(name, &index);
+            return (p != NULL) ? index : -STATUS_NOT_FOUND;
         }
 
         ssize_t Parameters::get_index(const char *name) const
@@ -137,24 +344,10 @@ namespace lsp
 
         ssize_t Parameters::get_type(const LSPString *name) const
         {
-            param_t *p = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *p = lookup_by_name(name);
             return (p != NULL) ? p->value.type : -STATUS_NOT_FOUND;
         }
 
-        Parameters::param_t *Parameters::lookup_by_name(const LSPString *name, size_t *idx)
-        {
-            for (size_t i=0, n=vParams.size(); i<n; ++i)
-            {
-                param_t *p = vParams.uget(i);
-                if ((p != NULL) && (p->len >= 0) && (name->equals(p->name, p->len)))
-                {
-                    *idx = i;
-                    return p;
-                }
-            }
-            return NULL;
-        }
-
         status_t Parameters::resolve(value_t *value, const LSPString *name, size_t num_indexes, const ssize_t *indexes)
         {
             // Need to form indexes?
@@ -207,6 +400,8 @@ namespace lsp
             if (p != NULL)
             {
                 init_value(&p->value);
+                p->hash = 0;
+                p->index = 0;
                 p->len = -1;
             }
             return p;
@@ -220,6 +415,8 @@ namespace lsp
             if (p != NULL)
             {
                 init_value(&p->value);
+                p->hash = LSPString::hash(name, len);
+                p->index = 0;
                 p->len = len;
                 ::memcpy(p->name, name, len * sizeof(lsp_wchar_t));
             }
@@ -235,6 +432,8 @@ namespace lsp
             if (p != NULL)
             {
                 init_value(&p->value, &src->value);
+                p->hash = src->hash;
+                p->index = 0;
                 p->len = src->len;
                 ::memcpy(p->name, src->name, len * sizeof(lsp_wchar_t));
             }
@@ -278,7 +477,8 @@ namespace lsp
             // Swap parameters and destroy old data
             vParams.swap(&slice);
             destroy_params(slice);
-            modified();
+            rebuild_index();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -321,7 +521,8 @@ namespace lsp
 
             // Clean temporary parameters, swap parameters and destroy old data
             vParams.swap(&slice);
-            modified();
+            rebuild_index();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -341,11 +542,13 @@ namespace lsp
                     for (size_t j=0; j<count; ++j)
                         destroy(vParams.uget(j));
                     vParams.remove_n(first, count);
+                    rebuild_index();
                     return STATUS_NO_MEM;
                 }
             }
 
-            modified();
+            rebuild_index();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -363,7 +566,8 @@ namespace lsp
             {
                 if (vParams.add(p))
                 {
-                    modified();
+                    index_param(p, vParams.size() - 1);
+                    do_modified(NULL);
                     return STATUS_OK;
                 }
                 res = STATUS_NO_MEM;
@@ -395,7 +599,8 @@ namespace lsp
             {
                 if (vParams.add(p))
                 {
-                    modified();
+                    index_param(p, vParams.size() - 1);
+                    do_modified(NULL);
                     return STATUS_OK;
                 }
                 res = STATUS_NO_MEM;
@@ -630,7 +835,8 @@ namespace lsp
             {
                 if (vParams.insert(index, p))
                 {
-                    modified();
+                    index_param(p, index);
+                    do_modified(NULL);
                     return STATUS_OK;
                 }
                 res = STATUS_NO_MEM;
@@ -654,7 +860,8 @@ namespace lsp
             {
                 if (vParams.insert(index, p))
                 {
-                    modified();
+                    index_param(p, index);
+                    do_modified(NULL);
                     return STATUS_OK;
                 }
                 res = STATUS_NO_MEM;
@@ -881,7 +1088,7 @@ namespace lsp
 
         status_t Parameters::get(const LSPString *name, value_t *value) const
         {
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
             return (value != NULL) ? copy_value(value, &v->value) : STATUS_OK;
@@ -1028,7 +1235,7 @@ namespace lsp
         {
             if (name == NULL)
                 return STATUS_INVALID_VALUE;
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
             else if (v->value.type != VT_INT)
@@ -1043,7 +1250,7 @@ namespace lsp
         {
             if (name == NULL)
                 return STATUS_INVALID_VALUE;
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
             else if (v->value.type != VT_FLOAT)
@@ -1058,7 +1265,7 @@ namespace lsp
         {
             if (name == NULL)
                 return STATUS_INVALID_VALUE;
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
             else if (v->value.type != VT_BOOL)
@@ -1073,7 +1280,7 @@ namespace lsp
         {
             if (name == NULL)
                 return STATUS_INVALID_VALUE;
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
             else if (v->value.type != VT_STRING)
@@ -1091,7 +1298,7 @@ namespace lsp
         {
             if (name == NULL)
                 return STATUS_INVALID_VALUE;
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
             else if (v->value.type != VT_NULL)
@@ -1104,7 +1311,7 @@ namespace lsp
         {
             if (name == NULL)
                 return STATUS_INVALID_VALUE;
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
             else if (v->value.type != VT_UNDEF)
@@ -1136,7 +1343,7 @@ namespace lsp
             if (name == NULL)
                 return STATUS_INVALID_VALUE;
 
-            param_t *v = const_cast<Parameters *>(this)->lookup_by_name(name);
+            param_t *v = lookup_by_name(name);
             if (v == NULL)
                 return STATUS_NOT_FOUND;
 
@@ -1370,7 +1577,7 @@ namespace lsp
 
             status_t res = copy_value(&v->value, value);
             if (res == STATUS_OK)
-                modified();
+                do_modified(name);
             return res;
         }
 
@@ -1382,7 +1589,7 @@ namespace lsp
 
             status_t res = copy_value(&v->value, value);
             if (res == STATUS_OK)
-                modified();
+                do_modified(NULL);
             return res;
         }
 
@@ -1588,8 +1795,9 @@ namespace lsp
             }
 
             vParams.remove(index);
+            unindex_param(v, index);
             destroy(v);
-            modified();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -1608,8 +1816,9 @@ namespace lsp
             }
 
             vParams.remove(index);
+            unindex_param(v, index);
             destroy(v);
-            modified();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -1654,8 +1863,9 @@ namespace lsp
             }
 
             vParams.remove(index);
+            unindex_param(v, index);
             destroy(v);
-            modified();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -1678,8 +1888,9 @@ namespace lsp
             }
 
             vParams.remove(index);
+            unindex_param(v, index);
             destroy(v);
-            modified();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -1696,8 +1907,9 @@ namespace lsp
                 destroy(vParams.uget(i));
 
             bool success = vParams.remove_n(first, count);
+            rebuild_index();
             if (success)
-                modified();
+                do_modified(NULL);
             return (success) ? STATUS_OK : STATUS_CORRUPTED;
         }
 
@@ -1710,8 +1922,9 @@ namespace lsp
                 return STATUS_BAD_TYPE;
 
             vParams.remove(index);
+            unindex_param(v, index);
             *out = v;
-            modified();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
@@ -1737,8 +1950,9 @@ namespace lsp
                 return STATUS_BAD_TYPE;
 
             vParams.remove(index);
+            unindex_param(v, index);
             *out = v;
-            modified();
+            do_modified(NULL);
             return STATUS_OK;
         }
 
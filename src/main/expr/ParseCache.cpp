@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/expr/ParseCache.h>
+#include <lsp-plug.in/expr/parser.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/lltl/pphash.h>
+
+namespace lsp
+{
+    namespace expr
+    {
+        typedef lltl::pphash<LSPString, parse_tree_t>       tree_map_t;
+
+        // Both the lock and the pointer are constant-initialized and have no destructors,
+        // so expressions may be parsed and destroyed at any stage of static initialization
+        // and destruction. The map is allocated by the first published tree and deleted
+        // when the last tree is released
+        static volatile atomic_t                            cache_lock = 1;
+        static tree_map_t                                  *cache_trees = NULL;
+
+        static inline void lock_cache()
+        {
+            while (!atomic_trylock(cache_lock))
+                ipc::Thread::yield();
+        }
+
+        static inline void unlock_cache()
+        {
+            atomic_unlock(cache_lock);
+        }
+
+        bool ParseCache::make_key(LSPString *key, const LSPString *text, size_t flags)
+        {
+            key->clear();
+            return (key->append(lsp_wchar_t('0' + flags))) && (key->append(text));
+        }
+
+        void ParseCache::destroy_deps(parse_tree_t *tree)
+        {
+            for (size_t i=0, n=tree->deps.size(); i<n; ++i)
+            {
+                LSPString *dep = tree->deps.uget(i);
+                if (dep != NULL)
+                    delete dep;
+            }
+            tree->deps.flush();
+            tree->ndeps.flush();
+        }
+
+        void ParseCache::destroy(parse_tree_t *tree)
+        {
+            for (size_t i=0, n=tree->roots.size(); i<n; ++i)
+            {
+                expr_t *root = tree->roots.uget(i);
+                if (root != NULL)
+                    parse_destroy(root);
+            }
+            tree->roots.flush();
+            destroy_deps(tree);
+            delete tree;
+        }
+
+        parse_tree_t *ParseCache::acquire(const LSPString *text, size_t flags)
+        {
+            LSPString key;
+            if (!make_key(&key, text, flags))
+                return NULL;
+
+            lock_cache();
+            parse_tree_t *tree  = (cache_trees != NULL) ? cache_trees->get(&key) : NULL;
+            if (tree != NULL)
+                ++tree->refs;
+            unlock_cache();
+
+            return tree;
+        }
+
+        bool ParseCache::copy_deps(parse_tree_t *tree, const LSPString * const *deps, const size_t *ndeps, size_t count)
+        {
+            if (!tree->ndeps.add_n(count, ndeps))
+                return false;
+
+            size_t total = 0;
+            for (size_t i=0; i<count; ++i)
+                total      += ndeps[i];
+
+            for (size_t i=0; i<total; ++i)
+            {
+                LSPString *dep = deps[i]->clone();
+                if (dep == NULL)
+                    return false;
+                if (!tree->deps.add(dep))
+                {
+                    delete dep;
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        parse_tree_t *ParseCache::publish(const LSPString *text, size_t flags, expr_t * const *roots, size_t count,
+                                          const LSPString * const *deps, const size_t *ndeps)
+        {
+            parse_tree_t *tree  = new parse_tree_t;
+            if (tree == NULL)
+                return NULL;
+            tree->refs          = 1;
+
+            if ((!make_key(&tree->key, text, flags)) ||
+                (!copy_deps(tree, deps, ndeps, count)) ||
+                (!tree->roots.add_n(count, roots)))
+            {
+                tree->roots.flush();
+                destroy_deps(tree);
+                delete tree;
+                return NULL;
+            }
+
+            // The same tree may have been published concurrently, the caller keeps its own tree then
+            lock_cache();
+            if (cache_trees == NULL)
+                cache_trees = new tree_map_t();
+            bool added  = (cache_trees != NULL) && (cache_trees->create(&tree->key, tree));
+            unlock_cache();
+
+            if (added)
+                return tree;
+
+            tree->roots.flush();
+            destroy_deps(tree);
+            delete tree;
+            return NULL;
+        }
+
+        void ParseCache::release(parse_tree_t *tree)
+        {
+            if (tree == NULL)
+                return;
+
+            tree_map_t *unused  = NULL;
+            lock_cache();
+            bool last   = (--tree->refs) <= 0;
+            if ((last) && (cache_trees != NULL))
+            {
+                cache_trees->remove(&tree->key, NULL);
+                if (cache_trees->size() <= 0)
+                {
+                    unused          = cache_trees;
+                    cache_trees     = NULL;
+                }
+            }
+            unlock_cache();
+
+            if (unused != NULL)
+                delete unused;
+            if (last)
+                destroy(tree);
+        }
+
+        size_t ParseCache::size()
+        {
+            lock_cache();
+            size_t count = (cache_trees != NULL) ? cache_trees->size() : 0;
+            unlock_cache();
+            return count;
+        }
+
+    } /* namespace expr */
+} /* namespace lsp */
@@ -20,11 +20,27 @@
  */
 
 #include <lsp-plug.in/expr/Resolver.h>
+#include <lsp-plug.in/stdlib/stdio.h>
 
 namespace lsp
 {
     namespace expr
     {
+        IResolverListener::IResolverListener()
+        {
+        }
+
+        IResolverListener::~IResolverListener()
+        {
+        }
+
+        void IResolverListener::changed(Resolver *resolver, const LSPString *name)
+        {
+        }
+
+        void IResolverListener::detached(Resolver *resolver)
+        {
+        }
         
         Resolver::Resolver()
         {
@@ -32,6 +48,41 @@ namespace lsp
         
         Resolver::~Resolver()
         {
+            // Listener may remove itself from the list while being detached
+            for (size_t n=vListeners.size(); n > 0; n = vListeners.size())
+            {
+                IResolverListener *listener = vListeners.uget(n - 1);
+                vListeners.pop();
+                listener->detached(this);
+            }
+            vListeners.flush();
+        }
+
+        void Resolver::notify(const LSPString *name)
+        {
+            for (size_t i=0, n=vListeners.size(); i<n; ++i)
+            {
+                IResolverListener *listener = vListeners.uget(i);
+                listener->changed(this, name);
+            }
+        }
+
+        status_t Resolver::add_listener(IResolverListener *listener)
+        {
+            if (listener == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (vListeners.index_of(listener) >= 0)
+                return STATUS_ALREADY_EXISTS;
+
+            return (vListeners.add(listener)) ? STATUS_OK : STATUS_NO_MEM;
+        }
+
+        status_t Resolver::remove_listener(IResolverListener *listener)
+        {
+            if (listener == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            return (vListeners.premove(listener)) ? STATUS_OK : STATUS_NOT_FOUND;
         }
     
         status_t Resolver::resolve(value_t *value, const char *name, size_t num_indexes, const ssize_t *indexes)
@@ -45,5 +96,29 @@ namespace lsp
             return resolve(value, name->get_utf8(), num_indexes, indexes);
         }
 
+        bool Resolver::indexed_name(LSPString *dst, const LSPString *name, size_t num_indexes, const ssize_t *indexes)
+        {
+            char buf[32];
+            if (!dst->set(name))
+                return false;
+            for (size_t i=0; i<num_indexes; ++i)
+            {
+                int n = ::snprintf(buf, sizeof(buf), "_%ld", long(indexes[i]));
+                if (!dst->append_ascii(buf, n))
+                    return false;
+            }
+            return true;
+        }
+
+        ssize_t Resolver::bind(const LSPString *name)
+        {
+            return -STATUS_NOT_SUPPORTED;
+        }
+
+        status_t Resolver::resolve_bound(value_t *value, size_t slot)
+        {
+            return STATUS_NOT_SUPPORTED;
+        }
+
     } /* namespace calc */
 } /* namespace lsp */
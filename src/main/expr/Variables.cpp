@@ -38,7 +38,23 @@ namespace lsp
         
         Variables::~Variables()
         {
-            clear();
+            do_destroy();
+        }
+
+        void Variables::do_destroy()
+        {
+            for (size_t i=0, n=vVars.size(); i<n; ++i)
+            {
+                variable_t *var = vVars.uget(i);
+                if (var != NULL)
+                {
+                    destroy_value(&var->value);
+                    delete var;
+                }
+            }
+            vVars.flush();
+            hVars.flush();
+            vSlots.flush();
         }
     
         status_t Variables::set_int(const char *name, ssize_t value)
@@ -252,34 +268,28 @@ namespace lsp
 
         status_t Variables::resolve(value_t *value, const LSPString *name, size_t num_indexes, const ssize_t *indexes)
         {
-            // Need to form indexes?
-            LSPString tmp;
+            // Need to form indexes? The key is local to the call: the resolver may call
+            // back into this object. Short names fit into the inline storage of the string
+            // and do not require memory allocations
             const LSPString *search;
+            LSPString key;
 
             if (num_indexes > 0)
             {
-                if (!tmp.set(name))
+                if (!indexed_name(&key, name, num_indexes, indexes))
                     return STATUS_NO_MEM;
-                for (size_t i=0; i<num_indexes; ++i)
-                {
-                    if (!tmp.fmt_append_ascii("_%ld", long(indexes[i])))
-                        return STATUS_NO_MEM;
-                }
-                search = &tmp;
+                search = &key;
             }
             else
                 search = name;
 
             // Lookup the cache
-            for (size_t i=0, n=vVars.size(); i<n; ++i)
+            variable_t *var = hVars.get(search);
+            if ((var != NULL) && (var->defined))
             {
-                variable_t *var = vVars.uget(i);
-                if ((var != NULL) && (var->name.equals(search)))
-                {
-                    if (value != NULL)
-                        return copy_value(value, &var->value);
-                    return STATUS_OK;
-                }
+                if (value != NULL)
+                    return copy_value(value, &var->value);
+                return STATUS_OK;
             }
 
             // No Resolver?
@@ -293,8 +303,8 @@ namespace lsp
             if (res != STATUS_OK)
                 return res;
 
-            // Save variable to cache
-            res = add(search, &v);
+            // Save variable to cache, this is not a change of the variable
+            res = store(search, &v);
             if ((res == STATUS_OK) && (value != NULL))
                 res = copy_value(value, &v);
 
@@ -302,42 +312,95 @@ namespace lsp
             return res;
         }
 
-        status_t Variables::add(const LSPString *name, const value_t *value)
+        ssize_t Variables::bind(const LSPString *name)
         {
-            variable_t *var = new variable_t;
-            if (!var->name.set(name))
-                return STATUS_NO_MEM;
+            if (name == NULL)
+                return -STATUS_BAD_ARGUMENTS;
 
-            init_value(&var->value);
-            status_t res = copy_value(&var->value, value);
-            if (res == STATUS_OK)
-                res = (vVars.add(var)) ? STATUS_OK : STATUS_NO_MEM;
-            if (res == STATUS_OK)
-                return res;
+            // Bind to existing variable or create undefined one
+            variable_t *var = hVars.get(name);
+            if (var == NULL)
+            {
+                if ((var = create(name)) == NULL)
+                    return -STATUS_NO_MEM;
+                var->defined    = false;
+            }
+            if (var->slot >= 0)
+                return var->slot;
 
-            destroy_value(&var->value);
-            delete var;
-            return res;
+            if (!vSlots.add(var))
+                return -STATUS_NO_MEM;
+            var->slot       = vSlots.size() - 1;
+
+            return var->slot;
         }
 
-        status_t Variables::set(const LSPString *name, const value_t *value)
+        status_t Variables::resolve_bound(value_t *value, size_t slot)
         {
-            if (name == NULL)
+            variable_t *var = vSlots.get(slot);
+            if (var == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            // Lookup for existing data
-            for (size_t i=0, n=vVars.size(); i<n; ++i)
+            if (var->defined)
+                return (value != NULL) ? copy_value(value, &var->value) : STATUS_OK;
+
+            return resolve(value, &var->name, 0, NULL);
+        }
+
+        Variables::variable_t *Variables::create(const LSPString *name)
+        {
+            variable_t *var = new variable_t;
+            if (var == NULL)
+                return NULL;
+
+            init_value(&var->value);
+            var->slot       = -1;
+            var->defined    = true;
+
+            if (var->name.set(name))
             {
-                variable_t *var = vVars.uget(i);
-                if (var->name.equals(name))
+                if (vVars.add(var))
                 {
-                    destroy_value(&var->value);
-                    return copy_value(&var->value, value);
+                    if (hVars.create(&var->name, var))
+                        return var;
+                    vVars.pop();
                 }
             }
 
-            // Add non-existing value
-            return add(name, value);
+            delete var;
+            return NULL;
+        }
+
+        status_t Variables::add(const LSPString *name, const value_t *value)
+        {
+            variable_t *var = create(name);
+            if (var == NULL)
+                return STATUS_NO_MEM;
+
+            return copy_value(&var->value, value);
+        }
+
+        status_t Variables::store(const LSPString *name, const value_t *value)
+        {
+            // Lookup for existing data
+            variable_t *var = hVars.get(name);
+            if (var == NULL)
+                return add(name, value);
+
+            destroy_value(&var->value);
+            var->defined    = true;
+            return copy_value(&var->value, value);
+        }
+
+        status_t Variables::set(const LSPString *name, const value_t *value)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res = store(name, value);
+            if (res == STATUS_OK)
+                notify(name);
+            return res;
         }
 
         status_t Variables::unset(const LSPString *name, value_t *value)
@@ -346,32 +409,60 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
 
             // Lookup for data
-            for (size_t i=0, n=vVars.size(); i<n; ++i)
+            variable_t *var = hVars.get(name);
+            if (var == NULL)
+                return STATUS_OK;
+
+            destroy_value(&var->value);
+            if (var->slot >= 0)
             {
-                variable_t *var = vVars.uget(i);
-                if (var->name.equals(name))
-                {
-                    vVars.qremove(i);
-                    destroy_value(&var->value);
-                    delete var;
-                }
+                // Keep bound variable, the slot should remain valid
+                var->defined    = false;
+                notify(name);
+                return STATUS_OK;
             }
 
+            hVars.remove(&var->name, NULL);
+            vVars.qpremove(var);
+            delete var;
+            notify(name);
+
             return STATUS_OK;
         }
 
         void Variables::clear()
         {
+            size_t j = 0;
             for (size_t i=0, n=vVars.size(); i<n; ++i)
             {
                 variable_t *var = vVars.uget(i);
-                if (var != NULL)
+                destroy_value(&var->value);
+
+                // Keep bound variables
+                if (var->slot >= 0)
                 {
-                    destroy_value(&var->value);
-                    delete var;
+                    var->defined    = false;
+                    vVars.set(j++, var);
+                    continue;
                 }
+
+                hVars.remove(&var->name, NULL);
+                delete var;
             }
-            vVars.flush();
+            vVars.truncate(j);
+            notify(NULL);
+        }
+
+        size_t Variables::size() const
+        {
+            size_t count = 0;
+            for (size_t i=0, n=vVars.size(); i<n; ++i)
+            {
+                const variable_t *var = vVars.uget(i);
+                if (var->defined)
+                    ++count;
+            }
+            return count;
         }
 
     } /* namespace calc */
@@ -23,149 +23,162 @@
 #include <lsp-plug.in/expr/evaluator.h>
 #include <lsp-plug.in/stdlib/math.h>
 
+#define INLINE_INDEXES          16
+
 namespace lsp
 {
     namespace expr
     {
-        #define INT_OP(eval_name, oper) \
-            status_t eval_name(value_t *value, const expr_t *expr, eval_env_t *env) \
-            { \
-                status_t res = expr->calc.left->eval(value, expr->calc.left, env); \
-                if (res != STATUS_OK) \
-                    return res; \
-                \
-                cast_int(value); \
-                if (value->type == VT_UNDEF) \
-                    return STATUS_OK; \
-                else if (value->type == VT_NULL) \
-                { \
-                    value->type = VT_UNDEF; \
-                    return STATUS_OK; \
-                } \
-                \
-                value_t right; \
-                init_value(&right); \
-                res = expr->calc.right->eval(&right, expr->calc.right, env); \
-                if (res != STATUS_OK) \
-                { \
-                    destroy_value(&right); \
-                    destroy_value(value); \
-                    return res; \
-                } \
-                \
-                cast_int(&right); \
-                switch (right.type) \
-                { \
-                    case VT_INT: value->v_int = value->v_int oper right.v_int; break; \
-                    case VT_NULL: value->type = VT_UNDEF; break; \
-                    case VT_UNDEF: break; \
-                    default: res = STATUS_BAD_TYPE; break; \
-                } \
-                \
-                if (res != STATUS_OK) \
-                    destroy_value(value); \
-                destroy_value(&right); \
-                \
-                return res; \
-            }
-
-        status_t eval_add(value_t *value, const expr_t *expr, eval_env_t *env)
+        //---------------------------------------------------------------------
+        // Guards for the left operand of binary operations
+        status_t guard_numeric(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
             cast_numeric(value);
             if (value->type == VT_UNDEF)
-                return STATUS_OK;
+                return STATUS_SKIP;
             else if (value->type == VT_NULL)
             {
                 value->type = VT_UNDEF;
-                return STATUS_OK;
+                return STATUS_SKIP;
             }
+            return STATUS_OK;
+        }
 
-            value_t right;
-            init_value(&right);
-
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
+        status_t guard_int(value_t *value)
+        {
+            cast_int(value);
+            if (value->type == VT_UNDEF)
+                return STATUS_SKIP;
+            else if (value->type == VT_NULL)
             {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
+                value->type = VT_UNDEF;
+                return STATUS_SKIP;
             }
+            return STATUS_OK;
+        }
 
-            cast_numeric(&right);
+        status_t guard_float(value_t *value)
+        {
+            cast_float(value);
+            if (value->type == VT_UNDEF)
+                return STATUS_SKIP;
+            else if (value->type == VT_NULL)
+            {
+                value->type = VT_UNDEF;
+                return STATUS_SKIP;
+            }
+            return STATUS_OK;
+        }
 
-            switch (right.type)
+        status_t guard_power(value_t *value)
+        {
+            cast_float(value);
+            switch (value->type)
             {
-                case VT_INT:
-                    if (value->type == VT_INT)
-                        value->v_int    = value->v_int + right.v_int;
-                    else
-                        value->v_float  = value->v_float + right.v_int;
-                    break;
                 case VT_FLOAT:
-                    if (value->type == VT_INT)
-                        value->v_float  = value->v_int + right.v_float;
-                    else
-                        value->v_float  = value->v_float + right.v_float;
-                    value->type = VT_FLOAT;
-                    break;
+                    return STATUS_OK;
                 case VT_NULL:
                     value->type = VT_UNDEF;
+                    return STATUS_SKIP;
+                case VT_UNDEF:
+                    return STATUS_SKIP;
+                default:
                     break;
-                case VT_UNDEF: break;
-                default: res = STATUS_BAD_TYPE; break;
             }
 
+            destroy_value(value);
+            return STATUS_BAD_TYPE;
+        }
+
+        status_t guard_bool(value_t *value)
+        {
+            status_t res = cast_bool(value);
             if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
-
             return res;
         }
 
-        status_t eval_sub(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t guard_or(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
+            status_t res = cast_bool(value);
             if (res != STATUS_OK)
+            {
+                destroy_value(value);
                 return res;
+            }
+            return (value->v_bool) ? STATUS_SKIP : STATUS_OK;
+        }
 
-            cast_numeric(value);
-            if (value->type == VT_UNDEF)
-                return STATUS_OK;
-            else if (value->type == VT_NULL)
+        status_t guard_and(value_t *value)
+        {
+            status_t res = cast_bool(value);
+            if (res != STATUS_OK)
             {
-                value->type = VT_UNDEF;
-                return STATUS_OK;
+                destroy_value(value);
+                return res;
             }
+            return (!value->v_bool) ? STATUS_SKIP : STATUS_OK;
+        }
 
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
+        status_t guard_string(value_t *value)
+        {
+            status_t res = cast_string_ext(value);
             if (res != STATUS_OK)
+                destroy_value(value);
+            return res;
+        }
+
+        status_t guard_ternary(value_t *value)
+        {
+            cast_bool(value);
+            if ((value->type) != VT_BOOL)
             {
-                destroy_value(&right);
                 destroy_value(value);
-                return res;
+                return STATUS_SKIP;
+            }
+            return STATUS_OK;
+        }
+
+        //---------------------------------------------------------------------
+        // Binary operations
+        #define CALC_INT_OP(calc_name, oper) \
+            status_t calc_name(value_t *value, value_t *right) \
+            { \
+                status_t res = STATUS_OK; \
+                cast_int(right); \
+                switch (right->type) \
+                { \
+                    case VT_INT: value->v_int = value->v_int oper right->v_int; break; \
+                    case VT_NULL: value->type = VT_UNDEF; break; \
+                    case VT_UNDEF: break; \
+                    default: res = STATUS_BAD_TYPE; break; \
+                } \
+                \
+                if (res != STATUS_OK) \
+                    destroy_value(value); \
+                destroy_value(right); \
+                \
+                return res; \
             }
 
-            cast_numeric(&right);
+        status_t calc_add(value_t *value, value_t *right)
+        {
+            status_t res = STATUS_OK;
+            cast_numeric(right);
 
-            switch (right.type)
+            switch (right->type)
             {
                 case VT_INT:
                     if (value->type == VT_INT)
-                        value->v_int    = value->v_int - right.v_int;
+                        value->v_int    = value->v_int + right->v_int;
                     else
-                        value->v_float  = value->v_float - double(right.v_int);
+                        value->v_float  = value->v_float + right->v_int;
                     break;
                 case VT_FLOAT:
                     if (value->type == VT_INT)
-                        value->v_float  = double(value->v_int) - right.v_float;
+                        value->v_float  = value->v_int + right->v_float;
                     else
-                        value->v_float  = value->v_float - right.v_float;
+                        value->v_float  = value->v_float + right->v_float;
                     value->type = VT_FLOAT;
                     break;
                 case VT_NULL:
@@ -177,51 +190,29 @@ namespace lsp
 
             if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
+            destroy_value(right);
 
             return res;
         }
 
-        status_t eval_mul(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_sub(value_t *value, value_t *right)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
-            cast_numeric(value);
-            if (value->type == VT_UNDEF)
-                return STATUS_OK;
-            else if (value->type == VT_NULL)
-            {
-                value->type = VT_UNDEF;
-                return STATUS_OK;
-            }
-
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
-            }
-
-            cast_numeric(&right);
+            status_t res = STATUS_OK;
+            cast_numeric(right);
 
-            switch (right.type)
+            switch (right->type)
             {
                 case VT_INT:
                     if (value->type == VT_INT)
-                        value->v_int    = value->v_int * right.v_int;
+                        value->v_int    = value->v_int - right->v_int;
                     else
-                        value->v_float  = value->v_float * double(right.v_int);
+                        value->v_float  = value->v_float - double(right->v_int);
                     break;
                 case VT_FLOAT:
                     if (value->type == VT_INT)
-                        value->v_float  = double(value->v_int) * right.v_float;
+                        value->v_float  = double(value->v_int) - right->v_float;
                     else
-                        value->v_float  = value->v_float * right.v_float;
+                        value->v_float  = value->v_float - right->v_float;
                     value->type = VT_FLOAT;
                     break;
                 case VT_NULL:
@@ -233,56 +224,68 @@ namespace lsp
 
             if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
+            destroy_value(right);
 
             return res;
         }
 
-        status_t eval_div(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_mul(value_t *value, value_t *right)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
+            cast_numeric(right);
 
-            cast_numeric(value);
-            if (value->type == VT_UNDEF)
-                return STATUS_OK;
-            else if (value->type == VT_NULL)
+            switch (right->type)
             {
-                value->type = VT_UNDEF;
-                return STATUS_OK;
+                case VT_INT:
+                    if (value->type == VT_INT)
+                        value->v_int    = value->v_int * right->v_int;
+                    else
+                        value->v_float  = value->v_float * double(right->v_int);
+                    break;
+                case VT_FLOAT:
+                    if (value->type == VT_INT)
+                        value->v_float  = double(value->v_int) * right->v_float;
+                    else
+                        value->v_float  = value->v_float * right->v_float;
+                    value->type = VT_FLOAT;
+                    break;
+                case VT_NULL:
+                    value->type = VT_UNDEF;
+                    break;
+                case VT_UNDEF: break;
+                default: res = STATUS_BAD_TYPE; break;
             }
 
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
             if (res != STATUS_OK)
-            {
-                destroy_value(&right);
                 destroy_value(value);
-                return res;
-            }
+            destroy_value(right);
+
+            return res;
+        }
 
-            cast_numeric(&right);
+        status_t calc_div(value_t *value, value_t *right)
+        {
+            status_t res = STATUS_OK;
+            cast_numeric(right);
 
-            switch (right.type)
+            switch (right->type)
             {
                 case VT_INT:
                     if (value->type == VT_INT)
                     {
-                        if (right.v_int != 0)
-                            value->v_int    = value->v_int / right.v_int;
+                        if (right->v_int != 0)
+                            value->v_int    = value->v_int / right->v_int;
                         else
                             value->type     = VT_UNDEF;
                     }
                     else
-                        value->v_float  = value->v_float / double(right.v_int);
+                        value->v_float  = value->v_float / double(right->v_int);
                     break;
                 case VT_FLOAT:
                     if (value->type == VT_INT)
-                        value->v_float  = double(value->v_int) / right.v_float;
+                        value->v_float  = double(value->v_int) / right->v_float;
                     else
-                        value->v_float  = value->v_float / right.v_float;
+                        value->v_float  = value->v_float / right->v_float;
                     value->type = VT_FLOAT;
                     break;
                 case VT_NULL:
@@ -294,50 +297,30 @@ namespace lsp
 
             if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
+            destroy_value(right);
 
             return res;
         }
 
-        INT_OP(eval_iadd, + );
-        INT_OP(eval_isub, - );
-        INT_OP(eval_imul, * );
-        INT_OP(eval_idiv, / );
-        INT_OP(eval_bit_or, | );
-        INT_OP(eval_bit_and, & );
-        INT_OP(eval_bit_xor, ^ );
-
-        status_t eval_imod(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+        CALC_INT_OP(calc_iadd, + );
+        CALC_INT_OP(calc_isub, - );
+        CALC_INT_OP(calc_imul, * );
+        CALC_INT_OP(calc_bit_or, | );
+        CALC_INT_OP(calc_bit_and, & );
+        CALC_INT_OP(calc_bit_xor, ^ );
 
-            cast_int(value);
-            if (value->type == VT_UNDEF)
-                return STATUS_OK;
-            else if (value->type == VT_NULL)
-            {
-                value->type = VT_UNDEF;
-                return STATUS_OK;
-            }
+        #undef CALC_INT_OP
 
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
-            }
+        status_t calc_idiv(value_t *value, value_t *right)
+        {
+            status_t res = STATUS_OK;
 
-            cast_int(&right);
-            switch (right.type)
+            cast_int(right);
+            switch (right->type)
             {
                 case VT_INT:
-                    if (right.v_int != 0)
-                        value->v_int = value->v_int % right.v_int;
+                    if (right->v_int != 0)
+                        value->v_int = value->v_int / right->v_int;
                     else
                         value->type  = VT_UNDEF;
                     break;
@@ -348,40 +331,24 @@ namespace lsp
 
             if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
+            destroy_value(right);
 
             return res;
         }
 
-        status_t eval_fmod(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_imod(value_t *value, value_t *right)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
-            cast_float(value);
-            if (value->type == VT_UNDEF)
-                return STATUS_OK;
-            else if (value->type == VT_NULL)
-            {
-                value->type = VT_UNDEF;
-                return STATUS_OK;
-            }
-
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
-            }
+            status_t res = STATUS_OK;
 
-            cast_float(&right);
-            switch (right.type)
+            cast_int(right);
+            switch (right->type)
             {
-                case VT_FLOAT: value->v_float = fmod(value->v_float, right.v_float); break;
+                case VT_INT:
+                    if (right->v_int != 0)
+                        value->v_int = value->v_int % right->v_int;
+                    else
+                        value->type  = VT_UNDEF;
+                    break;
                 case VT_NULL: value->type = VT_UNDEF; break;
                 case VT_UNDEF: break;
                 default: res = STATUS_BAD_TYPE; break;
@@ -389,129 +356,100 @@ namespace lsp
 
             if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
+            destroy_value(right);
 
             return res;
         }
 
-        status_t eval_xor(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_fmod(value_t *value, value_t *right)
         {
-            // Test left argument
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
 
-            value_t right;
-            init_value(&right);
-            res = cast_bool(value);
-            if (res == STATUS_OK)
-                res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
+            cast_float(right);
+            switch (right->type)
             {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
+                case VT_FLOAT: value->v_float = fmod(value->v_float, right->v_float); break;
+                case VT_NULL: value->type = VT_UNDEF; break;
+                case VT_UNDEF: break;
+                default: res = STATUS_BAD_TYPE; break;
             }
 
-            // Test right argument
-            res = cast_bool(&right);
-            if (res == STATUS_OK)
-                value->v_bool = !(value->v_bool == right.v_bool);
-            else
+            if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
+            destroy_value(right);
 
             return res;
         }
 
-        status_t eval_or(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_power(value_t *value, value_t *right)
         {
-            // Test left argument
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
 
-            res = cast_bool(value);
-            if (res != STATUS_OK)
+            cast_float(right);
+            switch (right->type)
             {
-                destroy_value(value);
-                return res;
+                case VT_FLOAT:
+                    value->v_float  = ::pow(value->v_float, right->v_float);
+                    break;
+                case VT_NULL:
+                case VT_UNDEF:
+                    value->type = VT_UNDEF;
+                    break;
+                default:
+                    res = STATUS_BAD_TYPE;
+                    break;
             }
-            else if (value->v_bool)
-                return STATUS_OK;
-
-            // Test right argument
-            destroy_value(value);
-            res = expr->calc.right->eval(value, expr->calc.right, env);
-            if (res != STATUS_OK)
-                return res;
 
-            res = cast_bool(value);
+            destroy_value(right);
             if (res != STATUS_OK)
                 destroy_value(value);
 
             return res;
         }
 
-        status_t eval_and(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_xor(value_t *value, value_t *right)
         {
-            // Test left argument
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
-            res = cast_bool(value);
-            if (res != STATUS_OK)
-            {
+            status_t res = cast_bool(right);
+            if (res == STATUS_OK)
+                value->v_bool = !(value->v_bool == right->v_bool);
+            else
                 destroy_value(value);
-                return res;
-            }
-            else if (!value->v_bool)
-                return STATUS_OK;
+            destroy_value(right);
+
+            return res;
+        }
 
-            // Test right argument
+        status_t calc_select(value_t *value, value_t *right)
+        {
+            // The right operand becomes the result
             destroy_value(value);
-            res = expr->calc.right->eval(value, expr->calc.right, env);
-            if (res != STATUS_OK)
-                return res;
+            *value          = *right;
+            right->type     = VT_UNDEF;
+            right->v_str    = NULL;
 
-            res = cast_bool(value);
+            status_t res = cast_bool(value);
             if (res != STATUS_OK)
                 destroy_value(value);
 
             return res;
         }
 
-        status_t eval_cmp(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_cmp(value_t *value, value_t *right)
         {
-            // Fetch left argument and test for UNDEF
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
-            // Fetch right argument and test for UNDEF
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
-            }
+            status_t res = STATUS_OK;
 
             if (value->type == VT_UNDEF)
             {
                 value->type     = VT_INT;
-                value->v_int    = (right.type == VT_UNDEF) ? 0 : -1;
-                destroy_value(&right);
+                value->v_int    = (right->type == VT_UNDEF) ? 0 : -1;
+                destroy_value(right);
                 return STATUS_OK;
             }
-            else if (right.type == VT_UNDEF)
+            else if (right->type == VT_UNDEF)
             {
                 value->type     = VT_INT;
                 value->v_int    = 1;
-                destroy_value(&right);
+                destroy_value(right);
                 return STATUS_OK;
             }
 
@@ -519,15 +457,15 @@ namespace lsp
             if (value->type == VT_NULL)
             {
                 value->type     = VT_INT;
-                value->v_int    = (right.type == VT_NULL) ? 0 : -1;
-                destroy_value(&right);
+                value->v_int    = (right->type == VT_NULL) ? 0 : -1;
+                destroy_value(right);
                 return STATUS_OK;
             }
-            else if (right.type == VT_NULL)
+            else if (right->type == VT_NULL)
             {
                 value->type     = VT_INT;
                 value->v_int    = 1;
-                destroy_value(&right);
+                destroy_value(right);
                 return STATUS_OK;
             }
 
@@ -536,19 +474,19 @@ namespace lsp
             {
                 case VT_INT:
                 {
-                    switch (right.type)
+                    switch (right->type)
                     {
                         case VT_INT:
                             value->type     = VT_INT;
                             value->v_int    =
-                                    (value->v_int < right.v_int) ? -1 :
-                                    (value->v_int > right.v_int) ? 1 : 0;
+                                    (value->v_int < right->v_int) ? -1 :
+                                    (value->v_int > right->v_int) ? 1 : 0;
                             break;
                         case VT_FLOAT:
                             value->type     = VT_INT;
                             value->v_int    =
-                                    (double(value->v_int) < right.v_float) ? -1 :
-                                    (double(value->v_int) > right.v_float) ? 1 : 0;
+                                    (double(value->v_int) < right->v_float) ? -1 :
+                                    (double(value->v_int) > right->v_float) ? 1 : 0;
                             break;
                         case VT_BOOL:
                         {
@@ -564,7 +502,7 @@ namespace lsp
                             res = cast_string(value);
                             if (res == STATUS_OK)
                             {
-                                ssize_t ivalue  = value->v_str->compare_to(right.v_str);
+                                ssize_t ivalue  = value->v_str->compare_to(right->v_str);
                                 destroy_value(value);
                                 value->type     = VT_INT;
                                 value->v_int    = ivalue;
@@ -579,19 +517,19 @@ namespace lsp
                 }
                 case VT_FLOAT:
                 {
-                    switch (right.type)
+                    switch (right->type)
                     {
                         case VT_INT:
                             value->type     = VT_INT;
                             value->v_int    =
-                                    (value->v_float < right.v_int) ? -1 :
-                                    (value->v_float > right.v_int) ? 1 : 0;
+                                    (value->v_float < right->v_int) ? -1 :
+                                    (value->v_float > right->v_int) ? 1 : 0;
                             break;
                         case VT_FLOAT:
                             value->type     = VT_INT;
                             value->v_int    =
-                                    (value->v_float < right.v_float) ? -1 :
-                                    (value->v_float > right.v_float) ? 1 : 0;
+                                    (value->v_float < right->v_float) ? -1 :
+                                    (value->v_float > right->v_float) ? 1 : 0;
                             break;
                         case VT_BOOL:
                         {
@@ -607,7 +545,7 @@ namespace lsp
                             res = cast_string(value);
                             if (res == STATUS_OK)
                             {
-                                ssize_t ivalue  = value->v_str->compare_to(right.v_str);
+                                ssize_t ivalue  = value->v_str->compare_to(right->v_str);
                                 destroy_value(value);
                                 value->type     = VT_INT;
                                 value->v_int    = ivalue;
@@ -624,19 +562,19 @@ namespace lsp
                 case VT_BOOL:
                 {
                     ssize_t xvalue = (value->v_bool) ? 1 : 0;
-                    switch (right.type)
+                    switch (right->type)
                     {
                         case VT_INT:
                             value->type     = VT_INT;
                             value->v_int    =
-                                    (xvalue < right.v_int) ? -1 :
-                                    (xvalue > right.v_int) ? 1 : 0;
+                                    (xvalue < right->v_int) ? -1 :
+                                    (xvalue > right->v_int) ? 1 : 0;
                             break;
                         case VT_FLOAT:
                             value->type     = VT_INT;
                             value->v_int    =
-                                    (xvalue < right.v_float) ? -1 :
-                                    (xvalue > right.v_float) ? 1 : 0;
+                                    (xvalue < right->v_float) ? -1 :
+                                    (xvalue > right->v_float) ? 1 : 0;
                             break;
                         case VT_BOOL:
                         {
@@ -652,7 +590,7 @@ namespace lsp
                             res = cast_string(value);
                             if (res == STATUS_OK)
                             {
-                                ssize_t ivalue  = value->v_str->compare_to(right.v_str);
+                                ssize_t ivalue  = value->v_str->compare_to(right->v_str);
                                 destroy_value(value);
                                 value->type     = VT_INT;
                                 value->v_int    = ivalue;
@@ -668,10 +606,10 @@ namespace lsp
 
                 case VT_STRING:
                 {
-                    res = cast_string(&right);
+                    res = cast_string(right);
                     if (res == STATUS_OK)
                     {
-                        ssize_t ivalue  = value->v_str->compare_to(right.v_str);
+                        ssize_t ivalue  = value->v_str->compare_to(right->v_str);
                         destroy_value(value);
                         value->type     = VT_INT;
                         value->v_int    = ivalue;
@@ -686,129 +624,27 @@ namespace lsp
 
             if (res != STATUS_OK)
                 destroy_value(value);
-            destroy_value(&right);
-
-            return res;
-        }
-
-        status_t eval_cmp_eq(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_cmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int == 0);
-            }
-
-            return res;
-        }
-
-        status_t eval_cmp_ne(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_cmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int != 0);
-            }
-
-            return res;
-        }
-
-        status_t eval_cmp_lt(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_cmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int < 0);
-            }
-
-            return res;
-        }
-
-        status_t eval_cmp_gt(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_cmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int > 0);
-            }
-
-            return res;
-        }
-
-        status_t eval_cmp_le(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_cmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int <= 0);
-            }
-
-            return res;
-        }
-
-        status_t eval_cmp_ge(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_cmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int >= 0);
-            }
+            destroy_value(right);
 
             return res;
         }
 
-
-
-        status_t eval_icmp(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_icmp(value_t *value, value_t *right)
         {
-            // Fetch left argument and test for UNDEF
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
-            // Fetch right argument and test for UNDEF
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
-            }
-
             cast_int(value);
-            cast_int(&right);
+            cast_int(right);
             if (value->type == VT_UNDEF)
             {
                 value->type     = VT_INT;
-                value->v_int    = (right.type == VT_UNDEF) ? 0 : -1;
-                destroy_value(&right);
+                value->v_int    = (right->type == VT_UNDEF) ? 0 : -1;
+                destroy_value(right);
                 return STATUS_OK;
             }
-            else if (right.type == VT_UNDEF)
+            else if (right->type == VT_UNDEF)
             {
                 value->type     = VT_INT;
                 value->v_int    = 1;
-                destroy_value(&right);
+                destroy_value(right);
                 return STATUS_OK;
             }
 
@@ -816,164 +652,125 @@ namespace lsp
             if (value->type == VT_NULL)
             {
                 value->type     = VT_INT;
-                value->v_int    = (right.type == VT_NULL) ? 0 : -1;
-                destroy_value(&right);
+                value->v_int    = (right->type == VT_NULL) ? 0 : -1;
+                destroy_value(right);
                 return STATUS_OK;
             }
-            else if (right.type == VT_NULL)
+            else if (right->type == VT_NULL)
             {
                 value->type     = VT_INT;
                 value->v_int    = 1;
-                destroy_value(&right);
+                destroy_value(right);
                 return STATUS_OK;
             }
 
             // Perform compare
             value->v_int =
-                    (value->v_int < right.v_int) ? -1 :
-                    (value->v_int > right.v_int) ? 1 : 0;
+                    (value->v_int < right->v_int) ? -1 :
+                    (value->v_int > right->v_int) ? 1 : 0;
+            destroy_value(right);
             return STATUS_OK;
         }
 
-        status_t eval_icmp_eq(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_icmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int == 0);
-            }
-
-            return res;
-        }
-
-        status_t eval_icmp_ne(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_icmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int != 0);
+        #define CALC_CMP_OP(calc_name, cmp_func, oper) \
+            status_t calc_name(value_t *value, value_t *right) \
+            { \
+                status_t res = cmp_func(value, right); \
+                if (res != STATUS_OK) \
+                    return res; \
+                if (value->type == VT_INT) \
+                { \
+                    value->type     = VT_BOOL; \
+                    value->v_bool   = (value->v_int oper 0); \
+                } \
+                \
+                return res; \
             }
 
-            return res;
-        }
+        CALC_CMP_OP(calc_cmp_eq, calc_cmp, == );
+        CALC_CMP_OP(calc_cmp_ne, calc_cmp, != );
+        CALC_CMP_OP(calc_cmp_lt, calc_cmp, < );
+        CALC_CMP_OP(calc_cmp_gt, calc_cmp, > );
+        CALC_CMP_OP(calc_cmp_le, calc_cmp, <= );
+        CALC_CMP_OP(calc_cmp_ge, calc_cmp, >= );
 
-        status_t eval_icmp_lt(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_icmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int < 0);
-            }
+        CALC_CMP_OP(calc_icmp_eq, calc_icmp, == );
+        CALC_CMP_OP(calc_icmp_ne, calc_icmp, != );
+        CALC_CMP_OP(calc_icmp_lt, calc_icmp, < );
+        CALC_CMP_OP(calc_icmp_gt, calc_icmp, > );
+        CALC_CMP_OP(calc_icmp_le, calc_icmp, <= );
+        CALC_CMP_OP(calc_icmp_ge, calc_icmp, >= );
 
-            return res;
-        }
+        #undef CALC_CMP_OP
 
-        status_t eval_icmp_gt(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_strcat(value_t *value, value_t *right)
         {
-            status_t res = eval_icmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
+            status_t res;
+            if ((res = cast_string_ext(right)) != STATUS_OK)
             {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int > 0);
-            }
-
-            return res;
-        }
-
-        status_t eval_icmp_le(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_icmp(value, expr, env);
-            if (res != STATUS_OK)
+                destroy_value(value);
+                destroy_value(right);
                 return res;
-            if (value->type == VT_INT)
-            {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int <= 0);
             }
 
-            return res;
-        }
-
-        status_t eval_icmp_ge(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = eval_icmp(value, expr, env);
-            if (res != STATUS_OK)
-                return res;
-            if (value->type == VT_INT)
+            if (!value->v_str->append(right->v_str))
             {
-                value->type     = VT_BOOL;
-                value->v_bool   = (value->v_int >= 0);
+                destroy_value(value);
+                res = STATUS_NO_MEM;
             }
+            destroy_value(right);
 
             return res;
         }
 
-        status_t eval_power(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_strrep(value_t *value, value_t *right)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
 
-            value_t right;
-            init_value(&right);
-            cast_float(value);
-            switch (value->type)
+            cast_int(right);
+            if ((right->type == VT_NULL) || (right->type == VT_UNDEF) || (right->v_int < 0))
             {
-                case VT_FLOAT:
-                    res = expr->calc.right->eval(&right, expr->calc.right, env);
-                    break;
-                case VT_NULL:
-                    value->type = VT_UNDEF;
-                    return STATUS_OK;
-                case VT_UNDEF:
-                    return STATUS_OK;
-                default:
-                    res = STATUS_BAD_TYPE;
-                    break;
+                destroy_value(right);
+                destroy_value(value);
+                return STATUS_OK;
             }
 
-            if (res == STATUS_OK)
+            // Perform string repeat
+            LSPString tmp;
+            tmp.swap(value->v_str);
+            size_t x = right->v_int;
+            while (x)
             {
-                cast_float(&right);
-                switch (right.type)
+                if (x & 1)
                 {
-                    case VT_FLOAT:
-                        value->v_float  = ::pow(value->v_float, right.v_float);
-                        break;
-                    case VT_NULL:
-                    case VT_UNDEF:
-                        value->type = VT_UNDEF;
+                    if (!value->v_str->append(&tmp))
+                    {
+                        res = STATUS_NO_MEM;
                         break;
-                    default:
-                        res = STATUS_BAD_TYPE;
+                    }
+                }
+                if (x >>= 1)
+                {
+                    if (!tmp.append(&tmp))
+                    {
+                        res = STATUS_NO_MEM;
                         break;
+                    }
                 }
             }
 
-            destroy_value(&right);
             if (res != STATUS_OK)
                 destroy_value(value);
+            destroy_value(right);
 
             return res;
         }
 
-        status_t eval_neg(value_t *value, const expr_t *expr, eval_env_t *env)
+        //---------------------------------------------------------------------
+        // Unary operations
+        status_t calc_neg(value_t *value)
         {
-            status_t res =  expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
+            status_t res = STATUS_OK;
             if (value->type == VT_STRING)
                 cast_numeric(value);
 
@@ -1007,11 +804,9 @@ namespace lsp
             return res;
         }
 
-        status_t eval_not(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_not(value_t *value)
         {
-            status_t res =  expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
 
             cast_bool(value);
             switch (value->type)
@@ -1035,16 +830,9 @@ namespace lsp
             return res;
         }
 
-        status_t eval_psign(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_nsign(value_t *value)
         {
-            return  expr->calc.left->eval(value, expr->calc.left, env);
-        }
-
-        status_t eval_nsign(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res =  expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
 
             cast_numeric(value);
             switch (value->type)
@@ -1073,12 +861,8 @@ namespace lsp
             return res;
         }
 
-        status_t eval_exists(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_exists(value_t *value)
         {
-            status_t res    =  expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-
             bool exists     = value->type != VT_UNDEF;
             destroy_value(value);
 
@@ -1088,11 +872,9 @@ namespace lsp
             return STATUS_OK;
         }
 
-        status_t eval_db(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_db(value_t *value)
         {
-            status_t res =  expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
 
             cast_float(value);
             switch (value->type)
@@ -1116,191 +898,10 @@ namespace lsp
             return res;
         }
 
-        status_t eval_resolve(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res;
-            if (env == NULL)
-            {
-                value->type     = VT_UNDEF;
-                value->v_str    = NULL;
-                return STATUS_OK;
-            }
-
-            // No indexes? Do simple stuff
-            if (expr->resolve.count <= 0)
-            {
-                res = env->resolve(value, expr->resolve.name, 0, NULL);
-                if (res != STATUS_NOT_FOUND)
-                    return res;
-
-                value->type     = VT_UNDEF;
-                value->v_str    = NULL;
-                return STATUS_OK;
-            }
-
-            // Compute index values
-            ssize_t *indexes = reinterpret_cast<ssize_t *>(::malloc(expr->resolve.count * sizeof(ssize_t)));
-            if (indexes == NULL)
-                return STATUS_NO_MEM;
-
-            value_t tmp;
-            init_value(&tmp);
-            for (size_t i=0; i<expr->resolve.count; ++i)
-            {
-                expr_t *e = expr->resolve.items[i];
-
-                // Evaluate and store index
-                res = e->eval(&tmp, e, env);
-                if (res == STATUS_OK)
-                {
-                    res = cast_int(&tmp);
-                    if (res == STATUS_OK)
-                        indexes[i] = tmp.v_int;
-                    destroy_value(&tmp);
-                }
-
-                // All is OK?
-                if (res != STATUS_OK)
-                {
-                    ::free(indexes);
-                    destroy_value(&tmp);
-                    return res;
-                }
-            }
-
-            // Now we can resolve values
-            res = env->resolve(value, expr->resolve.name, expr->resolve.count, indexes);
-            ::free(indexes);
-            destroy_value(&tmp);
-
-            return res;
-        }
-
-        status_t eval_value(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            return copy_value(value, &expr->value);
-        }
-
-        status_t eval_ternary(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = expr->calc.cond->eval(value, expr->calc.cond, env);
-            if (res != STATUS_OK)
-                return res;
-            cast_bool(value);
-            if ((value->type) != VT_BOOL)
-            {
-                destroy_value(value);
-                return STATUS_OK;
-            }
-
-            // Determine which expression to execute
-            expr = (value->v_bool) ? expr->calc.left : expr->calc.right;
-
-            destroy_value(value);
-            return expr->eval(value, expr, env);
-        }
-
-        status_t eval_strcat(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-            if ((res = cast_string_ext(value)) != STATUS_OK)
-            {
-                destroy_value(value);
-                return res;
-            }
-
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
-            }
-            if ((res = cast_string_ext(&right)) != STATUS_OK)
-            {
-                destroy_value(value);
-                destroy_value(&right);
-                return res;
-            }
-
-            if (!value->v_str->append(right.v_str))
-            {
-                destroy_value(value);
-                res = STATUS_NO_MEM;
-            }
-            destroy_value(&right);
-
-            return res;
-        }
-
-        status_t eval_strrep(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_strupper(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
-            if ((res = cast_string_ext(value)) != STATUS_OK)
-            {
-                destroy_value(value);
-                return res;
-            }
-
-            value_t right;
-            init_value(&right);
-            res = expr->calc.right->eval(&right, expr->calc.right, env);
-            if (res != STATUS_OK)
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return res;
-            }
-            cast_int(&right);
-            if ((right.type == VT_NULL) || (right.type == VT_UNDEF) || (right.v_int < 0))
-            {
-                destroy_value(&right);
-                destroy_value(value);
-                return STATUS_OK;
-            }
+            status_t res = STATUS_OK;
 
-            // Perform string repeat
-            LSPString tmp;
-            tmp.swap(value->v_str);
-            size_t x = right.v_int;
-            while (x)
-            {
-                if (x & 1)
-                {
-                    if (!value->v_str->append(&tmp))
-                    {
-                        res = STATUS_NO_MEM;
-                        break;
-                    }
-                }
-                if (x >>= 1)
-                {
-                    if (!tmp.append(&tmp))
-                    {
-                        res = STATUS_NO_MEM;
-                        break;
-                    }
-                }
-            }
-
-            if (res != STATUS_OK)
-                destroy_value(value);
-            destroy_value(&right);
-
-            return res;
-        }
-
-        status_t eval_strupper(value_t *value, const expr_t *expr, eval_env_t *env)
-        {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
             cast_string(value);
             switch (value->type)
             {
@@ -1323,11 +924,10 @@ namespace lsp
             return res;
         }
 
-        status_t eval_strlower(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_strlower(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
+
             cast_string(value);
             switch (value->type)
             {
@@ -1350,11 +950,10 @@ namespace lsp
             return res;
         }
 
-        status_t eval_strlen(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_strlen(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
+
             cast_string(value);
             switch (value->type)
             {
@@ -1382,11 +981,10 @@ namespace lsp
             return res;
         }
 
-        status_t eval_strrev(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_strrev(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res = STATUS_OK;
+
             cast_string(value);
             switch (value->type)
             {
@@ -1411,58 +1009,241 @@ namespace lsp
             return res;
         }
 
-        status_t eval_int_cast(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_int_cast(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
+            status_t res = cast_int(value);
             if (res != STATUS_OK)
-                return res;
+                destroy_value(value);
 
-            res = cast_int(value);
+            return res;
+        }
+
+        status_t calc_float_cast(value_t *value)
+        {
+            status_t res = cast_float(value);
             if (res != STATUS_OK)
                 destroy_value(value);
 
             return res;
         }
 
-        status_t eval_float_cast(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t calc_string_cast(value_t *value)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
+            status_t res = cast_string(value);
             if (res != STATUS_OK)
-                return res;
+                destroy_value(value);
+
+            return res;
+        }
 
-            res = cast_float(value);
+        status_t calc_bool_cast(value_t *value)
+        {
+            status_t res = cast_bool(value);
             if (res != STATUS_OK)
                 destroy_value(value);
 
             return res;
         }
 
-        status_t eval_string_cast(value_t *value, const expr_t *expr, eval_env_t *env)
+        //---------------------------------------------------------------------
+        // Tree evaluators
+        #define EVAL_BINARY(eval_name, guard_func, calc_func) \
+            status_t eval_name(value_t *value, const expr_t *expr, eval_env_t *env) \
+            { \
+                status_t res = expr->calc.left->eval(value, expr->calc.left, env); \
+                if (res != STATUS_OK) \
+                    return res; \
+                \
+                res = guard_func(value); \
+                if (res != STATUS_OK) \
+                    return (res == STATUS_SKIP) ? STATUS_OK : res; \
+                \
+                value_t right; \
+                init_value(&right); \
+                res = expr->calc.right->eval(&right, expr->calc.right, env); \
+                if (res != STATUS_OK) \
+                { \
+                    destroy_value(&right); \
+                    destroy_value(value); \
+                    return res; \
+                } \
+                \
+                return calc_func(value, &right); \
+            }
+
+        #define EVAL_COMPARE(eval_name, calc_func) \
+            status_t eval_name(value_t *value, const expr_t *expr, eval_env_t *env) \
+            { \
+                status_t res = expr->calc.left->eval(value, expr->calc.left, env); \
+                if (res != STATUS_OK) \
+                    return res; \
+                \
+                value_t right; \
+                init_value(&right); \
+                res = expr->calc.right->eval(&right, expr->calc.right, env); \
+                if (res != STATUS_OK) \
+                { \
+                    destroy_value(&right); \
+                    destroy_value(value); \
+                    return res; \
+                } \
+                \
+                return calc_func(value, &right); \
+            }
+
+        #define EVAL_UNARY(eval_name, calc_func) \
+            status_t eval_name(value_t *value, const expr_t *expr, eval_env_t *env) \
+            { \
+                status_t res = expr->calc.left->eval(value, expr->calc.left, env); \
+                if (res != STATUS_OK) \
+                    return res; \
+                \
+                return calc_func(value); \
+            }
+
+        EVAL_BINARY(eval_add, guard_numeric, calc_add);
+        EVAL_BINARY(eval_sub, guard_numeric, calc_sub);
+        EVAL_BINARY(eval_mul, guard_numeric, calc_mul);
+        EVAL_BINARY(eval_div, guard_numeric, calc_div);
+        EVAL_BINARY(eval_iadd, guard_int, calc_iadd);
+        EVAL_BINARY(eval_isub, guard_int, calc_isub);
+        EVAL_BINARY(eval_imul, guard_int, calc_imul);
+        EVAL_BINARY(eval_idiv, guard_int, calc_idiv);
+        EVAL_BINARY(eval_bit_or, guard_int, calc_bit_or);
+        EVAL_BINARY(eval_bit_and, guard_int, calc_bit_and);
+        EVAL_BINARY(eval_bit_xor, guard_int, calc_bit_xor);
+        EVAL_BINARY(eval_imod, guard_int, calc_imod);
+        EVAL_BINARY(eval_fmod, guard_float, calc_fmod);
+        EVAL_BINARY(eval_power, guard_power, calc_power);
+        EVAL_BINARY(eval_xor, guard_bool, calc_xor);
+        EVAL_BINARY(eval_or, guard_or, calc_select);
+        EVAL_BINARY(eval_and, guard_and, calc_select);
+        EVAL_BINARY(eval_strcat, guard_string, calc_strcat);
+        EVAL_BINARY(eval_strrep, guard_string, calc_strrep);
+
+        EVAL_COMPARE(eval_cmp, calc_cmp);
+        EVAL_COMPARE(eval_cmp_eq, calc_cmp_eq);
+        EVAL_COMPARE(eval_cmp_ne, calc_cmp_ne);
+        EVAL_COMPARE(eval_cmp_lt, calc_cmp_lt);
+        EVAL_COMPARE(eval_cmp_gt, calc_cmp_gt);
+        EVAL_COMPARE(eval_cmp_le, calc_cmp_le);
+        EVAL_COMPARE(eval_cmp_ge, calc_cmp_ge);
+        EVAL_COMPARE(eval_icmp, calc_icmp);
+        EVAL_COMPARE(eval_icmp_eq, calc_icmp_eq);
+        EVAL_COMPARE(eval_icmp_ne, calc_icmp_ne);
+        EVAL_COMPARE(eval_icmp_lt, calc_icmp_lt);
+        EVAL_COMPARE(eval_icmp_gt, calc_icmp_gt);
+        EVAL_COMPARE(eval_icmp_le, calc_icmp_le);
+        EVAL_COMPARE(eval_icmp_ge, calc_icmp_ge);
+
+        EVAL_UNARY(eval_neg, calc_neg);
+        EVAL_UNARY(eval_not, calc_not);
+        EVAL_UNARY(eval_nsign, calc_nsign);
+        EVAL_UNARY(eval_exists, calc_exists);
+        EVAL_UNARY(eval_db, calc_db);
+        EVAL_UNARY(eval_strupper, calc_strupper);
+        EVAL_UNARY(eval_strlower, calc_strlower);
+        EVAL_UNARY(eval_strlen, calc_strlen);
+        EVAL_UNARY(eval_strrev, calc_strrev);
+        EVAL_UNARY(eval_int_cast, calc_int_cast);
+        EVAL_UNARY(eval_float_cast, calc_float_cast);
+        EVAL_UNARY(eval_string_cast, calc_string_cast);
+        EVAL_UNARY(eval_bool_cast, calc_bool_cast);
+
+        #undef EVAL_BINARY
+        #undef EVAL_COMPARE
+        #undef EVAL_UNARY
+
+        status_t eval_psign(value_t *value, const expr_t *expr, eval_env_t *env)
+        {
+            return  expr->calc.left->eval(value, expr->calc.left, env);
+        }
+
+        status_t eval_resolve(value_t *value, const expr_t *expr, eval_env_t *env)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
-            if (res != STATUS_OK)
-                return res;
+            status_t res;
+            if (env == NULL)
+            {
+                value->type     = VT_UNDEF;
+                value->v_str    = NULL;
+                return STATUS_OK;
+            }
 
-            res = cast_string(value);
-            if (res != STATUS_OK)
-                destroy_value(value);
+            // No indexes? Do simple stuff
+            if (expr->resolve.count <= 0)
+            {
+                res = env->resolve(value, expr->resolve.name, 0, NULL);
+                if (res != STATUS_NOT_FOUND)
+                    return res;
+
+                value->type     = VT_UNDEF;
+                value->v_str    = NULL;
+                return STATUS_OK;
+            }
+
+            // Compute index values, use the heap only for extremely long index lists
+            ssize_t inline_indexes[INLINE_INDEXES];
+            ssize_t *indexes = inline_indexes;
+            if (expr->resolve.count > INLINE_INDEXES)
+            {
+                indexes = reinterpret_cast<ssize_t *>(::malloc(expr->resolve.count * sizeof(ssize_t)));
+                if (indexes == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            value_t tmp;
+            init_value(&tmp);
+            for (size_t i=0; i<expr->resolve.count; ++i)
+            {
+                expr_t *e = expr->resolve.items[i];
+
+                // Evaluate and store index
+                res = e->eval(&tmp, e, env);
+                if (res == STATUS_OK)
+                {
+                    res = cast_int(&tmp);
+                    if (res == STATUS_OK)
+                        indexes[i] = tmp.v_int;
+                    destroy_value(&tmp);
+                }
+
+                // All is OK?
+                if (res != STATUS_OK)
+                {
+                    if (indexes != inline_indexes)
+                        ::free(indexes);
+                    destroy_value(&tmp);
+                    return res;
+                }
+            }
+
+            // Now we can resolve values
+            res = env->resolve(value, expr->resolve.name, expr->resolve.count, indexes);
+            if (indexes != inline_indexes)
+                ::free(indexes);
+            destroy_value(&tmp);
 
             return res;
         }
 
-        status_t eval_bool_cast(value_t *value, const expr_t *expr, eval_env_t *env)
+        status_t eval_value(value_t *value, const expr_t *expr, eval_env_t *env)
         {
-            status_t res = expr->calc.left->eval(value, expr->calc.left, env);
+            return copy_value(value, &expr->value);
+        }
+
+        status_t eval_ternary(value_t *value, const expr_t *expr, eval_env_t *env)
+        {
+            status_t res = expr->calc.cond->eval(value, expr->calc.cond, env);
             if (res != STATUS_OK)
                 return res;
+            if (guard_ternary(value) != STATUS_OK)
+                return STATUS_OK;
 
-            res = cast_bool(value);
-            if (res != STATUS_OK)
-                destroy_value(value);
+            // Determine which expression to execute
+            expr = (value->v_bool) ? expr->calc.left : expr->calc.right;
 
-            return res;
+            destroy_value(value);
+            return expr->eval(value, expr, env);
         }
     }
 }
-
-
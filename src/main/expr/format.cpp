@@ -20,6 +20,7 @@
  */
 
 #include <lsp-plug.in/expr/format.h>
+#include <lsp-plug.in/expr/FormatTemplate.h>
 #include <lsp-plug.in/expr/Tokenizer.h>
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/io/OutStringSequence.h>
@@ -831,7 +832,7 @@ namespace lsp
             return (success) ? STATUS_OK : STATUS_NO_MEM;
         }
 
-        status_t emit_parameter(io::IOutSequence *out, fmt_spec_t *spec, const Parameters *r)
+        status_t render_parameter(fmt_spec_t *spec, const Parameters *r, ssize_t *left, ssize_t *right)
         {
             value_t v;
             init_value(&v);
@@ -905,11 +906,9 @@ namespace lsp
                     break;
             }
 
+            destroy_value(&v);
             if (res != STATUS_OK)
-            {
-                destroy_value(&v);
                 return res;
-            }
 
             // Compute padding
             ssize_t lpad = 0, rpad = 0, pad = ssize_t(lsp_max(spec->width, spec->xwidth)) - ssize_t(spec->buf.length());
@@ -945,33 +944,63 @@ namespace lsp
                 }
             }
 
+            *left   = lpad;
+            *right  = rpad;
+
+            return STATUS_OK;
+        }
+
+        status_t emit_parameter(io::IOutSequence *out, fmt_spec_t *spec, const Parameters *r)
+        {
+            ssize_t lpad, rpad;
+            status_t res = render_parameter(spec, r, &lpad, &rpad);
+            if (res != STATUS_OK)
+                return res;
+
             // Emit value
             while (lpad--)
             {
                 if ((res = out->write(spec->lpad)) != STATUS_OK)
-                {
-                    destroy_value(&v);
                     return res;
-                }
             }
             if ((res = out->write(&spec->buf)) != STATUS_OK)
-            {
-                destroy_value(&v);
                 return res;
-            }
             while (rpad--)
             {
                 if ((res = out->write(spec->rpad)) != STATUS_OK)
-                {
-                    destroy_value(&v);
                     return res;
-                }
             }
 
-            destroy_value(&v);
             return res;
         }
 
+        status_t append_parameter(LSPString *out, fmt_spec_t *spec, const Parameters *r)
+        {
+            ssize_t lpad, rpad;
+            status_t res = render_parameter(spec, r, &lpad, &rpad);
+            if (res != STATUS_OK)
+                return res;
+
+            if (!out->reserve(out->length() + lpad + spec->buf.length() + rpad))
+                return STATUS_NO_MEM;
+
+            // Emit value
+            while (lpad--)
+            {
+                if (!out->append(spec->lpad))
+                    return STATUS_NO_MEM;
+            }
+            if (!out->append(&spec->buf))
+                return STATUS_NO_MEM;
+            while (rpad--)
+            {
+                if (!out->append(spec->rpad))
+                    return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
         status_t format(io::IOutSequence *out, io::IInSequence *fmt, const Parameters *r)
         {
             if ((out == NULL) || (fmt == NULL))
@@ -1045,6 +1074,274 @@ namespace lsp
                 } // c
             }
         }
+
+        FormatTemplate::FormatTemplate()
+        {
+        }
+
+        FormatTemplate::~FormatTemplate()
+        {
+            clear();
+        }
+
+        void FormatTemplate::clear()
+        {
+            for (size_t i=0, n=vSegments.size(); i<n; ++i)
+            {
+                segment_t *seg = vSegments.uget(i);
+                if (seg == NULL)
+                    continue;
+                if (seg->spec != NULL)
+                    delete seg->spec;
+                delete seg;
+            }
+            vSegments.flush();
+        }
+
+        status_t FormatTemplate::add_literal(LSPString *text)
+        {
+            if (text->length() <= 0)
+                return STATUS_OK;
+
+            segment_t *seg = new segment_t;
+            if (seg == NULL)
+                return STATUS_NO_MEM;
+            seg->spec       = NULL;
+            seg->text.swap(text);
+
+            if (!vSegments.add(seg))
+            {
+                delete seg;
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t FormatTemplate::add_specifier(const fmt_spec_t *spec)
+        {
+            segment_t *seg = new segment_t;
+            if (seg == NULL)
+                return STATUS_NO_MEM;
+            if ((seg->spec = new fmt_spec_t) == NULL)
+            {
+                delete seg;
+                return STATUS_NO_MEM;
+            }
+
+            fmt_spec_t *dst = seg->spec;
+            init_spec(dst, spec->index);
+            dst->flags      = spec->flags;
+            dst->lpad       = spec->lpad;
+            dst->rpad       = spec->rpad;
+            dst->align      = spec->align;
+            dst->type       = spec->type;
+            dst->width      = spec->width;
+            dst->xwidth     = spec->xwidth;
+            dst->frac       = spec->frac;
+
+            if ((!dst->name.set(&spec->name)) || (!vSegments.add(seg)))
+            {
+                delete dst;
+                delete seg;
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t FormatTemplate::parse(const char *fmt)
+        {
+            if (fmt == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            io::InStringSequence xfmt;
+            status_t res = xfmt.wrap(fmt);
+            if (res != STATUS_OK)
+            {
+                xfmt.close();
+                return res;
+            }
+
+            res = parse(&xfmt);
+            if (res != STATUS_OK)
+            {
+                xfmt.close();
+                return res;
+            }
+
+            return xfmt.close();
+        }
+
+        status_t FormatTemplate::parse(const LSPString *fmt)
+        {
+            if (fmt == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            io::InStringSequence xfmt;
+            status_t res = xfmt.wrap(fmt);
+            if (res != STATUS_OK)
+            {
+                xfmt.close();
+                return res;
+            }
+
+            res = parse(&xfmt);
+            if (res != STATUS_OK)
+            {
+                xfmt.close();
+                return res;
+            }
+
+            return xfmt.close();
+        }
+
+        status_t FormatTemplate::parse(io::IInSequence *fmt)
+        {
+            if (fmt == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            clear();
+
+            // Literal text is collected into the buffer, malformed specifiers
+            // are also written there by read_specifier() as is
+            LSPString text;
+            io::OutStringSequence out;
+            status_t res = out.wrap(&text, false);
+            if (res != STATUS_OK)
+            {
+                out.close();
+                return res;
+            }
+
+            size_t index = 0;
+            bool protector = false;
+            fmt_spec_t spec;
+            init_spec(&spec, index);
+
+            while (res == STATUS_OK)
+            {
+                // Read character
+                lsp_swchar_t c = fmt->read();
+                if (c < 0)
+                {
+                    if (c != -STATUS_EOF)
+                        res = -c;
+                    else if ((res = add_literal(&text)) == STATUS_OK)
+                        break;
+                    continue;
+                }
+
+                switch (c)
+                {
+                    case '\\':
+                        if (protector)
+                            res = out.write('\\');
+                        protector = !protector;
+                        break;
+
+                    case '{':
+                        if (protector)
+                        {
+                            res = out.write('{');
+                            protector = false;
+                        }
+                        else
+                        {
+                            // Read specifier and store it as a segment
+                            res = read_specifier(&out, fmt, &spec);
+                            if (res == STATUS_OK)
+                            {
+                                if ((res = add_literal(&text)) == STATUS_OK)
+                                    res = add_specifier(&spec);
+
+                                // Reset specifier
+                                if (!(spec.flags & (F_NAME | F_INDEX)))
+                                    ++index;
+                            }
+                            else if (res == STATUS_BAD_FORMAT)
+                                res = STATUS_OK;
+                            init_spec(&spec, index);
+                        }
+                        break;
+                    case '}':
+                        protector = false;
+                        res = out.write('}');
+                        break;
+
+                    default:
+                        if (protector)
+                        {
+                            res = out.write('\\');
+                            protector = false;
+                        }
+                        if (res == STATUS_OK)
+                            res = out.write(c);
+                        break;
+                } // c
+            }
+
+            out.close();
+            if (res != STATUS_OK)
+                clear();
+
+            return res;
+        }
+
+        status_t FormatTemplate::format(LSPString *out, const Parameters *r)
+        {
+            if (out == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            out->set_length(0);
+            return append(out, r);
+        }
+
+        status_t FormatTemplate::append(LSPString *out, const Parameters *r)
+        {
+            if (out == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            size_t len = out->length();
+            status_t res = STATUS_OK;
+
+            for (size_t i=0, n=vSegments.size(); i<n; ++i)
+            {
+                segment_t *seg = vSegments.uget(i);
+                if (seg->spec != NULL)
+                    res = append_parameter(out, seg->spec, r);
+                else if (!out->append(&seg->text))
+                    res = STATUS_NO_MEM;
+
+                if (res != STATUS_OK)
+                {
+                    out->set_length(len);
+                    return res;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t FormatTemplate::format(io::IOutSequence *out, const Parameters *r)
+        {
+            if (out == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res;
+            for (size_t i=0, n=vSegments.size(); i<n; ++i)
+            {
+                segment_t *seg = vSegments.uget(i);
+                if (seg->spec != NULL)
+                    res = emit_parameter(out, seg->spec, r);
+                else
+                    res = out->write(&seg->text);
+
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OK;
+        }
     }
 }
-
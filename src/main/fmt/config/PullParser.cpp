@@ -58,6 +58,8 @@ namespace lsp
             pIn         = NULL;
             nWFlags     = 0;
             nFlags      = 0;
+            pPool       = NULL;
+            pName       = NULL;
         }
         
         PullParser::~PullParser()
@@ -236,6 +238,7 @@ namespace lsp
 
                 pIn     = NULL;
             }
+            pName   = NULL;
 
             return res;
         }
@@ -280,6 +283,11 @@ namespace lsp
             return ((sParam.flags & SF_TYPE_MASK) != SF_NONE) ? &sParam : NULL;
         }
 
+        const LSPString *PullParser::interned_name() const
+        {
+            return ((pPool != NULL) && (current() != NULL)) ? pName : NULL;
+        }
+
         status_t PullParser::current(param_t *ev) const
         {
             if (pIn == NULL)
@@ -503,40 +511,59 @@ namespace lsp
         status_t PullParser::commit_param()
         {
             param_t tmp;
-            status_t res    = STATUS_OK;
+            status_t res    = parse_value(&tmp);
+            if (res != STATUS_OK)
+                return res;
 
-            // Copy parameter name
+            // Intern the name, the key buffer keeps the computed hash for the copy
+            if (pPool != NULL)
+            {
+                if ((pName = pPool->intern(&sKey)) == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            // Reuse the buffer of previous parameter name to avoid allocation for each parameter
+            tmp.name.swap(&sParam.name);
             if (!tmp.name.set(&sKey))
+            {
+                tmp.name.swap(&sParam.name);
                 return STATUS_NO_MEM;
+            }
             tmp.comment.clear();
 
+            sParam.swap(&tmp);
+            return STATUS_OK;
+        }
+
+        status_t PullParser::parse_value(param_t *p)
+        {
+            status_t res    = STATUS_OK;
+
             // If type is explicitly set
             if (nFlags & SF_TYPE_SET)
             {
                 switch (nFlags & SF_TYPE_MASK)
                 {
-                    case SF_TYPE_I32: res = parse_int32(&sValue, &tmp.v.i32); break;
-                    case SF_TYPE_U32: res = parse_uint32(&sValue, &tmp.v.u32); break;
-                    case SF_TYPE_F32: res = parse_float(&sValue, &tmp.v.f32, &nFlags); break;
-                    case SF_TYPE_I64: res = parse_int64(&sValue, &tmp.v.i64); break;
-                    case SF_TYPE_U64: res = parse_uint64(&sValue, &tmp.v.u64); break;
-                    case SF_TYPE_F64: res = parse_double(&sValue, &tmp.v.f64, &nFlags); break;
-                    case SF_TYPE_BOOL: res = parse_bool(&sValue, &tmp.v.bval); break;
+                    case SF_TYPE_I32: res = parse_int32(&sValue, &p->v.i32); break;
+                    case SF_TYPE_U32: res = parse_uint32(&sValue, &p->v.u32); break;
+                    case SF_TYPE_F32: res = parse_float(&sValue, &p->v.f32, &nFlags); break;
+                    case SF_TYPE_I64: res = parse_int64(&sValue, &p->v.i64); break;
+                    case SF_TYPE_U64: res = parse_uint64(&sValue, &p->v.u64); break;
+                    case SF_TYPE_F64: res = parse_double(&sValue, &p->v.f64, &nFlags); break;
+                    case SF_TYPE_BOOL: res = parse_bool(&sValue, &p->v.bval); break;
                     case SF_TYPE_STR:
-                        if ((tmp.v.str = sValue.clone_utf8()) == NULL)
+                        if ((p->v.str = sValue.clone_utf8()) == NULL)
                             res     = STATUS_NO_MEM;
                         break;
                     case SF_TYPE_BLOB:
-                        tmp.v.blob.ctype  = NULL;
-                        tmp.v.blob.data   = NULL;
-                        res = parse_blob(&sValue, &tmp.v.blob);
+                        p->v.blob.ctype   = NULL;
+                        p->v.blob.data    = NULL;
+                        res = parse_blob(&sValue, &p->v.blob);
                         break;
                     default:
                         return STATUS_UNKNOWN_ERR;
                 }
-                tmp.flags       = nFlags;
-                if (res == STATUS_OK)
-                    sParam.swap(&tmp);
+                p->flags        = nFlags;
                 return res;
             }
 
@@ -546,37 +573,33 @@ namespace lsp
                 if (sValue.index_of('.') < 0)
                 {
                     // Try to parse as boolean
-                    if ((res = parse_bool(&sValue, &tmp.v.bval)) == STATUS_OK)
+                    if ((res = parse_bool(&sValue, &p->v.bval)) == STATUS_OK)
                     {
-                        tmp.flags     = nFlags | SF_TYPE_BOOL;
-                        sParam.swap(&tmp);
+                        p->flags      = nFlags | SF_TYPE_BOOL;
                         return STATUS_OK;
                     }
 
                     // Try to parse as integer
-                    if ((res = parse_int32(&sValue, &tmp.v.i32)) == STATUS_OK)
+                    if ((res = parse_int32(&sValue, &p->v.i32)) == STATUS_OK)
                     {
-                        tmp.flags     = nFlags | SF_TYPE_I32;
-                        sParam.swap(&tmp);
+                        p->flags      = nFlags | SF_TYPE_I32;
                         return STATUS_OK;
                     }
                 }
 
                 // Try to parse as float
-                if ((res = parse_float(&sValue, &tmp.v.f32, &nFlags)) == STATUS_OK)
+                if ((res = parse_float(&sValue, &p->v.f32, &nFlags)) == STATUS_OK)
                 {
-                    tmp.flags     = nFlags | SF_TYPE_F32;
-                    sParam.swap(&tmp);
+                    p->flags      = nFlags | SF_TYPE_F32;
                     return STATUS_OK;
                 }
             }
 
             // Return as a string
-            if ((tmp.v.str = sValue.clone_utf8()) == NULL)
+            if ((p->v.str = sValue.clone_utf8()) == NULL)
                 res     = STATUS_NO_MEM;
-            tmp.flags   = nFlags | SF_TYPE_STR;
+            p->flags    = nFlags | SF_TYPE_STR;
 
-            sParam.swap(&tmp);
             return STATUS_OK;
         }
 
@@ -22,7 +22,7 @@
 #include <lsp-plug.in/common/endian.h>
 #include <lsp-plug.in/common/alloc.h>
 #include <lsp-plug.in/stdlib/string.h>
-#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/InBufferedStream.h>
 #include <lsp-plug.in/io/InMemoryStream.h>
 
 #include <lsp-plug.in/fmt/java/defs.h>
@@ -99,7 +99,7 @@ namespace lsp
 
         status_t ObjectStream::open(const char *file)
         {
-            io::InFileStream *is = new io::InFileStream();
+            io::InBufferedStream *is = new io::InBufferedStream();
             status_t res = is->open(file);
             if (res == STATUS_OK)
             {
@@ -118,7 +118,7 @@ namespace lsp
 
         status_t ObjectStream::open(const LSPString *file)
         {
-            io::InFileStream *is = new io::InFileStream();
+            io::InBufferedStream *is = new io::InBufferedStream();
             status_t res = is->open(file);
             if (res == STATUS_OK)
             {
@@ -137,7 +137,7 @@ namespace lsp
 
         status_t ObjectStream::open(const io::Path *file)
         {
-            io::InFileStream *is = new io::InFileStream();
+            io::InBufferedStream *is = new io::InBufferedStream();
             status_t res = is->open(file);
             if (res == STATUS_OK)
             {
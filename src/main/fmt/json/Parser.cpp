@@ -38,6 +38,8 @@ namespace lsp
             sState.mode     = READ_ROOT;
             sState.flags    = 0;
             sCurrent.type   = JE_UNKNOWN;
+            pPool           = NULL;
+            pName           = NULL;
         }
         
         Parser::~Parser()
@@ -232,6 +234,7 @@ namespace lsp
             sCurrent.type   = JE_UNKNOWN;
             sCurrent.sValue.truncate();
             sStack.flush();
+            pName           = NULL;
 
             return res;
         }
@@ -278,6 +281,9 @@ namespace lsp
                     break;
 
                 case JE_PROPERTY:
+                    if (!ev->sValue.set((pName != NULL) ? pName : &sCurrent.sValue))
+                        return STATUS_NO_MEM;
+                    break;
                 case JE_STRING:
                     if (!ev->sValue.set(&sCurrent.sValue))
                         return STATUS_NO_MEM;
@@ -300,13 +306,31 @@ namespace lsp
             return STATUS_OK;
         }
 
+        status_t Parser::read_property(token_t tok)
+        {
+            if (pPool == NULL)
+            {
+                pName           = NULL;
+                return read_primitive(tok);
+            }
+
+            // The pool stores the name, so the parser does not keep own copy of it
+            if ((tok != JT_DQ_STRING) && (enVersion < JSON_VERSION5))
+                return STATUS_BAD_TOKEN;
+            if ((pName = pPool->intern(pTokenizer->text_value())) == NULL)
+                return STATUS_NO_MEM;
+            sCurrent.sValue.clear();
+            sCurrent.type   = JE_STRING;
+
+            return STATUS_OK;
+        }
+
         status_t Parser::read_primitive(token_t tok)
         {
             switch (tok)
             {
                 case JT_DQ_STRING:
-                    if (!sCurrent.sValue.set(pTokenizer->text_value()))
-                        return STATUS_NO_MEM;
+                    pTokenizer->take_text_value(&sCurrent.sValue);
                     sCurrent.type = JE_STRING;
                     break;
 
@@ -334,8 +358,7 @@ namespace lsp
                 case JT_IDENTIFIER:
                     if (enVersion < JSON_VERSION5)
                         return STATUS_BAD_TOKEN;
-                    if (!sCurrent.sValue.set(pTokenizer->text_value()))
-                        return STATUS_NO_MEM;
+                    pTokenizer->take_text_value(&sCurrent.sValue);
                     sCurrent.type = JE_STRING;
                     break;
 
@@ -559,7 +582,7 @@ namespace lsp
                         size_t flags = sState.flags & PF_OBJECT_ALL;
                         if ((flags == 0) || (flags == PF_OBJECT_ALL)) // Property name?
                         {
-                            if ((res = read_primitive(tok)) == STATUS_OK)
+                            if ((res = read_property(tok)) == STATUS_OK)
                             {
                                 sState.flags        = PF_PROPERTY;
                                 sCurrent.type       = JE_PROPERTY;  // Override type of event
@@ -705,6 +728,11 @@ namespace lsp
             return STATUS_OK;
         }
 
+        const LSPString *Parser::interned_name() const
+        {
+            return (sCurrent.type == JE_PROPERTY) ? pName : NULL;
+        }
+
         status_t Parser::get_string(LSPString *dst)
         {
             if (pTokenizer == NULL)
@@ -98,6 +98,7 @@ namespace lsp
         Tokenizer::Tokenizer(io::IInSequence *in)
         {
             pIn         = in;
+            sReader.wrap(in);
             cCurrent    = -1;
             enToken     = JT_UNKNOWN;
             nError      = STATUS_OK;
@@ -111,6 +112,7 @@ namespace lsp
         
         Tokenizer::~Tokenizer()
         {
+            sReader.commit();
             pIn         = NULL;
             if (vPending != NULL)
             {
@@ -121,6 +123,13 @@ namespace lsp
             nCapacity   = 0;
         }
 
+        void Tokenizer::take_text_value(LSPString *dst)
+        {
+            // Swap buffers so that both strings keep their capacity for further use
+            dst->swap(&sValue);
+            sValue.clear();
+        }
+
         token_t Tokenizer::set_error(status_t code)
         {
             nError          = code;
@@ -130,13 +139,13 @@ namespace lsp
         lsp_swchar_t Tokenizer::skip_whitespace()
         {
             if (cCurrent < 0)
-                cCurrent = pIn->read();
+                cCurrent = sReader.read();
 
             while (true)
             {
                 // Skip whitespace
                 if (::iswspace(cCurrent) || (::iswblank(cCurrent)))
-                    cCurrent = pIn->read();
+                    cCurrent = sReader.read();
                 else
                     return cCurrent;
             }
@@ -145,7 +154,7 @@ namespace lsp
         lsp_swchar_t Tokenizer::lookup()
         {
             if (cCurrent < 0)
-                cCurrent = pIn->read();
+                cCurrent = sReader.read();
             return cCurrent;
         }
 
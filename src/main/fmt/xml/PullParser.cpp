@@ -42,6 +42,8 @@ namespace lsp
             nStates     = 0;
 
             nUngetch    = 0;
+            pPool       = NULL;
+            pName       = NULL;
         }
         
         PullParser::~PullParser()
@@ -195,6 +197,7 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
 
             pIn             = seq;
+            sReader.wrap(seq);
             nWFlags         = flags;
             nToken          = -STATUS_NO_DATA;
             nState          = PS_READ_MISC;
@@ -225,6 +228,7 @@ namespace lsp
             sPublic.truncate();
             sSystem.truncate();
             nFlags          = 0;
+            pName           = NULL;
 
             // Remove all tag hierarchy
             drop_list(&vTags);
@@ -233,6 +237,10 @@ namespace lsp
             // Release input sequence
             if (pIn != NULL)
             {
+                // Consume the characters read from the sequence
+                res     = sReader.commit();
+                sReader.wrap(NULL);
+
                 if (nWFlags & WRAP_CLOSE)
                 {
                     if (res == STATUS_OK)
@@ -252,7 +260,7 @@ namespace lsp
 
         lsp_swchar_t PullParser::getch()
         {
-            return (nUngetch > 0) ? vUngetch[--nUngetch] : pIn->read();
+            return (nUngetch > 0) ? vUngetch[--nUngetch] : sReader.read();
         }
 
         void PullParser::ungetch(lsp_swchar_t ch)
@@ -273,6 +281,13 @@ namespace lsp
 
         void PullParser::drop_list(lltl::parray<LSPString> *list)
         {
+            // Names are owned by the pool if it is set
+            if (pPool != NULL)
+            {
+                list->flush();
+                return;
+            }
+
             for (size_t i=0, n=list->size(); i<n; ++i)
             {
                 LSPString *s = list->uget(i);
@@ -284,6 +299,17 @@ namespace lsp
 
         status_t PullParser::check_duplicate_attribute()
         {
+            // Interned names are compared by pointer and do not need a copy
+            if (pPool != NULL)
+            {
+                if ((pName = pPool->intern(&sName)) == NULL)
+                    return STATUS_NO_MEM;
+                LSPString *name = const_cast<LSPString *>(pName);
+                if (vAtts.index_of(name) >= 0)
+                    return STATUS_CORRUPTED;
+                return (vAtts.add(name)) ? STATUS_OK : STATUS_NO_MEM;
+            }
+
             // Is item present in list?
             for (size_t i=0, n=vAtts.size(); i<n; ++i)
             {
@@ -908,13 +934,21 @@ namespace lsp
             if ((res = read_name(&sName)) != STATUS_OK)
                 return res;
 
-            // Add tag to stack
-            LSPString *tag = sName.clone();
-            if (tag == NULL)
+            // Add tag to stack, the interned name does not need a copy
+            LSPString *tag;
+            if (pPool != NULL)
+            {
+                if ((pName = pPool->intern(&sName)) == NULL)
+                    return STATUS_NO_MEM;
+                tag     = const_cast<LSPString *>(pName);
+            }
+            else if ((tag = sName.clone()) == NULL)
                 return STATUS_NO_MEM;
-            else if (!vTags.push(tag))
+
+            if (!vTags.push(tag))
             {
-                delete tag;
+                if (pPool == NULL)
+                    delete tag;
                 return STATUS_NO_MEM;
             }
 
@@ -932,14 +966,29 @@ namespace lsp
             if (!vTags.pop(&name))
                 return STATUS_CORRUPTED;
 
-            if (copy)
-                sName.swap(name);
-            else if (!sName.equals(name))
+            if (pPool != NULL)
+            {
+                // The name is owned by the pool
+                pName   = name;
+                if (copy)
+                {
+                    if (!sName.set(name))
+                        return STATUS_NO_MEM;
+                }
+                else if (!sName.equals(name))
+                    return STATUS_CORRUPTED;
+            }
+            else
             {
+                if (copy)
+                    sName.swap(name);
+                else if (!sName.equals(name))
+                {
+                    delete name;
+                    return STATUS_CORRUPTED;
+                }
                 delete name;
-                return STATUS_CORRUPTED;
             }
-            delete name;
 
             // Update state
             drop_list(&vAtts);
@@ -1305,6 +1354,25 @@ namespace lsp
         status_t PullParser::read_next()
         {
             status_t res = read_token();
+            if ((res == STATUS_OK) && (pPool != NULL))
+            {
+                switch (nToken)
+                {
+                    // Names of elements and attributes are interned while reading them
+                    case XT_START_ELEMENT:
+                    case XT_END_ELEMENT:
+                    case XT_ATTRIBUTE:
+                        break;
+                    case XT_PROCESSING_INSTRUCTION:
+                    case XT_ENTITY_RESOLVE:
+                        if ((pName = pPool->intern(name())) == NULL)
+                            res     = STATUS_NO_MEM;
+                        break;
+                    default:
+                        pName   = NULL;
+                        break;
+                }
+            }
             return (res == STATUS_OK) ? nToken : -res;
         }
 
@@ -1352,5 +1420,19 @@ namespace lsp
             return NULL;
         }
 
+        status_t PullParser::set_pool(StringPool *pool)
+        {
+            // The open elements keep names owned by the current pool
+            if ((vTags.size() > 0) || (vAtts.size() > 0))
+                return STATUS_BAD_STATE;
+            pPool   = pool;
+            return STATUS_OK;
+        }
+
+        const LSPString *PullParser::interned_name() const
+        {
+            return ((pIn != NULL) && (pPool != NULL) && (name() != NULL)) ? pName : NULL;
+        }
+
     } /* namespace xml */
 } /* namespace lsp */
@@ -28,6 +28,197 @@ namespace lsp
 {
     namespace io
     {
+        static status_t decode_utf8(lsp_wchar_t **dst, lsp_wchar_t *dend, const uint8_t **src, const uint8_t *send)
+        {
+            lsp_wchar_t *d      = *dst;
+            const uint8_t *s    = *src;
+            status_t res        = STATUS_OK;
+
+            while ((s < send) && (d < dend))
+            {
+                lsp_wchar_t cp      = *s;
+                lsp_wchar_t min;
+                size_t len;
+
+                if (cp < 0x80)
+                {
+                    if (cp != 0)
+                    {
+                        // Convert ASCII characters in bulk
+                        size_t n            = ascii_to_utf32(d, reinterpret_cast<const char *>(s),
+                                                lsp_min(size_t(send - s), size_t(dend - d)));
+                        s                  += n;
+                        d                  += n;
+                    }
+                    else
+                    {
+                        *(d++)              = cp;
+                        ++s;
+                    }
+                    continue;
+                }
+
+                // Fast path for complete and well-formed 2-byte and 3-byte sequences
+                size_t left         = send - s;
+                if ((cp >= 0xc2) && (cp < 0xe0) && (left >= 2))
+                {
+                    lsp_wchar_t c1      = s[1];
+                    if ((c1 & 0xc0) == 0x80)
+                    {
+                        *(d++)              = ((cp & 0x1f) << 6) | (c1 & 0x3f);
+                        s                  += 2;
+                        continue;
+                    }
+                }
+                else if ((cp >= 0xe0) && (cp < 0xf0) && (left >= 3))
+                {
+                    lsp_wchar_t c1      = s[1];
+                    lsp_wchar_t c2      = s[2];
+                    if (((c1 & 0xc0) == 0x80) && ((c2 & 0xc0) == 0x80))
+                    {
+                        lsp_wchar_t xcp     = ((cp & 0x0f) << 12) | ((c1 & 0x3f) << 6) | (c2 & 0x3f);
+                        if ((xcp >= 0x800) && ((xcp < 0xd800) || (xcp >= 0xe000)))
+                        {
+                            *(d++)              = xcp;
+                            s                  += 3;
+                            continue;
+                        }
+                    }
+                }
+
+                // Decode multi-byte sequence
+                if (cp < 0xc2) // Unexpected continuation byte or overlong sequence
+                {
+                    res                 = STATUS_BAD_FORMAT;
+                    break;
+                }
+                else if (cp < 0xe0)
+                {
+                    cp                 &= 0x1f;
+                    min                 = 0x80;
+                    len                 = 2;
+                }
+                else if (cp < 0xf0)
+                {
+                    cp                 &= 0x0f;
+                    min                 = 0x800;
+                    len                 = 3;
+                }
+                else if (cp < 0xf5)
+                {
+                    cp                 &= 0x07;
+                    min                 = 0x10000;
+                    len                 = 4;
+                }
+                else
+                {
+                    res                 = STATUS_BAD_FORMAT;
+                    break;
+                }
+
+                // Check that we have enough data, the incomplete sequence may be continued in the future
+                size_t count        = lsp_min(size_t(send - s), len);
+                for (size_t i=1; i<count; ++i)
+                {
+                    lsp_wchar_t c       = s[i];
+                    if ((c & 0xc0) != 0x80)
+                    {
+                        res                 = STATUS_BAD_FORMAT;
+                        break;
+                    }
+                    cp                  = (cp << 6) | (c & 0x3f);
+                }
+                if ((res != STATUS_OK) || (count < len))
+                    break;
+
+                // Reject overlong sequences, surrogates and out-of-range code points
+                if ((cp < min) || ((cp >= 0xd800) && (cp < 0xe000)) || (cp > 0x10ffff))
+                {
+                    res                 = STATUS_BAD_FORMAT;
+                    break;
+                }
+
+                *(d++)              = cp;
+                s                  += len;
+            }
+
+            *dst                = d;
+            *src                = s;
+            return res;
+        }
+
+        static status_t decode_utf16(lsp_wchar_t **dst, lsp_wchar_t *dend, const uint8_t **src, const uint8_t *send, bool le)
+        {
+            lsp_wchar_t *d      = *dst;
+            const uint8_t *s    = *src;
+            size_t lo           = (le) ? 0 : 1;
+            size_t hi           = lo ^ 1;
+            status_t res        = STATUS_OK;
+
+            while (((send - s) >= 2) && (d < dend))
+            {
+                lsp_wchar_t cp      = s[lo] | (s[hi] << 8);
+                if ((cp < 0xd800) || (cp >= 0xe000))
+                {
+                    *(d++)              = cp;
+                    s                  += 2;
+                    continue;
+                }
+
+                // Surrogate pair
+                if (cp >= 0xdc00) // Unexpected low surrogate
+                {
+                    res                 = STATUS_BAD_FORMAT;
+                    break;
+                }
+                else if ((send - s) < 4) // Wait for the low surrogate
+                    break;
+
+                lsp_wchar_t sc      = s[lo + 2] | (s[hi + 2] << 8);
+                if ((sc < 0xdc00) || (sc >= 0xe000))
+                {
+                    res                 = STATUS_BAD_FORMAT;
+                    break;
+                }
+
+                *(d++)              = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
+                s                  += 4;
+            }
+
+            *dst                = d;
+            *src                = s;
+            return res;
+        }
+
+        static status_t decode_latin1(lsp_wchar_t **dst, lsp_wchar_t *dend, const uint8_t **src, const uint8_t *send, bool ascii)
+        {
+            lsp_wchar_t *d      = *dst;
+            const uint8_t *s    = *src;
+            size_t avail        = lsp_min(size_t(send - s), size_t(dend - d));
+            status_t res        = STATUS_OK;
+
+            for (size_t i=0; i<avail; )
+            {
+                // Convert ASCII characters in bulk
+                i                  += ascii_to_utf32(&d[i], reinterpret_cast<const char *>(&s[i]), avail - i);
+                if (i >= avail)
+                    break;
+
+                // Zero character or 8-bit character
+                lsp_wchar_t cp      = s[i];
+                if ((ascii) && (cp >= 0x80))
+                {
+                    avail               = i;
+                    res                 = STATUS_BAD_FORMAT;
+                    break;
+                }
+                d[i++]              = cp;
+            }
+
+            *dst                = &d[avail];
+            *src                = &s[avail];
+            return res;
+        }
         
         CharsetDecoder::CharsetDecoder()
         {
@@ -37,6 +228,7 @@ namespace lsp
             cBuffer         = NULL;
             cBufHead        = NULL;
             cBufTail        = NULL;
+            enNative        = NCS_NONE;
 
 #if defined(PLATFORM_WINDOWS)
             xBuffer         = NULL;
@@ -53,23 +245,31 @@ namespace lsp
     
         status_t CharsetDecoder::init(const char *charset)
         {
-#if defined(PLATFORM_WINDOWS)
-            if (nCodePage != UINT(-1))
+            if (bBuffer != NULL)
                 return STATUS_BAD_STATE;
 
-            ssize_t cp  = codepage_from_name(charset);
-            if (cp < 0)
-                return STATUS_BAD_LOCALE;
-            nCodePage       = cp;
+            // Use built-in decoder if possible
+            enNative        = native_charset(charset);
+            if (enNative == NCS_NONE)
+            {
+#if defined(PLATFORM_WINDOWS)
+                if (nCodePage != UINT(-1))
+                    return STATUS_BAD_STATE;
+
+                ssize_t cp  = codepage_from_name(charset);
+                if (cp < 0)
+                    return STATUS_BAD_LOCALE;
+                nCodePage       = cp;
 #else
-            if (hIconv != iconv_t(-1))
-                return STATUS_BAD_STATE;
+                if (hIconv != iconv_t(-1))
+                    return STATUS_BAD_STATE;
 
-            iconv_t handle = init_iconv_to_wchar_t(charset);
-            if (handle == iconv_t(-1))
-                return STATUS_BAD_LOCALE;
-            hIconv      = handle;
+                iconv_t handle = init_iconv_to_wchar_t(charset);
+                if (handle == iconv_t(-1))
+                    return STATUS_BAD_LOCALE;
+                hIconv      = handle;
 #endif /* PLATFORM_WINDOWS */
+            }
 
             // Allocate buffer
             uint8_t *buf= reinterpret_cast<uint8_t *>(::malloc(
@@ -114,6 +314,7 @@ namespace lsp
                 cBufHead        = NULL;
                 cBufTail        = NULL;
             }
+            enNative        = NCS_NONE;
 
 #ifdef PLATFORM_WINDOWS
             xBuffer     = NULL;
@@ -254,6 +455,15 @@ namespace lsp
             if (!xinleft)
                 return bufsz;
 
+            // Use built-in decoder if possible
+            if (enNative != NCS_NONE)
+            {
+                status_t res        = decode_native();
+                if ((res != STATUS_OK) && (cBufTail <= cBufHead))
+                    return -res;
+                return cBufTail - cBufHead;
+            }
+
             // Now we can surely decode DATA_BUFSIZE characters
 #ifdef PLATFORM_WINDOWS
             // Round 1: Perform native -> UTF-16 decoding
@@ -300,6 +510,40 @@ namespace lsp
             return cBufTail - cBufHead;
         }
 
+        status_t CharsetDecoder::decode_native()
+        {
+            const uint8_t *src  = bBufHead;
+            lsp_wchar_t *dst    = cBufTail;
+            lsp_wchar_t *dend   = &cBufTail[DATA_BUFSIZE];
+            status_t res;
+
+            switch (enNative)
+            {
+                case NCS_UTF8:
+                    res                 = decode_utf8(&dst, dend, &src, bBufTail);
+                    break;
+                case NCS_UTF16LE:
+                    res                 = decode_utf16(&dst, dend, &src, bBufTail, true);
+                    break;
+                case NCS_UTF16BE:
+                    res                 = decode_utf16(&dst, dend, &src, bBufTail, false);
+                    break;
+                case NCS_ASCII:
+                    res                 = decode_latin1(&dst, dend, &src, bBufTail, true);
+                    break;
+                case NCS_LATIN1:
+                    res                 = decode_latin1(&dst, dend, &src, bBufTail, false);
+                    break;
+                default:
+                    return STATUS_BAD_STATE;
+            }
+
+            bBufHead            = const_cast<uint8_t *>(src);
+            cBufTail            = dst;
+
+            return res;
+        }
+
         lsp_swchar_t CharsetDecoder::fetch()
         {
             if (bBuffer == NULL)
@@ -435,6 +679,45 @@ namespace lsp
             return processed;
         }
 
+        ssize_t CharsetDecoder::borrow(const lsp_wchar_t **buf)
+        {
+            if (bBuffer == NULL)
+                return -STATUS_CLOSED;
+            else if (buf == NULL)
+                return -STATUS_BAD_ARGUMENTS;
+
+            ssize_t nchars  = (cBufTail > cBufHead) ? cBufTail - cBufHead : decode_buffer();
+            if (nchars > 0)
+                *buf            = cBufHead;
+            return nchars;
+        }
+
+        ssize_t CharsetDecoder::skip(size_t count)
+        {
+            if (bBuffer == NULL)
+                return -STATUS_CLOSED;
+
+            // Compute the amount of data to skip
+            size_t processed = 0;
+
+            while (processed < count)
+            {
+                ssize_t nchars  = (cBufTail > cBufHead) ? cBufTail - cBufHead : decode_buffer();
+                if (nchars <= 0)
+                {
+                    if (processed > 0)
+                        break;
+                    return nchars;
+                }
+
+                size_t to_skip  = lsp_min(size_t(nchars), count - processed);
+                cBufHead       += to_skip;
+                processed      += to_skip;
+            }
+
+            return processed;
+        }
+
         ssize_t CharsetDecoder::fill(const void *buf, size_t count)
         {
             if (bBuffer == NULL)
@@ -448,7 +731,7 @@ namespace lsp
 
             if (count > bufsz)
                 count   = bufsz;
-            ::memcpy(&bBufTail, buf, count);
+            ::memcpy(bBufTail, buf, count);
             bBufTail       += count;
             return count;
         }
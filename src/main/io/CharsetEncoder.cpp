@@ -28,6 +28,132 @@ namespace lsp
 {
     namespace io
     {
+        static status_t encode_utf8(uint8_t **dst, uint8_t *dend, const lsp_wchar_t **src, const lsp_wchar_t *send)
+        {
+            uint8_t *d              = *dst;
+            const lsp_wchar_t *s    = *src;
+            status_t res            = STATUS_OK;
+
+            while (s < send)
+            {
+                lsp_wchar_t cp          = *s;
+                if (cp < 0x80)
+                {
+                    // Convert ASCII characters in bulk
+                    size_t n                = utf32_to_ascii(reinterpret_cast<char *>(d), s,
+                                                lsp_min(size_t(send - s), size_t(dend - d)));
+                    if (n <= 0)
+                        break;
+                    s                      += n;
+                    d                      += n;
+                    continue;
+                }
+
+                // Reject surrogates and out-of-range code points
+                if (((cp >= 0xd800) && (cp < 0xe000)) || (cp > 0x10ffff))
+                {
+                    res                     = STATUS_BAD_FORMAT;
+                    break;
+                }
+                else if ((dend - d) < 4) // Not enough space for the longest sequence
+                    break;
+
+                if (cp < 0x800)
+                {
+                    d[0]                    = (cp >> 6) | 0xc0;
+                    d[1]                    = (cp & 0x3f) | 0x80;
+                    d                      += 2;
+                }
+                else if (cp < 0x10000)
+                {
+                    d[0]                    = (cp >> 12) | 0xe0;
+                    d[1]                    = ((cp >> 6) & 0x3f) | 0x80;
+                    d[2]                    = (cp & 0x3f) | 0x80;
+                    d                      += 3;
+                }
+                else
+                {
+                    d[0]                    = (cp >> 18) | 0xf0;
+                    d[1]                    = ((cp >> 12) & 0x3f) | 0x80;
+                    d[2]                    = ((cp >> 6) & 0x3f) | 0x80;
+                    d[3]                    = (cp & 0x3f) | 0x80;
+                    d                      += 4;
+                }
+                ++s;
+            }
+
+            *dst                    = d;
+            *src                    = s;
+            return res;
+        }
+
+        static status_t encode_utf16(uint8_t **dst, uint8_t *dend, const lsp_wchar_t **src, const lsp_wchar_t *send, bool le)
+        {
+            uint8_t *d              = *dst;
+            const lsp_wchar_t *s    = *src;
+            size_t lo               = (le) ? 0 : 1;
+            size_t hi               = lo ^ 1;
+            status_t res            = STATUS_OK;
+
+            for ( ; s < send; ++s)
+            {
+                lsp_wchar_t cp          = *s;
+                if (((cp >= 0xd800) && (cp < 0xe000)) || (cp > 0x10ffff))
+                {
+                    res                     = STATUS_BAD_FORMAT;
+                    break;
+                }
+                else if ((dend - d) < 4) // Not enough space for the surrogate pair
+                    break;
+
+                if (cp >= 0x10000)
+                {
+                    cp                     -= 0x10000;
+                    lsp_wchar_t hs          = 0xd800 | (cp >> 10);
+                    lsp_wchar_t ls          = 0xdc00 | (cp & 0x3ff);
+                    d[lo]                   = uint8_t(hs);
+                    d[hi]                   = uint8_t(hs >> 8);
+                    d[lo + 2]               = uint8_t(ls);
+                    d[hi + 2]               = uint8_t(ls >> 8);
+                    d                      += 4;
+                }
+                else
+                {
+                    d[lo]                   = uint8_t(cp);
+                    d[hi]                   = uint8_t(cp >> 8);
+                    d                      += 2;
+                }
+            }
+
+            *dst                    = d;
+            *src                    = s;
+            return res;
+        }
+
+        static status_t encode_latin1(uint8_t **dst, uint8_t *dend, const lsp_wchar_t **src, const lsp_wchar_t *send, lsp_wchar_t max)
+        {
+            uint8_t *d              = *dst;
+            const lsp_wchar_t *s    = *src;
+            size_t avail            = lsp_min(size_t(send - s), size_t(dend - d));
+            status_t res            = STATUS_OK;
+
+            // Convert ASCII characters in bulk
+            size_t i                = utf32_to_ascii(reinterpret_cast<char *>(d), s, avail);
+            for ( ; i < avail; ++i)
+            {
+                lsp_wchar_t cp          = s[i];
+                if (cp > max)
+                {
+                    res                     = STATUS_BAD_FORMAT;
+                    break;
+                }
+                d[i]                    = uint8_t(cp);
+            }
+
+            *dst                    = &d[i];
+            *src                    = &s[i];
+            return res;
+        }
         
         CharsetEncoder::CharsetEncoder()
         {
@@ -38,6 +164,7 @@ namespace lsp
             cBuffer         = NULL;
             cBufHead        = NULL;
             cBufTail        = NULL;
+            enNative        = NCS_NONE;
 
 #if defined(PLATFORM_WINDOWS)
             xBuffer         = NULL;
@@ -54,23 +181,31 @@ namespace lsp
 
         status_t CharsetEncoder::init(const char *charset)
         {
-#if defined(PLATFORM_WINDOWS)
-            if (nCodePage != UINT(-1))
+            if (bBuffer != NULL)
                 return STATUS_BAD_STATE;
 
-            ssize_t cp  = codepage_from_name(charset);
-            if (cp < 0)
-                return STATUS_BAD_LOCALE;
-            nCodePage       = cp;
+            // Use built-in encoder if possible
+            enNative        = native_charset(charset);
+            if (enNative == NCS_NONE)
+            {
+#if defined(PLATFORM_WINDOWS)
+                if (nCodePage != UINT(-1))
+                    return STATUS_BAD_STATE;
+
+                ssize_t cp  = codepage_from_name(charset);
+                if (cp < 0)
+                    return STATUS_BAD_LOCALE;
+                nCodePage       = cp;
 #else
-            if (hIconv != iconv_t(-1))
-                return STATUS_BAD_STATE;
+                if (hIconv != iconv_t(-1))
+                    return STATUS_BAD_STATE;
 
-            iconv_t handle = init_iconv_from_wchar_t(charset);
-            if (handle == iconv_t(-1))
-                return STATUS_BAD_LOCALE;
-            hIconv      = handle;
+                iconv_t handle = init_iconv_from_wchar_t(charset);
+                if (handle == iconv_t(-1))
+                    return STATUS_BAD_LOCALE;
+                hIconv      = handle;
 #endif /* PLATFORM_WINDOWS */
+            }
 
             // Allocate buffer
             uint8_t *buf= reinterpret_cast<uint8_t *>(::malloc(
@@ -116,6 +251,7 @@ namespace lsp
                 cBufHead        = NULL;
                 cBufTail        = NULL;
             }
+            enNative        = NCS_NONE;
 
 #if defined(PLATFORM_WINDOWS)
             xBuffer     = NULL;
@@ -244,6 +380,15 @@ namespace lsp
             if (!xinleft)
                 return bufsz;
 
+            // Use built-in encoder if possible
+            if (enNative != NCS_NONE)
+            {
+                status_t res        = encode_native();
+                if ((res != STATUS_OK) && (bBufTail <= bBufHead))
+                    return -res;
+                return bBufTail - bBufHead;
+            }
+
 #ifdef PLATFORM_WINDOWS
             // Round 1: encode UTF-32 -> UTF-16
             size_t nsrc     = xinleft;
@@ -290,6 +435,40 @@ namespace lsp
             return bBufTail - bBufHead;
         }
 
+        status_t CharsetEncoder::encode_native()
+        {
+            const lsp_wchar_t *src  = cBufHead;
+            uint8_t *dst            = bBufTail;
+            uint8_t *dend           = &bBufTail[DATA_BUFSIZE * sizeof(lsp_utf32_t)];
+            status_t res;
+
+            switch (enNative)
+            {
+                case NCS_UTF8:
+                    res                 = encode_utf8(&dst, dend, &src, cBufTail);
+                    break;
+                case NCS_UTF16LE:
+                    res                 = encode_utf16(&dst, dend, &src, cBufTail, true);
+                    break;
+                case NCS_UTF16BE:
+                    res                 = encode_utf16(&dst, dend, &src, cBufTail, false);
+                    break;
+                case NCS_ASCII:
+                    res                 = encode_latin1(&dst, dend, &src, cBufTail, 0x7f);
+                    break;
+                case NCS_LATIN1:
+                    res                 = encode_latin1(&dst, dend, &src, cBufTail, 0xff);
+                    break;
+                default:
+                    return STATUS_BAD_STATE;
+            }
+
+            cBufHead            = const_cast<lsp_wchar_t *>(src);
+            bBufTail            = dst;
+
+            return res;
+        }
+
         ssize_t CharsetEncoder::fill(lsp_wchar_t ch)
         {
             if (bBuffer == NULL)
@@ -51,6 +51,11 @@ namespace lsp
             return set_error(STATUS_EOF);
         }
 
+        ssize_t IInSequence::borrow(const lsp_wchar_t **buf)
+        {
+            return -set_error(STATUS_NOT_SUPPORTED);
+        }
+
         ssize_t IInSequence::skip(size_t count)
         {
             ssize_t skipped = 0;
@@ -22,6 +22,7 @@
 #include <lsp-plug.in/common/endian.h>
 #include <lsp-plug.in/io/InBitStream.h>
 #include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/InBufferedStream.h>
 
 #define BITSTREAM_BUFSZ         (sizeof(umword_t) * 8)
 
@@ -106,7 +107,7 @@ namespace lsp
         {
             status_t res;
 
-            InFileStream *ofs = new InFileStream();
+            InBufferedStream *ofs = new InBufferedStream();
             if (ofs == NULL)
                 return set_error(STATUS_NO_MEM);
 
@@ -126,7 +127,7 @@ namespace lsp
         {
             status_t res;
 
-            InFileStream *ofs = new InFileStream();
+            InBufferedStream *ofs = new InBufferedStream();
             if (ofs == NULL)
                 return set_error(STATUS_NO_MEM);
 
@@ -147,7 +148,7 @@ namespace lsp
         {
             status_t res;
 
-            InFileStream *ofs = new InFileStream();
+            InBufferedStream *ofs = new InBufferedStream();
             if (ofs == NULL)
                 return set_error(STATUS_NO_MEM);
 
@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/io/InBufferedStream.h>
+#include <lsp-plug.in/io/InFileStream.h>
+
+#define BUFFERED_STREAM_BUFSZ       0x10000
+
+namespace lsp
+{
+    namespace io
+    {
+        InBufferedStream::InBufferedStream(size_t buf_size)
+        {
+            pIS         = NULL;
+            nWrapFlags  = 0;
+            pBuffer     = NULL;
+            pData       = NULL;
+            nBufSize    = align_size((buf_size > 0) ? buf_size : BUFFERED_STREAM_BUFSZ, DEFAULT_ALIGN);
+            nHead       = 0;
+            nTail       = 0;
+        }
+
+        InBufferedStream::~InBufferedStream()
+        {
+            close();
+            free_aligned(pData);
+            pBuffer     = NULL;
+        }
+
+        status_t InBufferedStream::wrap(FILE *fd, bool close)
+        {
+            status_t res;
+
+            InFileStream *ifs = new InFileStream();
+            if (ifs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ifs->wrap(fd, close)) == STATUS_OK)
+                res     = wrap(ifs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ifs->close();
+                delete ifs;
+            }
+
+            return res;
+        }
+
+        status_t InBufferedStream::wrap_native(fhandle_t fd, bool close)
+        {
+            status_t res;
+
+            InFileStream *ifs = new InFileStream();
+            if (ifs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ifs->wrap_native(fd, close)) == STATUS_OK)
+                res     = wrap(ifs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ifs->close();
+                delete ifs;
+            }
+
+            return res;
+        }
+
+        status_t InBufferedStream::wrap(File *fd, size_t flags)
+        {
+            status_t res;
+
+            InFileStream *ifs = new InFileStream();
+            if (ifs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ifs->wrap(fd, flags)) == STATUS_OK)
+                res     = wrap(ifs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ifs->close();
+                delete ifs;
+            }
+
+            return res;
+        }
+
+        status_t InBufferedStream::open(const char *path)
+        {
+            status_t res;
+
+            InFileStream *ifs = new InFileStream();
+            if (ifs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ifs->open(path)) == STATUS_OK)
+                res     = wrap(ifs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ifs->close();
+                delete ifs;
+            }
+
+            return set_error(res);
+        }
+
+        status_t InBufferedStream::open(const LSPString *path)
+        {
+            status_t res;
+
+            InFileStream *ifs = new InFileStream();
+            if (ifs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ifs->open(path)) == STATUS_OK)
+                res     = wrap(ifs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ifs->close();
+                delete ifs;
+            }
+
+            return set_error(res);
+        }
+
+        status_t InBufferedStream::open(const Path *path)
+        {
+            if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            return open(path->as_string());
+        }
+
+        status_t InBufferedStream::wrap(IInStream *is, size_t flags)
+        {
+            if (pIS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (is == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            // Allocate the buffer once, it is kept between close() and wrap()
+            if (pBuffer == NULL)
+            {
+                pBuffer     = alloc_aligned<uint8_t>(pData, nBufSize);
+                if (pBuffer == NULL)
+                    return set_error(STATUS_NO_MEM);
+            }
+
+            // Store pointers
+            pIS         = is;
+            nWrapFlags  = flags;
+            nHead       = 0;
+            nTail       = 0;
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t InBufferedStream::close()
+        {
+            status_t res = STATUS_OK;
+
+            // Close file descriptor
+            if (pIS != NULL)
+            {
+                // Perform close
+                if (nWrapFlags & WRAP_CLOSE)
+                    res = pIS->close();
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pIS;
+                pIS         = NULL;
+            }
+
+            nWrapFlags  = 0;
+            nHead       = 0;
+            nTail       = 0;
+
+            // Return result
+            return set_error(res);
+        }
+
+        status_t InBufferedStream::fill(size_t count)
+        {
+            size_t avail    = nTail - nHead;
+            if (avail >= count)
+                return STATUS_OK;
+
+            // Move the unread data to the beginning of the buffer
+            if (nHead > 0)
+            {
+                if (avail > 0)
+                    ::memmove(pBuffer, &pBuffer[nHead], avail);
+                nHead       = 0;
+                nTail       = avail;
+            }
+
+            // Read the whole free space of the buffer at once
+            while (nTail < count)
+            {
+                ssize_t n   = pIS->read(&pBuffer[nTail], nBufSize - nTail);
+                if (n <= 0)
+                    return (n < 0) ? status_t(-n) : STATUS_EOF;
+                nTail      += n;
+            }
+
+            return STATUS_OK;
+        }
+
+        wssize_t InBufferedStream::avail()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            wssize_t res    = pIS->avail();
+            if (res < 0)
+                return -set_error(status_t(-res));
+
+            set_error(STATUS_OK);
+            return res + (nTail - nHead);
+        }
+
+        wssize_t InBufferedStream::position()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            wssize_t res    = pIS->position();
+            if (res < 0)
+                return -set_error(status_t(-res));
+
+            set_error(STATUS_OK);
+            return res - (nTail - nHead);
+        }
+
+        ssize_t InBufferedStream::read(void *dst, size_t count)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            uint8_t *ptr    = reinterpret_cast<uint8_t *>(dst);
+
+            // Serve the request from the buffer first
+            size_t done     = lsp_min(nTail - nHead, count);
+            if (done > 0)
+            {
+                ::memcpy(ptr, &pBuffer[nHead], done);
+                nHead      += done;
+                if (done >= count)
+                {
+                    set_error(STATUS_OK);
+                    return done;
+                }
+            }
+
+            // The buffer is empty, access the wrapped stream at most once
+            size_t left     = count - done;
+            nHead           = 0;
+            nTail           = 0;
+
+            if (left >= nBufSize)
+            {
+                // Large read, pass it directly to the target buffer
+                ssize_t n       = pIS->read(&ptr[done], left);
+                if (n > 0)
+                    done           += n;
+                else if (done <= 0)
+                    return -set_error((n < 0) ? status_t(-n) : STATUS_EOF);
+            }
+            else
+            {
+                status_t res    = fill(1);
+                if (res == STATUS_OK)
+                {
+                    size_t n        = lsp_min(nTail, left);
+                    ::memcpy(&ptr[done], pBuffer, n);
+                    nHead           = n;
+                    done           += n;
+                }
+                else if (done <= 0)
+                    return -set_error(res);
+            }
+
+            set_error(STATUS_OK);
+            return done;
+        }
+
+        ssize_t InBufferedStream::read_byte()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            if (nHead >= nTail)
+            {
+                status_t res    = fill(1);
+                if (res != STATUS_OK)
+                    return -set_error(res);
+            }
+
+            set_error(STATUS_OK);
+            return pBuffer[nHead++];
+        }
+
+        ssize_t InBufferedStream::peek(void *dst, size_t count)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            if (count > nBufSize)
+                count       = nBufSize;
+
+            status_t res    = fill(count);
+            if ((res != STATUS_OK) && (res != STATUS_EOF))
+                return -set_error(res);
+
+            size_t n        = lsp_min(nTail - nHead, count);
+            if (n <= 0)
+                return -set_error(STATUS_EOF);
+
+            ::memcpy(dst, &pBuffer[nHead], n);
+            set_error(STATUS_OK);
+            return n;
+        }
+
+        status_t InBufferedStream::unread(size_t count)
+        {
+            if (pIS == NULL)
+                return set_error(STATUS_CLOSED);
+            if (count > nHead)
+                return set_error(STATUS_OVERFLOW);
+
+            nHead      -= count;
+            return set_error(STATUS_OK);
+        }
+
+        wssize_t InBufferedStream::seek(wsize_t position)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Try to seek within the buffered data
+            wssize_t pos    = pIS->position();
+            if (pos >= 0)
+            {
+                wsize_t base    = pos - nTail;
+                if ((position >= base) && (position <= wsize_t(pos)))
+                {
+                    nHead           = position - base;
+                    set_error(STATUS_OK);
+                    return position;
+                }
+            }
+
+            // Drop the buffer and seek the wrapped stream
+            nHead           = 0;
+            nTail           = 0;
+
+            wssize_t res    = pIS->seek(position);
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        wssize_t InBufferedStream::skip(wsize_t amount)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            size_t avail    = nTail - nHead;
+            if (amount <= avail)
+            {
+                nHead          += amount;
+                set_error(STATUS_OK);
+                return amount;
+            }
+
+            // Drop the buffer and skip the rest in the wrapped stream
+            nHead           = 0;
+            nTail           = 0;
+
+            wssize_t res    = pIS->skip(amount - avail);
+            if (res < 0)
+            {
+                if (avail > 0)
+                {
+                    set_error(STATUS_OK);
+                    return avail;
+                }
+                return -set_error(status_t(-res));
+            }
+
+            set_error(STATUS_OK);
+            return res + avail;
+        }
+    
+    } /* namespace io */
+} /* namespace lsp */
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InMappedStream.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        static const uint8_t empty_file[1] = { 0 };
+
+        InMappedStream::InMappedStream()
+        {
+        }
+        
+        InMappedStream::~InMappedStream()
+        {
+            InMemoryStream::drop();
+            sFile.close();
+        }
+
+        status_t InMappedStream::open(const char *path)
+        {
+            if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp);
+        }
+
+        status_t InMappedStream::open(const LSPString *path)
+        {
+            if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            if ((pData != NULL) || (sFile.opened()))
+                return set_error(STATUS_BAD_STATE);
+
+            status_t res = sFile.open(path);
+            if (res != STATUS_OK)
+                return set_error(res);
+
+            // Empty file has no mapping but still should be readable until EOF
+            const uint8_t *data = sFile.data();
+            wrap((data != NULL) ? data : empty_file, sFile.size());
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t InMappedStream::open(const Path *path)
+        {
+            if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            return open(path->as_string());
+        }
+
+        status_t InMappedStream::close()
+        {
+            InMemoryStream::drop();
+            return set_error(sFile.close());
+        }
+    
+    } /* namespace io */
+} /* namespace lsp */
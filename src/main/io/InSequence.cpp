@@ -310,6 +310,26 @@ namespace lsp
             return read_internal();
         }
 
+        ssize_t InSequence::borrow_internal(const lsp_wchar_t **buf)
+        {
+            while (true)
+            {
+                // Try to borrow decoded characters
+                ssize_t fetched = sDecoder.borrow(buf);
+                if (fetched > 0)
+                    return fetched;
+                else if (fetched < 0)
+                    return -set_error(-fetched);
+
+                // No data to fetch? Try to fill buffer
+                ssize_t filled  = sDecoder.fill(pIS);
+                if (filled < 0)
+                    return -set_error(-filled);
+                else if (filled == 0)
+                    return -set_error(STATUS_EOF);
+            }
+        }
+
         status_t InSequence::read_line(LSPString *s, bool force)
         {
             if (pIS == NULL)
@@ -317,27 +337,36 @@ namespace lsp
 
             while (true)
             {
-                // Try to fetch character
-                lsp_swchar_t ch = read_internal();
-                if (ch < 0)
+                // Borrow decoded characters
+                const lsp_wchar_t *buf;
+                ssize_t avail   = borrow_internal(&buf);
+                if (avail < 0)
                 {
-                    if (ch == -STATUS_EOF)
+                    if (avail == -STATUS_EOF)
                         break;
-                    return set_error(-ch);
+                    return set_error(-avail);
                 }
 
-                // End of line?
-                if (ch == '\n')
+                // Look for end of line
+                ssize_t n       = 0;
+                while ((n < avail) && (buf[n] != '\n'))
+                    ++n;
+
+                // Append characters
+                if (!sLine.append(buf, n))
+                    return set_error(STATUS_NO_MEM);
+                if (n >= avail)
                 {
-                    if (sLine.last() == '\r')
-                        sLine.set_length(sLine.length() - 1);
-                    s->take(&sLine);
-                    return set_error(STATUS_OK);
+                    sDecoder.skip(n);
+                    continue;
                 }
+                sDecoder.skip(n + 1);
 
-                // Append character
-                if (!sLine.append(lsp_wchar_t(ch)))
-                    return set_error(STATUS_NO_MEM);
+                // End of line
+                if (sLine.last() == '\r')
+                    sLine.set_length(sLine.length() - 1);
+                s->take(&sLine);
+                return set_error(STATUS_OK);
             }
 
             // Check force flag
@@ -350,10 +379,47 @@ namespace lsp
             return set_error(STATUS_EOF);
         }
 
+        ssize_t InSequence::borrow(const lsp_wchar_t **buf)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            else if (buf == NULL)
+                return -set_error(STATUS_BAD_ARGUMENTS);
+
+            // Clear line buffer
+            sLine.clear();
+
+            ssize_t avail   = borrow_internal(buf);
+            if (avail > 0)
+                set_error(STATUS_OK);
+            return avail;
+        }
+
         ssize_t InSequence::skip(size_t count)
         {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Clear line buffer
             sLine.clear();
-            return IInSequence::skip(count);
+
+            size_t skipped  = 0;
+            while (skipped < count)
+            {
+                const lsp_wchar_t *buf;
+                ssize_t avail   = borrow_internal(&buf);
+                if (avail <= 0)
+                {
+                    if (skipped > 0)
+                        break;
+                    return (avail == -STATUS_EOF) ? 0 : avail;
+                }
+
+                skipped        += sDecoder.skip(lsp_min(size_t(avail), count - skipped));
+            }
+
+            set_error(STATUS_OK);
+            return skipped;
         }
 
     }
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InSequenceReader.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        InSequenceReader::InSequenceReader(IInSequence *in)
+        {
+            pIn         = in;
+            pStart      = NULL;
+            pHead       = NULL;
+            pTail       = NULL;
+            bDirect     = false;
+        }
+
+        InSequenceReader::~InSequenceReader()
+        {
+            pIn         = NULL;
+            pStart      = NULL;
+            pHead       = NULL;
+            pTail       = NULL;
+        }
+
+        void InSequenceReader::wrap(IInSequence *in)
+        {
+            pIn         = in;
+            pStart      = NULL;
+            pHead       = NULL;
+            pTail       = NULL;
+            bDirect     = false;
+        }
+
+        status_t InSequenceReader::commit()
+        {
+            size_t count    = pHead - pStart;
+            pStart          = NULL;
+            pHead           = NULL;
+            pTail           = NULL;
+
+            if ((count <= 0) || (pIn == NULL))
+                return STATUS_OK;
+
+            ssize_t res     = pIn->skip(count);
+            if (res < 0)
+                return status_t(-res);
+            return (size_t(res) == count) ? STATUS_OK : STATUS_IO_ERROR;
+        }
+
+        lsp_swchar_t InSequenceReader::fill()
+        {
+            if (pIn == NULL)
+                return -STATUS_CLOSED;
+            else if (bDirect)
+                return pIn->read();
+
+            // Consume the previous window
+            status_t res    = commit();
+            if (res != STATUS_OK)
+                return -res;
+
+            // Borrow the next window
+            const lsp_wchar_t *buf = NULL;
+            ssize_t n       = pIn->borrow(&buf);
+            if (n > 0)
+            {
+                pStart          = buf;
+                pHead           = &buf[1];
+                pTail           = &buf[n];
+                return buf[0];
+            }
+            else if (n == 0)
+                return -STATUS_EOF;
+            else if (n != -STATUS_NOT_SUPPORTED)
+                return n;
+
+            // Borrowing is not supported, read characters one by one
+            bDirect         = true;
+            return pIn->read();
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
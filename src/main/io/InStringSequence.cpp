@@ -69,6 +69,7 @@ namespace lsp
             else if (in == NULL)
                 return set_error(STATUS_BAD_ARGUMENTS);
             pString     = in;
+            nOffset     = 0;
             bDelete     = del;
             nMark       = -1;
             nMarkLen    = 0;
@@ -213,6 +214,22 @@ namespace lsp
             return set_error(STATUS_OK);
         }
 
+        ssize_t InStringSequence::borrow(const lsp_wchar_t **buf)
+        {
+            if (pString == NULL)
+                return -set_error(STATUS_CLOSED);
+            else if (buf == NULL)
+                return -set_error(STATUS_BAD_ARGUMENTS);
+
+            size_t avail = pString->length() - nOffset;
+            if (avail <= 0)
+                return -set_error(STATUS_EOF);
+
+            *buf        = &pString->characters()[nOffset];
+            set_error(STATUS_OK);
+            return avail;
+        }
+
         ssize_t InStringSequence::skip(size_t count)
         {
             if (pString == NULL)
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/MappedFile.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <fileapi.h>
+    #include <memoryapi.h>
+#endif /* PLATFORM_WINDOWS */
+
+#if defined(PLATFORM_UNIX_COMPATIBLE)
+    #include <unistd.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <errno.h>
+#endif /* PLATFORM_UNIX_COMPATIBLE */
+
+namespace lsp
+{
+    namespace io
+    {
+        
+        MappedFile::MappedFile()
+        {
+            pData       = NULL;
+            nSize       = 0;
+            bOpened     = false;
+        #if defined(PLATFORM_WINDOWS)
+            hMapping    = NULL;
+        #endif /* PLATFORM_WINDOWS */
+        }
+        
+        MappedFile::~MappedFile()
+        {
+            close();
+        }
+
+        status_t MappedFile::open(const char *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return STATUS_NO_MEM;
+            return open(&tmp);
+        }
+
+        status_t MappedFile::open(const Path *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            return open(path->as_string());
+        }
+
+    #if defined(PLATFORM_WINDOWS)
+        status_t MappedFile::open(const LSPString *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (bOpened)
+                return STATUS_BAD_STATE;
+
+            HANDLE fd = CreateFileW(path->get_utf16(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                    NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            if (fd == INVALID_HANDLE_VALUE)
+            {
+                switch (GetLastError())
+                {
+                    case ERROR_FILE_NOT_FOUND: case ERROR_PATH_NOT_FOUND: return STATUS_NOT_FOUND;
+                    case ERROR_ACCESS_DENIED: return STATUS_PERMISSION_DENIED;
+                    default: break;
+                }
+                return STATUS_IO_ERROR;
+            }
+
+            LARGE_INTEGER fsize;
+            if (!GetFileSizeEx(fd, &fsize))
+            {
+                CloseHandle(fd);
+                return STATUS_IO_ERROR;
+            }
+            if (wsize_t(fsize.QuadPart) > wsize_t(~size_t(0)))
+            {
+                CloseHandle(fd);
+                return STATUS_OVERFLOW;
+            }
+
+            // Empty files can not be mapped, expose them as empty span
+            if (fsize.QuadPart <= 0)
+            {
+                CloseHandle(fd);
+                bOpened     = true;
+                return STATUS_OK;
+            }
+
+            HANDLE hmap = CreateFileMappingW(fd, NULL, PAGE_READONLY, 0, 0, NULL);
+            CloseHandle(fd);            // The mapping holds it's own reference to the file
+            if (hmap == NULL)
+                return STATUS_IO_ERROR;
+
+            void *ptr   = MapViewOfFile(hmap, FILE_MAP_READ, 0, 0, 0);
+            if (ptr == NULL)
+            {
+                CloseHandle(hmap);
+                return STATUS_NO_MEM;
+            }
+
+            pData       = reinterpret_cast<uint8_t *>(ptr);
+            nSize       = size_t(fsize.QuadPart);
+            hMapping    = hmap;
+            bOpened     = true;
+
+            return STATUS_OK;
+        }
+
+        status_t MappedFile::close()
+        {
+            if (!bOpened)
+                return STATUS_OK;
+
+            status_t res = STATUS_OK;
+            if (pData != NULL)
+            {
+                if (!UnmapViewOfFile(pData))
+                    res         = STATUS_IO_ERROR;
+                pData       = NULL;
+            }
+            if (hMapping != NULL)
+            {
+                CloseHandle(reinterpret_cast<HANDLE>(hMapping));
+                hMapping    = NULL;
+            }
+            nSize       = 0;
+            bOpened     = false;
+
+            return res;
+        }
+    #else
+        status_t MappedFile::open(const LSPString *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (bOpened)
+                return STATUS_BAD_STATE;
+
+            int fd      = ::open(path->get_native(), O_RDONLY);
+            if (fd < 0)
+            {
+                int code = errno;
+                status_t res = STATUS_IO_ERROR;
+
+                switch (code)
+                {
+                    case EPERM: case EACCES: res = STATUS_PERMISSION_DENIED; break;
+                    case ENAMETOOLONG: res = STATUS_OVERFLOW; break;
+                    case ENOENT: res = STATUS_NOT_FOUND; break;
+                    case ENOMEM: res = STATUS_NO_MEM; break;
+                    case ENOTDIR: res = STATUS_NOT_DIRECTORY; break;
+                    default: break;
+                }
+
+                return res;
+            }
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                return STATUS_IO_ERROR;
+            }
+            if (S_ISDIR(st.st_mode))
+            {
+                ::close(fd);
+                return STATUS_IS_DIRECTORY;
+            }
+            if (!S_ISREG(st.st_mode))
+            {
+                ::close(fd);
+                return STATUS_BAD_TYPE;
+            }
+            if (wsize_t(st.st_size) > wsize_t(~size_t(0)))
+            {
+                ::close(fd);
+                return STATUS_OVERFLOW;
+            }
+
+            // Empty files can not be mapped, expose them as empty span
+            if (st.st_size <= 0)
+            {
+                ::close(fd);
+                bOpened     = true;
+                return STATUS_OK;
+            }
+
+            size_t size = size_t(st.st_size);
+            void *ptr   = ::mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+            int code    = (ptr == MAP_FAILED) ? errno : 0; // close() may overwrite errno
+            ::close(fd);                // The mapping holds it's own reference to the file
+            if (ptr == MAP_FAILED)
+                return (code == ENOMEM) ? STATUS_NO_MEM : STATUS_IO_ERROR;
+
+            pData       = reinterpret_cast<uint8_t *>(ptr);
+            nSize       = size;
+            bOpened     = true;
+
+            return STATUS_OK;
+        }
+
+        status_t MappedFile::close()
+        {
+            if (!bOpened)
+                return STATUS_OK;
+
+            status_t res = STATUS_OK;
+            if (pData != NULL)
+            {
+                if (::munmap(pData, nSize) != 0)
+                    res         = STATUS_IO_ERROR;
+                pData       = NULL;
+            }
+            nSize       = 0;
+            bOpened     = false;
+
+            return res;
+        }
+    #endif /* PLATFORM_WINDOWS */
+    
+    } /* namespace io */
+} /* namespace lsp */
@@ -21,6 +21,7 @@
 
 #include <lsp-plug.in/io/OutBitStream.h>
 #include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/io/OutBufferedStream.h>
 #include <lsp-plug.in/common/endian.h>
 
 #define BITSTREAM_BUFSZ     (sizeof(umword_t) * 8)
@@ -102,7 +103,7 @@ namespace lsp
             else if (path == NULL)
                 return set_error(STATUS_BAD_ARGUMENTS);
 
-            OutFileStream *f = new OutFileStream();
+            OutBufferedStream *f = new OutBufferedStream();
             if (f == NULL)
                 return set_error(STATUS_NO_MEM);
             status_t res = f->open(path, mode);
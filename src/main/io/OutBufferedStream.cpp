@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/io/OutBufferedStream.h>
+#include <lsp-plug.in/io/OutFileStream.h>
+
+#define BUFFERED_STREAM_BUFSZ       0x10000
+
+namespace lsp
+{
+    namespace io
+    {
+        OutBufferedStream::OutBufferedStream(size_t buf_size)
+        {
+            pOS         = NULL;
+            nWrapFlags  = 0;
+            pBuffer     = NULL;
+            pData       = NULL;
+            nBufSize    = align_size((buf_size > 0) ? buf_size : BUFFERED_STREAM_BUFSZ, DEFAULT_ALIGN);
+            nFill       = 0;
+        }
+
+        OutBufferedStream::~OutBufferedStream()
+        {
+            if (pOS != NULL)
+            {
+                flush_buffer();
+
+                if (nWrapFlags & WRAP_CLOSE)
+                    pOS->close();
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pOS;
+                pOS         = NULL;
+            }
+
+            nFill       = 0;
+            free_aligned(pData);
+            pBuffer     = NULL;
+        }
+
+        status_t OutBufferedStream::close()
+        {
+            status_t res = STATUS_OK, tres;
+
+            // Close file descriptor
+            if (pOS != NULL)
+            {
+                // Flush buffers
+                res = flush_buffer();
+
+                // Perform close
+                if (nWrapFlags & WRAP_CLOSE)
+                {
+                    tres = pOS->close();
+                    if (res == STATUS_OK)
+                        res = tres;
+                }
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pOS;
+                pOS         = NULL;
+            }
+            nWrapFlags  = 0;
+            nFill       = 0;
+
+            // Return result
+            return set_error(res);
+        }
+
+        status_t OutBufferedStream::open(const char *path, size_t mode)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp, mode);
+        }
+
+        status_t OutBufferedStream::open(const LSPString *path, size_t mode)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            OutFileStream *f = new OutFileStream();
+            if (f == NULL)
+                return set_error(STATUS_NO_MEM);
+            status_t res = f->open(path, mode);
+            if (res == STATUS_OK)
+                res = wrap(f, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufferedStream::open(const io::Path *path, size_t mode)
+        {
+            if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            return open(path->as_string(), mode);
+        }
+
+        status_t OutBufferedStream::wrap(FILE *fd, bool close)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (fd == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            OutFileStream *f = new OutFileStream();
+            if (f == NULL)
+                return set_error(STATUS_NO_MEM);
+            status_t res = f->wrap(fd, close);
+            if (res == STATUS_OK)
+                res = wrap(f, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufferedStream::wrap_native(fhandle_t fd, bool close)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+
+            OutFileStream *f = new OutFileStream();
+            if (f == NULL)
+                return set_error(STATUS_NO_MEM);
+            status_t res = f->wrap_native(fd, close);
+            if (res == STATUS_OK)
+                res = wrap(f, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufferedStream::wrap(File *fd, size_t flags)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (fd == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            OutFileStream *f = new OutFileStream();
+            if (f == NULL)
+                return set_error(STATUS_NO_MEM);
+            status_t res = f->wrap(fd, flags);
+            if (res == STATUS_OK)
+                res = wrap(f, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufferedStream::wrap(IOutStream *os, size_t flags)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (os == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            // Allocate the buffer once, it is kept between close() and wrap()
+            if (pBuffer == NULL)
+            {
+                pBuffer     = alloc_aligned<uint8_t>(pData, nBufSize);
+                if (pBuffer == NULL)
+                    return set_error(STATUS_NO_MEM);
+            }
+
+            // Store pointers
+            pOS         = os;
+            nWrapFlags  = flags;
+            nFill       = 0;
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t OutBufferedStream::flush_buffer()
+        {
+            size_t off  = 0;
+            while (off < nFill)
+            {
+                ssize_t n   = pOS->write(&pBuffer[off], nFill - off);
+                if (n <= 0)
+                {
+                    // Keep the data that has not been written yet
+                    if (off > 0)
+                    {
+                        ::memmove(pBuffer, &pBuffer[off], nFill - off);
+                        nFill      -= off;
+                    }
+                    return set_error((n < 0) ? status_t(-n) : STATUS_IO_ERROR);
+                }
+                off        += n;
+            }
+
+            nFill       = 0;
+            return set_error(STATUS_OK);
+        }
+
+        wssize_t OutBufferedStream::position()
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            wssize_t res    = pOS->position();
+            if (res < 0)
+                return -set_error(status_t(-res));
+
+            set_error(STATUS_OK);
+            return res + nFill;
+        }
+
+        ssize_t OutBufferedStream::write(const void *buf, size_t count)
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            const uint8_t *src  = reinterpret_cast<const uint8_t *>(buf);
+            size_t done         = 0;
+            status_t res;
+
+            while (done < count)
+            {
+                size_t left         = count - done;
+
+                // Large write with empty buffer, pass it directly to the wrapped stream
+                if ((nFill == 0) && (left >= nBufSize))
+                {
+                    ssize_t n           = pOS->write(&src[done], left);
+                    if (n <= 0)
+                    {
+                        if (done > 0)
+                            break;
+                        return -set_error((n < 0) ? status_t(-n) : STATUS_IO_ERROR);
+                    }
+                    done               += n;
+                    continue;
+                }
+
+                // Append data to the buffer and flush it if it becomes full
+                size_t n            = lsp_min(nBufSize - nFill, left);
+                ::memcpy(&pBuffer[nFill], &src[done], n);
+                nFill              += n;
+                done               += n;
+
+                // Data is already accepted by the buffer, report only the error
+                // that happened before any byte has been accepted
+                if (nFill >= nBufSize)
+                {
+                    if ((res = flush_buffer()) != STATUS_OK)
+                    {
+                        if (done > 0)
+                            break;
+                        return -res;
+                    }
+                }
+            }
+
+            set_error(STATUS_OK);
+            return done;
+        }
+
+        ssize_t OutBufferedStream::writeb(int v)
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            if (nFill >= nBufSize)
+            {
+                status_t res = flush_buffer();
+                if (res != STATUS_OK)
+                    return -res;
+            }
+
+            pBuffer[nFill++]    = uint8_t(v);
+            set_error(STATUS_OK);
+            return 1;
+        }
+
+        wssize_t OutBufferedStream::seek(wsize_t position)
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            status_t res    = flush_buffer();
+            if (res != STATUS_OK)
+                return -res;
+
+            wssize_t pos    = pOS->seek(position);
+            set_error((pos < 0) ? status_t(-pos) : STATUS_OK);
+            return pos;
+        }
+
+        status_t OutBufferedStream::flush()
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+
+            status_t res    = flush_buffer();
+            if (res != STATUS_OK)
+                return res;
+
+            return set_error(pOS->flush());
+        }
+    
+    } /* namespace io */
+} /* namespace lsp */
@@ -29,6 +29,10 @@
 #include <stdlib.h>
 #include <wctype.h>
 
+#if defined(ARCH_X86) && defined(__SSE2__)
+    #include <emmintrin.h>
+#endif /* ARCH_X86 */
+
 namespace lsp
 {
 #if defined(PLATFORM_WINDOWS)
@@ -611,6 +615,53 @@ namespace lsp
     }
 #endif
 
+    typedef struct native_charset_name_t
+    {
+        const char         *name;
+        native_charset_t    charset;
+    } native_charset_name_t;
+
+    // Names are stored in upper case without '-', '_' and ' ' delimiters
+    static const native_charset_name_t native_charset_names[] =
+    {
+        { "UTF8",           NCS_UTF8        },
+        { "UTF16LE",        NCS_UTF16LE     },
+        { "UTF16BE",        NCS_UTF16BE     },
+        { "ASCII",          NCS_ASCII       },
+        { "USASCII",        NCS_ASCII       },
+        { "LATIN1",         NCS_LATIN1      },
+        { "ISO88591",       NCS_LATIN1      },
+        { NULL,             NCS_NONE        }
+    };
+
+    native_charset_t native_charset(const char *charset)
+    {
+        if (charset == NULL)
+            return NCS_NONE;
+
+        // Normalize the name
+        char buf[16];
+        size_t n = 0;
+        for ( ; *charset != '\0'; ++charset)
+        {
+            char c = *charset;
+            if ((c == '-') || (c == '_') || (c == ' '))
+                continue;
+            if (n >= (sizeof(buf) - 1))
+                return NCS_NONE;
+            buf[n++]    = ((c >= 'a') && (c <= 'z')) ? c - 'a' + 'A' : c;
+        }
+        buf[n]      = '\0';
+
+        for (const native_charset_name_t *p = native_charset_names; p->name != NULL; ++p)
+        {
+            if (!::strcmp(p->name, buf))
+                return p->charset;
+        }
+
+        return NCS_NONE;
+    }
+
     //-------------------------------------------------------------------------
     // UTF-16 helper routines
     lsp_utf32_t read_utf16le_codepoint(const lsp_utf16_t **str)
@@ -988,6 +1039,93 @@ namespace lsp
             return (cp >= 0x80) ? 2 : 1;
     }
 
+    size_t ascii_to_utf32(lsp_utf32_t *dst, const char *src, size_t n)
+    {
+        size_t i = 0;
+
+    #if defined(ARCH_X86) && defined(__SSE2__)
+        // Process 16 characters per iteration
+        const __m128i zero  = _mm_setzero_si128();
+        for ( ; (i + 16) <= n; i += 16)
+        {
+            __m128i v           = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i]));
+            // Stop at bytes with the highest bit set and at zero bytes
+            if (_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, zero))) != 0)
+                break;
+
+            __m128i lo          = _mm_unpacklo_epi8(v, zero);
+            __m128i hi          = _mm_unpackhi_epi8(v, zero);
+            __m128i *d          = reinterpret_cast<__m128i *>(&dst[i]);
+            _mm_storeu_si128(&d[0], _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(&d[1], _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(&d[2], _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(&d[3], _mm_unpackhi_epi16(hi, zero));
+        }
+    #else
+        // Process machine words, stop at bytes with the highest bit set and at zero bytes
+        const umword_t lsb  = umword_t(-1) / 0xff;      // 0x0101...01
+        const umword_t msb  = lsb << 7;                 // 0x8080...80
+        for ( ; (i + sizeof(umword_t)) <= n; i += sizeof(umword_t))
+        {
+            umword_t w;
+            ::memcpy(&w, &src[i], sizeof(umword_t));
+            if ((w | ((w - lsb) & (~w))) & msb)
+                break;
+            for (size_t j=0; j<sizeof(umword_t); ++j)
+                dst[i + j]      = uint8_t(src[i + j]);
+        }
+    #endif /* ARCH_X86 */
+
+        // Process the tail
+        for ( ; i < n; ++i)
+        {
+            uint8_t c           = src[i];
+            if ((c == 0) || (c >= 0x80))
+                break;
+            dst[i]              = c;
+        }
+
+        return i;
+    }
+
+    size_t utf32_to_ascii(char *dst, const lsp_utf32_t *src, size_t n)
+    {
+        size_t i = 0;
+
+    #if defined(ARCH_X86) && defined(__SSE2__)
+        // Process 16 characters per iteration
+        const __m128i zero  = _mm_setzero_si128();
+        const __m128i mask  = _mm_set1_epi32(~0x7f);
+        for ( ; (i + 16) <= n; i += 16)
+        {
+            const __m128i *s    = reinterpret_cast<const __m128i *>(&src[i]);
+            __m128i a           = _mm_loadu_si128(&s[0]);
+            __m128i b           = _mm_loadu_si128(&s[1]);
+            __m128i c           = _mm_loadu_si128(&s[2]);
+            __m128i d           = _mm_loadu_si128(&s[3]);
+
+            // Stop at code points that do not fit into 7 bits
+            __m128i x           = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(x, zero)) != 0xffff)
+                break;
+
+            __m128i v           = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[i]), v);
+        }
+    #endif /* ARCH_X86 */
+
+        // Process the tail
+        for ( ; i < n; ++i)
+        {
+            lsp_utf32_t c       = src[i];
+            if (c >= 0x80)
+                break;
+            dst[i]              = char(c);
+        }
+
+        return i;
+    }
+
     void write_utf8_codepoint(char **str, lsp_utf32_t cp)
     {
         char *dst = *str;
@@ -1002,7 +1140,7 @@ namespace lsp
             }
             else if (cp < 0x200000) // 4 bytes
             {
-                dst[0]      = (cp >> 16) | 0xf0;
+                dst[0]      = (cp >> 18) | 0xf0;
                 dst[1]      = ((cp >> 12) & 0x3f) | 0x80;
                 dst[2]      = ((cp >> 6) & 0x3f) | 0x80;
                 dst[3]      = (cp & 0x3f) | 0x80;
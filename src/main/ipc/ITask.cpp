@@ -21,6 +21,14 @@
 
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/ipc/ITask.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/Semaphore.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#define WAITERS_ON_STACK        32
+#define SUBMIT_ATTEMPTS         64
 
 namespace lsp
 {
@@ -28,9 +36,16 @@ namespace lsp
     {
         ITask::ITask()
         {
-            nState  = TS_IDLE;
-            nCode   = 0;
-            pNext   = NULL;
+            nState          = TS_IDLE;
+            nCode           = 0;
+            pNext           = NULL;
+
+            atomic_init(nLock);
+            pWaiters        = NULL;
+            pCallback       = NULL;
+            pCbArg          = NULL;
+            pThen           = NULL;
+            pThenExecutor   = NULL;
         }
 
         ITask::~ITask()
@@ -41,6 +56,257 @@ namespace lsp
         {
             return 0;
         }
+
+        void ITask::lock()
+        {
+            // The lock is held for a very short period of time
+            while (!atomic_trylock(nLock))
+                Thread::yield();
+        }
+
+        void ITask::unlock()
+        {
+            atomic_unlock(nLock);
+        }
+
+        void ITask::complete()
+        {
+            // Take all completion data and commit the state at once. The task
+            // may be destroyed by other thread as soon as its state becomes
+            // COMPLETED, so the task should not be accessed after that
+            lock();
+            task_callback_t cb      = pCallback;
+            void *cb_arg            = pCbArg;
+            ITask *then             = pThen;
+            IExecutor *executor     = pThenExecutor;
+            waiter_t *waiters       = pWaiters;
+            pCallback               = NULL;
+            pCbArg                  = NULL;
+            pThen                   = NULL;
+            pThenExecutor           = NULL;
+            pWaiters                = NULL;
+            nState                  = TS_COMPLETED;
+            unlock();
+
+            // Wake up waiting threads. The waiter may leave as soon as
+            // its semaphore is posted, so obtain the next item first
+            while (waiters != NULL)
+            {
+                waiter_t *next          = waiters->pNext;
+                waiters->pSem->post();
+                waiters                 = next;
+            }
+
+            // Call completion handlers, only the pointer to the task is passed
+            if (cb != NULL)
+                cb(this, cb_arg);
+            if (then != NULL)
+                submit_then(then, executor);
+        }
+
+        void ITask::submit_then(ITask *task, IExecutor *executor)
+        {
+            // Executor may refuse the task because of contention, retry a bit
+            for (size_t i=0; i<SUBMIT_ATTEMPTS; ++i)
+            {
+                if (executor->submit(task))
+                    return;
+                // The task is owned by someone else and will complete
+                if (!task->idle())
+                    return;
+                Thread::yield();
+            }
+
+            // Executor does not accept tasks, do not leave waiters blocked
+            task->nCode     = STATUS_CANCELLED;
+            task->complete();
+        }
+
+        bool ITask::add_waiter(waiter_t *w)
+        {
+            lock();
+            bool res        = nState != TS_COMPLETED;
+            if (res)
+            {
+                w->pNext        = pWaiters;
+                pWaiters        = w;
+            }
+            unlock();
+
+            return res;
+        }
+
+        bool ITask::remove_waiter(waiter_t *w)
+        {
+            lock();
+            for (waiter_t **pw = &pWaiters; *pw != NULL; pw = &(*pw)->pNext)
+            {
+                if (*pw == w)
+                {
+                    *pw             = w->pNext;
+                    unlock();
+                    return true;
+                }
+            }
+            unlock();
+
+            return false;
+        }
+
+        bool ITask::on_complete(task_callback_t callback, void *arg)
+        {
+            lock();
+            if (nState == TS_COMPLETED)
+            {
+                unlock();
+                callback(this, arg);
+                return true;
+            }
+
+            bool res        = pCallback == NULL;
+            if (res)
+            {
+                pCallback       = callback;
+                pCbArg          = arg;
+            }
+            unlock();
+
+            return res;
+        }
+
+        bool ITask::then(ITask *task, IExecutor *executor)
+        {
+            if ((task == NULL) || (executor == NULL))
+                return false;
+
+            lock();
+            if (nState == TS_COMPLETED)
+            {
+                unlock();
+                return executor->submit(task);
+            }
+
+            bool res        = pThen == NULL;
+            if (res)
+            {
+                pThen           = task;
+                pThenExecutor   = executor;
+            }
+            unlock();
+
+            return res;
+        }
+
+        ssize_t ITask::wait_for(ITask * const *tasks, size_t count, bool timed, wsize_t millis)
+        {
+            // Fast path: check that some task is already completed
+            for (size_t i=0; i<count; ++i)
+                if (tasks[i]->completed())
+                    return i;
+            if ((count <= 0) || ((timed) && (millis <= 0)))
+                return -STATUS_TIMED_OUT;
+
+            waiter_t vlocal[WAITERS_ON_STACK];
+            waiter_t *waiters   = vlocal;
+            if (count > WAITERS_ON_STACK)
+            {
+                waiters             = static_cast<waiter_t *>(::malloc(count * sizeof(waiter_t)));
+                if (waiters == NULL)
+                    return -STATUS_NO_MEM;
+            }
+
+            // Register waiters, stop if some task has been completed
+            Semaphore sem;
+            size_t added        = 0;
+            for ( ; added < count; ++added)
+            {
+                waiters[added].pSem     = &sem;
+                waiters[added].pNext    = NULL;
+                if (!tasks[added]->add_waiter(&waiters[added]))
+                    break;
+            }
+
+            // Wait for the signal
+            size_t received     = 0;
+            if (added >= count)
+            {
+                bool signalled      = (timed) ? sem.wait(millis) : sem.wait();
+                if (signalled)
+                    ++received;
+            }
+
+            // Unregister waiters. The waiter that can not be found in the list
+            // has been taken by the completed task which will post the semaphore
+            size_t taken        = 0;
+            for (size_t i=0; i<added; ++i)
+            {
+                if (!tasks[i]->remove_waiter(&waiters[i]))
+                    ++taken;
+            }
+
+            // Receive all pending signals before destroying the semaphore
+            for ( ; received < taken; ++received)
+                sem.wait();
+
+            if (waiters != vlocal)
+                ::free(waiters);
+
+            // Find the completed task
+            for (size_t i=0; i<count; ++i)
+                if (tasks[i]->completed())
+                    return i;
+
+            return -STATUS_TIMED_OUT;
+        }
+
+        bool ITask::wait()
+        {
+            ITask *self     = this;
+            return wait_for(&self, 1, false, 0) >= 0;
+        }
+
+        bool ITask::wait(wsize_t millis)
+        {
+            ITask *self     = this;
+            return wait_for(&self, 1, true, millis) >= 0;
+        }
+
+        ssize_t ITask::wait_any(ITask * const *tasks, size_t count)
+        {
+            return wait_for(tasks, count, false, 0);
+        }
+
+        ssize_t ITask::wait_any(ITask * const *tasks, size_t count, wsize_t millis)
+        {
+            return wait_for(tasks, count, true, millis);
+        }
+
+        bool ITask::wait_all(ITask * const *tasks, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                if (wait_for(&tasks[i], 1, false, 0) < 0)
+                    return false;
+            }
+            return true;
+        }
+
+        bool ITask::wait_all(ITask * const *tasks, size_t count, wsize_t millis)
+        {
+            system::time_t ts;
+            system::get_time(&ts);
+            wsize_t deadline    = wsize_t(ts.seconds) * 1000 + ts.nanos / 1000000 + millis;
+
+            for (size_t i=0; i<count; ++i)
+            {
+                system::get_time(&ts);
+                wsize_t now         = wsize_t(ts.seconds) * 1000 + ts.nanos / 1000000;
+                wsize_t left        = (now < deadline) ? deadline - now : 0;
+                if (wait_for(&tasks[i], 1, true, left) < 0)
+                    return false;
+            }
+            return true;
+        }
     }
 
 } /* namespace lsp */
@@ -32,6 +32,7 @@ namespace lsp
             // Initialize list
             pHead       = NULL;
             pTail       = NULL;
+            bShutdown   = false;
             atomic_init(nLock);
         }
 
@@ -66,8 +67,9 @@ namespace lsp
                 pHead   = task;
             pTail   = task;
 
-            // Release critical section
+            // Release critical section and wake up the thread
             atomic_unlock(nLock);
+            sWakeup.post();
             return true;
         }
 
@@ -75,24 +77,9 @@ namespace lsp
         {
             lsp_trace("start shutdown");
 
-            // Wait until the queue is empty
-            while (true)
-            {
-                // Try to acquire critical section
-                if (atomic_trylock(nLock))
-                {
-                    // Check that queue is empty
-                    if (pHead == NULL)
-                        break;
-                    // Release critical section
-                    atomic_unlock(nLock);
-                }
-
-                ipc::Thread::sleep(100);
-            }
-
-            // Now there are no pending tasks, terminate thread
-            hThread.cancel();
+            // Request the thread to leave as soon as the queue becomes empty
+            bShutdown   = true;
+            sWakeup.post();
             hThread.join();
 
             lsp_trace("shutdown complete");
@@ -102,11 +89,12 @@ namespace lsp
         {
             while (!ipc::Thread::is_cancelled())
             {
-                // Sleep until critical section is acquired
+                // Spin until critical section is acquired, submit() holds it for a short time
                 while (!atomic_trylock(nLock))
                 {
-                    if (ipc::Thread::sleep(100) == STATUS_CANCELLED)
+                    if (ipc::Thread::is_cancelled())
                         return;
+                    ipc::Thread::yield();
                 }
 
                 // Try to get task
@@ -116,9 +104,12 @@ namespace lsp
                     // Release critical section
                     atomic_unlock(nLock);
 
-                    // Wait for a while
-                    if (ipc::Thread::sleep(100) == STATUS_CANCELLED)
+                    // Leave if there are no more tasks and shutdown was requested
+                    if (bShutdown)
                         return;
+
+                    // Wait until new task is submitted or shutdown is requested
+                    sWakeup.wait();
                 }
                 else
                 {
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/ipc/Semaphore.h>
+
+#include <time.h>
+#include <limits.h>
+
+namespace lsp
+{
+    namespace ipc
+    {
+#if defined(PLATFORM_WINDOWS)
+        Semaphore::Semaphore()
+        {
+            hSem        = CreateSemaphoreW(NULL, 0, LONG_MAX, NULL);
+        }
+
+        Semaphore::~Semaphore()
+        {
+            CloseHandle(hSem);
+        }
+
+        bool Semaphore::post()
+        {
+            return ReleaseSemaphore(hSem, 1, NULL) != 0;
+        }
+
+        bool Semaphore::wait()
+        {
+            return WaitForSingleObject(hSem, INFINITE) == WAIT_OBJECT_0;
+        }
+
+        bool Semaphore::wait(wsize_t millis)
+        {
+            DWORD timeout   = (millis < INFINITE) ? DWORD(millis) : INFINITE - 1;
+            return WaitForSingleObject(hSem, timeout) == WAIT_OBJECT_0;
+        }
+
+        bool Semaphore::try_wait()
+        {
+            return WaitForSingleObject(hSem, 0) == WAIT_OBJECT_0;
+        }
+
+#elif defined(PLATFORM_LINUX)
+        // The counter holds the number of signals in upper bits,
+        // bit 0 tells that some threads may sleep on the futex
+        #define SEM_SLEEPERS        1
+        #define SEM_SIGNAL          2
+
+        Semaphore::Semaphore()
+        {
+            nCount      = 0;
+            nWaiters    = 0;
+        }
+
+        Semaphore::~Semaphore()
+        {
+        }
+
+        bool Semaphore::post()
+        {
+            // Publish the signal and take the sleepers flag at once. The woken
+            // thread restores the flag if there are more waiters
+            atomic_t count;
+            do
+            {
+                count       = nCount;
+            } while (!atomic_cas(&nCount, count, (count + SEM_SIGNAL) & (~SEM_SLEEPERS)));
+
+            // The semaphore may be already destroyed by the waiter, so do not access
+            // it anymore. Waking up private futex does not access the memory
+            if (count & SEM_SLEEPERS)
+                syscall(SYS_futex, &nCount, FUTEX_WAKE_PRIVATE, 1, NULL, 0, 0);
+            return true;
+        }
+
+        bool Semaphore::try_wait()
+        {
+            while (true)
+            {
+                atomic_t count  = nCount;
+                if (count < SEM_SIGNAL)
+                    return false;
+                if (atomic_cas(&nCount, count, count - SEM_SIGNAL))
+                    return true;
+            }
+        }
+
+        bool Semaphore::wait_signal(const struct timespec *timeout)
+        {
+            atomic_t count  = nCount;
+            if (count >= SEM_SIGNAL)
+                return atomic_cas(&nCount, count, count - SEM_SIGNAL);
+
+            // Mark that there is a sleeping thread. The kernel checks that
+            // counter is still the same before sleeping, so the wakeup issued
+            // by post() can not be lost
+            if ((!(count & SEM_SLEEPERS)) && (!atomic_cas(&nCount, count, count | SEM_SLEEPERS)))
+                return false;
+            syscall(SYS_futex, &nCount, FUTEX_WAIT_PRIVATE, count | SEM_SLEEPERS, timeout, 0, 0);
+            return false;
+        }
+
+        void Semaphore::remove_waiter()
+        {
+            // post() resets the sleepers flag when it wakes up the thread,
+            // restore it and pass the signal if other threads still wait
+            atomic_add(&nWaiters, -1);
+            if (nWaiters <= 0)
+                return;
+
+            atomic_t count;
+            do
+            {
+                count       = nCount;
+            } while ((!(count & SEM_SLEEPERS)) && (!atomic_cas(&nCount, count, count | SEM_SLEEPERS)));
+
+            if (count >= SEM_SIGNAL)
+                syscall(SYS_futex, &nCount, FUTEX_WAKE_PRIVATE, 1, NULL, 0, 0);
+        }
+
+        bool Semaphore::wait()
+        {
+            if (try_wait())
+                return true;
+
+            atomic_add(&nWaiters, 1);
+            while (!wait_signal(NULL)) { }
+            remove_waiter();
+
+            return true;
+        }
+
+        bool Semaphore::wait(wsize_t millis)
+        {
+            struct timespec now, deadline, timeout;
+
+            if (try_wait())
+                return true;
+
+            ::clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec    += millis / 1000;
+            deadline.tv_nsec   += (millis % 1000) * 1000000;
+            if (deadline.tv_nsec >= 1000000000)
+            {
+                deadline.tv_sec    += 1;
+                deadline.tv_nsec   -= 1000000000;
+            }
+
+            bool res;
+            atomic_add(&nWaiters, 1);
+            while (true)
+            {
+                // Compute the remaining time
+                ::clock_gettime(CLOCK_MONOTONIC, &now);
+                timeout.tv_sec      = deadline.tv_sec - now.tv_sec;
+                timeout.tv_nsec     = deadline.tv_nsec - now.tv_nsec;
+                if (timeout.tv_nsec < 0)
+                {
+                    timeout.tv_sec     -= 1;
+                    timeout.tv_nsec    += 1000000000;
+                }
+                if (timeout.tv_sec < 0)
+                {
+                    res                 = try_wait();
+                    break;
+                }
+
+                if ((res = wait_signal(&timeout)))
+                    break;
+            }
+            remove_waiter();
+
+            return res;
+        }
+
+        #undef SEM_SLEEPERS
+        #undef SEM_SIGNAL
+
+#else
+        Semaphore::Semaphore()
+        {
+            pthread_mutex_init(&sMutex, NULL);
+            pthread_cond_init(&sCond, NULL);
+            nCount      = 0;
+        }
+
+        Semaphore::~Semaphore()
+        {
+            pthread_cond_destroy(&sCond);
+            pthread_mutex_destroy(&sMutex);
+        }
+
+        bool Semaphore::post()
+        {
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return false;
+            ++nCount;
+            pthread_cond_signal(&sCond);
+            pthread_mutex_unlock(&sMutex);
+            return true;
+        }
+
+        bool Semaphore::try_wait()
+        {
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return false;
+            bool res    = nCount > 0;
+            if (res)
+                --nCount;
+            pthread_mutex_unlock(&sMutex);
+            return res;
+        }
+
+        bool Semaphore::wait()
+        {
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return false;
+            while (nCount <= 0)
+                pthread_cond_wait(&sCond, &sMutex);
+            --nCount;
+            pthread_mutex_unlock(&sMutex);
+            return true;
+        }
+
+        bool Semaphore::wait(wsize_t millis)
+        {
+            struct timespec deadline;
+
+            ::clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec    += millis / 1000;
+            deadline.tv_nsec   += (millis % 1000) * 1000000;
+            if (deadline.tv_nsec >= 1000000000)
+            {
+                deadline.tv_sec    += 1;
+                deadline.tv_nsec   -= 1000000000;
+            }
+
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return false;
+            while (nCount <= 0)
+            {
+                if (pthread_cond_timedwait(&sCond, &sMutex, &deadline) == ETIMEDOUT)
+                    break;
+            }
+            bool res    = nCount > 0;
+            if (res)
+                --nCount;
+            pthread_mutex_unlock(&sMutex);
+            return res;
+        }
+#endif /* PLATFORM_LINUX */
+
+    } /* namespace ipc */
+} /* namespace lsp */
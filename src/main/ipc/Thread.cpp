@@ -204,6 +204,11 @@ namespace lsp
             return STATUS_OK;
         }
 
+        void Thread::yield()
+        {
+            SwitchToThread();
+        }
+
         size_t Thread::system_cores()
         {
             SYSTEM_INFO     os_sysinfo;
@@ -317,6 +322,11 @@ namespace lsp
             return STATUS_OK;
         }
 
+        void Thread::yield()
+        {
+            sched_yield();
+        }
+
         size_t Thread::system_cores()
         {
             return sysconf(_SC_NPROCESSORS_ONLN);
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/ipc/ThreadPoolExecutor.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+namespace lsp
+{
+    namespace ipc
+    {
+        ThreadPoolExecutor::ThreadPoolExecutor(size_t threads)
+        {
+            vWorkers    = NULL;
+            nWorkers    = 0;
+            nThreads    = threads;
+            nNext       = 0;
+            nPending    = 0;
+            bShutdown   = false;
+        }
+
+        ThreadPoolExecutor::~ThreadPoolExecutor()
+        {
+            destroy();
+        }
+
+        void ThreadPoolExecutor::destroy()
+        {
+            if (vWorkers == NULL)
+                return;
+
+            // Stop all threads first, then drop the workers
+            for (size_t i=0; i<nWorkers; ++i)
+            {
+                worker_t *w = vWorkers[i];
+                if ((w != NULL) && (w->pThread != NULL))
+                    w->pThread->cancel();
+            }
+            wakeup_all();
+
+            for (size_t i=0; i<nWorkers; ++i)
+            {
+                worker_t *w = vWorkers[i];
+                if (w == NULL)
+                    continue;
+                if (w->pThread != NULL)
+                {
+                    w->pThread->join();
+                    delete w->pThread;
+                    w->pThread  = NULL;
+                }
+                delete w;
+            }
+
+            ::free(vWorkers);
+            vWorkers    = NULL;
+            nWorkers    = 0;
+        }
+
+        status_t ThreadPoolExecutor::start()
+        {
+            if (vWorkers != NULL)
+                return STATUS_BAD_STATE;
+
+            size_t n    = (nThreads > 0) ? nThreads : Thread::system_cores();
+            if (n <= 0)
+                n           = 1;
+
+            vWorkers    = static_cast<worker_t **>(::malloc(n * sizeof(worker_t *)));
+            if (vWorkers == NULL)
+                return STATUS_NO_MEM;
+            for (size_t i=0; i<n; ++i)
+                vWorkers[i] = NULL;
+            nWorkers    = n;
+            bShutdown   = false;
+
+            // Create all workers before starting any of them: running workers
+            // access the whole list when stealing tasks
+            for (size_t i=0; i<n; ++i)
+            {
+                worker_t *w     = new worker_t;
+                if (w == NULL)
+                {
+                    destroy();
+                    return STATUS_NO_MEM;
+                }
+                vWorkers[i]     = w;
+
+                w->pExecutor    = this;
+                w->pThread      = NULL;
+                w->nIndex       = i;
+                w->pHead        = NULL;
+                w->pTail        = NULL;
+
+                if ((w->pThread = new Thread(execute, w)) == NULL)
+                {
+                    destroy();
+                    return STATUS_NO_MEM;
+                }
+            }
+
+            for (size_t i=0; i<n; ++i)
+            {
+                status_t res    = vWorkers[i]->pThread->start();
+                if (res != STATUS_OK)
+                {
+                    destroy();
+                    return res;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        ThreadPoolExecutor::worker_t *ThreadPoolExecutor::current_worker()
+        {
+            Thread *self    = Thread::current();
+            if (self == NULL)
+                return NULL;
+
+            for (size_t i=0; i<nWorkers; ++i)
+            {
+                worker_t *w     = vWorkers[i];
+                if (w->pThread == self)
+                    return w;
+            }
+
+            return NULL;
+        }
+
+        bool ThreadPoolExecutor::submit(ITask *task)
+        {
+            lsp_trace("submit task=%p", task);
+            // Check task state
+            if (!task->idle())
+                return false;
+
+            // The pool lock keeps shutdown() from releasing workers while
+            // the task is linked into the queue
+            if (!sPoolLock.lock())
+                return false;
+            if (vWorkers == NULL)
+            {
+                sPoolLock.unlock();
+                return false;
+            }
+
+            // Tasks submitted by workers go to the own queue of the worker.
+            // Other tasks are distributed between workers in round-robin manner
+            worker_t *w     = current_worker();
+            if (w == NULL)
+            {
+                if (bShutdown)
+                {
+                    sPoolLock.unlock();
+                    return false;
+                }
+                uatomic_t idx   = atomic_add(&nNext, 1);
+                w               = vWorkers[idx % nWorkers];
+            }
+
+            // Update task state to SUBMITTED
+            atomic_add(&nPending, 1);
+            change_task_state(task, ITask::TS_SUBMITTED);
+
+            // Append task to the queue
+            w->sLock.lock();
+            if (w->pTail != NULL)
+                link_task(w->pTail, task);
+            else
+                w->pHead    = task;
+            w->pTail    = task;
+            w->sLock.unlock();
+            sPoolLock.unlock();
+
+            // Wake up one of idle workers
+            sWakeup.post();
+
+            return true;
+        }
+
+        ITask *ThreadPoolExecutor::dequeue(worker_t *w)
+        {
+            // Fast check without locking
+            if (w->pHead == NULL)
+                return NULL;
+
+            w->sLock.lock();
+            ITask *task     = w->pHead;
+            if (task != NULL)
+            {
+                w->pHead        = next_task(task);
+                if (w->pHead == NULL)
+                    w->pTail        = NULL;
+            }
+            w->sLock.unlock();
+
+            return task;
+        }
+
+        ITask *ThreadPoolExecutor::steal(worker_t *w)
+        {
+            // Walk other workers starting from the next one
+            for (size_t i=1; i<nWorkers; ++i)
+            {
+                worker_t *victim    = vWorkers[(w->nIndex + i) % nWorkers];
+                ITask *task         = dequeue(victim);
+                if (task != NULL)
+                {
+                    lsp_trace("worker %d stole task %p from worker %d",
+                            int(w->nIndex), task, int(victim->nIndex));
+                    return task;
+                }
+            }
+
+            return NULL;
+        }
+
+        void ThreadPoolExecutor::wakeup_all()
+        {
+            for (size_t i=0; i<nWorkers; ++i)
+                sWakeup.post();
+        }
+
+        void ThreadPoolExecutor::shutdown()
+        {
+            lsp_trace("start shutdown");
+
+            // Deny submission of new tasks from outside. Any submit() that
+            // has already passed the check completes before the flag is set.
+            // Workers leave when all pending tasks are complete, including
+            // the ones submitted by running tasks
+            if (!sPoolLock.lock())
+                return;
+            if ((vWorkers == NULL) || (bShutdown))
+            {
+                sPoolLock.unlock();
+                return;
+            }
+            bShutdown   = true;
+            sPoolLock.unlock();
+
+            wakeup_all();
+            for (size_t i=0; i<nWorkers; ++i)
+                vWorkers[i]->pThread->join();
+
+            // Release workers, submit() observes either the shutdown flag
+            // or the empty list of workers
+            sPoolLock.lock();
+            destroy();
+            sPoolLock.unlock();
+
+            lsp_trace("shutdown complete");
+        }
+
+        void ThreadPoolExecutor::run(worker_t *w)
+        {
+            while (!ipc::Thread::is_cancelled())
+            {
+                // Take task from own queue first, then try to steal
+                ITask *task     = dequeue(w);
+                if (task == NULL)
+                    task            = steal(w);
+
+                if (task == NULL)
+                {
+                    // Leave if there are no more tasks and shutdown was requested
+                    if ((bShutdown) && (nPending <= 0))
+                        return;
+
+                    // Wait until new task is submitted or shutdown is requested
+                    sWakeup.wait();
+                    continue;
+                }
+
+                // Execute task
+                lsp_trace("worker %d executing task %p", int(w->nIndex), task);
+                run_task(task);
+                lsp_trace("worker %d executed task %p with code %d", int(w->nIndex), task, int(task->code()));
+
+                // The last completed task during shutdown releases all idle workers
+                atomic_add(&nPending, -1);
+                if ((bShutdown) && (nPending <= 0))
+                    wakeup_all();
+            }
+        }
+
+        status_t ThreadPoolExecutor::execute(void *params)
+        {
+            worker_t *w     = reinterpret_cast<worker_t *>(params);
+            w->pExecutor->run(w);
+            return STATUS_OK;
+        }
+    } /* namespace ipc */
+} /* namespace lsp */
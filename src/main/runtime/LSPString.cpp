@@ -25,6 +25,8 @@
 #include <lsp-plug.in/stdlib/stdio.h>
 #include <lsp-plug.in/stdlib/string.h>
 #include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
 #include <lsp-plug.in/runtime/LSPString.h>
 
 #include <stdlib.h>
@@ -32,6 +34,10 @@
 #include <wctype.h>
 #include <stdarg.h>
 
+#if defined(ARCH_X86) && defined(__SSE2__)
+    #include <emmintrin.h>
+#endif /* ARCH_X86 */
+
 #define GRANULARITY     0x20
 #define BUF_SIZE        0x200
 //#define BUF_SIZE        16
@@ -56,6 +62,24 @@
 
 namespace lsp
 {
+    // Lock for the list of temporary buffers. Spinlock is constant-initialized, so
+    // it can be used by static strings at any stage of static initialization and
+    // destruction. It is held for a very short period of time
+    static volatile atomic_t    temp_lock = 1;
+
+    static inline void lock_temp_list()
+    {
+        while (!atomic_trylock(temp_lock))
+            ipc::Thread::yield();
+    }
+
+    static inline void unlock_temp_list()
+    {
+        atomic_unlock(temp_lock);
+    }
+
+    LSPString::buffer_t *LSPString::pTempList  = NULL;
+
     static bool is_space(lsp_wchar_t c)
     {
         switch (c)
@@ -114,33 +138,334 @@ namespace lsp
         return i;
     }
 
+    inline lsp_wchar_t LSPString::xlower(lsp_wchar_t c)
+    {
+        if (c >= 0x80)
+            return towlower(c);
+        return ((c >= 'A') && (c <= 'Z')) ? c + ('a' - 'A') : c;
+    }
+
     int LSPString::xcasecmp(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n)
     {
-        while (n--)
+        for (size_t i = xmismatch_nocase(a, b, n); i < n; i += xmismatch_nocase(&a[i], &b[i], n - i))
         {
-            int32_t retval = int32_t(towlower(*(a++))) - int32_t(towlower(*(b++)));
+            int32_t retval = int32_t(xlower(a[i])) - int32_t(xlower(b[i]));
             if (retval != 0)
                 return (retval > 0) ? 1 : -1;
+            ++i;
         }
         return 0;
     }
 
+    size_t LSPString::xmismatch(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n)
+    {
+        size_t i = 0;
+
+    #if defined(ARCH_X86) && defined(__SSE2__)
+        // Compare 8 characters per iteration
+        for ( ; (i + 8) <= n; i += 8)
+        {
+            const __m128i *va   = reinterpret_cast<const __m128i *>(&a[i]);
+            const __m128i *vb   = reinterpret_cast<const __m128i *>(&b[i]);
+            __m128i eq          = _mm_and_si128(
+                _mm_cmpeq_epi32(_mm_loadu_si128(&va[0]), _mm_loadu_si128(&vb[0])),
+                _mm_cmpeq_epi32(_mm_loadu_si128(&va[1]), _mm_loadu_si128(&vb[1])));
+            if (_mm_movemask_epi8(eq) != 0xffff)
+                break;
+        }
+    #endif /* ARCH_X86 */
+
+        for ( ; i < n; ++i)
+        {
+            if (a[i] != b[i])
+                break;
+        }
+        return i;
+    }
+
+    size_t LSPString::xmismatch_nocase(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n)
+    {
+        size_t i = 0;
+
+    #if defined(ARCH_X86) && defined(__SSE2__)
+        // Compare 4 characters per iteration, convert ASCII upper-case letters to lower case
+        const __m128i lo    = _mm_set1_epi32('A' - 1);
+        const __m128i hi    = _mm_set1_epi32('Z' + 1);
+        const __m128i delta = _mm_set1_epi32('a' - 'A');
+        for ( ; (i + 4) <= n; i += 4)
+        {
+            __m128i va          = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&a[i]));
+            __m128i vb          = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&b[i]));
+            __m128i ua          = _mm_and_si128(_mm_cmpgt_epi32(va, lo), _mm_cmplt_epi32(va, hi));
+            __m128i ub          = _mm_and_si128(_mm_cmpgt_epi32(vb, lo), _mm_cmplt_epi32(vb, hi));
+            va                  = _mm_add_epi32(va, _mm_and_si128(ua, delta));
+            vb                  = _mm_add_epi32(vb, _mm_and_si128(ub, delta));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(va, vb)) != 0xffff)
+                break;
+        }
+    #endif /* ARCH_X86 */
+
+        for ( ; i < n; ++i)
+        {
+            lsp_wchar_t ca = a[i], cb = b[i];
+            if ((ca != cb) && ((ca >= 0x80) || (cb >= 0x80) || (xlower(ca) != xlower(cb))))
+                break;
+        }
+        return i;
+    }
+
+    ssize_t LSPString::xfind(const lsp_wchar_t *s, size_t n, lsp_wchar_t ch)
+    {
+        size_t i = 0;
+
+    #if defined(ARCH_X86) && defined(__SSE2__)
+        // Check 16 characters per iteration
+        const __m128i vc    = _mm_set1_epi32(ch);
+        for ( ; (i + 16) <= n; i += 16)
+        {
+            const __m128i *v    = reinterpret_cast<const __m128i *>(&s[i]);
+            __m128i eq          = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[0]), vc),
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[1]), vc)),
+                _mm_or_si128(
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[2]), vc),
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[3]), vc)));
+            if (_mm_movemask_epi8(eq) != 0)
+                break;
+        }
+    #endif /* ARCH_X86 */
+
+        for ( ; i < n; ++i)
+        {
+            if (s[i] == ch)
+                return i;
+        }
+        return -1;
+    }
+
+    ssize_t LSPString::xrfind(const lsp_wchar_t *s, size_t n, lsp_wchar_t ch)
+    {
+    #if defined(ARCH_X86) && defined(__SSE2__)
+        // Check 16 characters per iteration
+        const __m128i vc    = _mm_set1_epi32(ch);
+        for ( ; n >= 16; n -= 16)
+        {
+            const __m128i *v    = reinterpret_cast<const __m128i *>(&s[n - 16]);
+            __m128i eq          = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[0]), vc),
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[1]), vc)),
+                _mm_or_si128(
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[2]), vc),
+                    _mm_cmpeq_epi32(_mm_loadu_si128(&v[3]), vc)));
+            if (_mm_movemask_epi8(eq) != 0)
+                break;
+        }
+    #endif /* ARCH_X86 */
+
+        while (n > 0)
+        {
+            if (s[--n] == ch)
+                return n;
+        }
+        return -1;
+    }
+
+    ssize_t LSPString::xsearch(const lsp_wchar_t *s, size_t n, const lsp_wchar_t *p, size_t m)
+    {
+        if (m <= 1)
+            return (m > 0) ? xfind(s, n, p[0]) : 0;
+        if (m > n)
+            return -1;
+
+        // Filter positions by the first and the last character of the pattern
+        const lsp_wchar_t first = p[0], last = p[m - 1];
+        size_t i = 0, end = n - m + 1;
+
+    #if defined(ARCH_X86) && defined(__SSE2__)
+        // Check 4 positions per iteration
+        const __m128i vf    = _mm_set1_epi32(first);
+        const __m128i vl    = _mm_set1_epi32(last);
+        for ( ; (i + 4) <= end; i += 4)
+        {
+            __m128i eq          = _mm_and_si128(
+                _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&s[i])), vf),
+                _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&s[i + m - 1])), vl));
+            int mask            = _mm_movemask_epi8(eq);
+            if (mask == 0)
+                continue;
+
+            for (size_t j=0; j<4; ++j, mask >>= 4)
+            {
+                if ((mask & 0x0f) && (xcmp(&s[i + j + 1], &p[1], m - 2) == 0))
+                    return i + j;
+            }
+        }
+    #endif /* ARCH_X86 */
+
+        while (i < end)
+        {
+            ssize_t off         = xfind(&s[i], end - i, first);
+            if (off < 0)
+                break;
+            i                  += off;
+            if ((s[i + m - 1] == last) && (xcmp(&s[i + 1], &p[1], m - 2) == 0))
+                return i;
+            ++i;
+        }
+
+        return -1;
+    }
+
+    ssize_t LSPString::xrsearch(const lsp_wchar_t *s, size_t n, const lsp_wchar_t *p, size_t m)
+    {
+        if (m <= 1)
+            return (m > 0) ? xrfind(s, n, p[0]) : n;
+        if (m > n)
+            return -1;
+
+        // Filter positions by the first and the last character of the pattern
+        const lsp_wchar_t first = p[0], last = p[m - 1];
+        size_t end = n - m + 1;
+
+        while (end > 0)
+        {
+            ssize_t off         = xrfind(s, end, first);
+            if (off < 0)
+                break;
+            if ((s[off + m - 1] == last) && (xcmp(&s[off + 1], &p[1], m - 2) == 0))
+                return off;
+            end                 = off;
+        }
+
+        return -1;
+    }
+
     void LSPString::acopy(lsp_wchar_t *dst, const char *src, size_t n)
     {
         while (n--)
             *(dst++) = uint8_t(*(src++));
     }
 
+    LSPStringScratch::LSPStringScratch()
+    {
+        nOffset     = 0;
+        nLength     = 0;
+        pData       = NULL;
+    }
+
+    LSPStringScratch::~LSPStringScratch()
+    {
+        truncate();
+    }
+
+    void LSPStringScratch::truncate()
+    {
+        if (pData != NULL)
+            ::free(pData);
+        nOffset     = 0;
+        nLength     = 0;
+        pData       = NULL;
+    }
+
+    bool LSPStringScratch::reserve(size_t size)
+    {
+        return (size <= nLength) ? true : resize(size);
+    }
+
+    bool LSPStringScratch::resize(size_t n)
+    {
+        char *xc        = static_cast<char *>(::realloc(pData, n * sizeof(char)));
+        if ((xc == NULL) && (n > 0))
+            return false;
+
+        pData           = xc;
+        nLength         = n;
+        nOffset         = lsp_min(nOffset, n);
+        return true;
+    }
+
+    bool LSPStringScratch::grow(size_t n)
+    {
+        return resize(nLength + n);
+    }
+
+    bool LSPStringScratch::append(const void *p, size_t n)
+    {
+        if ((nLength - nOffset) < n)
+        {
+            size_t size     = nLength + n + (n >> 1);
+            if (!resize(size))
+                return false;
+        }
+
+        ::memcpy(&pData[nOffset], p, n * sizeof(char));
+        nOffset        += n;
+
+        return true;
+    }
+
+    LSPStringScratch *LSPString::temp() const
+    {
+        if (pTemp != NULL)
+            return pTemp;
+
+        buffer_t *buf   = new buffer_t();
+        if (buf == NULL)
+            return NULL;
+
+        // Link the buffer to the list
+        lock_temp_list();
+        buf->pPrev      = NULL;
+        buf->pNext      = pTempList;
+        if (pTempList != NULL)
+            pTempList->pPrev    = buf;
+        pTempList       = buf;
+        unlock_temp_list();
+
+        return pTemp    = buf;
+    }
+
     void LSPString::drop_temp()
     {
-        if (pTemp == NULL)
+        release_temp();
+    }
+
+    void LSPString::release_temp() const
+    {
+        buffer_t *buf   = pTemp;
+        if (buf == NULL)
             return;
+        pTemp           = NULL;
+
+        // Unlink the buffer from the list
+        lock_temp_list();
+        if (buf->pPrev != NULL)
+            buf->pPrev->pNext   = buf->pNext;
+        else
+            pTempList           = buf->pNext;
+        if (buf->pNext != NULL)
+            buf->pNext->pPrev   = buf->pPrev;
+        unlock_temp_list();
+
+        delete buf;
+    }
+
+    size_t LSPString::release_all_temp()
+    {
+        size_t released = 0;
 
-        if (pTemp->pData != NULL)
-            ::free(pTemp->pData);
+        // Release memory but keep the buffers, they are still referenced by strings
+        lock_temp_list();
+        for (buffer_t *buf = pTempList; buf != NULL; buf = buf->pNext)
+        {
+            released       += buf->capacity();
+            buf->truncate();
+        }
+        unlock_temp_list();
 
-        ::free(pTemp);
-        pTemp = NULL;
+        return released;
     }
 
     void LSPString::clear()
@@ -157,10 +482,8 @@ namespace lsp
         nLength     = 0;
         nHash       = 0;
         nCapacity   = 0;
-        if (pData == NULL)
-            return;
-
-        xfree(pData);
+        if ((pData != NULL) && (!is_inline()))
+            xfree(pData);
         pData       = NULL;
     }
 
@@ -175,13 +498,7 @@ namespace lsp
             nLength     = size;
         }
 
-        lsp_wchar_t *v = xrealloc(pData, size);
-        if ((v == NULL) && (size > 0))
-            return false;
-
-        pData       = (size > 0) ? v : NULL;
-        nCapacity   = size;
-        return true;
+        return size_reserve(size);
     }
 
     size_t LSPString::set_length(size_t length)
@@ -196,26 +513,49 @@ namespace lsp
 
     bool LSPString::size_reserve(size_t size)
     {
-        if (size > 0)
+        if (size <= 0)
         {
-            lsp_wchar_t *v = xrealloc(pData, size);
-            if (v == NULL)
-                return false;
-            pData   = v;
+            if ((pData != NULL) && (!is_inline()))
+                xfree(pData);
+            pData       = NULL;
+            nCapacity   = 0;
+            return true;
         }
-        else if (pData != NULL)
+
+        // Short strings are stored in the inline buffer
+        if (size <= INLINE_CAPACITY)
         {
-            ::free(pData);
-            pData   = NULL;
+            if (!is_inline())
+            {
+                if (pData != NULL)
+                {
+                    xmove(vInline, pData, lsp_min(nLength, size));
+                    xfree(pData);
+                }
+                pData       = vInline;
+            }
+            nCapacity   = INLINE_CAPACITY;
+            return true;
+        }
+
+        lsp_wchar_t *v;
+        if (is_inline())
+        {
+            if ((v = xmalloc(size)) == NULL)
+                return false;
+            xmove(v, vInline, INLINE_CAPACITY);
         }
+        else if ((v = xrealloc(pData, size)) == NULL)
+            return false;
 
+        pData       = v;
         nCapacity   = size;
         return true;
     }
 
     inline bool LSPString::cap_reserve(size_t size)
     {
-        size_t ncap = (size + (GRANULARITY-1)) & (~(GRANULARITY-1));
+        size_t ncap = (size <= INLINE_CAPACITY) ? size : (size + (GRANULARITY-1)) & (~(GRANULARITY-1));
         return (ncap > nCapacity) ? size_reserve(ncap) : true;
     }
 
@@ -224,6 +564,8 @@ namespace lsp
         size_t avail = nCapacity - nLength;
         if (delta <= avail)
             return true;
+        if ((nLength + delta) <= INLINE_CAPACITY)
+            return size_reserve(INLINE_CAPACITY);
         avail = nCapacity >> 1;
         if (avail < delta)
             avail = delta;
@@ -235,11 +577,7 @@ namespace lsp
         drop_temp();
         if (nCapacity <= nLength)
             return;
-        lsp_wchar_t *v = xrealloc(pData, nLength);
-        if ((v == NULL) && (nLength > 0))
-            return;
-        pData       = (nLength > 0) ? v : NULL;
-        nCapacity   = nLength;
+        size_reserve(nLength);
     }
 
     void LSPString::trim()
@@ -283,20 +621,33 @@ namespace lsp
         if (src == this)
             return;
 
-        size_t len      = src->nLength;
-        size_t cap      = src->nCapacity;
-        lsp_wchar_t *c  = src->pData;
-        size_t hash     = src->nHash;
-
-        src->nLength    = nLength;
-        src->nCapacity  = nCapacity;
-        src->pData      = pData;
-        src->nHash      = nHash;
+        // Inline data can not be passed by pointer. Callers may fill the reserved
+        // space before updating the length, so the whole inline buffer is moved
+        bool inl        = is_inline();
+        bool src_inl    = src->is_inline();
+        if ((inl) && (src_inl))
+        {
+            for (size_t i=0; i<INLINE_CAPACITY; ++i)
+                lsp::swap(vInline[i], src->vInline[i]);
+        }
+        else if (inl)
+        {
+            xmove(src->vInline, vInline, INLINE_CAPACITY);
+            pData           = src->pData;
+            src->pData      = src->vInline;
+        }
+        else if (src_inl)
+        {
+            xmove(vInline, src->vInline, INLINE_CAPACITY);
+            src->pData      = pData;
+            pData           = vInline;
+        }
+        else
+            lsp::swap(pData, src->pData);
 
-        nLength         = len;
-        nCapacity       = cap;
-        pData           = c;
-        nHash           = hash;
+        lsp::swap(nLength, src->nLength);
+        lsp::swap(nCapacity, src->nCapacity);
+        lsp::swap(nHash, src->nHash);
     }
 
     bool LSPString::swap(ssize_t idx1, ssize_t idx2)
@@ -318,13 +669,18 @@ namespace lsp
     void LSPString::take(LSPString *src)
     {
         drop_temp();
-        if (pData != NULL)
+        if ((pData != NULL) && (!is_inline()))
             xfree(pData);
 
         nLength         = src->nLength;
         nCapacity       = src->nCapacity;
         pData           = src->pData;
         nHash           = src->nHash;
+        if (src->is_inline())
+        {
+            xmove(vInline, src->vInline, INLINE_CAPACITY);
+            pData           = vInline;
+        }
 
         src->nLength    = 0;
         src->nCapacity  = 0;
@@ -338,21 +694,17 @@ namespace lsp
         if (s == NULL)
             return s;
 
-        s->nLength      = nLength;
-        s->nCapacity    = nLength;
-        if (s->nLength > 0)
+        if (nLength > 0)
         {
-            s->pData        = xmalloc(nLength);
-            if (s->pData == NULL)
+            if (!s->size_reserve(nLength))
             {
                 delete s;
                 return NULL;
             }
 
             xmove(s->pData, pData, nLength);
+            s->nLength      = nLength;
         }
-        else
-            s->pData        = NULL;
 
         return s;
     }
@@ -422,17 +774,9 @@ namespace lsp
     {
         drop_temp();
 
-        if (nCapacity == 0)
-        {
-            lsp_wchar_t *v = xmalloc(GRANULARITY);
-            if (v == NULL)
-                return false;
-            v[0]        = ch;
-            pData       = v;
-            nCapacity   = GRANULARITY;
-        }
-        else
-            pData[0]    = ch;
+        if ((nCapacity == 0) && (!size_reserve(INLINE_CAPACITY)))
+            return false;
+        pData[0]    = ch;
 
         nHash       = 0;
         nLength     = 1;
@@ -476,7 +820,7 @@ namespace lsp
         if (src->nLength > 0)
             xmove(pData, src->pData, src->nLength);
         nLength     = src->nLength;
-        nHash       = 0;
+        nHash       = src->nHash;   // The contents are equal, so is the hash
         return true;
     }
 
@@ -1249,14 +1593,8 @@ namespace lsp
         if (str->nLength <= 0)
             return start;
 
-        ssize_t last = nLength - str->nLength;
-        while (start < last)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start ++;
-        }
-        return -1;
+        ssize_t off = xsearch(&pData[start], nLength - start, str->pData, str->nLength);
+        return (off >= 0) ? start + off : -1;
     }
 
     ssize_t LSPString::index_of(const LSPString *str) const
@@ -1264,39 +1602,20 @@ namespace lsp
         if (str->nLength <= 0)
             return 0;
 
-        ssize_t start = 0, last = nLength - str->nLength;
-        while (start < last)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start ++;
-        }
-        return -1;
+        return xsearch(pData, nLength, str->pData, str->nLength);
     }
 
     ssize_t LSPString::index_of(ssize_t start, lsp_wchar_t ch) const
     {
         XSAFE_TRANS(start, nLength, -1);
 
-        ssize_t length = nLength;
-        while (start < length)
-        {
-            if (pData[start] == ch)
-                return start;
-            start ++;
-        }
-
-        return -1;
+        ssize_t off = xfind(&pData[start], nLength - start, ch);
+        return (off >= 0) ? start + off : -1;
     }
 
     ssize_t LSPString::index_of(lsp_wchar_t ch) const
     {
-        for (size_t start = 0; start < nLength; ++start)
-        {
-            if (pData[start] == ch)
-                return start;
-        }
-        return -1;
+        return xfind(pData, nLength, ch);
     }
 
     ssize_t LSPString::rindex_of(ssize_t start, const LSPString *str) const
@@ -1305,14 +1624,8 @@ namespace lsp
         if (str->nLength <= 0)
             return start;
 
-        start -= str->nLength;
-        while (start >= 0)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start --;
-        }
-        return -1;
+        // Look for the occurrence that ends before the start position
+        return xrsearch(pData, start, str->pData, str->nLength);
     }
 
     ssize_t LSPString::rindex_of(const LSPString *str) const
@@ -1320,38 +1633,19 @@ namespace lsp
         if (str->nLength <= 0)
             return 0;
 
-        ssize_t start = nLength - str->nLength - 1;
-        while (start >= 0)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start --;
-        }
-        return -1;
+        return xrsearch(pData, nLength, str->pData, str->nLength);
     }
 
     ssize_t LSPString::rindex_of(ssize_t start, lsp_wchar_t ch) const
     {
         XSAFE_ITRANS(start, nLength, -1);
 
-        while (start >= 0)
-        {
-            if (pData[start] == ch)
-                return start;
-            start --;
-        }
-
-        return -1;
+        return xrfind(pData, start + 1, ch);
     }
 
     ssize_t LSPString::rindex_of(lsp_wchar_t ch) const
     {
-        for (ssize_t start=nLength-1; start >= 0; --start)
-        {
-            if (pData[start] == ch)
-                return start;
-        }
-        return -1;
+        return xrfind(pData, nLength, ch);
     }
 
     LSPString *LSPString::substring(ssize_t first) const
@@ -1363,22 +1657,17 @@ namespace lsp
         if (s == NULL)
             return s;
 
-        s->nLength      = length;
-        s->nCapacity    = length;
-
         if (length > 0)
         {
-            s->pData        = xmalloc(length);
-            if (s->pData == NULL)
+            if (!s->size_reserve(length))
             {
                 delete s;
                 return NULL;
             }
 
             xmove(s->pData, &pData[first], length);
+            s->nLength      = length;
         }
-        else
-            s->pData        = NULL;
 
         return s;
     }
@@ -1395,22 +1684,17 @@ namespace lsp
         if (s == NULL)
             return s;
 
-        s->nLength      = length;
-        s->nCapacity    = length;
-
         if (length > 0)
         {
-            s->pData        = xmalloc(length);
-            if (s->pData == NULL)
+            if (!s->size_reserve(length))
             {
                 delete s;
                 return NULL;
             }
 
             xmove(s->pData, &pData[first], length);
+            s->nLength      = length;
         }
-        else
-            s->pData        = NULL;
 
         return s;
     }
@@ -1422,20 +1706,15 @@ namespace lsp
 
     int LSPString::compare_to(const lsp_wchar_t *src, size_t len) const
     {
-        ssize_t n = (nLength > len) ? len : nLength;
-        const lsp_wchar_t *a = pData, *b = src;
+        size_t n = lsp_min(nLength, len);
+        size_t i = xmismatch(pData, src, n);
 
-        while (n--)
-        {
-            int retval = int(*(a++)) - int(*(b++));
-            if (retval != 0)
-                return retval;
-        }
-
-        if (a < &pData[nLength])
-            return int(*a);
-        else if (b < &src[len])
-            return -int(*b);
+        if (i < n)
+            return int(pData[i]) - int(src[i]);
+        else if (n < nLength)
+            return int(pData[n]);
+        else if (n < len)
+            return -int(src[n]);
 
         return 0;
     }
@@ -1482,20 +1761,20 @@ namespace lsp
 
     int LSPString::compare_to_nocase(const lsp_wchar_t *src, size_t len) const
     {
-        ssize_t n = (nLength > len) ? len : nLength;
-        const lsp_wchar_t *a = pData, *b = src;
+        size_t n = lsp_min(nLength, len);
 
-        while (n--)
+        for (size_t i = xmismatch_nocase(pData, src, n); i < n; i += xmismatch_nocase(&pData[i], &src[i], n - i))
         {
-            int retval = int(::towlower(*(a++))) - int(::towlower(*(b++)));
+            int retval = int(xlower(pData[i])) - int(xlower(src[i]));
             if (retval != 0)
                 return retval;
+            ++i;
         }
 
-        if (a < &pData[nLength])
-            return int(*a);
-        else if (b < &src[len])
-            return -int(*b);
+        if (n < nLength)
+            return int(pData[n]);
+        else if (n < len)
+            return -int(src[n]);
 
         return 0;
     }
@@ -1627,14 +1906,7 @@ namespace lsp
         if (nLength != len)
             return false;
 
-        const lsp_wchar_t *a = pData, *b = src;
-        for (size_t i=nLength; i>0; --i)
-        {
-            if (towlower(*(a++)) != towlower(*(b++)))
-                return false;
-        }
-
-        return true;
+        return xcasecmp(pData, src, nLength) == 0;
     }
 
     bool LSPString::equals_nocase(const lsp_wchar_t *src) const
@@ -1697,18 +1969,35 @@ namespace lsp
 
     bool LSPString::set_utf8(const char *s, size_t n)
     {
+        // Each byte produces at most one code point
         LSPString   tmp;
-        lsp_wchar_t ch;
+        if (!tmp.reserve(n))
+            return false;
 
-        while (lsp_utf32_t(ch = read_utf8_streaming(&s, &n, true)) != LSP_UTF32_EOF)
+        lsp_wchar_t *dst = tmp.pData;
+        while (n > 0)
         {
-            // Append code point
-            if (!tmp.append(ch))
-                return false;
+            // Convert ASCII characters in bulk, then decode one multi-byte sequence
+            size_t count = ascii_to_utf32(dst, s, n);
+            dst        += count;
+            s          += count;
+            n          -= count;
+
+            lsp_utf32_t ch = read_utf8_streaming(&s, &n, true);
+            if (ch == LSP_UTF32_EOF)
+                break;
+            *(dst++)    = ch;
         }
         if (n > 0)
             return false;
 
+        // Multi-byte sequences produce less code points than bytes, release the
+        // memory reserved for them if it takes a noticeable part of the buffer
+        tmp.nLength     = dst - tmp.pData;
+        size_t cap      = (tmp.nLength + (GRANULARITY-1)) & (~(GRANULARITY-1));
+        if (tmp.nCapacity > (cap + (cap >> 2)))
+            tmp.size_reserve(cap);  // The larger buffer is still valid on failure
+
         tmp.swap(this);
         return true;
     }
@@ -1867,47 +2156,74 @@ namespace lsp
     }
 
     const char *LSPString::get_utf8(ssize_t first, ssize_t last) const
+    {
+        LSPStringScratch *buf = temp();
+        return (buf != NULL) ? to_utf8(buf, first, last) : NULL;
+    }
+
+    const lsp_utf16_t *LSPString::get_utf16(ssize_t first, ssize_t last) const
+    {
+        LSPStringScratch *buf = temp();
+        return (buf != NULL) ? to_utf16(buf, first, last) : NULL;
+    }
+
+    const char *LSPString::get_ascii(ssize_t first, ssize_t last) const
+    {
+        LSPStringScratch *buf = temp();
+        return (buf != NULL) ? to_ascii(buf, first, last) : NULL;
+    }
+
+    const char *LSPString::get_native(ssize_t first, ssize_t last, const char *charset) const
+    {
+        LSPStringScratch *buf = temp();
+        return (buf != NULL) ? to_native(buf, first, last, charset) : NULL;
+    }
+
+    const char *LSPString::to_utf8(LSPStringScratch *buf, ssize_t first, ssize_t last) const
     {
         XSAFE_TRANS(first, nLength, NULL);
         XSAFE_TRANS(last, nLength, NULL);
         if (first > last)
             return NULL;
 
-        if (pTemp != NULL)
-            pTemp->nOffset      = 0;
+        buf->clear();
 
         char temp[BUF_SIZE + 16];
         char *th = temp, *tt = &temp[BUF_SIZE];
 
-        for (ssize_t i=first; i<last; ++i)
+        for (ssize_t i=first; i<last; )
         {
-            lsp_wchar_t ch = pData[i];
-            write_utf8_codepoint(&th, ch);
+            // Convert ASCII characters in bulk
+            size_t count = utf32_to_ascii(th, &pData[i], lsp_min(size_t(last - i), size_t(tt - th)));
+            th         += count;
+            i          += count;
+
+            if ((i < last) && (th < tt))
+                write_utf8_codepoint(&th, pData[i++]);
 
             if (th >= tt)
             {
-                if (!append_temp(temp, th - temp))
+                if (!buf->append(temp, th - temp))
                     return NULL;
                 th  = temp;
             }
         }
 
         *(th++) = '\0';
-        if (!append_temp(temp, th - temp))
+        if (!buf->append(temp, th - temp))
             return NULL;
 
-        return pTemp->pData;
+        return buf->pData;
     }
 
-    const lsp_utf16_t *LSPString::get_utf16(ssize_t first, ssize_t last) const
+    const lsp_utf16_t *LSPString::to_utf16(LSPStringScratch *buf, ssize_t first, ssize_t last) const
     {
         XSAFE_TRANS(first, nLength, NULL);
         XSAFE_TRANS(last, nLength, NULL);
         if (first > last)
             return NULL;
 
-        if (pTemp != NULL)
-            pTemp->nOffset      = 0;
+        buf->clear();
 
         lsp_utf16_t temp[BUF_SIZE + 8];
         lsp_utf16_t *th = temp, *tt = &temp[BUF_SIZE];
@@ -1919,31 +2235,32 @@ namespace lsp
 
             if (th >= tt)
             {
-                if (!append_temp(reinterpret_cast<char *>(temp), (th - temp) * sizeof(lsp_utf16_t)))
+                if (!buf->append(temp, (th - temp) * sizeof(lsp_utf16_t)))
                     return NULL;
                 th  = temp;
             }
         }
 
         *(th++) = '\0';
-        if (!append_temp(reinterpret_cast<char *>(temp), (th - temp) * sizeof(lsp_utf16_t)))
+        if (!buf->append(temp, (th - temp) * sizeof(lsp_utf16_t)))
             return NULL;
 
-        return reinterpret_cast<lsp_utf16_t *>(pTemp->pData);
+        return reinterpret_cast<lsp_utf16_t *>(buf->pData);
     }
 
-    const char *LSPString::get_ascii(ssize_t first, ssize_t last) const
+    const char *LSPString::to_ascii(LSPStringScratch *buf, ssize_t first, ssize_t last) const
     {
         XSAFE_TRANS(first, nLength, NULL);
         XSAFE_TRANS(last, nLength, NULL);
         if (first > last)
             return NULL;
 
-        if (!resize_temp(last - first + 1))
+        buf->clear();
+        if (!buf->reserve(last - first + 1))
             return NULL;
 
         lsp_wchar_t *p  = &pData[first];
-        char *dst       = pTemp->pData;
+        char *dst       = buf->pData;
 
         for (; first < last; ++first)
         {
@@ -1952,13 +2269,13 @@ namespace lsp
         }
 
         *(dst++)        = '\0';
-        pTemp->nOffset  = dst - pTemp->pData;
+        buf->nOffset    = dst - buf->pData;
 
-        return pTemp->pData;
+        return buf->pData;
     }
 
 #if defined(PLATFORM_WINDOWS)
-    const char *LSPString::get_native(ssize_t first, ssize_t last, const char *charset) const
+    const char *LSPString::to_native(LSPStringScratch *buf, ssize_t first, ssize_t last, const char *charset) const
     {
         XSAFE_TRANS(first, nLength, NULL);
         XSAFE_TRANS(last, nLength, NULL);
@@ -1972,43 +2289,34 @@ namespace lsp
             return NULL;
 
         // Estimate number of bytes required
-        lsp_utf16_t *buf    = const_cast<lsp_utf16_t *>(get_utf16(first, last));
-        if (buf == NULL)
+        LSPStringScratch tmp;
+        lsp_utf16_t *src    = const_cast<lsp_utf16_t *>(to_utf16(&tmp, first, last));
+        if (src == NULL)
             return NULL;
 
-        // Drop temporary data because it is stored in buf variable and can not be reused
-        pTemp->pData        = NULL;
-        pTemp->nLength      = 0;
-        pTemp->nOffset      = 0;
-
+        buf->clear();
         size_t slen         = length;
-        size_t res = widechar_to_multibyte(cp, buf, &slen, NULL, NULL) + 4; // + terminating 0
-        if ((res <= 0) || (!resize_temp(res)))
-        {
-            free(buf);
+        size_t res = widechar_to_multibyte(cp, src, &slen, NULL, NULL) + 4; // + terminating 0
+        if ((res <= 0) || (!buf->reserve(res)))
             return NULL;
-        }
 
         // We have enough space for saving data
         size_t n = res;
-        res = widechar_to_multibyte(cp, buf, &slen, pTemp->pData, &n);
+        res = widechar_to_multibyte(cp, src, &slen, buf->pData, &n);
         if (res <= 0)
-        {
-            free(buf);
             return NULL;
-        }
 
         // Append terminating zero
-        pTemp->pData[res++] = '\0';
-        pTemp->pData[res++] = '\0';
-        pTemp->pData[res++] = '\0';
-        pTemp->pData[res]   = '\0';
+        buf->pData[res++]   = '\0';
+        buf->pData[res++]   = '\0';
+        buf->pData[res++]   = '\0';
+        buf->pData[res++]   = '\0';
+        buf->nOffset        = res;
 
-        free(buf);
-        return pTemp->pData;
+        return buf->pData;
     }
 #else
-    const char *LSPString::get_native(ssize_t first, ssize_t last, const char *charset) const
+    const char *LSPString::to_native(LSPStringScratch *buf, ssize_t first, ssize_t last, const char *charset) const
     {
         XSAFE_TRANS(first, nLength, NULL);
         XSAFE_TRANS(last, nLength, NULL);
@@ -2018,17 +2326,12 @@ namespace lsp
         // Open conversion
         iconv_t cd = init_iconv_from_wchar_t(charset);
         if (cd == iconv_t(-1))
-            return get_utf8(first, last);
+            return to_utf8(buf, first, last);
 
         // Analyze temp
-        size_t outsize  = 0;
-        char *outbuf    = NULL;
-        if (pTemp != NULL)
-        {
-            pTemp->nOffset      = 0;
-            outsize             = pTemp->nLength;
-            outbuf              = pTemp->pData;
-        }
+        buf->clear();
+        size_t outsize  = buf->nLength;
+        char *outbuf    = buf->pData;
 
         size_t insize   = (last - first) * sizeof(lsp_wchar_t);
         char *inbuf     = reinterpret_cast<char *>(const_cast<lsp_wchar_t *>(&pData[first]));
@@ -2039,15 +2342,15 @@ namespace lsp
             if (outsize < 16)
             {
                 // Try to grow the temprary buffer
-                if (!grow_temp(BUF_SIZE))
+                if (!buf->grow(BUF_SIZE))
                 {
                     iconv_close(cd);
                     return NULL;
                 }
 
                 // Initialize location of buffers to store data
-                outsize         = pTemp->nLength - pTemp->nOffset;
-                outbuf          = &pTemp->pData[pTemp->nOffset];
+                outsize         = buf->nLength - buf->nOffset;
+                outbuf          = &buf->pData[buf->nOffset];
             }
 
             // Do the conversion
@@ -2067,17 +2370,17 @@ namespace lsp
             }
 
             // Update pointer
-            pTemp->nOffset      = pTemp->nLength - outsize;
+            buf->nOffset        = buf->nLength - outsize;
         }
 
         // Close the iconv descriptor
         iconv_close(cd);
 
         // Append zeros at the end to make compatible with C-strings
-        if (!append_temp("\x00\x00\x00\x00", 4))
+        if (!buf->append("\x00\x00\x00\x00", 4))
             return NULL;
 
-        return pTemp->pData;
+        return buf->pData;
     }
 #endif /* PLATFORM_WINDOWS */
 
@@ -2085,142 +2388,68 @@ namespace lsp
     {
         if (index >= nLength)
             return 0;
-        size_t i=0, n = lsp_min(s->nLength, nLength - index);
+        size_t n = lsp_min(s->nLength, nLength - index);
 
-        for (; i < n; ++i)
-        {
-            if (pData[i] != s->pData[i])
-                return i;
-        }
-        return i;
+        return xmismatch(&pData[index], s->pData, n);
     }
 
     size_t LSPString::match_nocase(const LSPString *s, size_t index) const
     {
         if (index >= nLength)
             return 0;
-        size_t i=0, n = lsp_min(s->nLength, nLength - index);
+        const lsp_wchar_t *a = &pData[index], *b = s->pData;
+        size_t i, n = lsp_min(s->nLength, nLength - index);
 
-        for (; i < n; ++i)
+        for (i = xmismatch_nocase(a, b, n); i < n; i += xmismatch_nocase(&a[i], &b[i], n - i))
         {
-            if (towlower(pData[i]) != towlower(s->pData[i]))
-                return i;
+            if (xlower(a[i]) != xlower(b[i]))
+                break;
+            ++i;
         }
         return i;
     }
 
     char *LSPString::clone_utf8(size_t *bytes, ssize_t first, ssize_t last) const
     {
-        const char *utf8 = get_utf8(first, last);
-        if (utf8 == NULL)
-            return NULL;
-
-        size_t offset = (pTemp != NULL) ? pTemp->nOffset : 0;
-        char *ptr = (utf8 != NULL) ? reinterpret_cast<char *>(lsp::memdup(utf8, offset)) : NULL;
-        if (bytes != NULL)
-            *bytes = (ptr != NULL) ? offset : 0;
-        return ptr;
+        LSPStringScratch tmp;
+        char *ptr = const_cast<char *>(to_utf8(&tmp, first, last));
+        return static_cast<char *>(detach(&tmp, ptr, bytes));
     }
 
     lsp_utf16_t *LSPString::clone_utf16(size_t *bytes, ssize_t first, ssize_t last) const
     {
-        const lsp_utf16_t *utf16 = get_utf16(first, last);
-        if (utf16 == NULL)
-            return NULL;
-
-        size_t offset = (pTemp != NULL) ? pTemp->nOffset : 0;
-        lsp_utf16_t *ptr = (utf16 != NULL) ? reinterpret_cast<lsp_utf16_t *>(lsp::memdup(utf16, offset)) : NULL;
-        if (bytes != NULL)
-            *bytes = (ptr != NULL) ? offset : 0;
-        return ptr;
+        LSPStringScratch tmp;
+        lsp_utf16_t *ptr = const_cast<lsp_utf16_t *>(to_utf16(&tmp, first, last));
+        return static_cast<lsp_utf16_t *>(detach(&tmp, ptr, bytes));
     }
 
     char *LSPString::clone_ascii(size_t *bytes, ssize_t first, ssize_t last) const
     {
-        const char *ascii = get_ascii(first, last);
-        if (ascii == NULL)
-            return NULL;
-
-        size_t offset = (pTemp != NULL) ? pTemp->nOffset : 0;
-        char *ptr = (ascii != NULL) ? reinterpret_cast<char *>(lsp::memdup(ascii, offset)) : NULL;
-        if (bytes != NULL)
-            *bytes = (ptr != NULL) ? offset : 0;
-        return ptr;
+        LSPStringScratch tmp;
+        char *ptr = const_cast<char *>(to_ascii(&tmp, first, last));
+        return static_cast<char *>(detach(&tmp, ptr, bytes));
     }
 
     char *LSPString::clone_native(size_t *bytes, ssize_t first, ssize_t last, const char *charset) const
     {
-        const char *native = get_native(first, last, charset);
-        if (native == NULL)
-            return NULL;
-
-        size_t offset = (pTemp != NULL) ? pTemp->nOffset : 0;
-        char *ptr = (native != NULL) ? reinterpret_cast<char *>(lsp::memdup(native, offset)) : NULL;
-        if (bytes != NULL)
-            *bytes = (ptr != NULL) ? offset : 0;
-        return ptr;
+        LSPStringScratch tmp;
+        char *ptr = const_cast<char *>(to_native(&tmp, first, last, charset));
+        return static_cast<char *>(detach(&tmp, ptr, bytes));
     }
 
-    bool LSPString::append_temp(const char *p, size_t n) const
+    void *LSPString::detach(LSPStringScratch *buf, void *ptr, size_t *bytes)
     {
-        ssize_t free = (pTemp != NULL) ? pTemp->nLength - pTemp->nOffset : -1;
-
-        if (free < ssize_t(n))
+        // Take the memory of the scratch buffer
+        if (ptr != NULL)
         {
-            size_t resize   = n + (n >> 1);
-            if (pTemp != NULL)
-                resize         += pTemp->nLength;
-
-            if (!resize_temp(resize))
-                return false;
+            buf->pData      = NULL;
+            buf->nLength    = 0;
         }
+        if (bytes != NULL)
+            *bytes          = (ptr != NULL) ? buf->nOffset : 0;
+        buf->nOffset    = 0;
 
-        memcpy(&pTemp->pData[pTemp->nOffset], p, n * sizeof(char));
-        pTemp->nOffset     += n;
-
-        return true;
-    }
-
-    bool LSPString::grow_temp(size_t n) const
-    {
-        if (pTemp == NULL)
-        {
-            pTemp = static_cast<buffer_t *>(malloc(sizeof(buffer_t)));
-            if (pTemp == NULL)
-                return false;
-            pTemp->nLength  = 0;
-            pTemp->nOffset  = 0;
-            pTemp->pData    = 0;
-        }
-
-        char *xc        = static_cast<char *>(realloc(pTemp->pData, (pTemp->nLength + n)*sizeof(char)));
-        if (xc == NULL)
-            return false;
-
-        pTemp->pData    = xc;
-        pTemp->nLength += n;
-        return true;
-    }
-
-    bool LSPString::resize_temp(size_t n) const
-    {
-        if (pTemp == NULL)
-        {
-            pTemp = static_cast<buffer_t *>(malloc(sizeof(buffer_t)));
-            if (pTemp == NULL)
-                return false;
-            pTemp->nLength  = 0;
-            pTemp->nOffset  = 0;
-            pTemp->pData    = 0;
-        }
-
-        char *xc        = static_cast<char *>(realloc(pTemp->pData, n*sizeof(char)));
-        if (xc == NULL)
-            return false;
-
-        pTemp->pData    = xc;
-        pTemp->nLength  = n;
-        return true;
+        return ptr;
     }
 
     size_t LSPString::count(lsp_wchar_t ch) const
@@ -2460,11 +2689,61 @@ namespace lsp
         else if (nHash != 0)
             return nHash;
 
-        size_t hash = 0;
-        for (size_t i=0; i<nLength; ++i)
-            hash = (hash * 0x10015) ^ pData[i];
+        return nHash = hash(pData, nLength);
+    }
+
+    size_t LSPString::hash(const lsp_wchar_t *s, size_t n)
+    {
+        if (n <= 0)
+            return 0;
 
-        return nHash = hash;
+        size_t i = 0;
+
+    #if defined(ARCH_64BIT)
+        // Two independent lanes, each consumes two characters per step
+        const uint64_t k1 = 0x9e3779b97f4a7c15ULL;
+        const uint64_t k2 = 0xc2b2ae3d27d4eb4fULL;
+        uint64_t h0 = n, h1 = 0;
+        for ( ; (i + 4) <= n; i += 4)
+        {
+            uint64_t c0     = (uint64_t(s[i]) | (uint64_t(s[i + 1]) << 32)) * k1;
+            uint64_t c1     = (uint64_t(s[i + 2]) | (uint64_t(s[i + 3]) << 32)) * k1;
+            h0              = h0 ^ c0;
+            h1              = h1 ^ c1;
+            h0              = ((h0 << 27) | (h0 >> 37)) * k2;
+            h1              = ((h1 << 31) | (h1 >> 33)) * k2;
+        }
+        for ( ; i < n; ++i)
+        {
+            h0             ^= uint64_t(s[i]) * k1;
+            h0              = ((h0 << 27) | (h0 >> 37)) * k2;
+        }
+
+        // Final avalanche
+        uint64_t h      = h0 ^ ((h1 << 17) | (h1 >> 47));
+        h              ^= h >> 33;
+        h              *= 0xff51afd7ed558ccdULL;
+        h              ^= h >> 33;
+        h              *= 0xc4ceb9fe1a85ec53ULL;
+        h              ^= h >> 33;
+    #else
+        uint32_t h      = n;
+        for ( ; i < n; ++i)
+        {
+            uint32_t c      = uint32_t(s[i]) * 0xcc9e2d51U;
+            h              ^= ((c << 15) | (c >> 17)) * 0x1b873593U;
+            h               = ((h << 13) | (h >> 19)) * 5 + 0xe6546b64U;
+        }
+
+        // Final avalanche
+        h              ^= h >> 16;
+        h              *= 0x85ebca6bU;
+        h              ^= h >> 13;
+        h              *= 0xc2b2ae35U;
+        h              ^= h >> 16;
+    #endif /* ARCH_64BIT */
+
+        return h;
     }
 
     namespace lltl
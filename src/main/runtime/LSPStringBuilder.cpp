@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/LSPStringBuilder.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <stdlib.h>
+
+namespace lsp
+{
+    LSPStringBuilder::LSPStringBuilder()
+    {
+        nLength     = 0;
+    }
+
+    LSPStringBuilder::~LSPStringBuilder()
+    {
+        clear();
+    }
+
+    LSPStringBuilder::chunk_t *LSPStringBuilder::alloc_chunk(size_t size)
+    {
+        chunk_t *c      = static_cast<chunk_t *>(::malloc(sizeof(chunk_t) + size * sizeof(lsp_wchar_t)));
+        if (c == NULL)
+            return NULL;
+
+        c->nSize        = 0;
+        c->nCapacity    = size;
+        c->vData        = reinterpret_cast<lsp_wchar_t *>(&c[1]);
+
+        return c;
+    }
+
+    void LSPStringBuilder::drop_chunks(lltl::parray<chunk_t> *list)
+    {
+        for (size_t i=0, n=list->size(); i<n; ++i)
+        {
+            chunk_t *c = list->uget(i);
+            if (c != NULL)
+                ::free(c);
+        }
+        list->flush();
+    }
+
+    void LSPStringBuilder::clear()
+    {
+        drop_chunks(&vHead);
+        drop_chunks(&vTail);
+        nLength     = 0;
+    }
+
+    void LSPStringBuilder::swap(LSPStringBuilder *dst)
+    {
+        vHead.swap(&dst->vHead);
+        vTail.swap(&dst->vTail);
+        lsp::swap(nLength, dst->nLength);
+    }
+
+    lsp_wchar_t *LSPStringBuilder::append_space(size_t n)
+    {
+        chunk_t *c      = vTail.last();
+        if ((c == NULL) || ((c->nCapacity - c->nSize) < n))
+        {
+            // The size of the new chunk is proportional to the length of the string
+            c               = alloc_chunk(lsp_max(n, lsp_max(size_t(CHUNK_SIZE), nLength >> 1)));
+            if (c == NULL)
+                return NULL;
+            if (!vTail.add(c))
+            {
+                ::free(c);
+                return NULL;
+            }
+        }
+
+        lsp_wchar_t *dst = &c->vData[c->nSize];
+        c->nSize       += n;
+        nLength        += n;
+
+        return dst;
+    }
+
+    lsp_wchar_t *LSPStringBuilder::prepend_space(size_t n)
+    {
+        chunk_t *c      = vHead.last();
+        if ((c == NULL) || ((c->nCapacity - c->nSize) < n))
+        {
+            // The size of the new chunk is proportional to the length of the string
+            c               = alloc_chunk(lsp_max(n, lsp_max(size_t(CHUNK_SIZE), nLength >> 1)));
+            if (c == NULL)
+                return NULL;
+            if (!vHead.add(c))
+            {
+                ::free(c);
+                return NULL;
+            }
+        }
+
+        // Prepended chunks are filled from the end
+        c->nSize       += n;
+        nLength        += n;
+
+        return &c->vData[c->nCapacity - c->nSize];
+    }
+
+    bool LSPStringBuilder::append(lsp_wchar_t ch)
+    {
+        lsp_wchar_t *dst = append_space(1);
+        if (dst == NULL)
+            return false;
+        *dst            = ch;
+        return true;
+    }
+
+    bool LSPStringBuilder::append(const lsp_wchar_t *arr, size_t n)
+    {
+        if (n <= 0)
+            return true;
+        lsp_wchar_t *dst = append_space(n);
+        if (dst == NULL)
+            return false;
+        ::memcpy(dst, arr, n * sizeof(lsp_wchar_t));
+        return true;
+    }
+
+    bool LSPStringBuilder::append(const LSPString *src)
+    {
+        return append(src->characters(), src->length());
+    }
+
+    bool LSPStringBuilder::append(const LSPString *src, ssize_t first)
+    {
+        return append(src, first, src->length());
+    }
+
+    bool LSPStringBuilder::append(const LSPString *src, ssize_t first, ssize_t last)
+    {
+        ssize_t len = src->length();
+        if (first < 0)
+            first  += len;
+        if (last < 0)
+            last   += len;
+        if ((first < 0) || (last < 0) || (first > len) || (last > len))
+            return false;
+        if (first >= last)
+            return true;
+
+        return append(&src->characters()[first], last - first);
+    }
+
+    bool LSPStringBuilder::append_ascii(const char *arr, size_t n)
+    {
+        if (n <= 0)
+            return true;
+        lsp_wchar_t *dst = append_space(n);
+        if (dst == NULL)
+            return false;
+        for (size_t i=0; i<n; ++i)
+            dst[i]          = uint8_t(arr[i]);
+        return true;
+    }
+
+    bool LSPStringBuilder::append_utf8(const char *arr, size_t n)
+    {
+        LSPString tmp;
+        if (!tmp.set_utf8(arr, n))
+            return false;
+        return append(tmp.characters(), tmp.length());
+    }
+
+    bool LSPStringBuilder::prepend(lsp_wchar_t ch)
+    {
+        lsp_wchar_t *dst = prepend_space(1);
+        if (dst == NULL)
+            return false;
+        *dst            = ch;
+        return true;
+    }
+
+    bool LSPStringBuilder::prepend(const lsp_wchar_t *arr, size_t n)
+    {
+        if (n <= 0)
+            return true;
+        lsp_wchar_t *dst = prepend_space(n);
+        if (dst == NULL)
+            return false;
+        ::memcpy(dst, arr, n * sizeof(lsp_wchar_t));
+        return true;
+    }
+
+    bool LSPStringBuilder::prepend(const LSPString *src)
+    {
+        return prepend(src->characters(), src->length());
+    }
+
+    bool LSPStringBuilder::prepend(const LSPString *src, ssize_t first)
+    {
+        return prepend(src, first, src->length());
+    }
+
+    bool LSPStringBuilder::prepend(const LSPString *src, ssize_t first, ssize_t last)
+    {
+        ssize_t len = src->length();
+        if (first < 0)
+            first  += len;
+        if (last < 0)
+            last   += len;
+        if ((first < 0) || (last < 0) || (first > len) || (last > len))
+            return false;
+        if (first >= last)
+            return true;
+
+        return prepend(&src->characters()[first], last - first);
+    }
+
+    bool LSPStringBuilder::prepend_ascii(const char *arr, size_t n)
+    {
+        if (n <= 0)
+            return true;
+        lsp_wchar_t *dst = prepend_space(n);
+        if (dst == NULL)
+            return false;
+        for (size_t i=0; i<n; ++i)
+            dst[i]          = uint8_t(arr[i]);
+        return true;
+    }
+
+    bool LSPStringBuilder::prepend_utf8(const char *arr, size_t n)
+    {
+        LSPString tmp;
+        if (!tmp.set_utf8(arr, n))
+            return false;
+        return prepend(tmp.characters(), tmp.length());
+    }
+
+    bool LSPStringBuilder::append_to(LSPString *dst) const
+    {
+        // Reserve space to make the operation atomic
+        if (!dst->reserve(dst->length() + nLength))
+            return false;
+
+        for (size_t i=vHead.size(); i > 0; )
+        {
+            const chunk_t *c = vHead.uget(--i);
+            dst->append(&c->vData[c->nCapacity - c->nSize], c->nSize);
+        }
+        for (size_t i=0, n=vTail.size(); i<n; ++i)
+        {
+            const chunk_t *c = vTail.uget(i);
+            dst->append(c->vData, c->nSize);
+        }
+
+        return true;
+    }
+
+    bool LSPStringBuilder::flatten(LSPString *dst) const
+    {
+        LSPString tmp;
+        if (!append_to(&tmp))
+            return false;
+        dst->swap(&tmp);
+        return true;
+    }
+
+} /* namespace lsp */
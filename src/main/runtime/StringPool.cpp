@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/StringPool.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <stdlib.h>
+
+namespace lsp
+{
+    StringPool::StringPool()
+    {
+        vIndex      = NULL;
+        nIndexCap   = 0;
+    }
+
+    StringPool::~StringPool()
+    {
+        clear();
+    }
+
+    void StringPool::clear()
+    {
+        for (size_t i=0, n=vItems.size(); i<n; ++i)
+        {
+            LSPString *s = vItems.uget(i);
+            if (s != NULL)
+                delete s;
+        }
+        vItems.flush();
+
+        if (vIndex != NULL)
+        {
+            ::free(vIndex);
+            vIndex      = NULL;
+        }
+        nIndexCap   = 0;
+    }
+
+    size_t StringPool::index_slot(const lsp_wchar_t *s, size_t n, size_t hash) const
+    {
+        size_t mask = nIndexCap - 1;
+        size_t slot = (hash ^ (hash >> 15)) & mask;
+
+        // The index is never filled more than by half, so there always is an empty slot
+        for (LSPString *p; (p = vIndex[slot]) != NULL; slot = (slot + 1) & mask)
+        {
+            // Empty strings may have no data, memcmp() does not accept NULL pointers
+            if ((p->hash() == hash) && (p->length() == n) &&
+                ((n <= 0) || (::memcmp(p->characters(), s, n * sizeof(lsp_wchar_t)) == 0)))
+                break;
+        }
+
+        return slot;
+    }
+
+    bool StringPool::grow_index()
+    {
+        size_t cap = (nIndexCap > 0) ? nIndexCap << 1 : 16;
+        LSPString **index = static_cast<LSPString **>(::malloc(cap * sizeof(LSPString *)));
+        if (index == NULL)
+            return false;
+        ::memset(index, 0, cap * sizeof(LSPString *));
+
+        if (vIndex != NULL)
+            ::free(vIndex);
+        vIndex      = index;
+        nIndexCap   = cap;
+
+        // Strings are unique, so just put each one to the first free slot
+        for (size_t i=0, n=vItems.size(); i<n; ++i)
+        {
+            LSPString *s = vItems.uget(i);
+            size_t slot = index_slot(s->characters(), s->length(), s->hash());
+            vIndex[slot]    = s;
+        }
+
+        return true;
+    }
+
+    const LSPString *StringPool::lookup(const lsp_wchar_t *s, size_t n) const
+    {
+        if (nIndexCap <= 0)
+            return NULL;
+        return vIndex[index_slot(s, n, LSPString::hash(s, n))];
+    }
+
+    const LSPString *StringPool::lookup(const LSPString *s) const
+    {
+        if (nIndexCap <= 0)
+            return NULL;
+        return vIndex[index_slot(s->characters(), s->length(), s->hash())];
+    }
+
+    const LSPString *StringPool::lookup_ascii(const char *s) const
+    {
+        LSPString tmp;
+        return (tmp.set_ascii(s)) ? lookup(&tmp) : NULL;
+    }
+
+    const LSPString *StringPool::intern(const lsp_wchar_t *s, size_t n)
+    {
+        return intern(s, n, LSPString::hash(s, n));
+    }
+
+    const LSPString *StringPool::intern(const LSPString *s)
+    {
+        // Reuse the hash value cached by the string
+        return intern(s->characters(), s->length(), s->hash());
+    }
+
+    const LSPString *StringPool::intern(const lsp_wchar_t *s, size_t n, size_t hash)
+    {
+        // Lookup for existing string
+        if (nIndexCap > 0)
+        {
+            LSPString *res = vIndex[index_slot(s, n, hash)];
+            if (res != NULL)
+                return res;
+        }
+
+        // Keep the load factor of the index not greater than 1/2
+        if ((vItems.size() + 1) * 2 > nIndexCap)
+        {
+            if (!grow_index())
+                return NULL;
+        }
+
+        // Create new string
+        LSPString *str = new LSPString();
+        if (str == NULL)
+            return NULL;
+        if ((!str->set(s, n)) || (!vItems.add(str)))
+        {
+            delete str;
+            return NULL;
+        }
+        str->reduce();      // Release the unused memory
+        str->hash();        // Compute and cache the hash value
+
+        return vIndex[index_slot(s, n, hash)] = str;
+    }
+
+    const LSPString *StringPool::intern_ascii(const char *s, size_t n)
+    {
+        LSPString tmp;
+        return (tmp.set_ascii(s, n)) ? intern(&tmp) : NULL;
+    }
+
+    const LSPString *StringPool::intern_utf8(const char *s, size_t n)
+    {
+        LSPString tmp;
+        return (tmp.set_utf8(s, n)) ? intern(&tmp) : NULL;
+    }
+
+} /* namespace lsp */
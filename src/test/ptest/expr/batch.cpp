@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/expr/Batch.h>
+#include <lsp-plug.in/expr/Expression.h>
+#include <lsp-plug.in/expr/Variables.h>
+
+#define LANES       1024
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.expr", batch, 5, 100)
+
+    void call(const char *label, const char *text, expr::Batch *b, double *dst)
+    {
+        char key[80];
+        expr::Expression e(b);
+        expr::value_t res;
+        expr::init_value(&res);
+
+        if (e.parse(text, NULL, expr::Expression::FLAG_NONE) != STATUS_OK)
+            PTEST_FAIL_MSG("Error parsing expression: %s", text);
+
+        printf("Testing %s: %s\n", label, text);
+
+        snprintf(key, sizeof(key), "%s scalar x%d", label, LANES);
+        PTEST_LOOP(key,
+            for (size_t i=0; i<LANES; ++i)
+            {
+                b->set_lane(i);
+                e.evaluate(&res);
+                dst[i] = (expr::cast_float(&res) == STATUS_OK) ? res.v_float : 0.0;
+                expr::destroy_value(&res);
+            }
+        );
+
+        snprintf(key, sizeof(key), "%s batch x%d", label, LANES);
+        PTEST_LOOP(key,
+            e.evaluate_batch(b, dst, LANES);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        expr::Variables v;
+        expr::Batch b(&v);
+        float *x    = new float[LANES];
+        double *y   = new double[LANES];
+        double *dst = new double[LANES];
+
+        for (size_t i=0; i<LANES; ++i)
+        {
+            x[i]        = i * 0.01f;
+            y[i]        = (ssize_t(i) - LANES/2) * 0.5;
+        }
+
+        v.set_float("g", 0.5);
+        v.set_int("n", 3);
+        b.set("x", x);
+        b.set("y", y);
+
+        call("linear", ":x * :g + :n", &b, dst);
+        call("polynomial", ":x * :x * :g - :y * :n + 1", &b, dst);
+        call("power", ":x ** 2 + :y / :n", &b, dst);
+        call("compare", ":x < :y", &b, dst);
+        call("fallback", ":x < :y ? :x : :y", &b, dst);
+        PTEST_SEPARATOR;
+
+        delete [] x;
+        delete [] y;
+        delete [] dst;
+    }
+
+PTEST_END
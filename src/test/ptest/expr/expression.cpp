@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/expr/Expression.h>
+#include <lsp-plug.in/expr/Variables.h>
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.expr", expression, 5, 10000)
+
+    void call(const char *label, const char *text, expr::Resolver *r, size_t flags)
+    {
+        char key[80];
+        expr::Expression e(r);
+        expr::value_t res;
+        expr::init_value(&res);
+
+        if (e.parse(text, NULL, flags) != STATUS_OK)
+            PTEST_FAIL_MSG("Error parsing expression: %s", text);
+
+        snprintf(key, sizeof(key), "%s [%d bytes]", label, int(::strlen(text)));
+        printf("Testing %s: %s\n", key, text);
+
+        PTEST_LOOP(key,
+            e.evaluate(&res);
+            expr::destroy_value(&res);
+        );
+    }
+
+    void parse(const char *label, const char *text, bool shared)
+    {
+        char key[80];
+        expr::Expression holder, e;
+
+        // Holder keeps the shared tree alive in the cache
+        if ((shared) && (holder.parse(text, NULL, expr::Expression::FLAG_NONE) != STATUS_OK))
+            PTEST_FAIL_MSG("Error parsing expression: %s", text);
+
+        snprintf(key, sizeof(key), "%s [%d bytes]", label, int(::strlen(text)));
+        printf("Testing %s: %s\n", key, text);
+
+        PTEST_LOOP(key,
+            e.parse(text, NULL, expr::Expression::FLAG_NONE);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        expr::Variables v;
+
+        v.set_int("ia", 1);
+        v.set_int("ib", 2);
+        v.set_int("ic", 5);
+        v.set_float("fa", 0.5);
+        v.set_float("fb", 2.75);
+        v.set_float("x", 12.0);
+        v.set_bool("ba", true);
+        v.set_bool("bb", false);
+        v.set_string("sa", "Meter");
+        v.set_float("v_0_1", 0.25);
+        v.set_float("v_1_2", -6.0);
+
+        call("constant", "1 / 3", &v, expr::Expression::FLAG_NONE);
+        call("arithmetic", ":fa * 2 + (1 / 3)", &v, expr::Expression::FLAG_NONE);
+        call("mixed", ":ia * :ic + :fb / :fa - :ib", &v, expr::Expression::FLAG_NONE);
+        call("decibels", "(:fa > 0) ? db :x : -12 db", &v, expr::Expression::FLAG_NONE);
+        call("ternary", ":x < 20 ? :x < 10 ? 0 : 1 : :x < 30 ? 2 : 3", &v, expr::Expression::FLAG_NONE);
+        call("logical", "(:ba || :bb) && !(:ia > :ib)", &v, expr::Expression::FLAG_NONE);
+        call("indexed", ":v[:ia-1][:ia] + :v[:ia][:ib]", &v, expr::Expression::FLAG_NONE);
+        call("string", "lc :sa sc ' ' sc :ic", &v, expr::Expression::FLAG_NONE);
+        call("substitution", "${sa}: ${:x * 2} dB", &v, expr::Expression::FLAG_STRING);
+        PTEST_SEPARATOR;
+
+        // Large environment with hundreds of ports
+        expr::Variables ports;
+        char name[32];
+        for (int i=0; i<500; ++i)
+        {
+            snprintf(name, sizeof(name), "port_%d", i);
+            ports.set_float(name, i * 0.5);
+        }
+
+        call("ports", ":port_17 + :port_250 * :port_499", &ports, expr::Expression::FLAG_NONE);
+        PTEST_SEPARATOR;
+
+        // Parsing of expressions
+        parse("parse", ":x < 20 ? :x < 10 ? 0 : 1 : :x < 30 ? 2 : 3", false);
+        parse("parse shared", ":x < 20 ? :x < 10 ? 0 : 1 : :x < 30 ? 2 : 3", true);
+        PTEST_SEPARATOR;
+    }
+
+PTEST_END
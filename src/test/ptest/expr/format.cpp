@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/expr/format.h>
+#include <lsp-plug.in/expr/FormatTemplate.h>
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.expr", format, 5, 10000)
+
+    void call(const char *label, const char *text, const expr::Parameters *p)
+    {
+        char key[80];
+        LSPString out;
+        expr::FormatTemplate tpl;
+
+        if (tpl.parse(text) != STATUS_OK)
+            PTEST_FAIL_MSG("Error parsing template: %s", text);
+
+        printf("Testing %s: %s\n", label, text);
+
+        snprintf(key, sizeof(key), "%s format()", label);
+        PTEST_LOOP(key,
+            expr::format(&out, text, p);
+        );
+
+        snprintf(key, sizeof(key), "%s template", label);
+        PTEST_LOOP(key,
+            tpl.format(&out, p);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        expr::Parameters p;
+
+        p.add_float("level", -12.5);
+        p.add_int("id", 3);
+        p.add_cstring("name", "Meter");
+        p.add_cstring("ext", "wav");
+
+        call("meter", "{@name%T} {@id}: {@level%+.1f} dB", &p);
+        call("file", "{@name%t}_{@id^0%4d}.{@ext}", &p);
+        call("padded", "[{>@name^.%16s}] [{|@level%10.2f}]", &p);
+        PTEST_SEPARATOR;
+
+        // Message catalog with many named parameters
+        char name[32];
+        for (int i=0; i<64; ++i)
+        {
+            snprintf(name, sizeof(name), "arg_%d", i);
+            p.add_int(name, i);
+        }
+
+        call("catalog", "{@arg_60} of {@arg_63}: {@arg_31%4d}", &p);
+        PTEST_SEPARATOR;
+    }
+
+PTEST_END
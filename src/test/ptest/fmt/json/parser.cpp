@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/fmt/json/Parser.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+
+#define MIN_ITEMS           16
+#define MAX_ITEMS           4096
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.fmt.json", parser, 5, 100)
+
+    void make_document(LSPString *doc, size_t items)
+    {
+        doc->clear();
+        doc->append_ascii("{\n  \"version\": 1,\n  \"ports\": [\n");
+        for (size_t i=0; i<items; ++i)
+        {
+            doc->fmt_append_ascii(
+                "    { \"id\": \"port_%d\", \"value\": %f, \"index\": %d, \"enabled\": %s, \"comment\": null }%s\n",
+                int(i), double(i) * 0.125, int(i), (i & 1) ? "true" : "false",
+                (i < (items - 1)) ? "," : ""
+            );
+        }
+        doc->append_ascii("  ]\n}\n");
+    }
+
+    void parse_document(const LSPString *doc)
+    {
+        json::Parser p;
+        json::event_t ev;
+
+        if (p.wrap(doc, json::JSON_VERSION5) != STATUS_OK)
+            PTEST_FAIL();
+        while (p.read_next(&ev) == STATUS_OK) {}
+        p.close();
+    }
+
+    void test_parse(size_t items)
+    {
+        char key[80];
+        LSPString doc;
+        make_document(&doc, items);
+
+        snprintf(key, sizeof(key), "read_next x %d items [%d bytes]", int(items), int(doc.length()));
+        printf("Testing %s...\n", key);
+
+        PTEST_LOOP(key,
+            parse_document(&doc);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        for (size_t items=MIN_ITEMS; items <= MAX_ITEMS; items <<= 2)
+            test_parse(items);
+        PTEST_SEPARATOR;
+    }
+
+PTEST_END
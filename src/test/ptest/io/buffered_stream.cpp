@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/io/InBitStream.h>
+#include <lsp-plug.in/io/InBufferedStream.h>
+#include <lsp-plug.in/io/OutBufferedStream.h>
+
+#define FILE_SIZE           0x40000
+
+using namespace lsp;
+
+namespace
+{
+    // Each read() and write() call of the file stream issues one system call
+    class CountingInStream: public io::InFileStream
+    {
+        public:
+            size_t  nCalls;
+
+        public:
+            explicit CountingInStream()     { nCalls = 0; }
+
+            virtual ssize_t read(void *dst, size_t count)
+            {
+                ++nCalls;
+                return io::InFileStream::read(dst, count);
+            }
+    };
+
+    class CountingOutStream: public io::OutFileStream
+    {
+        public:
+            size_t  nCalls;
+
+        public:
+            explicit CountingOutStream()    { nCalls = 0; }
+
+            virtual ssize_t write(const void *buf, size_t count)
+            {
+                ++nCalls;
+                return io::OutFileStream::write(buf, count);
+            }
+    };
+
+    enum read_mode_t
+    {
+        RD_BYTE,
+        RD_WORD,
+        RD_BITS
+    };
+
+    const char *read_modes[] =
+    {
+        "read_byte()",
+        "read(4)",
+        "InBitStream::readv(3 bits)"
+    };
+}
+
+PTEST_BEGIN("runtime.io", buffered_stream, 5, 10)
+
+    size_t read_file(const LSPString *path, read_mode_t mode, bool buffered)
+    {
+        CountingInStream fis;
+        io::InBufferedStream bis;
+        io::InBitStream ibs;
+        io::IInStream *is = &fis;
+        uint32_t word;
+        uint8_t bits;
+
+        if (fis.open(path) != STATUS_OK)
+            PTEST_FAIL();
+        if (buffered)
+        {
+            if (bis.wrap(&fis) != STATUS_OK)
+                PTEST_FAIL();
+            is = &bis;
+        }
+
+        switch (mode)
+        {
+            case RD_BYTE:
+                while (is->read_byte() >= 0) { }
+                break;
+            case RD_WORD:
+                while (is->read(&word, sizeof(word)) > 0) { }
+                break;
+            case RD_BITS:
+                if (ibs.wrap(is) != STATUS_OK)
+                    PTEST_FAIL();
+                while (ibs.readv(&bits, 3) > 0) { }
+                ibs.close();
+                break;
+        }
+
+        bis.close();
+        fis.close();
+
+        return fis.nCalls;
+    }
+
+    size_t write_file(const LSPString *path, bool buffered)
+    {
+        CountingOutStream fos;
+        io::OutBufferedStream bos;
+        io::IOutStream *os = &fos;
+
+        if (fos.open(path, io::File::FM_WRITE_NEW) != STATUS_OK)
+            PTEST_FAIL();
+        if (buffered)
+        {
+            if (bos.wrap(&fos) != STATUS_OK)
+                PTEST_FAIL();
+            os = &bos;
+        }
+
+        for (size_t i=0; i<FILE_SIZE; ++i)
+            os->writeb(uint8_t(i));
+
+        bos.close();
+        fos.close();
+
+        return fos.nCalls;
+    }
+
+    void test_read(const LSPString *path, read_mode_t mode)
+    {
+        char key[80];
+        size_t calls[2];
+
+        calls[0] = read_file(path, mode, false);
+        calls[1] = read_file(path, mode, true);
+        printf("%s: %d read calls unbuffered, %d read calls buffered\n",
+                read_modes[mode], int(calls[0]), int(calls[1]));
+
+        snprintf(key, sizeof(key), "unbuffered %s", read_modes[mode]);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key,
+            read_file(path, mode, false);
+        );
+
+        snprintf(key, sizeof(key), "buffered %s", read_modes[mode]);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key,
+            read_file(path, mode, true);
+        );
+    }
+
+    void test_write(const LSPString *path)
+    {
+        size_t calls[2];
+
+        calls[0] = write_file(path, false);
+        calls[1] = write_file(path, true);
+        printf("writeb(): %d write calls unbuffered, %d write calls buffered\n",
+                int(calls[0]), int(calls[1]));
+
+        printf("Testing unbuffered writeb()...\n");
+        PTEST_LOOP("unbuffered writeb()",
+            write_file(path, false);
+        );
+
+        printf("Testing buffered writeb()...\n");
+        PTEST_LOOP("buffered writeb()",
+            write_file(path, true);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        LSPString path;
+        if (!path.fmt_utf8("%s" FILE_SEPARATOR_S "ptest-%s.tmp", tempdir(), full_name()))
+            PTEST_FAIL();
+
+        test_write(&path);
+        PTEST_SEPARATOR;
+
+        test_read(&path, RD_BYTE);
+        PTEST_SEPARATOR;
+        test_read(&path, RD_WORD);
+        PTEST_SEPARATOR;
+        test_read(&path, RD_BITS);
+        PTEST_SEPARATOR;
+
+        io::File::remove(&path);
+    }
+
+PTEST_END
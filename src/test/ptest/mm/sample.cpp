@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/mm/sample.h>
+
+#define MIN_SAMPLES         256
+#define MAX_SAMPLES         0x10000
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.mm", sample, 5, 1000)
+
+    void call(const char *label, uint8_t *dst, uint8_t *src, size_t samples, size_t to, size_t from)
+    {
+        char key[80];
+        size_t bytes = samples * mm::sformat_size_of(from);
+
+        snprintf(key, sizeof(key), "%s x %d samples [%d bytes]", label, int(samples), int(bytes));
+        printf("Testing %s...\n", key);
+
+        PTEST_LOOP(key,
+            mm::convert_samples(dst, src, samples, to, from);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t bytes    = MAX_SAMPLES * sizeof(mm::f64_t);
+        uint8_t *ptr    = static_cast<uint8_t *>(malloc(bytes * 2));
+        if (ptr == NULL)
+            PTEST_FAIL();
+
+        uint8_t *src    = ptr;
+        uint8_t *dst    = &ptr[bytes];
+        mm::f32_t *fsrc = reinterpret_cast<mm::f32_t *>(src);
+        for (size_t i=0, n=bytes/sizeof(mm::f32_t); i<n; ++i)
+            fsrc[i]         = (float(rand()) / RAND_MAX) * 2.0f - 1.0f;
+
+        #define CVT(to, from) \
+            for (size_t count=MIN_SAMPLES; count <= MAX_SAMPLES; count <<= 4) \
+                call(#from " -> " #to, dst, src, count, mm::to, mm::from); \
+            PTEST_SEPARATOR;
+
+        CVT(SFMT_F32_CPU, SFMT_S16_CPU);
+        CVT(SFMT_F32_CPU, SFMT_S16_BE);
+        CVT(SFMT_F32_CPU, SFMT_S24_CPU);
+        CVT(SFMT_F32_CPU, SFMT_S32_CPU);
+        CVT(SFMT_F32_CPU, SFMT_U8_CPU);
+        CVT(SFMT_S16_CPU, SFMT_F32_CPU);
+        CVT(SFMT_S24_CPU, SFMT_F32_CPU);
+        CVT(SFMT_F64_CPU, SFMT_F32_CPU);
+
+        #undef CVT
+
+        free(ptr);
+    }
+
+PTEST_END
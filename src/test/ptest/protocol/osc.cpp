@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/protocol/osc.h>
+
+#define MIN_MESSAGES        1
+#define MAX_MESSAGES        256
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.protocol", osc, 5, 10000)
+
+    status_t forge_bundle(osc::packet_t *packet, size_t messages)
+    {
+        osc::forge_t forge;
+        osc::forge_frame_t sframe, sbundle;
+        char address[32];
+
+        status_t res = osc::forge_begin_dynamic(&sframe, &forge);
+        if (res != STATUS_OK)
+            return res;
+
+        if ((res = osc::forge_begin_bundle(&sbundle, &sframe, uint64_t(0x1122334455667788ULL))) == STATUS_OK)
+        {
+            for (size_t i=0; (res == STATUS_OK) && (i < messages); ++i)
+            {
+                snprintf(address, sizeof(address), "/plugin/port_%d", int(i));
+                res = osc::forge_message(&sbundle, address, "ifsdT",
+                        int32_t(i), float(i) * 0.5f, "parameter", double(i) * 0.25, true);
+            }
+            if (res == STATUS_OK)
+                res = osc::forge_end(&sbundle);
+        }
+        if (res == STATUS_OK)
+            res = osc::forge_end(&sframe);
+        if (res == STATUS_OK)
+            res = osc::forge_close(packet, &forge);
+
+        osc::forge_destroy(&forge);
+        return res;
+    }
+
+    status_t parse_bundle(const osc::packet_t *packet, size_t messages)
+    {
+        osc::parser_t parser;
+        osc::parse_frame_t sframe, sbundle;
+        const char *address, *s;
+        uint64_t tag;
+        int32_t iv;
+        float fv;
+        double dv;
+        bool bv;
+
+        status_t res = osc::parse_begin(&sframe, &parser, packet->data, packet->size);
+        if (res != STATUS_OK)
+            return res;
+
+        if ((res = osc::parse_begin_bundle(&sbundle, &sframe, &tag)) == STATUS_OK)
+        {
+            for (size_t i=0; (res == STATUS_OK) && (i < messages); ++i)
+                res = osc::parse_message(&sbundle, "ifsdT", &address, &iv, &fv, &s, &dv, &bv);
+            if (res == STATUS_OK)
+                res = osc::parse_end(&sbundle);
+        }
+        if (res == STATUS_OK)
+            res = osc::parse_end(&sframe);
+
+        osc::parse_destroy(&parser);
+        return res;
+    }
+
+    PTEST_MAIN
+    {
+        char key[80];
+        osc::packet_t packet;
+
+        for (size_t count=MIN_MESSAGES; count <= MAX_MESSAGES; count <<= 2)
+        {
+            if (forge_bundle(&packet, count) != STATUS_OK)
+                PTEST_FAIL_MSG("Failed to forge OSC bundle of %d messages", int(count));
+            if (parse_bundle(&packet, count) != STATUS_OK)
+            {
+                osc::forge_free(packet.data);
+                PTEST_FAIL_MSG("Failed to parse OSC bundle of %d messages", int(count));
+            }
+
+            snprintf(key, sizeof(key), "parse x %d messages [%d bytes]", int(count), int(packet.size));
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                parse_bundle(&packet, count);
+            );
+
+            snprintf(key, sizeof(key), "forge x %d messages [%d bytes]", int(count), int(packet.size));
+            printf("Testing %s...\n", key);
+            osc::forge_free(packet.data);
+            PTEST_LOOP(key,
+                forge_bundle(&packet, count);
+                osc::forge_free(packet.data);
+            );
+
+            PTEST_SEPARATOR;
+        }
+    }
+
+PTEST_END
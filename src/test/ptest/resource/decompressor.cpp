@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/resource/Compressor.h>
+#include <lsp-plug.in/resource/Decompressor.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+
+#define BUFFER_SIZE         0x100000
+#define CHUNK_SIZE          0x1000
+#define MIN_ITEMS           64
+#define MAX_ITEMS           0x4000
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.resource", decompressor, 5, 10)
+
+    void make_resource(LSPString *text, size_t items)
+    {
+        text->clear();
+        text->append_ascii("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<presets>\n");
+        for (size_t i=0; i<items; ++i)
+            text->fmt_append_ascii("  <port id=\"band_%d\" value=\"%f\" />\n", int(i), double(rand()) / RAND_MAX);
+        text->append_ascii("</presets>\n");
+    }
+
+    void decompress(const uint8_t *data, const resource::raw_resource_t *ent, uint8_t *buf)
+    {
+        resource::Decompressor d;
+        if (d.init(&data[ent->segment], ent->offset + ent->length, BUFFER_SIZE) != STATUS_OK)
+            PTEST_FAIL();
+        if (d.skip(ent->offset) != ent->offset)
+            PTEST_FAIL();
+
+        while (d.read(buf, CHUNK_SIZE) > 0) {}
+        d.close();
+    }
+
+    void test_read(size_t items, uint8_t *buf)
+    {
+        char key[80];
+        LSPString text;
+        io::OutMemoryStream oms;
+        resource::Compressor c;
+
+        // Compress the resource
+        make_resource(&text, items);
+        const char *utf8    = text.get_utf8();
+        size_t bytes        = ::strlen(utf8);
+        io::InMemoryStream ims(utf8, bytes);
+
+        if (c.init(BUFFER_SIZE, &oms) != STATUS_OK)
+            PTEST_FAIL();
+        if (c.create_file("presets.xml", &ims) != wssize_t(bytes))
+            PTEST_FAIL();
+        c.flush();
+
+        const uint8_t *data                 = oms.data();
+        const resource::raw_resource_t *ent = c.entries();
+
+        snprintf(key, sizeof(key), "read x %d bytes [%d compressed]", int(bytes), int(oms.size()));
+        printf("Testing %s...\n", key);
+
+        PTEST_LOOP(key,
+            decompress(data, ent, buf);
+        );
+
+        c.close();
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *buf = static_cast<uint8_t *>(malloc(CHUNK_SIZE));
+        if (buf == NULL)
+            PTEST_FAIL();
+
+        for (size_t items=MIN_ITEMS; items <= MAX_ITEMS; items <<= 2)
+            test_read(items, buf);
+        PTEST_SEPARATOR;
+
+        free(buf);
+    }
+
+PTEST_END
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+
+#define MIN_LENGTH          8
+#define MAX_LENGTH          4096
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.runtime", string, 5, 1000)
+
+    void fill_string(LSPString *s, size_t length)
+    {
+        s->clear();
+        for (size_t i=0; i<length; ++i)
+            s->append(lsp_wchar_t('a' + (i % 26)));
+    }
+
+    void test_append(size_t length)
+    {
+        char key[80];
+        LSPString src, dst;
+        fill_string(&src, length);
+
+        snprintf(key, sizeof(key), "append x %d chars [%d bytes]", int(length), int(length * sizeof(lsp_wchar_t)));
+        printf("Testing %s...\n", key);
+
+        PTEST_LOOP(key,
+            dst.clear();
+            for (size_t i=0; i<8; ++i)
+                dst.append(&src);
+        );
+    }
+
+    void test_append_char(size_t length)
+    {
+        char key[80];
+        LSPString dst;
+
+        snprintf(key, sizeof(key), "append char x %d chars [%d bytes]", int(length), int(length * sizeof(lsp_wchar_t)));
+        printf("Testing %s...\n", key);
+
+        PTEST_LOOP(key,
+            dst.clear();
+            for (size_t i=0; i<length; ++i)
+                dst.append(lsp_wchar_t('a' + (i % 26)));
+        );
+    }
+
+    void test_compare(size_t length)
+    {
+        char key[80];
+        LSPString a, b;
+        fill_string(&a, length);
+        fill_string(&b, length);
+
+        snprintf(key, sizeof(key), "compare x %d chars [%d bytes]", int(length), int(length * sizeof(lsp_wchar_t)));
+        printf("Testing %s...\n", key);
+
+        PTEST_LOOP(key,
+            a.equals(&b);
+            a.compare_to(&b);
+        );
+    }
+
+    void test_hash(size_t length)
+    {
+        char key[80];
+        LSPString a, b;
+        fill_string(&a, length);
+
+        snprintf(key, sizeof(key), "hash x %d chars [%d bytes]", int(length), int(length * sizeof(lsp_wchar_t)));
+        printf("Testing %s...\n", key);
+
+        // Copy the string each time to prevent the cached hash value from being used
+        PTEST_LOOP(key,
+            b.set(&a);
+            b.hash();
+        );
+    }
+
+    void test_search(size_t length)
+    {
+        char key[80];
+        LSPString a, b;
+        fill_string(&a, length);
+        a.append('!');
+        b.set_ascii("xyz!");
+        a.insert(a.length() - 1, &b, 0, 3);
+
+        snprintf(key, sizeof(key), "index_of x %d chars [%d bytes]", int(length), int(length * sizeof(lsp_wchar_t)));
+        printf("Testing %s...\n", key);
+
+        // The searched character and substring are located at the end of the string
+        PTEST_LOOP(key,
+            a.index_of('!');
+            a.rindex_of('a');
+            a.index_of(&b);
+        );
+    }
+
+    void test_compare_nocase(size_t length)
+    {
+        char key[80];
+        LSPString a, b;
+        fill_string(&a, length);
+        fill_string(&b, length);
+        b.toupper(length / 2);
+
+        snprintf(key, sizeof(key), "compare nocase x %d chars [%d bytes]", int(length), int(length * sizeof(lsp_wchar_t)));
+        printf("Testing %s...\n", key);
+
+        PTEST_LOOP(key,
+            a.equals_nocase(&b);
+            a.compare_to_nocase(&b);
+        );
+    }
+
+    void test_short_keys(size_t length)
+    {
+        char key[80];
+        char text[80];
+        for (size_t i=0; i<length; ++i)
+            text[i]     = 'a' + (i % 26);
+        text[length]    = '\0';
+
+        snprintf(key, sizeof(key), "short key x %d chars", int(length));
+        printf("Testing %s...\n", key);
+
+        // Construct, fill and destroy short strings like parsers do for keys
+        PTEST_LOOP(key,
+            for (size_t i=0; i<16; ++i)
+            {
+                LSPString tmp;
+                tmp.set_ascii(text, length);
+                tmp.hash();
+            }
+        );
+    }
+
+    PTEST_MAIN
+    {
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+            test_append(len);
+        PTEST_SEPARATOR;
+
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+            test_append_char(len);
+        PTEST_SEPARATOR;
+
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+            test_compare(len);
+        PTEST_SEPARATOR;
+
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+            test_hash(len);
+        PTEST_SEPARATOR;
+
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+            test_search(len);
+        PTEST_SEPARATOR;
+
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+            test_compare_nocase(len);
+        PTEST_SEPARATOR;
+
+        for (size_t len=4; len <= 32; len <<= 1)
+            test_short_keys(len);
+        PTEST_SEPARATOR;
+    }
+
+PTEST_END
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/runtime/LSPStringBuilder.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+
+#define MIN_LENGTH          0x400
+#define MAX_LENGTH          0x40000
+
+using namespace lsp;
+
+PTEST_BEGIN("runtime.runtime", string_builder, 5, 100)
+
+    void test_append(size_t length)
+    {
+        char key[80];
+        LSPString src, dst;
+        LSPStringBuilder sb;
+        src.set_ascii("key = \"value\";\n");
+
+        snprintf(key, sizeof(key), "LSPString append x %d chars", int(length));
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key,
+            dst.truncate();
+            while (dst.length() < length)
+                dst.append(&src);
+        );
+
+        snprintf(key, sizeof(key), "LSPStringBuilder append x %d chars", int(length));
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key,
+            sb.clear();
+            while (sb.length() < length)
+                sb.append(&src);
+            sb.flatten(&dst);
+        );
+    }
+
+    void test_prepend(size_t length)
+    {
+        char key[80];
+        LSPString src, dst;
+        LSPStringBuilder sb;
+        src.set_ascii("key = \"value\";\n");
+
+        snprintf(key, sizeof(key), "LSPString prepend x %d chars", int(length));
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key,
+            dst.truncate();
+            while (dst.length() < length)
+                dst.prepend(&src);
+        );
+
+        snprintf(key, sizeof(key), "LSPStringBuilder prepend x %d chars", int(length));
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key,
+            sb.clear();
+            while (sb.length() < length)
+                sb.prepend(&src);
+            sb.flatten(&dst);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+        {
+            test_append(len);
+            PTEST_SEPARATOR;
+        }
+
+        for (size_t len=MIN_LENGTH; len <= MAX_LENGTH; len <<= 3)
+        {
+            test_prepend(len);
+            PTEST_SEPARATOR;
+        }
+    }
+
+PTEST_END
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/expr/Batch.h>
+#include <lsp-plug.in/expr/Expression.h>
+#include <lsp-plug.in/expr/Variables.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#define LANES       1000
+
+namespace lsp
+{
+    using namespace lsp::expr;
+}
+
+UTEST_BEGIN("runtime.expr", batch)
+
+    bool same(double a, double b)
+    {
+        if (isnan(a) || isnan(b))
+            return isnan(a) && isnan(b);
+        return (a == b) || (fabs(a - b) <= 1e-9 * fabs(a));
+    }
+
+    void test_batch(const char *text, Batch *b, size_t count)
+    {
+        Expression e;
+        value_t v;
+        double *vd  = new double[count];
+        float *vf   = new float[count];
+        UTEST_ASSERT((vd != NULL) && (vf != NULL));
+        init_value(&v);
+
+        printf("  evaluating batch: %s\n", text);
+        UTEST_ASSERT_MSG(e.parse(text, NULL, Expression::FLAG_NONE) == STATUS_OK, "Error parsing expression: %s", text);
+        UTEST_ASSERT(e.evaluate_batch(b, vd, count) == STATUS_OK);
+        UTEST_ASSERT(e.evaluate_batch(b, vf, count) == STATUS_OK);
+
+        // Compare with the scalar evaluation of each lane
+        e.set_resolver(b);
+        for (size_t i=0; i<count; ++i)
+        {
+            b->set_lane(i);
+            UTEST_ASSERT(e.evaluate(&v) == STATUS_OK);
+            double x = (cast_float(&v) == STATUS_OK) && (v.type == VT_FLOAT) ? v.v_float : NAN;
+            destroy_value(&v);
+
+            UTEST_ASSERT_MSG(same(x, vd[i]), "Lane %d: expected %f, got %f", int(i), x, vd[i]);
+            UTEST_ASSERT_MSG(same(float(x), vf[i]), "Lane %d: expected %f, got %f", int(i), x, vf[i]);
+        }
+
+        delete [] vd;
+        delete [] vf;
+    }
+
+    UTEST_MAIN
+    {
+        Variables vars;
+        Batch b(&vars);
+        float *x    = new float[LANES];
+        double *y   = new double[LANES];
+        UTEST_ASSERT((x != NULL) && (y != NULL));
+
+        for (size_t i=0; i<LANES; ++i)
+        {
+            x[i]        = (ssize_t(i) - 500) * 0.125f;
+            y[i]        = ::sin(i * 0.01) * 10.0;
+        }
+
+        UTEST_ASSERT(vars.set_int("n", 3) == STATUS_OK);
+        UTEST_ASSERT(vars.set_float("g", 0.5) == STATUS_OK);
+        UTEST_ASSERT(vars.set_string("s", "text") == STATUS_OK);
+        UTEST_ASSERT(vars.set_int("i", 1) == STATUS_OK);
+        UTEST_ASSERT(b.set("x", x) == STATUS_OK);
+        UTEST_ASSERT(b.set("y", y) == STATUS_OK);
+        UTEST_ASSERT(b.set("arr_0", x) == STATUS_OK);
+        UTEST_ASSERT(b.set("arr_1", y) == STATUS_OK);
+        UTEST_ASSERT(b.size() == 4);
+
+        printf("Testing vectorized evaluation\n");
+        test_batch(":x", &b, LANES);
+        test_batch(":x + :y", &b, LANES);
+        test_batch(":x * :g - :y / :n", &b, LANES);
+        test_batch("2 - :x", &b, LANES);
+        test_batch(":n / :x", &b, LANES);
+        test_batch(":x / 0", &b, LANES);
+        test_batch("-:x * 3 + :n * :g", &b, LANES);
+        test_batch("~:y", &b, LANES);
+        test_batch(":x ** 2 + 2 ** :g", &b, 300);
+        test_batch("3 ** :y", &b, 300);
+        test_batch(":x < :y", &b, LANES);
+        test_batch(":x >= 1", &b, LANES);
+        test_batch("2 > :y", &b, LANES);
+        test_batch(":x = :x", &b, LANES);
+        test_batch(":x != 0", &b, LANES);
+        test_batch(":arr[:i] * 2", &b, LANES);
+        test_batch(":n * 2 + 1", &b, LANES);
+        test_batch(":missing + :x", &b, LANES);
+        test_batch("(:n > 2) ? :x : :y", &b, LANES);
+
+        printf("Testing scalar fallback\n");
+        test_batch(":x < 0 ? :x : :y", &b, LANES);
+        test_batch("(:x < :y) + 1", &b, LANES);
+        test_batch("db :x", &b, LANES);
+        test_batch(":x idiv 3", &b, LANES);
+        test_batch(":s sc :x", &b, LANES);
+        test_batch(":s", &b, 10);
+        test_batch(":x <=> :y", &b, LANES);
+        test_batch("(:x > 0) && (:y > 0)", &b, LANES);
+        test_batch(":arr[:x > 0] + 1", &b, LANES);
+        test_batch("int :x + :y", &b, LANES);
+
+        UTEST_ASSERT(b.unset("x") == STATUS_OK);
+        UTEST_ASSERT(b.unset("x") == STATUS_NOT_FOUND);
+        b.clear();
+        UTEST_ASSERT(b.size() == 0);
+
+        delete [] x;
+        delete [] y;
+    }
+
+UTEST_END;
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/io/InStringSequence.h>
+#include <lsp-plug.in/expr/parser.h>
+#include <lsp-plug.in/expr/Bytecode.h>
+#include <lsp-plug.in/expr/Variables.h>
+
+namespace lsp
+{
+    using namespace lsp::expr;
+}
+
+UTEST_BEGIN("runtime.expr", bytecode)
+
+    bool values_equal(const value_t *a, const value_t *b)
+    {
+        if (a->type != b->type)
+            return false;
+
+        switch (a->type)
+        {
+            case VT_INT:    return a->v_int == b->v_int;
+            case VT_FLOAT:  return (a->v_float == b->v_float) || ((a->v_float != a->v_float) && (b->v_float != b->v_float));
+            case VT_BOOL:   return a->v_bool == b->v_bool;
+            case VT_STRING: return a->v_str->equals(b->v_str);
+            default:        break;
+        }
+
+        return true;
+    }
+
+    void test_expr(const char *text, Resolver *r, bool constant = false)
+    {
+        io::InStringSequence is;
+        expr_t *expr = NULL;
+        Bytecode code;
+        value_t tv, bv;
+
+        printf("Testing expression: %s\n", text);
+        UTEST_ASSERT(is.wrap(text, "UTF-8") == STATUS_OK);
+        {
+            Tokenizer t(&is);
+            UTEST_ASSERT_MSG(parse_expression(&expr, &t, TF_GET) == STATUS_OK, "Error parsing expression: %s", text);
+        }
+
+        UTEST_ASSERT(code.compile(expr) == STATUS_OK);
+        UTEST_ASSERT(code.size() > 0);
+        UTEST_ASSERT_MSG(code.constant() == constant, "%s: expected to be %s", text, (constant) ? "constant" : "variable");
+
+        // Evaluate several times to ensure that the register file is properly reused
+        for (size_t i=0; i<3; ++i)
+        {
+            init_value(&tv);
+            init_value(&bv);
+            status_t tres   = expr->eval(&tv, expr, r);
+            status_t bres   = code.execute(&bv, r);
+
+            UTEST_ASSERT_MSG(tres == bres, "%s: status mismatch tree=%d, bytecode=%d", text, int(tres), int(bres));
+            if (tres == STATUS_OK)
+            {
+                UTEST_ASSERT_MSG(values_equal(&tv, &bv), "%s: result mismatch: types tree=%d, bytecode=%d",
+                    text, int(tv.type), int(bv.type));
+                destroy_value(&tv);
+                destroy_value(&bv);
+            }
+        }
+
+        parse_destroy(expr);
+        is.close();
+    }
+
+    void init_vars(Variables &v)
+    {
+        UTEST_ASSERT(v.set_int("ia", 1) == STATUS_OK);
+        UTEST_ASSERT(v.set_int("ib", 3) == STATUS_OK);
+        UTEST_ASSERT(v.set_int("iz", 0) == STATUS_OK);
+        UTEST_ASSERT(v.set_bool("ba", true) == STATUS_OK);
+        UTEST_ASSERT(v.set_bool("bb", false) == STATUS_OK);
+        UTEST_ASSERT(v.set_float("fa", 0.5) == STATUS_OK);
+        UTEST_ASSERT(v.set_float("fb", 14.1) == STATUS_OK);
+        UTEST_ASSERT(v.set_null("za") == STATUS_OK);
+        UTEST_ASSERT(v.set_string("sa", "lower") == STATUS_OK);
+        UTEST_ASSERT(v.set_string("sn", "12") == STATUS_OK);
+        UTEST_ASSERT(v.set_string("sx", "abc") == STATUS_OK);
+        UTEST_ASSERT(v.set_int("v_0_0", 1234) == STATUS_OK);
+        UTEST_ASSERT(v.set_float("v_0_1", 1.234) == STATUS_OK);
+        UTEST_ASSERT(v.set_bool("v_1_0", true) == STATUS_OK);
+        UTEST_ASSERT(v.set_string("v_1_1", "test") == STATUS_OK);
+        UTEST_ASSERT(v.set_int("w_0_1_2_3_4_5_6_7_8_9_10_11_12_13_14_15_16_17", 42) == STATUS_OK);
+    }
+
+    void test_all(Resolver *r)
+    {
+        // Constant expressions
+        test_expr("12 db", r, true);
+        test_expr("+6 + -3 - --2", r, true);
+        test_expr("'1' sc 20 sc 3*9", r, true);
+        test_expr("'xy' sr 3", r, true);
+        test_expr("(1 < 2) ? 'a' : 'b'", r, true);
+        test_expr("null <=> undef", r, true);
+        test_expr("1 idiv 0", r, true);
+        test_expr("1 imod 0", r, true);
+
+        // Arithmetic
+        test_expr(":ia + :ib * :fa - :fb / 2", r);
+        test_expr(":ia + 1", r);
+        test_expr(":ia / :iz", r);
+        test_expr(":ia / 0", r);
+        test_expr(":fa / 0", r);
+        test_expr(":sn + 1", r);
+        test_expr(":sn * :ia", r);
+        test_expr(":sx + 1", r);
+        test_expr(":za + 1", r);
+        test_expr(":zz - :ia", r);
+        test_expr("1 - :zz", r);
+        test_expr(":ba + 1", r);
+        test_expr(":ib ** :fa", r);
+        test_expr(":ib ** :za", r);
+        test_expr(":sx ** 2", r);
+        test_expr("(:ia + :ib) idiv 2 + :ib imod 2 + :fb fmod 3", r);
+        test_expr(":ia idiv 0", r);
+        test_expr(":ia idiv :iz", r);
+        test_expr(":ia imod :iz", r);
+        test_expr(":ib bxor 0x3 bor :ia band 0xc", r);
+        test_expr("-:fa + ~:ia + ++:ib", r);
+
+        // Comparison
+        test_expr(":ia < :fa", r);
+        test_expr(":ia >= 1", r);
+        test_expr(":fa <=> :ib", r);
+        test_expr(":sa == 'lower'", r);
+        test_expr(":sn == 12", r);
+        test_expr(":za == undef", r);
+        test_expr(":ia icmp null", r);
+        test_expr(":ba eq true", r);
+        test_expr("'0x100' ieq :ia", r);
+
+        // Logic
+        test_expr(":ba || :bb && :ia ^^ :fa", r);
+        test_expr(":bb || :ia", r);
+        test_expr(":ba && :sx", r);
+        test_expr("!:ba xor :bb", r);
+        test_expr(":ia < 2 ? :ib < 1 ? 0 : 1 : :fa", r);
+        test_expr(":sx ? 1 : 2", r);
+        test_expr(":za ? 1 : 2", r);
+
+        // Strings and functions
+        test_expr("uc :sa sc lc :sa sc srev :sa", r);
+        test_expr("slen :sa + slen 'abc'", r);
+        test_expr(":sa sr :ib", r);
+        test_expr(":sa sr :za", r);
+        test_expr("'null: ' sc :za sc ', undef: ' sc :zz", r);
+        test_expr("int :fb + fp :ia + bool :fa", r);
+        test_expr("str :ba sc str :fa", r);
+        test_expr("ex :ia && !ex :zz", r);
+        test_expr("db :fa", r);
+
+        // Indexed variables
+        test_expr(":v[0][0] + :v[0][1]", r);
+        test_expr(":v[:bb][:ia] = 1.234", r);
+        test_expr(":v[:fa][:ia - :fa] && (:v[1][:ba] = 'test')", r);
+        test_expr(":v[:sx][0]", r);
+        test_expr(":v[2][2]", r);
+        test_expr(":w[0][1][2][3][4][5][6][7][8][9][10][11][12][13][14][15][16][:ia + 16]", r);
+    }
+
+    UTEST_MAIN
+    {
+        Variables v;
+        init_vars(v);
+
+        test_all(&v);
+        test_all(NULL);
+    }
+
+UTEST_END;
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/expr/Expression.h>
+#include <lsp-plug.in/expr/ParseCache.h>
+#include <lsp-plug.in/expr/Variables.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+#define THREADS         4
+#define ITERATIONS      500
+
+namespace lsp
+{
+    using namespace lsp::expr;
+
+    namespace
+    {
+        static const char *texts[] =
+        {
+            ":a + :b * 2",
+            "(:a > :b) ? :a : :b",
+            ":a * 10 + 1",
+            "'value' sc :a",
+            NULL
+        };
+
+        typedef struct thread_ctx_t
+        {
+            Variables          *vars;
+            size_t              errors;
+        } thread_ctx_t;
+
+        static status_t parse_proc(void *arg)
+        {
+            thread_ctx_t *ctx = static_cast<thread_ctx_t *>(arg);
+            value_t v;
+            init_value(&v);
+
+            for (size_t i=0; i<ITERATIONS; ++i)
+            {
+                for (const char **t = texts; *t != NULL; ++t)
+                {
+                    Expression e(ctx->vars);
+                    if ((e.parse(*t, NULL, Expression::FLAG_NONE) != STATUS_OK) ||
+                        (e.evaluate(&v) != STATUS_OK))
+                        ++ctx->errors;
+                    destroy_value(&v);
+                }
+            }
+
+            return STATUS_OK;
+        }
+    }
+}
+
+UTEST_BEGIN("runtime.expr", cache)
+
+    void test_sharing()
+    {
+        Variables vars;
+        value_t v;
+        init_value(&v);
+
+        printf("Testing sharing of parsed trees\n");
+
+        UTEST_ASSERT(vars.set_int("a", 3) == STATUS_OK);
+        UTEST_ASSERT(vars.set_int("b", 4) == STATUS_OK);
+
+        size_t base = ParseCache::size();
+        Expression *e1 = new Expression(&vars);
+        Expression *e2 = new Expression(&vars);
+        Expression *e3 = new Expression(&vars);
+        UTEST_ASSERT((e1 != NULL) && (e2 != NULL) && (e3 != NULL));
+
+        UTEST_ASSERT(e1->parse(":a + :b * 2; :a", NULL, Expression::FLAG_MULTIPLE) == STATUS_OK);
+        UTEST_ASSERT(ParseCache::size() == base + 1);
+        UTEST_ASSERT(e2->parse(":a + :b * 2; :a", NULL, Expression::FLAG_MULTIPLE) == STATUS_OK);
+        UTEST_ASSERT(ParseCache::size() == base + 1);
+
+        // Different flags produce different trees
+        UTEST_ASSERT(e3->parse(":a + :b * 2; :a", NULL, Expression::FLAG_STRING) == STATUS_OK);
+        UTEST_ASSERT(ParseCache::size() == base + 2);
+
+        // Shared trees should give the same results and dependencies
+        UTEST_ASSERT(e2->results() == 2);
+        UTEST_ASSERT(e2->dependencies() == 2);
+        UTEST_ASSERT(e2->has_dependency("a"));
+        UTEST_ASSERT(e2->has_dependency("b"));
+        UTEST_ASSERT(e1->evaluate(&v) == STATUS_OK);
+        UTEST_ASSERT((v.type == VT_INT) && (v.v_int == 11));
+        UTEST_ASSERT(e2->evaluate(&v) == STATUS_OK);
+        UTEST_ASSERT((v.type == VT_INT) && (v.v_int == 11));
+        UTEST_ASSERT(e2->evaluate(1, &v) == STATUS_OK);
+        UTEST_ASSERT((v.type == VT_INT) && (v.v_int == 3));
+        UTEST_ASSERT(e3->evaluate(&v) == STATUS_OK);
+        UTEST_ASSERT(v.type == VT_STRING);
+        UTEST_ASSERT(v.v_str->equals_ascii(":a + :b * 2; :a"));
+        destroy_value(&v);
+
+        // Results are owned by each expression
+        UTEST_ASSERT(vars.set_int("b", 1) == STATUS_OK);
+        UTEST_ASSERT(e2->evaluate(&v) == STATUS_OK);
+        UTEST_ASSERT(v.v_int == 5);
+        UTEST_ASSERT(e1->result(&v, 0) == STATUS_OK);
+        UTEST_ASSERT(v.v_int == 11);
+
+        // Tree lives while it is referenced
+        delete e1;
+        UTEST_ASSERT(ParseCache::size() == base + 2);
+        UTEST_ASSERT(e2->evaluate(&v) == STATUS_OK);
+        UTEST_ASSERT(v.v_int == 5);
+
+        // Re-parsing releases the tree
+        UTEST_ASSERT(e2->parse(":b", NULL, Expression::FLAG_NONE) == STATUS_OK);
+        UTEST_ASSERT(ParseCache::size() == base + 2);
+        UTEST_ASSERT(e2->results() == 1);
+        UTEST_ASSERT(e2->evaluate(&v) == STATUS_OK);
+        UTEST_ASSERT(v.v_int == 1);
+
+        delete e2;
+        delete e3;
+        UTEST_ASSERT(ParseCache::size() == base);
+
+        // Failed parse does not get into the cache
+        Expression e4;
+        UTEST_ASSERT(e4.parse(":a +", NULL, Expression::FLAG_NONE) != STATUS_OK);
+        UTEST_ASSERT(!e4.valid());
+        UTEST_ASSERT(ParseCache::size() == base);
+
+        destroy_value(&v);
+    }
+
+    void test_dependencies()
+    {
+        Variables vars;
+        printf("Testing dependencies of shared trees\n");
+
+        UTEST_ASSERT(vars.set_int("x", 1) == STATUS_OK);
+        UTEST_ASSERT(vars.set_int("y", 2) == STATUS_OK);
+        UTEST_ASSERT(vars.set_bool("z", false) == STATUS_OK);
+
+        // The second parse hits the cache and gets the already optimized tree
+        const char *text = "(1 ? :x : :y) + (true || :z); :y";
+        Expression e1(&vars), e2(&vars);
+        UTEST_ASSERT(e1.parse(text, NULL, Expression::FLAG_MULTIPLE) == STATUS_OK);
+        UTEST_ASSERT(e2.parse(text, NULL, Expression::FLAG_MULTIPLE) == STATUS_OK);
+
+        UTEST_ASSERT(e1.dependencies() == 3);
+        UTEST_ASSERT(e2.dependencies() == e1.dependencies());
+        for (size_t i=0, n=e1.dependencies(); i<n; ++i)
+        {
+            UTEST_ASSERT(e1.dependency(i)->equals(e2.dependency(i)));
+        }
+
+        // Invalidation should work the same way
+        LSPString name;
+        UTEST_ASSERT(name.set_ascii("z"));
+        UTEST_ASSERT(e1.invalidate(&name));
+        UTEST_ASSERT(e2.invalidate(&name));
+    }
+
+    void test_threads()
+    {
+        Variables vars[THREADS];
+        thread_ctx_t ctx[THREADS];
+        ipc::Thread *threads[THREADS];
+
+        printf("Testing concurrent access to the cache\n");
+
+        size_t base = ParseCache::size();
+        for (size_t i=0; i<THREADS; ++i)
+        {
+            UTEST_ASSERT(vars[i].set_int("a", i) == STATUS_OK);
+            UTEST_ASSERT(vars[i].set_int("b", i * 2) == STATUS_OK);
+            ctx[i].vars     = &vars[i];
+            ctx[i].errors   = 0;
+            threads[i]      = new ipc::Thread(parse_proc, &ctx[i]);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+
+        for (size_t i=0; i<THREADS; ++i)
+            UTEST_ASSERT(threads[i]->start() == STATUS_OK);
+        for (size_t i=0; i<THREADS; ++i)
+        {
+            UTEST_ASSERT(threads[i]->join() == STATUS_OK);
+            UTEST_ASSERT(ctx[i].errors == 0);
+            delete threads[i];
+        }
+
+        UTEST_ASSERT(ParseCache::size() == base);
+    }
+
+    UTEST_MAIN
+    {
+        test_sharing();
+        test_dependencies();
+        test_threads();
+    }
+
+UTEST_END;
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/expr/Context.h>
+#include <lsp-plug.in/expr/Expression.h>
+#include <lsp-plug.in/expr/Parameters.h>
+#include <lsp-plug.in/expr/Variables.h>
+
+namespace lsp
+{
+    using namespace lsp::expr;
+
+    namespace
+    {
+        class CountingVariables: public Variables
+        {
+            public:
+                size_t      nCalls;
+
+            public:
+                explicit CountingVariables()
+                {
+                    nCalls      = 0;
+                }
+
+            public:
+                virtual status_t resolve(value_t *value, const LSPString *name, size_t num_indexes = 0, const ssize_t *indexes = NULL)
+                {
+                    ++nCalls;
+                    return Variables::resolve(value, name, num_indexes, indexes);
+                }
+
+                virtual status_t resolve_bound(value_t *value, size_t slot)
+                {
+                    ++nCalls;
+                    return Variables::resolve_bound(value, slot);
+                }
+        };
+    }
+}
+
+UTEST_BEGIN("runtime.expr", context)
+
+    void test_variables()
+    {
+        CountingVariables v;
+        Context ctx;
+        Expression e1(&v), e2(&v);
+        value_t value;
+        init_value(&value);
+
+        printf("Testing dependency tracking of variables\n");
+
+        UTEST_ASSERT(v.set_int("a", 1) == STATUS_OK);
+        UTEST_ASSERT(v.set_int("b", 2) == STATUS_OK);
+        UTEST_ASSERT(v.set_int("c", 3) == STATUS_OK);
+
+        UTEST_ASSERT(e1.parse(":a + :b; :c * 2", NULL, Expression::FLAG_MULTIPLE) == STATUS_OK);
+        UTEST_ASSERT(e2.parse(":c + 1", NULL, Expression::FLAG_NONE) == STATUS_OK);
+
+        UTEST_ASSERT(ctx.attach(&v) == STATUS_OK);
+        UTEST_ASSERT(ctx.attach(&v) == STATUS_ALREADY_EXISTS);
+        UTEST_ASSERT(ctx.add(&e1) == STATUS_OK);
+        UTEST_ASSERT(ctx.add(&e2) == STATUS_OK);
+        UTEST_ASSERT(ctx.add(&e2) == STATUS_OK);
+        UTEST_ASSERT(ctx.size() == 2);
+        UTEST_ASSERT(e1.context() == &ctx);
+
+        // First evaluation computes everything
+        UTEST_ASSERT(e1.dirty());
+        UTEST_ASSERT(e1.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 3);
+        UTEST_ASSERT(e2.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 4);
+        UTEST_ASSERT(v.nCalls == 4);
+        UTEST_ASSERT(!e1.dirty());
+        UTEST_ASSERT(!e2.dirty());
+
+        // Clean expressions return cached results
+        UTEST_ASSERT(e1.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 3);
+        UTEST_ASSERT(e1.evaluate(1, &value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 6);
+        UTEST_ASSERT(e2.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(v.nCalls == 4);
+
+        // Change of 'a' affects only the first result of e1
+        UTEST_ASSERT(v.set_int("a", 10) == STATUS_OK);
+        UTEST_ASSERT(e1.dirty(0));
+        UTEST_ASSERT(!e1.dirty(1));
+        UTEST_ASSERT(!e2.dirty());
+        UTEST_ASSERT(e1.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 12);
+        UTEST_ASSERT(v.nCalls == 6);
+
+        // Change of 'c' affects the second result of e1 and e2
+        UTEST_ASSERT(v.set_int("c", 5) == STATUS_OK);
+        UTEST_ASSERT(!e1.dirty(0));
+        UTEST_ASSERT(e1.dirty(1));
+        UTEST_ASSERT(e2.dirty());
+        UTEST_ASSERT(e1.evaluate(1, &value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 10);
+        UTEST_ASSERT(e2.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 6);
+        UTEST_ASSERT(v.nCalls == 8);
+
+        // Unrelated variable does not affect anything
+        UTEST_ASSERT(v.set_int("d", 5) == STATUS_OK);
+        UTEST_ASSERT(!e1.dirty());
+        UTEST_ASSERT(!e2.dirty());
+
+        // Unset and clear
+        UTEST_ASSERT(v.unset("b") == STATUS_OK);
+        UTEST_ASSERT(e1.dirty(0));
+        UTEST_ASSERT(e1.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(!e1.dirty(0));
+        v.clear();
+        UTEST_ASSERT(e1.dirty(0));
+        UTEST_ASSERT(e1.dirty(1));
+        UTEST_ASSERT(e2.dirty());
+
+        // Expression that is not tracked anymore is always evaluated
+        UTEST_ASSERT(ctx.remove(&e2) == STATUS_OK);
+        UTEST_ASSERT(ctx.remove(&e2) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(e2.context() == NULL);
+        UTEST_ASSERT(ctx.size() == 1);
+        size_t calls = v.nCalls;
+        UTEST_ASSERT(e2.evaluate(&value) == STATUS_OK);
+        size_t delta = v.nCalls - calls;
+        UTEST_ASSERT(delta > 0);
+        UTEST_ASSERT(e2.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(v.nCalls == calls + delta * 2);
+
+        // Re-parsing the expression updates dependencies
+        UTEST_ASSERT(v.set_int("d", 7) == STATUS_OK);
+        e1.destroy();
+        e1.set_resolver(&v);
+        UTEST_ASSERT(e1.context() == NULL);
+        UTEST_ASSERT(ctx.add(&e1) == STATUS_OK);
+        UTEST_ASSERT(e1.parse(":d", NULL, Expression::FLAG_NONE) == STATUS_OK);
+        UTEST_ASSERT(e1.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 7);
+        UTEST_ASSERT(v.set_int("d", 8) == STATUS_OK);
+        UTEST_ASSERT(e1.dirty());
+        UTEST_ASSERT(e1.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 8);
+
+        destroy_value(&value);
+    }
+
+    void test_indexed()
+    {
+        Variables v;
+        Context ctx;
+        Expression e(&v);
+        value_t value;
+        init_value(&value);
+
+        printf("Testing dependency tracking of indexed variables\n");
+
+        UTEST_ASSERT(v.set_int("i", 1) == STATUS_OK);
+        UTEST_ASSERT(v.set_int("arr_0", 10) == STATUS_OK);
+        UTEST_ASSERT(v.set_int("arr_1", 20) == STATUS_OK);
+        UTEST_ASSERT(e.parse(":arr[:i]", NULL, Expression::FLAG_NONE) == STATUS_OK);
+        UTEST_ASSERT(ctx.attach(&v) == STATUS_OK);
+        UTEST_ASSERT(ctx.add(&e) == STATUS_OK);
+
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 20);
+
+        UTEST_ASSERT(v.set_int("arr_1", 30) == STATUS_OK);
+        UTEST_ASSERT(e.dirty());
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 30);
+
+        UTEST_ASSERT(v.set_int("i", 0) == STATUS_OK);
+        UTEST_ASSERT(e.dirty());
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 10);
+
+        // Manual notification
+        ctx.invalidate_all();
+        UTEST_ASSERT(e.dirty());
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(ctx.changed("arr_5") == STATUS_OK);
+        UTEST_ASSERT(e.dirty());
+
+        destroy_value(&value);
+    }
+
+    void test_parameters()
+    {
+        Parameters p;
+        Context ctx;
+        Expression e(&p);
+        value_t value;
+        init_value(&value);
+
+        printf("Testing dependency tracking of parameters\n");
+
+        UTEST_ASSERT(p.add_int("x", 2) == STATUS_OK);
+        UTEST_ASSERT(p.add_int("y", 3) == STATUS_OK);
+        UTEST_ASSERT(e.parse(":x * 10", NULL, Expression::FLAG_NONE) == STATUS_OK);
+        UTEST_ASSERT(ctx.attach(&p) == STATUS_OK);
+        UTEST_ASSERT(ctx.add(&e) == STATUS_OK);
+
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 20);
+
+        UTEST_ASSERT(p.set_int("y", 4) == STATUS_OK);
+        UTEST_ASSERT(!e.dirty());
+        UTEST_ASSERT(p.set_int("x", 4) == STATUS_OK);
+        UTEST_ASSERT(e.dirty());
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 40);
+
+        // Structural changes invalidate everything
+        UTEST_ASSERT(p.remove_value("y", VT_INT) == STATUS_OK);
+        UTEST_ASSERT(e.dirty());
+
+        destroy_value(&value);
+    }
+
+    void test_lifetime()
+    {
+        Context ctx;
+        Expression *e = new Expression();
+        Variables *v = new Variables();
+        UTEST_ASSERT((e != NULL) && (v != NULL));
+
+        printf("Testing lifetime of tracked objects\n");
+
+        UTEST_ASSERT(e->parse(":a", NULL, Expression::FLAG_NONE) == STATUS_OK);
+        UTEST_ASSERT(ctx.attach(v) == STATUS_OK);
+        UTEST_ASSERT(ctx.add(e) == STATUS_OK);
+        UTEST_ASSERT(ctx.size() == 1);
+
+        // Destroyed objects should be forgotten by the context
+        delete e;
+        UTEST_ASSERT(ctx.size() == 0);
+        delete v;
+        UTEST_ASSERT(ctx.detach(v) == STATUS_NOT_FOUND);
+    }
+
+    UTEST_MAIN
+    {
+        test_variables();
+        test_indexed();
+        test_parameters();
+        test_lifetime();
+    }
+
+UTEST_END;
@@ -233,6 +233,18 @@ UTEST_BEGIN("runtime.expr", expression)
             test_int(":x < 20 ? :x < 10 ? 0 : 1 : :x < 30 ? 2 : 3", &v, j);
         }
 
+        // Constant sub-expressions and dead branches
+        test_float(":fa * 2 + (1 / 4.0)", &v, 2.25);
+        test_float("(12 db) * :fa", &v, GAIN_AMP_P_12_DB);
+        test_int("(1 < 2) ? :ia : :zz", &v, 1);
+        test_int("(1 > 2) ? :zz : +(:ib + 1 * 2)", &v, 5);
+        test_int("('abc' ? 1 : 2) <=> :ia", &v, -1);
+        test_bool("true || :zz", &v, true);
+        test_bool("false || :ia", &v, true);
+        test_bool("false && :ia", &v, false);
+        test_bool("true && :bb", &v, false);
+        test_string("'a' sc 'b' sr 2 sc :ia", &v, "abb1");
+
         test_int("slen 'abcdef'", &v, 6);
         test_string("'ABC'", &v, "ABC");
         test_string("'1' sc 20+:ib sc :ic*9", &v, "12345");
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/expr/format.h>
+#include <lsp-plug.in/expr/FormatTemplate.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+namespace lsp
+{
+    using namespace lsp::expr;
+}
+
+#define OK(arg)     UTEST_ASSERT((arg) == STATUS_OK)
+
+namespace
+{
+    static const char *formats[] =
+    {
+        "",
+        "123",
+        "{}",
+        "{} {} {}",
+        "{@bool} {@int} {@float} {@strA} {@strB} {@null} {@undef} {@nan} {@pinf} {@ninf}",
+        "{[0]} {[1]} {[2]} {[3]} {[4]} {[5]} {[6]} {[7]} {[8]} {[9]}",
+        "\\{[0]} {} {[1]} {} {[2]}",
+        "{\\} {@1} {[int]} {[]} {^} {$} {>>} {||} {@int$} {^0$1[a]} {%Z} {[",
+        "{@a@b} {[1][2]} {^0^9} {$0$9} {>|>|} {%d%d} {%.f}",
+        "{@int%d} {@neg%d} {@int%+d} {@neg%+d} {@int%b} {@int%o} {@hex%x} {@hex%X} {@hex%+X} {@neg%x}",
+        "{@int%8d} {@neg%8d} {@int%+8d} {@neg%+8d} {@int%20b} {@int%8o} {@hex%8x} {@hex%8X} {@hex%+8X} {@neg%8x}",
+        "{@null%d} {@undef%d} {@null%b} {@undef%b} {@null%o} {@undef%o} {@null%x} {@undef%x}",
+        "{@float%f} {@float%.2f} {@float%.0f} {@float%+.2f} {@nan%f} {@pinf%f} {@ninf%f} {@pinf%+f} {@null%f} {@undef%f}",
+        "{@float%16f} {@float%8.2f} {@float%8.0f} {@float%+8.2f} {@neg_float%8.2f}",
+        "{@float%F} {@float%.2F} {@float%.0F} {@float%+.2F} {@nan%F} {@pinf%F} {@ninf%F} {@pinf%+F} {@null%F} {@undef%F}",
+        "{@bool%l} {@bool%L} {@bool%Ll} {@bool%lL} {@null%l} {@undef%l}",
+        "{@strA%s} {@strA%t} {@strA%T} {@strA%Tt} {@strA%tT} {@null%s} {@null%t} {@undef%s} {@undef%t}",
+        "{@strB%s} {@strB%t} {@strB%T} {@strB%Tt} {@strB%tT}",
+        "{@strC%s} {@strC%t} {@strC%T} {@strC%Tt} {@strC%tT}",
+        "{>@strA^0%10s$1} {@strA^0%10s$1<} {|@strA^0%10s$1} {|>@strA^0%10s$1} {<|@strA^0%10s$1} {>|@strA^0%10s$1} {|<@strA^0%10s$1}",
+        "{>@strB^0%10s$1} {@strB^0%10s$1<} {|@strB^0%10s$1} {|>@strB^0%10s$1} {<|@strB^0%10s$1} {>|@strB^0%10s$1} {|<@strB^0%10s$1}",
+        "{>@strC^0%10s$1} {@strC^0%10s$1<} {|@strC^0%10s$1} {|>@strC^0%10s$1} {<|@strC^0%10s$1} {>|@strC^0%10s$1} {|<@strC^0%10s$1}",
+        "{>@null^0%10s$1} {@null^0%10s$1<} {|@null^0%10s$1} {|>@null^0%10s$1} {<|@null^0%10s$1} {>|@null^0%10s$1} {|<@null^0%10s$1}",
+        "{>@null%10s} {@null%10s<} {|@null%10s} {|>@null%10s} {<|@null%10s} {>|@null%10s} {|<@null%10s}",
+        "{>@hex^_%8x:16$_} {@hex^_%8x:16$_<} {|@hex^_%8x:16$_} {|>@hex^_%8x:16$_} {<|@hex^_%8x:16$_} {>|@hex^_%7x:16$_} {|<@hex^_%7x:16$_}",
+        "\\\\ \\x \\} {}{}{[0]} trailing \\",
+        NULL
+    };
+}
+
+UTEST_BEGIN("runtime.expr", format_template)
+
+    void test_match(Parameters *p)
+    {
+        LSPString tout, fout;
+        FormatTemplate tpl;
+
+        for (const char * const *fmt = formats; *fmt != NULL; ++fmt)
+        {
+            printf("  template: %s\n", *fmt);
+            OK(tpl.parse(*fmt));
+            OK(format(&fout, *fmt, p));
+
+            // Format twice to ensure that the template is reusable
+            for (size_t i=0; i<2; ++i)
+            {
+                OK(tpl.format(&tout, p));
+                if (!tout.equals(&fout))
+                    UTEST_FAIL_MSG("Template output '%s' does not match format() output '%s'",
+                        tout.get_utf8(), fout.get_utf8());
+            }
+        }
+    }
+
+    void test_bound(Parameters *p)
+    {
+        FormatTemplate tpl;
+        LSPString out;
+
+        OK(tpl.parse("Level: {@level%.1f} dB {@name%T}"));
+        UTEST_ASSERT(tpl.segments() == 4);
+
+        OK(p->set_float("level", -6.0));
+        OK(tpl.format(&out, p));
+        UTEST_ASSERT(out.equals_ascii("Level: -6.0 dB METER"));
+
+        OK(p->set_float("level", 12.25));
+        OK(p->set_cstring("name", "gain"));
+        OK(tpl.format(&out, p));
+        UTEST_ASSERT(out.equals_ascii("Level: 12.2 dB GAIN"));
+
+        // Append mode keeps the previous contents
+        OK(tpl.append(&out, p));
+        UTEST_ASSERT(out.equals_ascii("Level: 12.2 dB GAINLevel: 12.2 dB GAIN"));
+
+        // Missing parameter keeps output untouched
+        out.set_ascii("keep");
+        OK(tpl.parse("{@missing}"));
+        UTEST_ASSERT(tpl.append(&out, p) != STATUS_OK);
+        UTEST_ASSERT(out.equals_ascii("keep"));
+
+        // Re-parse and clear
+        OK(tpl.parse("plain text"));
+        UTEST_ASSERT(tpl.segments() == 1);
+        tpl.clear();
+        UTEST_ASSERT(tpl.segments() == 0);
+        OK(tpl.format(&out, p));
+        UTEST_ASSERT(out.is_empty());
+    }
+
+    UTEST_MAIN
+    {
+        Parameters p;
+        OK(p.add_int("int", 100500));
+        OK(p.add_float("float", 440.0));
+        OK(p.add_bool("bool", true));
+        OK(p.add_cstring("strA", "string"));
+        OK(p.add_cstring("strB", "CaMeL"));
+        OK(p.add_float("nan", NAN));
+        OK(p.add_float("pinf", +INFINITY));
+        OK(p.add_float("ninf", -INFINITY));
+        OK(p.add_null("null"));
+        OK(p.add_undef("undef"));
+        OK(p.add_int("neg", -1234));
+        OK(p.add_int("hex", 0xc0de));
+        OK(p.add_cstring("strC", ""));
+        OK(p.add_float("neg_float", -123.45));
+
+        printf("\nTesting match with format()...\n");
+        test_match(&p);
+
+        OK(p.add_float("level", 0.0));
+        OK(p.add_cstring("name", "meter"));
+
+        printf("\nTesting bound parameters...\n");
+        test_bound(&p);
+    }
+
+UTEST_END;
@@ -1368,6 +1368,107 @@ UTEST_BEGIN("runtime.expr", parameters)
         delete tmp;
     }
 
+    void check_name_index(Parameters *p, size_t names)
+    {
+        char name[32];
+        LSPString key, pname;
+
+        for (size_t i=0; i<names; ++i)
+        {
+            snprintf(name, sizeof(name), "p%d", int(i));
+            key.set_ascii(name);
+
+            // Compute the expected index with linear search
+            ssize_t expected = -STATUS_NOT_FOUND;
+            for (size_t j=0, n=p->size(); j<n; ++j)
+            {
+                if ((p->get_name(j, &pname) == STATUS_OK) && (pname.equals(&key)))
+                {
+                    expected = j;
+                    break;
+                }
+            }
+
+            ssize_t index = p->get_index(&key);
+            if (index != expected)
+                UTEST_FAIL_MSG("Index of parameter '%s' is %d, expected %d", name, int(index), int(expected));
+        }
+    }
+
+    void test_name_index()
+    {
+        Parameters p, x;
+        char name[32];
+
+        // Random sequence of modifications with duplicate names
+        srand(0x1234);
+        for (size_t i=0; i<2000; ++i)
+        {
+            snprintf(name, sizeof(name), "p%d", rand() % 10);
+            size_t index = (p.size() > 0) ? rand() % p.size() : 0;
+
+            switch (rand() % 8)
+            {
+                case 0: OK(p.add_int(name, i)); break;
+                case 1: OK(p.add_int(i)); break;
+                case 2: OK(p.insert_int(index, name, i)); break;
+                case 3: OK(p.set_int(name, i)); break;
+                case 4:
+                    if (p.size() > 0)
+                        OK(p.remove(index, static_cast<value_t *>(NULL)));
+                    break;
+                case 5:
+                {
+                    status_t res = p.remove(name, NULL);
+                    UTEST_ASSERT((res == STATUS_OK) || (res == STATUS_NOT_FOUND));
+                    break;
+                }
+                case 6:
+                {
+                    ssize_t value;
+                    status_t res = p.remove_int(name, &value);
+                    UTEST_ASSERT((res == STATUS_OK) || (res == STATUS_NOT_FOUND));
+                    break;
+                }
+                default:
+                    if (p.size() > 20)
+                        OK(p.remove(ssize_t(index), ssize_t(lsp_min(index + 5, p.size()))));
+                    break;
+            }
+
+            check_name_index(&p, 10);
+        }
+
+        // Bulk operations
+        OK(x.add_int("p1", 1));
+        OK(x.add_int("p2", 2));
+        OK(x.insert(0, &p, 0, p.size()));
+        check_name_index(&x, 10);
+        x.swap(&p);
+        check_name_index(&x, 10);
+        check_name_index(&p, 10);
+        OK(x.set(&p));
+        check_name_index(&x, 10);
+        OK(x.add(&p, 0, p.size()));
+        check_name_index(&x, 10);
+        x.clear();
+        check_name_index(&x, 10);
+
+        // Many distinct names
+        for (size_t i=0; i<500; ++i)
+        {
+            snprintf(name, sizeof(name), "p%d", int(i));
+            OK(x.add_int(name, i));
+        }
+        check_name_index(&x, 500);
+        for (size_t i=0; i<500; i += 2)
+        {
+            snprintf(name, sizeof(name), "p%d", int(i));
+            OK(x.remove(name, NULL));
+        }
+        check_name_index(&x, 500);
+    }
+
     UTEST_MAIN
     {
         printf("Testing add functions...\n");
@@ -1390,6 +1491,9 @@ UTEST_BEGIN("runtime.expr", parameters)
 
         printf("Testing functions for manipulating set of parameters...\n");
         test_set_operations();
+
+        printf("Testing name index...\n");
+        test_name_index();
     }
 
 UTEST_END
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/expr/Expression.h>
+#include <lsp-plug.in/expr/Variables.h>
+
+namespace lsp
+{
+    using namespace lsp::expr;
+
+    namespace
+    {
+        // Resolver that looks up other indexed variable in the same Variables object
+        class ReentrantResolver: public Resolver
+        {
+            public:
+                Variables      *pVars;
+
+            public:
+                explicit ReentrantResolver()    { pVars = NULL; }
+
+                virtual status_t resolve(value_t *value, const LSPString *name, size_t num_indexes, const ssize_t *indexes)
+                {
+                    if ((num_indexes != 1) || (!name->equals_ascii("arr")))
+                    {
+                        set_value_int(value, 1000);
+                        return STATUS_OK;
+                    }
+
+                    // Resolve the element of other array through the caller
+                    ssize_t index   = indexes[0] + 100;
+                    status_t res    = pVars->resolve(value, "other", 1, &index);
+                    if (res != STATUS_OK)
+                        return res;
+                    set_value_int(value, value->v_int + indexes[0]);
+                    return STATUS_OK;
+                }
+        };
+    }
+}
+
+UTEST_BEGIN("runtime.expr", variables)
+
+    void test_lookup()
+    {
+        Variables v;
+        LSPString name;
+        value_t value;
+        init_value(&value);
+
+        printf("Testing lookup of variables\n");
+
+        // Fill many variables to force rehashing of the index
+        for (size_t i=0; i<1000; ++i)
+        {
+            UTEST_ASSERT(name.fmt_ascii("var_%d", int(i)) > 0);
+            UTEST_ASSERT(v.set_int(&name, i * 3) == STATUS_OK);
+        }
+        UTEST_ASSERT(v.size() == 1000);
+
+        for (size_t i=0; i<1000; ++i)
+        {
+            UTEST_ASSERT(name.fmt_ascii("var_%d", int(i)) > 0);
+            UTEST_ASSERT(v.resolve(&value, &name) == STATUS_OK);
+            UTEST_ASSERT(value.type == VT_INT);
+            UTEST_ASSERT(value.v_int == ssize_t(i * 3));
+        }
+
+        // Indexed variable
+        ssize_t idx[2] = { 1, 2 };
+        UTEST_ASSERT(v.set_int("var_1_2", 12) == STATUS_OK);
+        UTEST_ASSERT(v.resolve(&value, "var", 2, idx) == STATUS_OK);
+        UTEST_ASSERT(value.type == VT_INT);
+        UTEST_ASSERT(value.v_int == 12);
+
+        // Unset every even variable
+        for (size_t i=0; i<1000; i += 2)
+        {
+            UTEST_ASSERT(name.fmt_ascii("var_%d", int(i)) > 0);
+            UTEST_ASSERT(v.unset(&name) == STATUS_OK);
+        }
+        UTEST_ASSERT(v.size() == 501);
+
+        for (size_t i=0; i<1000; ++i)
+        {
+            UTEST_ASSERT(name.fmt_ascii("var_%d", int(i)) > 0);
+            status_t res = v.resolve(&value, &name);
+            if (i & 1)
+            {
+                UTEST_ASSERT(res == STATUS_OK);
+                UTEST_ASSERT(value.v_int == ssize_t(i * 3));
+            }
+            else
+                UTEST_ASSERT(res == STATUS_NOT_FOUND);
+        }
+
+        v.clear();
+        UTEST_ASSERT(v.size() == 0);
+        UTEST_ASSERT(v.resolve(&value, "var_1") == STATUS_NOT_FOUND);
+
+        destroy_value(&value);
+    }
+
+    void test_binding()
+    {
+        Variables v, parent;
+        LSPString name;
+        value_t value;
+        init_value(&value);
+
+        printf("Testing binding of variables\n");
+
+        UTEST_ASSERT(name.set_ascii("a"));
+        UTEST_ASSERT(v.set_int("a", 1) == STATUS_OK);
+        ssize_t sa = v.bind(&name);
+        UTEST_ASSERT(sa >= 0);
+        UTEST_ASSERT(v.bind(&name) == sa);
+
+        // Binding of non-existing variable
+        UTEST_ASSERT(name.set_ascii("b"));
+        ssize_t sb = v.bind(&name);
+        UTEST_ASSERT(sb >= 0);
+        UTEST_ASSERT(sb != sa);
+        UTEST_ASSERT(v.size() == 1);
+        UTEST_ASSERT(v.resolve_bound(&value, sb) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(v.resolve_bound(&value, sb + 1) == STATUS_BAD_ARGUMENTS);
+
+        // Define the variable
+        UTEST_ASSERT(v.set_float("b", 2.5f) == STATUS_OK);
+        UTEST_ASSERT(v.resolve_bound(&value, sb) == STATUS_OK);
+        UTEST_ASSERT(value.type == VT_FLOAT);
+        UTEST_ASSERT(value.v_float == 2.5);
+
+        // Unset and clear should keep bindings valid
+        UTEST_ASSERT(v.unset("a") == STATUS_OK);
+        UTEST_ASSERT(v.resolve_bound(&value, sa) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(v.set_int("a", 3) == STATUS_OK);
+        UTEST_ASSERT(v.resolve_bound(&value, sa) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 3);
+
+        v.clear();
+        UTEST_ASSERT(v.resolve_bound(&value, sa) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(v.resolve_bound(&value, sb) == STATUS_NOT_FOUND);
+
+        // Undefined bound variable should be resolved by the underlying resolver
+        UTEST_ASSERT(parent.set_int("a", 4) == STATUS_OK);
+        v.set_resolver(&parent);
+        UTEST_ASSERT(v.resolve_bound(&value, sa) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 4);
+
+        destroy_value(&value);
+    }
+
+    void test_expression()
+    {
+        Variables v, w;
+        Expression e(&v);
+        value_t value;
+        init_value(&value);
+
+        printf("Testing bound expression\n");
+
+        UTEST_ASSERT(e.parse(":a + :b * 2", NULL, Expression::FLAG_NONE) == STATUS_OK);
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.type == VT_UNDEF);
+
+        UTEST_ASSERT(v.set_int("a", 1) == STATUS_OK);
+        UTEST_ASSERT(v.set_int("b", 2) == STATUS_OK);
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.type == VT_INT);
+        UTEST_ASSERT(value.v_int == 5);
+
+        UTEST_ASSERT(v.set_int("b", 10) == STATUS_OK);
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 21);
+
+        // Change the resolver
+        UTEST_ASSERT(w.set_int("a", 100) == STATUS_OK);
+        UTEST_ASSERT(w.set_int("b", 200) == STATUS_OK);
+        e.set_resolver(&w);
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 500);
+
+        e.set_resolver(NULL);
+        UTEST_ASSERT(e.evaluate(&value) == STATUS_OK);
+        UTEST_ASSERT(value.type == VT_UNDEF);
+
+        destroy_value(&value);
+    }
+
+    void test_reentrant()
+    {
+        ReentrantResolver r;
+        Variables v(&r);
+        value_t value;
+        init_value(&value);
+        ssize_t index = 5;
+        r.pVars     = &v;
+
+        printf("Testing re-entrant resolver\n");
+
+        UTEST_ASSERT(v.resolve(&value, "arr", 1, &index) == STATUS_OK);
+        UTEST_ASSERT((value.type == VT_INT) && (value.v_int == 1005));
+
+        // Both values should be cached under their own names
+        v.set_resolver(NULL);
+        UTEST_ASSERT(v.resolve(&value, "arr", 1, &index) == STATUS_OK);
+        UTEST_ASSERT((value.type == VT_INT) && (value.v_int == 1005));
+        UTEST_ASSERT(v.resolve(&value, "arr_5") == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 1005);
+        UTEST_ASSERT(v.resolve(&value, "other_105") == STATUS_OK);
+        UTEST_ASSERT(value.v_int == 1000);
+
+        destroy_value(&value);
+    }
+
+    UTEST_MAIN
+    {
+        test_lookup();
+        test_binding();
+        test_expression();
+        test_reentrant();
+    }
+
+UTEST_END;
@@ -252,6 +252,32 @@ UTEST_BEGIN("runtime.fmt.json", tokenizer)
         ck_invalid("/* test comment", JT_ERROR);
     }
 
+    void test_take_value()
+    {
+        static const char *tokens = "\"first string value\" 'second' \"third\"";
+
+        io::InStringSequence sq;
+        UTEST_ASSERT(sq.wrap(tokens, "UTF-8") == STATUS_OK);
+        Tokenizer t(&sq);
+        LSPString value;
+
+        UTEST_ASSERT(t.get_token(true) == JT_DQ_STRING);
+        t.take_text_value(&value);
+        UTEST_ASSERT(value.equals_ascii("first string value"));
+        UTEST_ASSERT(t.text_value()->is_empty());
+
+        UTEST_ASSERT(t.get_token(true) == JT_SQ_STRING);
+        UTEST_ASSERT(t.text_value()->equals_ascii("second"));
+        t.take_text_value(&value);
+        UTEST_ASSERT(value.equals_ascii("second"));
+        UTEST_ASSERT(t.text_value()->is_empty());
+
+        UTEST_ASSERT(t.get_token(true) == JT_DQ_STRING);
+        UTEST_ASSERT(t.text_value()->equals_ascii("third"));
+
+        UTEST_ASSERT(t.get_token(true) == JT_EOF);
+    }
+
     UTEST_MAIN
     {
         printf("Testing basic tokens...\n");
@@ -266,6 +292,8 @@ UTEST_BEGIN("runtime.fmt.json", tokenizer)
         test_unicode_comments();
         printf("Testing invalid tokens...\n");
         test_invalid_tokens();
+        printf("Testing moving of token values...\n");
+        test_take_value();
     }
 
 UTEST_END
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/io/InBufferedStream.h>
+#include <lsp-plug.in/io/OutBufferedStream.h>
+
+#define DATA_SIZE       0x4000
+#define BLOCK_SIZE      0x100
+
+using namespace lsp;
+using namespace lsp::io;
+
+namespace
+{
+    class CountingInStream: public InMemoryStream
+    {
+        public:
+            size_t  nCalls;
+
+        public:
+            explicit CountingInStream(const void *data, size_t size): InMemoryStream(data, size)
+            {
+                nCalls      = 0;
+            }
+
+        public:
+            virtual ssize_t read(void *dst, size_t count)
+            {
+                ++nCalls;
+                return InMemoryStream::read(dst, count);
+            }
+    };
+
+    class CountingOutStream: public OutMemoryStream
+    {
+        public:
+            size_t  nCalls;
+            bool    bFail;
+
+        public:
+            explicit CountingOutStream()
+            {
+                nCalls      = 0;
+                bFail       = false;
+            }
+
+        public:
+            virtual ssize_t write(const void *buf, size_t count)
+            {
+                ++nCalls;
+                if (bFail)
+                    return -STATUS_IO_ERROR;
+                return OutMemoryStream::write(buf, count);
+            }
+
+            virtual ssize_t writeb(int v)
+            {
+                ++nCalls;
+                return OutMemoryStream::writeb(v);
+            }
+    };
+}
+
+UTEST_BEGIN("runtime.io", bufferedstream)
+
+    void init_data(uint8_t *data, size_t size)
+    {
+        for (size_t i=0; i<size; ++i)
+            data[i]     = uint8_t(i * 7 + (i >> 8));
+    }
+
+    void testRead(const uint8_t *data)
+    {
+        uint8_t buf[BLOCK_SIZE * 2];
+        CountingInStream cis(data, DATA_SIZE);
+        InBufferedStream is(BLOCK_SIZE);
+
+        UTEST_ASSERT(is.buffer_size() == BLOCK_SIZE);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+        UTEST_ASSERT(is.wrap(&cis) == STATUS_OK);
+        UTEST_ASSERT(is.wrap(&cis) == STATUS_BAD_STATE);
+
+        // Small reads should be served from the buffer
+        size_t offset = 0;
+        for (size_t i=0; i<BLOCK_SIZE; ++i)
+        {
+            ssize_t b = is.read_byte();
+            UTEST_ASSERT(b == data[offset]);
+            ++offset;
+        }
+        UTEST_ASSERT(cis.nCalls == 1);
+        UTEST_ASSERT(is.position() == wssize_t(offset));
+
+        for (size_t i=0; i<BLOCK_SIZE / 4; ++i)
+        {
+            UTEST_ASSERT(is.read(buf, 4) == 4);
+            UTEST_ASSERT(::memcmp(buf, &data[offset], 4) == 0);
+            offset     += 4;
+        }
+        UTEST_ASSERT(cis.nCalls == 2);
+        UTEST_ASSERT(is.buffered() == 0);
+
+        // Large read should bypass the buffer
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == ssize_t(sizeof(buf)));
+        UTEST_ASSERT(::memcmp(buf, &data[offset], sizeof(buf)) == 0);
+        UTEST_ASSERT(cis.nCalls == 3);
+        UTEST_ASSERT(is.buffered() == 0);
+        offset     += sizeof(buf);
+
+        // Read crossing the buffer boundary
+        UTEST_ASSERT(is.read(buf, 10) == 10);
+        UTEST_ASSERT(::memcmp(buf, &data[offset], 10) == 0);
+        offset     += 10;
+        UTEST_ASSERT(is.read(buf, BLOCK_SIZE - 1) == BLOCK_SIZE - 1);
+        UTEST_ASSERT(::memcmp(buf, &data[offset], BLOCK_SIZE - 1) == 0);
+        offset     += BLOCK_SIZE - 1;
+        UTEST_ASSERT(is.position() == wssize_t(offset));
+        UTEST_ASSERT(is.avail() == wssize_t(DATA_SIZE - offset));
+
+        // Read until the end of stream
+        while (true)
+        {
+            ssize_t n = is.read(buf, 33);
+            if (n < 0)
+            {
+                UTEST_ASSERT(n == -STATUS_EOF);
+                break;
+            }
+            UTEST_ASSERT(::memcmp(buf, &data[offset], n) == 0);
+            offset     += n;
+        }
+        UTEST_ASSERT(offset == DATA_SIZE);
+        UTEST_ASSERT(is.read_byte() == -STATUS_EOF);
+
+        UTEST_ASSERT(is.close() == STATUS_OK);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+    }
+
+    void testPeekUnread(const uint8_t *data)
+    {
+        uint8_t buf[BLOCK_SIZE * 2];
+        CountingInStream cis(data, DATA_SIZE);
+        InBufferedStream is(BLOCK_SIZE);
+        UTEST_ASSERT(is.wrap(&cis) == STATUS_OK);
+
+        // Peek should not advance the position
+        UTEST_ASSERT(is.peek(buf, 8) == 8);
+        UTEST_ASSERT(::memcmp(buf, data, 8) == 0);
+        UTEST_ASSERT(is.position() == 0);
+        UTEST_ASSERT(is.read(buf, 8) == 8);
+        UTEST_ASSERT(::memcmp(buf, data, 8) == 0);
+
+        // Unread the data
+        UTEST_ASSERT(is.unread(3) == STATUS_OK);
+        UTEST_ASSERT(is.position() == 5);
+        UTEST_ASSERT(is.read_byte() == data[5]);
+        UTEST_ASSERT(is.unread(100) == STATUS_OVERFLOW);
+
+        // Peek crossing the buffer boundary should compact the buffer
+        UTEST_ASSERT(is.skip(BLOCK_SIZE - 16) == BLOCK_SIZE - 16);
+        UTEST_ASSERT(is.position() == BLOCK_SIZE - 10);
+        UTEST_ASSERT(is.peek(buf, 32) == 32);
+        UTEST_ASSERT(::memcmp(buf, &data[BLOCK_SIZE - 10], 32) == 0);
+        UTEST_ASSERT(is.position() == BLOCK_SIZE - 10);
+
+        // Peek is limited with the size of the buffer
+        UTEST_ASSERT(is.peek(buf, sizeof(buf)) == BLOCK_SIZE);
+        UTEST_ASSERT(::memcmp(buf, &data[BLOCK_SIZE - 10], BLOCK_SIZE) == 0);
+
+        // Peek at the end of file
+        UTEST_ASSERT(is.seek(DATA_SIZE - 4) == DATA_SIZE - 4);
+        UTEST_ASSERT(is.peek(buf, 16) == 4);
+        UTEST_ASSERT(::memcmp(buf, &data[DATA_SIZE - 4], 4) == 0);
+        UTEST_ASSERT(is.skip(16) == 4);
+        UTEST_ASSERT(is.peek(buf, 16) == -STATUS_EOF);
+    }
+
+    void testSeekSkip(const uint8_t *data)
+    {
+        uint8_t buf[0x10];
+        CountingInStream cis(data, DATA_SIZE);
+        InBufferedStream is(BLOCK_SIZE);
+        UTEST_ASSERT(is.wrap(&cis) == STATUS_OK);
+
+        UTEST_ASSERT(is.read(buf, 4) == 4);
+        UTEST_ASSERT(cis.nCalls == 1);
+
+        // Seek and skip within the buffer should not access the stream
+        UTEST_ASSERT(is.seek(100) == 100);
+        UTEST_ASSERT(is.read_byte() == data[100]);
+        UTEST_ASSERT(is.seek(2) == 2);
+        UTEST_ASSERT(is.read_byte() == data[2]);
+        UTEST_ASSERT(is.skip(50) == 50);
+        UTEST_ASSERT(is.read_byte() == data[53]);
+        UTEST_ASSERT(cis.nCalls == 1);
+
+        // Seek and skip outside of the buffer
+        UTEST_ASSERT(is.seek(1000) == 1000);
+        UTEST_ASSERT(is.read_byte() == data[1000]);
+        UTEST_ASSERT(is.skip(2000) == 2000);
+        UTEST_ASSERT(is.position() == 3001);
+        UTEST_ASSERT(is.read_byte() == data[3001]);
+        UTEST_ASSERT(is.skip(DATA_SIZE) == DATA_SIZE - 3002);
+        UTEST_ASSERT(is.read_byte() == -STATUS_EOF);
+    }
+
+    void testWrite(const uint8_t *data)
+    {
+        CountingOutStream cos;
+        OutBufferedStream os(BLOCK_SIZE);
+
+        UTEST_ASSERT(os.buffer_size() == BLOCK_SIZE);
+        UTEST_ASSERT(os.writeb(0) == -STATUS_CLOSED);
+        UTEST_ASSERT(os.wrap(&cos) == STATUS_OK);
+        UTEST_ASSERT(os.wrap(&cos) == STATUS_BAD_STATE);
+
+        // Small writes should be collected in the buffer
+        size_t offset = 0;
+        for (size_t i=0; i<BLOCK_SIZE; ++i, ++offset)
+            UTEST_ASSERT(os.writeb(data[offset]) == 1);
+        UTEST_ASSERT(cos.nCalls == 0);
+        UTEST_ASSERT(os.buffered() == BLOCK_SIZE);
+
+        for (size_t i=0; i<BLOCK_SIZE/4; ++i, offset += 4)
+            UTEST_ASSERT(os.write(&data[offset], 4) == 4);
+        UTEST_ASSERT(cos.nCalls == 2);
+        UTEST_ASSERT(os.buffered() == 0);
+
+        // Large write should bypass the buffer
+        UTEST_ASSERT(os.flush() == STATUS_OK);
+        UTEST_ASSERT(cos.nCalls == 2);
+        UTEST_ASSERT(os.write(&data[offset], BLOCK_SIZE * 3) == BLOCK_SIZE * 3);
+        UTEST_ASSERT(cos.nCalls == 3);
+        offset     += BLOCK_SIZE * 3;
+
+        // Mixed writes
+        while (offset < DATA_SIZE)
+        {
+            size_t n = lsp_min(size_t(DATA_SIZE - offset), size_t(offset % 37 + 1));
+            UTEST_ASSERT(os.write(&data[offset], n) == ssize_t(n));
+            offset     += n;
+        }
+
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(os.writeb(0) == -STATUS_CLOSED);
+        UTEST_ASSERT(cos.size() == DATA_SIZE);
+        UTEST_ASSERT(::memcmp(cos.data(), data, DATA_SIZE) == 0);
+    }
+
+    void testWriteFailure(const uint8_t *data)
+    {
+        CountingOutStream cos;
+        OutBufferedStream os(BLOCK_SIZE);
+        UTEST_ASSERT(os.wrap(&cos) == STATUS_OK);
+
+        // Failed flush should report only the data accepted by the buffer
+        UTEST_ASSERT(os.write(data, BLOCK_SIZE / 2) == BLOCK_SIZE / 2);
+        cos.bFail   = true;
+        UTEST_ASSERT(os.write(&data[BLOCK_SIZE / 2], BLOCK_SIZE) == BLOCK_SIZE / 2);
+        UTEST_ASSERT(os.buffered() == BLOCK_SIZE);
+
+        // Nothing can be accepted while the buffer is full
+        UTEST_ASSERT(os.write(&data[BLOCK_SIZE], 16) == -STATUS_IO_ERROR);
+        UTEST_ASSERT(os.writeb(data[BLOCK_SIZE]) == -STATUS_IO_ERROR);
+        UTEST_ASSERT(os.buffered() == BLOCK_SIZE);
+
+        // Accepted data should be written exactly once
+        cos.bFail   = false;
+        UTEST_ASSERT(os.write(&data[BLOCK_SIZE], 16) == 16);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(cos.size() == BLOCK_SIZE + 16);
+        UTEST_ASSERT(::memcmp(cos.data(), data, BLOCK_SIZE + 16) == 0);
+    }
+
+    void testFile(const uint8_t *data)
+    {
+        uint8_t buf[0x100];
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s" FILE_SEPARATOR_S "utest-%s.tmp", tempdir(), full_name()));
+
+        OutBufferedStream os;
+        UTEST_ASSERT(os.open(&path, File::FM_WRITE_NEW) == STATUS_OK);
+        for (size_t i=0; i<DATA_SIZE; ++i)
+            UTEST_ASSERT(os.writeb(data[i]) == 1);
+        UTEST_ASSERT(os.position() == DATA_SIZE);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+
+        InBufferedStream is;
+        UTEST_ASSERT(is.open(&path) == STATUS_OK);
+        UTEST_ASSERT(is.avail() == DATA_SIZE);
+        size_t offset = 0;
+        while (true)
+        {
+            ssize_t n = is.read(buf, 29);
+            if (n < 0)
+            {
+                UTEST_ASSERT(n == -STATUS_EOF);
+                break;
+            }
+            UTEST_ASSERT(::memcmp(buf, &data[offset], n) == 0);
+            offset     += n;
+        }
+        UTEST_ASSERT(offset == DATA_SIZE);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+
+        UTEST_ASSERT(File::remove(&path) == STATUS_OK);
+    }
+
+    UTEST_MAIN
+    {
+        uint8_t *data = reinterpret_cast<uint8_t *>(::malloc(DATA_SIZE));
+        UTEST_ASSERT(data != NULL);
+        init_data(data, DATA_SIZE);
+
+        printf("Testing buffered read...\n");
+        testRead(data);
+        printf("Testing peek and unread...\n");
+        testPeekUnread(data);
+        printf("Testing seek and skip...\n");
+        testSeekSkip(data);
+        printf("Testing buffered write...\n");
+        testWrite(data);
+        printf("Testing write failures...\n");
+        testWriteFailure(data);
+        printf("Testing file access...\n");
+        testFile(data);
+
+        ::free(data);
+    }
+
+UTEST_END
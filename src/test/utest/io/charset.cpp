@@ -387,10 +387,50 @@ UTEST_BEGIN("runtime.io", charset)
         }
     }
 
+    void check_ascii_runs()
+    {
+        char src[128], dst[128];
+        lsp_utf32_t wc[128];
+
+        printf("Checking conversion of ASCII runs...\n");
+
+        // Stop positions at all offsets, both vector and scalar paths are involved
+        for (size_t len=0; len<=64; ++len)
+        {
+            for (size_t stop=0; stop<=len; ++stop)
+            {
+                for (size_t i=0; i<len; ++i)
+                    src[i]      = 'A' + (i % 26);
+                if (stop < len)
+                    src[stop]   = (stop & 1) ? char(0xd0) : '\0';
+
+                ::memset(wc, 0xff, sizeof(wc));
+                size_t n = ascii_to_utf32(wc, src, len);
+                UTEST_ASSERT_MSG(n == stop, "ascii_to_utf32: len=%d, stop=%d, result=%d", int(len), int(stop), int(n));
+                for (size_t i=0; i<n; ++i)
+                    UTEST_ASSERT(wc[i] == lsp_utf32_t(src[i]));
+                UTEST_ASSERT(wc[n] == lsp_utf32_t(-1));
+
+                for (size_t i=0; i<len; ++i)
+                    wc[i]       = 'a' + (i % 26);
+                if (stop < len)
+                    wc[stop]    = (stop & 1) ? 0x80 : 0x10000;
+
+                ::memset(dst, 0x55, sizeof(dst));
+                n = utf32_to_ascii(dst, wc, len);
+                UTEST_ASSERT_MSG(n == stop, "utf32_to_ascii: len=%d, stop=%d, result=%d", int(len), int(stop), int(n));
+                for (size_t i=0; i<n; ++i)
+                    UTEST_ASSERT(dst[i] == char(wc[i]));
+                UTEST_ASSERT(dst[n] == 0x55);
+            }
+        }
+    }
+
     UTEST_MAIN
     {
         check_utf8_to_utfX();
         check_utf16_to_utfX();
+        check_ascii_runs();
     }
 UTEST_END;
 
@@ -197,6 +197,238 @@ UTEST_BEGIN("runtime.io", encdec)
         compareFiles(&fsrc, &fdec);
     }
 
+    ssize_t decodeData(LSPString *dst, const char *charset, const void *data, size_t size, size_t chunk)
+    {
+        CharsetDecoder decoder;
+        const uint8_t *src = static_cast<const uint8_t *>(data);
+        ssize_t res;
+
+        dst->clear();
+        UTEST_ASSERT(decoder.init(charset) == STATUS_OK);
+
+        while (true)
+        {
+            // Feed the decoder with small chunks to test the incomplete sequences
+            if (size > 0)
+            {
+                res = decoder.fill(src, lsp_min(size, chunk));
+                UTEST_ASSERT(res >= 0);
+                src    += res;
+                size   -= res;
+            }
+
+            res = decoder.fetch(dst);
+            if ((res == 0) || (res == -STATUS_EOF))
+            {
+                if (size > 0)
+                    continue;
+                res = STATUS_OK;
+                break;
+            }
+            else if (res < 0)
+                break;
+        }
+
+        decoder.close();
+        return res;
+    }
+
+    void testDecodeNativeFile(const char *base, const char *src, const char *charset, const char *ref)
+    {
+        LSPString fsrc, fref, dsrc, dref;
+        NativeFile in;
+        uint8_t *buf = new uint8_t[0x40000];
+        UTEST_ASSERT(buf != NULL);
+
+        UTEST_ASSERT(fsrc.fmt_utf8("%s" FILE_SEPARATOR_S "%s" FILE_SEPARATOR_S "%s", resources(), base, src));
+        UTEST_ASSERT(fref.fmt_utf8("%s" FILE_SEPARATOR_S "%s" FILE_SEPARATOR_S "%s", resources(), base, ref));
+        printf("Testing built-in decoder on file %s (%s)...\n", fsrc.get_native(), charset);
+
+        // Read source file and decode it with different chunk sizes
+        UTEST_ASSERT(in.open(&fsrc, File::FM_READ) == STATUS_OK);
+        ssize_t nsrc = in.read(buf, 0x40000);
+        UTEST_ASSERT((nsrc > 0) && (nsrc < 0x40000));
+        UTEST_ASSERT(in.close() == STATUS_OK);
+
+        UTEST_ASSERT(decodeData(&dsrc, charset, buf, nsrc, nsrc) == STATUS_OK);
+        for (size_t chunk=1; chunk < 8; ++chunk)
+        {
+            UTEST_ASSERT(decodeData(&dref, charset, buf, nsrc, chunk) == STATUS_OK);
+            UTEST_ASSERT(dref.equals(&dsrc));
+        }
+
+        // Compare with the reference file decoded with system facilities
+        UTEST_ASSERT(in.open(&fref, File::FM_READ) == STATUS_OK);
+        ssize_t nref = in.read(buf, 0x40000);
+        UTEST_ASSERT((nref > 0) && (nref < 0x40000));
+        UTEST_ASSERT(in.close() == STATUS_OK);
+
+        UTEST_ASSERT(decodeData(&dref, "CP1251", buf, nref, nref) == STATUS_OK);
+        UTEST_ASSERT(dref.equals(&dsrc));
+
+        delete [] buf;
+    }
+
+    void testDecodeNative()
+    {
+        LSPString s;
+        uint8_t buf[0x100];
+
+        printf("Testing built-in decoders...\n");
+
+        UTEST_ASSERT(native_charset("UTF-8") == NCS_UTF8);
+        UTEST_ASSERT(native_charset("utf8") == NCS_UTF8);
+        UTEST_ASSERT(native_charset("UTF-16LE") == NCS_UTF16LE);
+        UTEST_ASSERT(native_charset("utf_16be") == NCS_UTF16BE);
+        UTEST_ASSERT(native_charset("US-ASCII") == NCS_ASCII);
+        UTEST_ASSERT(native_charset("ISO-8859-1") == NCS_LATIN1);
+        UTEST_ASSERT(native_charset("CP1251") == NCS_NONE);
+        UTEST_ASSERT(native_charset("UTF-8-but-too-long") == NCS_NONE);
+        UTEST_ASSERT(native_charset(NULL) == NCS_NONE);
+
+        // Latin-1 and ASCII
+        for (size_t i=0; i<0x100; ++i)
+            buf[i]  = uint8_t(i);
+        UTEST_ASSERT(decodeData(&s, "ISO-8859-1", buf, 0x100, 0x100) == STATUS_OK);
+        UTEST_ASSERT(s.length() == 0x100);
+        for (size_t i=0; i<0x100; ++i)
+            UTEST_ASSERT(s.char_at(i) == i);
+        UTEST_ASSERT(decodeData(&s, "ASCII", buf, 0x80, 0x80) == STATUS_OK);
+        UTEST_ASSERT(s.length() == 0x80);
+        UTEST_ASSERT(decodeData(&s, "ASCII", buf, 0x81, 0x81) == -STATUS_BAD_FORMAT);
+        UTEST_ASSERT(s.length() == 0x80);
+
+        // UTF-8 with zero characters, all sequence lengths and invalid sequences
+        static const char utf8[] = "a\0b\xc2\xa9\xe2\x82\xac\xf0\x9f\x98\x80z";
+        static const lsp_wchar_t utf32[] = { 'a', 0, 'b', 0xa9, 0x20ac, 0x1f600, 'z' };
+        for (size_t chunk=1; chunk < 4; ++chunk)
+        {
+            UTEST_ASSERT(decodeData(&s, "UTF-8", utf8, sizeof(utf8) - 1, chunk) == STATUS_OK);
+            UTEST_ASSERT(s.length() == 7);
+            UTEST_ASSERT(::memcmp(s.characters(), utf32, sizeof(utf32)) == 0);
+        }
+        UTEST_ASSERT(decodeData(&s, "UTF-8", "ab\xc0\xaf" "cd", 6, 6) == -STATUS_BAD_FORMAT);     // Overlong
+        UTEST_ASSERT(s.equals_ascii("ab"));
+        UTEST_ASSERT(decodeData(&s, "UTF-8", "ab\xed\xa0\x80", 5, 5) == -STATUS_BAD_FORMAT);  // Surrogate
+        UTEST_ASSERT(s.equals_ascii("ab"));
+        UTEST_ASSERT(decodeData(&s, "UTF-8", "ab\xe2\x28\xa1", 5, 5) == -STATUS_BAD_FORMAT);  // Bad continuation
+        UTEST_ASSERT(s.equals_ascii("ab"));
+
+        // UTF-16 with surrogate pairs and invalid sequences
+        static const char utf16le[] = "a\0\xa9\0\x3d\xd8\x00\xde";
+        static const char utf16be[] = "\0a\0\xa9\xd8\x3d\xde\x00";
+        for (size_t chunk=1; chunk < 4; ++chunk)
+        {
+            UTEST_ASSERT(decodeData(&s, "UTF-16LE", utf16le, sizeof(utf16le) - 1, chunk) == STATUS_OK);
+            UTEST_ASSERT((s.length() == 3) && (s.char_at(0) == 'a') && (s.char_at(1) == 0xa9) && (s.char_at(2) == 0x1f600));
+            UTEST_ASSERT(decodeData(&s, "UTF-16BE", utf16be, sizeof(utf16be) - 1, chunk) == STATUS_OK);
+            UTEST_ASSERT((s.length() == 3) && (s.char_at(0) == 'a') && (s.char_at(1) == 0xa9) && (s.char_at(2) == 0x1f600));
+        }
+        UTEST_ASSERT(decodeData(&s, "UTF-16LE", "a\0\x00\xde", 4, 4) == -STATUS_BAD_FORMAT);
+        UTEST_ASSERT(s.equals_ascii("a"));
+        UTEST_ASSERT(decodeData(&s, "UTF-16LE", "a\0\x3d\xd8" "b\0", 6, 6) == -STATUS_BAD_FORMAT);
+        UTEST_ASSERT(s.equals_ascii("a"));
+    }
+
+    ssize_t encodeData(uint8_t *dst, size_t *ndst, const char *charset, const lsp_wchar_t *data, size_t size)
+    {
+        CharsetEncoder encoder;
+        size_t cap = *ndst;
+        ssize_t res;
+
+        *ndst   = 0;
+        UTEST_ASSERT(encoder.init(charset) == STATUS_OK);
+
+        while (true)
+        {
+            if (size > 0)
+            {
+                res = encoder.fill(data, size);
+                UTEST_ASSERT(res >= 0);
+                data   += res;
+                size   -= res;
+            }
+
+            res = encoder.fetch(&dst[*ndst], cap - *ndst);
+            if ((res == 0) || (res == -STATUS_EOF))
+            {
+                if (size > 0)
+                    continue;
+                res = STATUS_OK;
+                break;
+            }
+            else if (res < 0)
+                break;
+            *ndst  += res;
+        }
+
+        encoder.close();
+        return res;
+    }
+
+    void testEncodeNative()
+    {
+        lsp_wchar_t buf[0x100];
+        uint8_t out[0x400];
+        size_t n;
+
+        printf("Testing built-in encoders...\n");
+
+        // Latin-1 and ASCII
+        for (size_t i=0; i<0x100; ++i)
+            buf[i]  = i;
+        n = sizeof(out);
+        UTEST_ASSERT(encodeData(out, &n, "ISO-8859-1", buf, 0x100) == STATUS_OK);
+        UTEST_ASSERT(n == 0x100);
+        for (size_t i=0; i<0x100; ++i)
+            UTEST_ASSERT(out[i] == i);
+        n = sizeof(out);
+        UTEST_ASSERT(encodeData(out, &n, "ASCII", buf, 0x80) == STATUS_OK);
+        UTEST_ASSERT(n == 0x80);
+        n = sizeof(out);
+        UTEST_ASSERT(encodeData(out, &n, "ASCII", buf, 0x81) == -STATUS_BAD_FORMAT);
+        UTEST_ASSERT(n == 0x80);
+        buf[0x10] = 0x100;
+        n = sizeof(out);
+        UTEST_ASSERT(encodeData(out, &n, "LATIN1", buf, 0x20) == -STATUS_BAD_FORMAT);
+        UTEST_ASSERT(n == 0x10);
+
+        // UTF-8 with zero characters and all sequence lengths
+        static const char utf8[] = "a\0b\xc2\xa9\xe2\x82\xac\xf0\x9f\x98\x80z";
+        static const lsp_wchar_t utf32[] = { 'a', 0, 'b', 0xa9, 0x20ac, 0x1f600, 'z' };
+        n = sizeof(out);
+        UTEST_ASSERT(encodeData(out, &n, "UTF-8", utf32, 7) == STATUS_OK);
+        UTEST_ASSERT(n == sizeof(utf8) - 1);
+        UTEST_ASSERT(::memcmp(out, utf8, n) == 0);
+
+        // UTF-16 with surrogate pairs
+        static const char utf16le[] = "a\0\xa9\0\x3d\xd8\x00\xde";
+        static const char utf16be[] = "\0a\0\xa9\xd8\x3d\xde\x00";
+        static const lsp_wchar_t utf16src[] = { 'a', 0xa9, 0x1f600 };
+        n = sizeof(out);
+        UTEST_ASSERT(encodeData(out, &n, "UTF-16LE", utf16src, 3) == STATUS_OK);
+        UTEST_ASSERT(n == sizeof(utf16le) - 1);
+        UTEST_ASSERT(::memcmp(out, utf16le, n) == 0);
+        n = sizeof(out);
+        UTEST_ASSERT(encodeData(out, &n, "UTF-16BE", utf16src, 3) == STATUS_OK);
+        UTEST_ASSERT(n == sizeof(utf16be) - 1);
+        UTEST_ASSERT(::memcmp(out, utf16be, n) == 0);
+
+        // Invalid code points
+        static const lsp_wchar_t bad1[] = { 'a', 'b', 0xd800, 'c' };
+        static const lsp_wchar_t bad2[] = { 'a', 'b', 0x110000, 'c' };
+        static const char *charsets[] = { "UTF-8", "UTF-16LE", "UTF-16BE", NULL };
+        for (const char **cs = charsets; *cs != NULL; ++cs)
+        {
+            n = sizeof(out);
+            UTEST_ASSERT(encodeData(out, &n, *cs, bad1, 4) == -STATUS_BAD_FORMAT);
+            UTEST_ASSERT(n == ((*cs)[4] == '8' ? 2 : 4));
+            n = sizeof(out);
+            UTEST_ASSERT(encodeData(out, &n, *cs, bad2, 4) == -STATUS_BAD_FORMAT);
+            UTEST_ASSERT(n == ((*cs)[4] == '8' ? 2 : 4));
+        }
+    }
+
     UTEST_MAIN
     {
         const char *base = "io" FILE_SEPARATOR_S "iconv";
@@ -208,6 +440,11 @@ UTEST_BEGIN("runtime.io", encdec)
         testFileCoding(base, "03-ru-cp1251.txt", "CP1251");
         testFileCoding(base, "03-ru-utf16le.txt", "UTF-16LE");
         testFileCoding(base, "03-ru-utf8.txt", "UTF-8");
+
+        testDecodeNative();
+        testEncodeNative();
+        testDecodeNativeFile(base, "03-ru-utf8.txt", "UTF-8", "03-ru-cp1251.txt");
+        testDecodeNativeFile(base, "03-ru-utf16le.txt", "UTF-16LE", "03-ru-cp1251.txt");
     }
 
 UTEST_END
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/MappedFile.h>
+#include <lsp-plug.in/io/InMappedStream.h>
+
+using namespace lsp;
+using namespace lsp::io;
+
+UTEST_BEGIN("runtime.io", mappedstream)
+
+    uint8_t *load_file(const LSPString *path, size_t *size)
+    {
+        NativeFile fd;
+        UTEST_ASSERT(fd.open(path, File::FM_READ) == STATUS_OK);
+        wssize_t fsize = fd.size();
+        UTEST_ASSERT(fsize > 0);
+
+        uint8_t *buf = reinterpret_cast<uint8_t *>(::malloc(fsize));
+        UTEST_ASSERT(buf != NULL);
+        UTEST_ASSERT(fd.read(buf, fsize) == fsize);
+        UTEST_ASSERT(fd.close() == STATUS_OK);
+
+        *size = fsize;
+        return buf;
+    }
+
+    void testMappedFile(const LSPString *path)
+    {
+        size_t size = 0;
+        uint8_t *ref = load_file(path, &size);
+
+        MappedFile mf;
+        UTEST_ASSERT(!mf.opened());
+        UTEST_ASSERT(mf.open(path) == STATUS_OK);
+        UTEST_ASSERT(mf.opened());
+        UTEST_ASSERT(mf.open(path) == STATUS_BAD_STATE);
+        UTEST_ASSERT(mf.size() == size);
+        UTEST_ASSERT(mf.data() != NULL);
+        UTEST_ASSERT(::memcmp(mf.data(), ref, size) == 0);
+        UTEST_ASSERT(mf.close() == STATUS_OK);
+        UTEST_ASSERT(!mf.opened());
+        UTEST_ASSERT(mf.data() == NULL);
+        UTEST_ASSERT(mf.size() == 0);
+
+        ::free(ref);
+    }
+
+    void testMappedStream(const LSPString *path)
+    {
+        size_t size = 0;
+        uint8_t *ref = load_file(path, &size);
+        uint8_t buf[0x100];
+
+        InMappedStream is;
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) < 0);
+        UTEST_ASSERT(is.open(path) == STATUS_OK);
+        UTEST_ASSERT(is.open(path) == STATUS_BAD_STATE);
+        UTEST_ASSERT(is.size() == size);
+        UTEST_ASSERT(::memcmp(is.data(), ref, size) == 0);
+
+        // Read the whole stream by chunks
+        size_t offset = 0;
+        while (true)
+        {
+            ssize_t n = is.read(buf, 77);
+            if (n < 0)
+            {
+                UTEST_ASSERT(n == -STATUS_EOF);
+                break;
+            }
+            UTEST_ASSERT(::memcmp(buf, &ref[offset], n) == 0);
+            offset     += n;
+        }
+        UTEST_ASSERT(offset == size);
+        UTEST_ASSERT(is.avail() == 0);
+
+        // Test seek and skip
+        UTEST_ASSERT(is.seek(10) == 10);
+        UTEST_ASSERT(is.skip(5) == 5);
+        UTEST_ASSERT(is.position() == 15);
+        UTEST_ASSERT(is.avail() == wssize_t(size - 15));
+        UTEST_ASSERT(is.read(buf, 16) == 16);
+        UTEST_ASSERT(::memcmp(buf, &ref[15], 16) == 0);
+        UTEST_ASSERT(is.skip(size) == wssize_t(size - 31));
+        UTEST_ASSERT(is.read(buf, 16) == -STATUS_EOF);
+
+        // Close and re-open
+        UTEST_ASSERT(is.close() == STATUS_OK);
+        UTEST_ASSERT(is.data() == NULL);
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) < 0);
+        UTEST_ASSERT(is.open(path) == STATUS_OK);
+        UTEST_ASSERT(is.read(buf, 16) == 16);
+        UTEST_ASSERT(::memcmp(buf, ref, 16) == 0);
+
+        ::free(ref);
+    }
+
+    void testEmptyFile()
+    {
+        LSPString path;
+        uint8_t buf[0x10];
+        UTEST_ASSERT(path.fmt_utf8("%s" FILE_SEPARATOR_S "utest-%s-empty.tmp", tempdir(), full_name()));
+
+        NativeFile fd;
+        UTEST_ASSERT(fd.open(&path, File::FM_WRITE_NEW) == STATUS_OK);
+        UTEST_ASSERT(fd.close() == STATUS_OK);
+
+        MappedFile mf;
+        UTEST_ASSERT(mf.open(&path) == STATUS_OK);
+        UTEST_ASSERT(mf.opened());
+        UTEST_ASSERT(mf.size() == 0);
+        UTEST_ASSERT(mf.close() == STATUS_OK);
+
+        InMappedStream is;
+        UTEST_ASSERT(is.open(&path) == STATUS_OK);
+        UTEST_ASSERT(is.size() == 0);
+        UTEST_ASSERT(is.avail() == 0);
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == -STATUS_EOF);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+
+        UTEST_ASSERT(File::remove(&path) == STATUS_OK);
+    }
+
+    void testFailures()
+    {
+        LSPString path;
+        MappedFile mf;
+        InMappedStream is;
+
+        UTEST_ASSERT(mf.open(static_cast<const char *>(NULL)) == STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(is.open(static_cast<const char *>(NULL)) == STATUS_BAD_ARGUMENTS);
+
+        UTEST_ASSERT(path.fmt_utf8("%s" FILE_SEPARATOR_S "utest-nonexisting-%s.tmp", tempdir(), full_name()));
+        UTEST_ASSERT(mf.open(&path) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(!mf.opened());
+        UTEST_ASSERT(is.open(&path) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(is.data() == NULL);
+
+        UTEST_ASSERT(path.set_utf8(tempdir()));
+        UTEST_ASSERT(mf.open(&path) != STATUS_OK);
+        UTEST_ASSERT(!mf.opened());
+    }
+
+    UTEST_MAIN
+    {
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s" FILE_SEPARATOR_S "io" FILE_SEPARATOR_S "iconv" FILE_SEPARATOR_S "01-de-utf8.txt", resources()));
+
+        printf("Testing MappedFile...\n");
+        testMappedFile(&path);
+        printf("Testing InMappedStream...\n");
+        testMappedStream(&path);
+        printf("Testing empty file...\n");
+        testEmptyFile();
+        printf("Testing failures...\n");
+        testFailures();
+    }
+
+UTEST_END
@@ -25,6 +25,9 @@
 #include <lsp-plug.in/stdlib/string.h>
 #include <lsp-plug.in/io/NativeFile.h>
 #include <lsp-plug.in/io/OutSequence.h>
+#include <lsp-plug.in/io/InStringSequence.h>
+#include <lsp-plug.in/io/InSequenceReader.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
 
 // Test buffer size is a simple number, more than 0x1000
 #define BUFFER_SIZE         4567
@@ -159,6 +162,132 @@ UTEST_BEGIN("runtime.io", sequence)
         compareFiles(&fsrc, &fdec);
     }
 
+    void readAll(LSPString *dst, IInSequence *in)
+    {
+        InSequenceReader rd(in);
+        lsp_swchar_t c;
+
+        dst->clear();
+        for (size_t i=0; ; ++i)
+        {
+            // Interleave the reader with direct access to the sequence
+            if ((i % 1000) == 999)
+            {
+                UTEST_ASSERT(rd.commit() == STATUS_OK);
+                if ((c = in->read()) < 0)
+                    break;
+            }
+            else if ((c = rd.read()) < 0)
+                break;
+            UTEST_ASSERT(dst->append(lsp_wchar_t(c)));
+        }
+        UTEST_ASSERT(c == -STATUS_EOF);
+        UTEST_ASSERT(rd.commit() == STATUS_OK);
+    }
+
+    void readLines(LSPString *dst, IInSequence *in)
+    {
+        LSPString line;
+        status_t res;
+
+        dst->clear();
+        while ((res = in->read_line(&line, true)) == STATUS_OK)
+        {
+            UTEST_ASSERT(dst->append(&line));
+            UTEST_ASSERT(dst->append('\n'));
+        }
+        UTEST_ASSERT(res == STATUS_EOF);
+    }
+
+    void testBorrow(const char *base, const char *src, const char *charset)
+    {
+        LSPString fsrc, text, tmp, lines;
+        InSequence in;
+        InStringSequence sin;
+        const lsp_wchar_t *buf;
+
+        UTEST_ASSERT(fsrc.fmt_utf8("%s" FILE_SEPARATOR_S "%s" FILE_SEPARATOR_S "%s", resources(), base, src));
+        printf("Testing borrowing of characters on file %s...\n", fsrc.get_native());
+
+        // Read the reference text
+        UTEST_ASSERT(in.open(&fsrc, charset) == STATUS_OK);
+        lsp_wchar_t *xbuf = new lsp_wchar_t[BUFFER_SIZE];
+        UTEST_ASSERT(xbuf != NULL);
+        ssize_t nread;
+        while ((nread = in.read(xbuf, BUFFER_SIZE)) > 0)
+            UTEST_ASSERT(text.append(xbuf, nread));
+        delete [] xbuf;
+        UTEST_ASSERT(in.close() == STATUS_OK);
+        UTEST_ASSERT(text.length() > 0x1000);
+
+        // Borrow characters without consuming
+        UTEST_ASSERT(in.open(&fsrc, charset) == STATUS_OK);
+        ssize_t n = in.borrow(&buf);
+        UTEST_ASSERT(n > 0);
+        UTEST_ASSERT(::memcmp(buf, text.characters(), n * sizeof(lsp_wchar_t)) == 0);
+        UTEST_ASSERT(in.borrow(&buf) == n);
+        UTEST_ASSERT(in.skip(10) == 10);
+        UTEST_ASSERT(in.read() == lsp_swchar_t(text.at(10)));
+        UTEST_ASSERT(in.close() == STATUS_OK);
+        UTEST_ASSERT(in.borrow(&buf) == -STATUS_CLOSED);
+
+        // Read with InSequenceReader
+        UTEST_ASSERT(in.open(&fsrc, charset) == STATUS_OK);
+        readAll(&tmp, &in);
+        UTEST_ASSERT(tmp.equals(&text));
+        UTEST_ASSERT(in.borrow(&buf) == -STATUS_EOF);
+        UTEST_ASSERT(in.close() == STATUS_OK);
+
+        UTEST_ASSERT(sin.wrap(&text) == STATUS_OK);
+        readAll(&tmp, &sin);
+        UTEST_ASSERT(tmp.equals(&text));
+        UTEST_ASSERT(sin.borrow(&buf) == -STATUS_EOF);
+        UTEST_ASSERT(sin.close() == STATUS_OK);
+
+        // Read lines
+        UTEST_ASSERT(in.open(&fsrc, charset) == STATUS_OK);
+        readLines(&lines, &in);
+        UTEST_ASSERT(in.close() == STATUS_OK);
+
+        UTEST_ASSERT(sin.wrap(&text) == STATUS_OK);
+        readLines(&tmp, &sin);
+        UTEST_ASSERT(sin.close() == STATUS_OK);
+        UTEST_ASSERT(tmp.equals(&lines));
+    }
+
+    void testLongLines()
+    {
+        LSPString text, line;
+        InSequence in;
+
+        printf("Testing reading of long lines...\n");
+
+        // Lines longer than the decoder buffer with CR/LF at the window boundaries
+        for (size_t i=0; i<4; ++i)
+        {
+            for (size_t j=0; j<0x1000 + i*0x7ff - 1; ++j)
+                UTEST_ASSERT(text.append(lsp_wchar_t('a' + i)));
+            UTEST_ASSERT(text.append_ascii("\r\n"));
+        }
+        UTEST_ASSERT(text.append_ascii("tail"));
+
+        const char *utf8 = text.get_utf8();
+        UTEST_ASSERT(utf8 != NULL);
+        InMemoryStream is(utf8, ::strlen(utf8));
+        UTEST_ASSERT(in.wrap(&is, WRAP_NONE, "UTF-8") == STATUS_OK);
+        for (size_t i=0; i<4; ++i)
+        {
+            UTEST_ASSERT(in.read_line(&line) == STATUS_OK);
+            UTEST_ASSERT(line.length() == 0x1000 + i*0x7ff - 1);
+            UTEST_ASSERT(line.first() == lsp_wchar_t('a' + i));
+            UTEST_ASSERT(line.last() == lsp_wchar_t('a' + i));
+        }
+        UTEST_ASSERT(in.read_line(&line) == STATUS_EOF);
+        UTEST_ASSERT(in.read_line(&line, true) == STATUS_OK);
+        UTEST_ASSERT(line.equals_ascii("tail"));
+        UTEST_ASSERT(in.close() == STATUS_OK);
+    }
+
     UTEST_MAIN
     {
         const char *base = "io" FILE_SEPARATOR_S "iconv";
@@ -170,5 +299,10 @@ UTEST_BEGIN("runtime.io", sequence)
         testFileCoding(base, "03-ru-cp1251.txt", "CP1251");
         testFileCoding(base, "03-ru-utf16le.txt", "UTF-16LE");
         testFileCoding(base, "03-ru-utf8.txt", "UTF-8");
+
+        testBorrow(base, "01-de-utf8.txt", "UTF-8");
+        testBorrow(base, "02-ja-utf16le.txt", "UTF-16LE");
+        testBorrow(base, "03-ru-cp1251.txt", "CP1251");
+        testLongLines();
     }
 UTEST_END
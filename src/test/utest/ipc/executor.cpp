@@ -22,6 +22,10 @@
 #include <lsp-plug.in/test-fw/utest.h>
 #include <lsp-plug.in/ipc/Thread.h>
 #include <lsp-plug.in/ipc/NativeExecutor.h>
+#include <lsp-plug.in/runtime/system.h>
+
+#define LATENCY_TASKS       100
+#define LATENCY_BUCKETS     6
 
 using namespace lsp;
 
@@ -50,7 +54,88 @@ UTEST_BEGIN("runtime.ipc", executor)
             }
     };
 
-    UTEST_MAIN
+    class LatencyTask: public ipc::ITask
+    {
+        public:
+            system::time_t  sSubmitted;
+            system::time_t  sStarted;
+
+        public:
+            explicit LatencyTask() {}
+            virtual ~LatencyTask() {}
+
+        public:
+            virtual status_t run()
+            {
+                system::get_time(&sStarted);
+                return STATUS_OK;
+            }
+    };
+
+    static int64_t latency_us(const system::time_t *start, const system::time_t *end)
+    {
+        int64_t nanos   = (int64_t(end->seconds) - int64_t(start->seconds)) * 1000000000LL +
+                          (int64_t(end->nanos) - int64_t(start->nanos));
+        return nanos / 1000;
+    }
+
+    void test_latency()
+    {
+        static const int64_t limits[LATENCY_BUCKETS] = { 10, 100, 1000, 10000, 100000, -1 };
+        static const char *names[LATENCY_BUCKETS] = { "< 10 us", "< 100 us", "< 1 ms", "< 10 ms", "< 100 ms", ">= 100 ms" };
+        size_t histogram[LATENCY_BUCKETS];
+        int64_t samples[LATENCY_TASKS];
+        LatencyTask task;
+
+        printf("Measuring submit-to-run latency...\n");
+        ipc::NativeExecutor executor;
+        UTEST_ASSERT(executor.start() == STATUS_OK);
+
+        for (size_t i=0; i<LATENCY_BUCKETS; ++i)
+            histogram[i]    = 0;
+
+        for (size_t i=0; i<LATENCY_TASKS; ++i)
+        {
+            // Let the executor become idle before submitting the task
+            ipc::Thread::sleep(2);
+
+            system::get_time(&task.sSubmitted);
+            UTEST_ASSERT(executor.submit(&task));
+            while (!task.completed())
+                ipc::Thread::sleep(1);
+
+            int64_t lat     = latency_us(&task.sSubmitted, &task.sStarted);
+            samples[i]      = lat;
+            size_t b        = 0;
+            while ((limits[b] >= 0) && (lat >= limits[b]))
+                ++b;
+            ++histogram[b];
+
+            UTEST_ASSERT(task.code() == STATUS_OK);
+            UTEST_ASSERT(task.reset());
+        }
+
+        executor.shutdown();
+
+        printf("Latency histogram:\n");
+        for (size_t i=0; i<LATENCY_BUCKETS; ++i)
+            printf("  %-10s: %d\n", names[i], int(histogram[i]));
+
+        // Compute median latency, it should be far less than the former 100 ms polling interval
+        for (size_t i=0; i<LATENCY_TASKS; ++i)
+            for (size_t j=i+1; j<LATENCY_TASKS; ++j)
+                if (samples[j] < samples[i])
+                {
+                    int64_t tmp     = samples[i];
+                    samples[i]      = samples[j];
+                    samples[j]      = tmp;
+                }
+        int64_t median  = samples[LATENCY_TASKS/2];
+        printf("Median latency: %d us\n", int(median));
+        UTEST_ASSERT_MSG(median < 10000, "Median latency is too high: %d us", int(median));
+    }
+
+    void test_execution()
     {
         TestTask *tasks[4];
 
@@ -93,5 +178,11 @@ UTEST_BEGIN("runtime.ipc", executor)
             delete tasks[i];
     }
 
+    UTEST_MAIN
+    {
+        test_execution();
+        test_latency();
+    }
+
 UTEST_END
 
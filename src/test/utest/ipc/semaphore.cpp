@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/ipc/Semaphore.h>
+
+#define ITEMS       1000
+
+using namespace lsp;
+
+UTEST_BEGIN("runtime.ipc", semaphore)
+
+    typedef struct shared_t
+    {
+        ipc::Semaphore      sem;
+        volatile atomic_t   consumed;
+    } shared_t;
+
+    static status_t consume(void *arg)
+    {
+        shared_t *sh    = static_cast<shared_t *>(arg);
+        while (true)
+        {
+            if (!sh->sem.wait())
+                return STATUS_UNKNOWN_ERR;
+            if (atomic_add(&sh->consumed, 1) >= ITEMS - 1)
+                break;
+        }
+        return STATUS_OK;
+    }
+
+    void test_single_thread()
+    {
+        ipc::Semaphore sem;
+
+        printf("Testing single-thread operations...\n");
+        UTEST_ASSERT(!sem.try_wait());
+        UTEST_ASSERT(!sem.wait(10));
+
+        UTEST_ASSERT(sem.post());
+        UTEST_ASSERT(sem.post());
+        UTEST_ASSERT(sem.try_wait());
+        UTEST_ASSERT(sem.wait(10));
+        UTEST_ASSERT(!sem.try_wait());
+
+        UTEST_ASSERT(sem.post());
+        UTEST_ASSERT(sem.wait());
+        UTEST_ASSERT(!sem.try_wait());
+    }
+
+    void test_multiple_threads()
+    {
+        shared_t sh;
+        ipc::Thread *threads[4];
+        sh.consumed     = 0;
+
+        printf("Starting consumer threads...\n");
+        for (size_t i=0; i<4; ++i)
+        {
+            threads[i]      = new ipc::Thread(consume, &sh);
+            UTEST_ASSERT(threads[i] != NULL);
+            UTEST_ASSERT(threads[i]->start() == STATUS_OK);
+        }
+
+        printf("Posting %d signals...\n", int(ITEMS));
+        for (size_t i=0; i<ITEMS; ++i)
+            UTEST_ASSERT(sh.sem.post());
+
+        // Each thread leaves after it receives the last signal,
+        // release the rest of threads
+        for (size_t i=0; i<4; ++i)
+            UTEST_ASSERT(sh.sem.post());
+
+        printf("Waiting for consumer threads...\n");
+        for (size_t i=0; i<4; ++i)
+        {
+            UTEST_ASSERT(threads[i]->join() == STATUS_OK);
+            UTEST_ASSERT(threads[i]->get_result() == STATUS_OK);
+            delete threads[i];
+        }
+
+        UTEST_ASSERT(sh.consumed >= ITEMS);
+    }
+
+    typedef struct handoff_t
+    {
+        ipc::Semaphore * volatile   sem;
+        size_t                      count;
+    } handoff_t;
+
+    static status_t post_handoff(void *arg)
+    {
+        handoff_t *h    = static_cast<handoff_t *>(arg);
+        for (size_t i=0; i<h->count; ++i)
+        {
+            ipc::Semaphore *sem;
+            while ((sem = h->sem) == NULL)
+                ipc::Thread::yield();
+            h->sem          = NULL;
+            sem->post();
+        }
+        return STATUS_OK;
+    }
+
+    void test_destroy_after_wait()
+    {
+        handoff_t h;
+        h.sem           = NULL;
+        h.count         = ITEMS;
+
+        // The waiter destroys the semaphore as soon as wait() returns,
+        // post() should not access the semaphore after the signal
+        printf("Testing destroy of semaphore after wait...\n");
+        ipc::Thread poster(post_handoff, &h);
+        UTEST_ASSERT(poster.start() == STATUS_OK);
+
+        for (size_t i=0; i<ITEMS; ++i)
+        {
+            ipc::Semaphore *sem = new ipc::Semaphore();
+            UTEST_ASSERT(sem != NULL);
+            h.sem           = sem;
+            UTEST_ASSERT(sem->wait());
+            delete sem;
+        }
+
+        UTEST_ASSERT(poster.join() == STATUS_OK);
+    }
+
+    UTEST_MAIN
+    {
+        test_single_thread();
+        test_multiple_threads();
+        test_destroy_after_wait();
+    }
+
+UTEST_END
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/ipc/NativeExecutor.h>
+#include <lsp-plug.in/ipc/ThreadPoolExecutor.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("runtime.ipc", task)
+
+    class TestTask: public ipc::ITask
+    {
+        private:
+            size_t              nDelay;
+            status_t            nResult;
+
+        public:
+            volatile atomic_t  *pOrder;         // Global execution counter
+            ssize_t             nOrder;         // Order of execution
+
+        public:
+            explicit TestTask(size_t delay, status_t result)
+            {
+                nDelay      = delay;
+                nResult     = result;
+                pOrder      = NULL;
+                nOrder      = -1;
+            }
+
+        public:
+            virtual status_t run()
+            {
+                if (nDelay > 0)
+                    ipc::Thread::sleep(nDelay);
+                if (pOrder != NULL)
+                    nOrder      = atomic_add(pOrder, 1);
+                return nResult;
+            }
+    };
+
+    typedef struct callback_t
+    {
+        ipc::ITask         *task;
+        volatile atomic_t   calls;
+    } callback_t;
+
+    static void on_task_complete(ipc::ITask *task, void *arg)
+    {
+        callback_t *cb  = static_cast<callback_t *>(arg);
+        cb->task        = task;
+        atomic_add(&cb->calls, 1);
+    }
+
+    void test_wait(ipc::IExecutor *executor)
+    {
+        printf("Testing wait...\n");
+        TestTask t1(200, STATUS_OK), t2(10, STATUS_CANCELLED);
+
+        // The task that has not been submitted should time out
+        UTEST_ASSERT(!t1.wait(10));
+
+        UTEST_ASSERT(executor->submit(&t1));
+        UTEST_ASSERT(!t1.wait(10));
+        UTEST_ASSERT(t1.wait(5000));
+        UTEST_ASSERT(t1.completed());
+        UTEST_ASSERT(t1.code() == STATUS_OK);
+
+        // Completed task should not block
+        UTEST_ASSERT(t1.wait(0));
+        UTEST_ASSERT(t1.wait());
+
+        UTEST_ASSERT(executor->submit(&t2));
+        UTEST_ASSERT(t2.wait());
+        UTEST_ASSERT(t2.code() == STATUS_CANCELLED);
+    }
+
+    void test_callbacks(ipc::IExecutor *executor)
+    {
+        printf("Testing callbacks and continuations...\n");
+        TestTask t1(50, STATUS_OK), t2(10, STATUS_OK), t3(10, STATUS_OK);
+        volatile atomic_t order = 0;
+        callback_t cb;
+        cb.task     = NULL;
+        cb.calls    = 0;
+
+        t1.pOrder   = &order;
+        t2.pOrder   = &order;
+        t3.pOrder   = &order;
+
+        // Build chain t1 -> t2 -> t3
+        UTEST_ASSERT(t1.on_complete(on_task_complete, &cb));
+        UTEST_ASSERT(!t1.on_complete(on_task_complete, &cb));
+        UTEST_ASSERT(t1.then(&t2, executor));
+        UTEST_ASSERT(!t1.then(&t3, executor));
+        UTEST_ASSERT(t2.then(&t3, executor));
+
+        UTEST_ASSERT(executor->submit(&t1));
+        UTEST_ASSERT(t1.wait(5000));
+        UTEST_ASSERT(t3.wait(5000));
+        UTEST_ASSERT(t1.completed());
+        UTEST_ASSERT(t2.completed());
+
+        UTEST_ASSERT(cb.calls == 1);
+        UTEST_ASSERT(cb.task == &t1);
+        UTEST_ASSERT((t1.nOrder == 0) && (t2.nOrder == 1) && (t3.nOrder == 2));
+
+        // Handlers of completed task are called immediately
+        UTEST_ASSERT(t1.on_complete(on_task_complete, &cb));
+        UTEST_ASSERT(cb.calls == 2);
+        UTEST_ASSERT(t3.reset());
+        UTEST_ASSERT(t1.then(&t3, executor));
+        UTEST_ASSERT(t3.wait(5000));
+        UTEST_ASSERT(t3.nOrder == 3);
+    }
+
+    void test_refused_continuation(ipc::IExecutor *executor)
+    {
+        printf("Testing continuation refused by executor...\n");
+        TestTask t1(10, STATUS_OK), t2(10, STATUS_OK);
+        volatile atomic_t order = 0;
+        t2.pOrder   = &order;
+
+        // The executor that has not been started refuses all tasks
+        ipc::ThreadPoolExecutor stopped(1);
+        UTEST_ASSERT(t1.then(&t2, &stopped));
+        UTEST_ASSERT(executor->submit(&t1));
+
+        // The continuation should not block waiters forever
+        UTEST_ASSERT(t2.wait(5000));
+        UTEST_ASSERT(t2.completed());
+        UTEST_ASSERT(t2.code() == STATUS_CANCELLED);
+        UTEST_ASSERT(t2.nOrder < 0);
+    }
+
+    void test_wait_many(ipc::IExecutor *executor)
+    {
+        printf("Testing wait for many tasks...\n");
+        TestTask t1(300, STATUS_OK), t2(10, STATUS_OK), t3(200, STATUS_OK);
+        ipc::ITask *tasks[] = { &t1, &t2, &t3 };
+
+        UTEST_ASSERT(ipc::ITask::wait_any(tasks, 3, 10) < 0);
+        UTEST_ASSERT(!ipc::ITask::wait_all(tasks, 3, 10));
+
+        UTEST_ASSERT(executor->submit(&t1));
+        UTEST_ASSERT(executor->submit(&t3));
+        ipc::Thread::sleep(50);
+        UTEST_ASSERT(executor->submit(&t2));
+
+        ssize_t idx = ipc::ITask::wait_any(tasks, 3, 5000);
+        UTEST_ASSERT_MSG(idx == 1, "Expected task index 1, got %d", int(idx));
+        UTEST_ASSERT(ipc::ITask::wait_any(tasks, 3) == 1);
+        UTEST_ASSERT(!t1.completed());
+
+        UTEST_ASSERT(ipc::ITask::wait_all(tasks, 3, 5000));
+        for (size_t i=0; i<3; ++i)
+            UTEST_ASSERT(tasks[i]->completed());
+        UTEST_ASSERT(ipc::ITask::wait_all(tasks, 3));
+    }
+
+    UTEST_MAIN
+    {
+        printf("Using thread pool executor...\n");
+        ipc::ThreadPoolExecutor pool(4);
+        UTEST_ASSERT(pool.start() == STATUS_OK);
+        test_wait(&pool);
+        test_callbacks(&pool);
+        test_refused_continuation(&pool);
+        test_wait_many(&pool);
+        pool.shutdown();
+
+        printf("Using native executor...\n");
+        ipc::NativeExecutor native;
+        UTEST_ASSERT(native.start() == STATUS_OK);
+        test_wait(&native);
+        test_callbacks(&native);
+        test_refused_continuation(&native);
+        native.shutdown();
+    }
+
+UTEST_END
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/ipc/ThreadPoolExecutor.h>
+
+#define TASKS           64
+#define SUBMITTERS      4
+#define CHILDREN        4
+#define SHUTDOWN_TASKS  4096
+
+using namespace lsp;
+
+UTEST_BEGIN("runtime.ipc", threadpool)
+
+    class TestTask: public ipc::ITask
+    {
+        private:
+            size_t              nDelay;
+            status_t            nResult;
+            ipc::IExecutor     *pExecutor;
+            TestTask           *vChildren;
+            size_t              nChildren;
+
+        public:
+            volatile atomic_t   nRuns;
+
+        public:
+            explicit TestTask()
+            {
+                nDelay      = 0;
+                nResult     = STATUS_OK;
+                pExecutor   = NULL;
+                vChildren   = NULL;
+                nChildren   = 0;
+                nRuns       = 0;
+            }
+
+            void init(size_t delay, status_t result, ipc::IExecutor *executor = NULL, TestTask *children = NULL, size_t count = 0)
+            {
+                nDelay      = delay;
+                nResult     = result;
+                pExecutor   = executor;
+                vChildren   = children;
+                nChildren   = count;
+            }
+
+        public:
+            virtual status_t run()
+            {
+                atomic_add(&nRuns, 1);
+
+                // Submit child tasks from the worker thread
+                for (size_t i=0; i<nChildren; ++i)
+                {
+                    if (!pExecutor->submit(&vChildren[i]))
+                        return STATUS_UNKNOWN_ERR;
+                }
+
+                if (nDelay > 0)
+                    ipc::Thread::sleep(nDelay);
+                return nResult;
+            }
+    };
+
+    typedef struct submitter_t
+    {
+        ipc::IExecutor *executor;
+        TestTask       *tasks;
+        size_t          count;
+        size_t          failed;
+    } submitter_t;
+
+    static status_t submit_tasks(void *arg)
+    {
+        submitter_t *s  = static_cast<submitter_t *>(arg);
+        for (size_t i=0; i<s->count; ++i)
+        {
+            if (!s->executor->submit(&s->tasks[i]))
+                ++s->failed;
+        }
+        return STATUS_OK;
+    }
+
+    void test_concurrent_submit()
+    {
+        TestTask tasks[TASKS];
+        for (size_t i=0; i<TASKS; ++i)
+            tasks[i].init(rand() % 10, (i & 1) ? STATUS_OK : STATUS_CANCELLED);
+
+        printf("Starting thread pool executor...\n");
+        ipc::ThreadPoolExecutor executor(4);
+        UTEST_ASSERT(executor.start() == STATUS_OK);
+        UTEST_ASSERT(executor.threads() == 4);
+        UTEST_ASSERT(executor.start() == STATUS_BAD_STATE);
+
+        printf("Submitting tasks from %d threads...\n", int(SUBMITTERS));
+        submitter_t sub[SUBMITTERS];
+        ipc::Thread *threads[SUBMITTERS];
+        for (size_t i=0; i<SUBMITTERS; ++i)
+        {
+            sub[i].executor = &executor;
+            sub[i].tasks    = &tasks[i * (TASKS / SUBMITTERS)];
+            sub[i].count    = TASKS / SUBMITTERS;
+            sub[i].failed   = 0;
+            threads[i]      = new ipc::Thread(submit_tasks, &sub[i]);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+        for (size_t i=0; i<SUBMITTERS; ++i)
+            UTEST_ASSERT(threads[i]->start() == STATUS_OK);
+        for (size_t i=0; i<SUBMITTERS; ++i)
+        {
+            UTEST_ASSERT(threads[i]->join() == STATUS_OK);
+            UTEST_ASSERT_MSG(sub[i].failed == 0, "Submitter %d failed to submit %d tasks", int(i), int(sub[i].failed));
+            delete threads[i];
+        }
+
+        printf("Shutting down executor...\n");
+        executor.shutdown();
+        UTEST_ASSERT(!executor.submit(&tasks[0]));
+
+        printf("Checking tasks...\n");
+        for (size_t i=0; i<TASKS; ++i)
+        {
+            UTEST_ASSERT(tasks[i].completed());
+            UTEST_ASSERT(tasks[i].nRuns == 1);
+            UTEST_ASSERT(tasks[i].code() == ((i & 1) ? STATUS_OK : STATUS_CANCELLED));
+            UTEST_ASSERT(tasks[i].reset());
+        }
+    }
+
+    void test_nested_submit()
+    {
+        TestTask parents[CHILDREN];
+        TestTask children[CHILDREN * CHILDREN];
+
+        printf("Starting thread pool executor...\n");
+        ipc::ThreadPoolExecutor executor(2);
+        UTEST_ASSERT(executor.start() == STATUS_OK);
+
+        for (size_t i=0; i<CHILDREN; ++i)
+        {
+            for (size_t j=0; j<CHILDREN; ++j)
+                children[i*CHILDREN + j].init(5, STATUS_OK);
+            parents[i].init(0, STATUS_OK, &executor, &children[i*CHILDREN], CHILDREN);
+        }
+
+        printf("Submitting tasks that spawn child tasks...\n");
+        for (size_t i=0; i<CHILDREN; ++i)
+            UTEST_ASSERT(executor.submit(&parents[i]));
+        UTEST_ASSERT(!executor.submit(&parents[0]));
+
+        printf("Shutting down executor...\n");
+        executor.shutdown();
+
+        printf("Checking tasks...\n");
+        for (size_t i=0; i<CHILDREN; ++i)
+        {
+            UTEST_ASSERT(parents[i].completed());
+            UTEST_ASSERT(parents[i].code() == STATUS_OK);
+        }
+        for (size_t i=0; i<CHILDREN*CHILDREN; ++i)
+        {
+            UTEST_ASSERT(children[i].completed());
+            UTEST_ASSERT(children[i].nRuns == 1);
+        }
+    }
+
+    void test_submit_during_shutdown()
+    {
+        TestTask *tasks = new TestTask[SHUTDOWN_TASKS];
+        UTEST_ASSERT(tasks != NULL);
+        for (size_t i=0; i<SHUTDOWN_TASKS; ++i)
+            tasks[i].init(0, STATUS_OK);
+
+        printf("Starting thread pool executor...\n");
+        ipc::ThreadPoolExecutor executor(4);
+        UTEST_ASSERT(executor.start() == STATUS_OK);
+
+        printf("Submitting tasks from %d threads while shutting down...\n", int(SUBMITTERS));
+        submitter_t sub[SUBMITTERS];
+        ipc::Thread *threads[SUBMITTERS];
+        for (size_t i=0; i<SUBMITTERS; ++i)
+        {
+            sub[i].executor = &executor;
+            sub[i].tasks    = &tasks[i * (SHUTDOWN_TASKS / SUBMITTERS)];
+            sub[i].count    = SHUTDOWN_TASKS / SUBMITTERS;
+            sub[i].failed   = 0;
+            threads[i]      = new ipc::Thread(submit_tasks, &sub[i]);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+        for (size_t i=0; i<SUBMITTERS; ++i)
+            UTEST_ASSERT(threads[i]->start() == STATUS_OK);
+
+        // Start shutdown when the submission is in progress
+        while (tasks[0].idle())
+            ipc::Thread::yield();
+        executor.shutdown();
+
+        size_t failed = 0;
+        for (size_t i=0; i<SUBMITTERS; ++i)
+        {
+            UTEST_ASSERT(threads[i]->join() == STATUS_OK);
+            failed     += sub[i].failed;
+            delete threads[i];
+        }
+
+        // Each accepted task should be complete, each rejected task should stay idle
+        printf("Checking tasks, %d of %d rejected...\n", int(failed), int(SHUTDOWN_TASKS));
+        size_t completed = 0;
+        for (size_t i=0; i<SHUTDOWN_TASKS; ++i)
+        {
+            if (tasks[i].completed())
+            {
+                UTEST_ASSERT(tasks[i].nRuns == 1);
+                ++completed;
+            }
+            else
+            {
+                UTEST_ASSERT(tasks[i].idle());
+                UTEST_ASSERT(tasks[i].nRuns == 0);
+            }
+        }
+        UTEST_ASSERT(completed + failed == SHUTDOWN_TASKS);
+
+        delete [] tasks;
+    }
+
+    UTEST_MAIN
+    {
+        test_concurrent_submit();
+        test_nested_submit();
+        test_submit_during_shutdown();
+    }
+
+UTEST_END
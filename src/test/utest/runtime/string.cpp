@@ -21,8 +21,11 @@
 
 #include <lsp-plug.in/test-fw/utest.h>
 #include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/charset.h>
 #include <lsp-plug.in/lltl/pphash.h>
 
+#include <wctype.h>
+
 namespace lsp
 {
     static const lsp_utf16_t utf16_ja[] =
@@ -373,12 +376,366 @@ UTEST_BEGIN("runtime.runtime", string)
         UTEST_ASSERT(h.size() == 10);
     }
 
+    void test_short_strings()
+    {
+        printf("Testing transitions between short and long strings...\n");
+
+        LSPString s1, s2, s3;
+
+        // Grow the short string to the long one and shrink back
+        UTEST_ASSERT(s1.set_ascii("short"));
+        UTEST_ASSERT(s1.capacity() >= s1.length());
+        for (size_t i=0; i<40; ++i)
+            UTEST_ASSERT(s1.append(lsp_wchar_t('a' + (i % 26))));
+        UTEST_ASSERT(s1.length() == 45);
+        UTEST_ASSERT(s1.starts_with_ascii("shortabcdefghijklmnopqrstuvwxyzabcd"));
+        UTEST_ASSERT(s1.truncate(5));
+        UTEST_ASSERT(s1.equals_ascii("short"));
+        UTEST_ASSERT(s1.append_ascii(" string"));
+        UTEST_ASSERT(s1.equals_ascii("short string"));
+        s1.reduce();
+        UTEST_ASSERT(s1.equals_ascii("short string"));
+
+        // Swap short and long strings in all combinations
+        UTEST_ASSERT(s2.set_ascii("this is a rather long string value"));
+        s1.swap(&s2);
+        UTEST_ASSERT(s1.equals_ascii("this is a rather long string value"));
+        UTEST_ASSERT(s2.equals_ascii("short string"));
+        UTEST_ASSERT(s3.set_ascii("tiny"));
+        s2.swap(&s3);
+        UTEST_ASSERT(s2.equals_ascii("tiny"));
+        UTEST_ASSERT(s3.equals_ascii("short string"));
+        s3.swap(&s2);
+        UTEST_ASSERT(s2.equals_ascii("short string"));
+        UTEST_ASSERT(s3.equals_ascii("tiny"));
+
+        // Take, copy and substring
+        s1.take(&s3);
+        UTEST_ASSERT(s1.equals_ascii("tiny"));
+        UTEST_ASSERT(s3.is_empty());
+        UTEST_ASSERT(s3.append_ascii("after take"));
+        UTEST_ASSERT(s3.equals_ascii("after take"));
+
+        LSPString *c = s2.copy();
+        UTEST_ASSERT(c != NULL);
+        UTEST_ASSERT(c->equals(&s2));
+        delete c;
+
+        c = s2.substring(6);
+        UTEST_ASSERT(c != NULL);
+        UTEST_ASSERT(c->equals_ascii("string"));
+        delete c;
+
+        c = s2.release();
+        UTEST_ASSERT(c != NULL);
+        UTEST_ASSERT(c->equals_ascii("short string"));
+        UTEST_ASSERT(s2.is_empty());
+        delete c;
+
+        // Self-referencing modifications of short strings
+        UTEST_ASSERT(s1.append(&s1));
+        UTEST_ASSERT(s1.equals_ascii("tinytiny"));
+        UTEST_ASSERT(s1.append(&s1));
+        UTEST_ASSERT(s1.equals_ascii("tinytinytinytiny"));
+        UTEST_ASSERT(s1.append(&s1));
+        UTEST_ASSERT(s1.equals_ascii("tinytinytinytinytinytinytinytiny"));
+        s1.truncate();
+        UTEST_ASSERT(s1.capacity() == 0);
+        UTEST_ASSERT(s1.set('x'));
+        UTEST_ASSERT(s1.equals_ascii("x"));
+    }
+
+    void test_utf8_conversion()
+    {
+        printf("Testing UTF-8 conversion of mixed strings...\n");
+
+        static const char *parts[] =
+        {
+            "a", "config_key", "/usr/share/lsp-plugins/", " ", "\xd0\xaf", "\xe2\x82\xac",
+            "\xf0\x9f\x8e\xbc", "\xff", "\xc0\x80", "\xe2\x82", "0123456789abcdefghijklmnopqrstuvwxyz"
+        };
+        const size_t nparts = sizeof(parts) / sizeof(parts[0]);
+
+        LSPString s, ref, tmp;
+        char buf[0x800];
+
+        srand(0x5678);
+        for (size_t iter=0; iter<2000; ++iter)
+        {
+            // Build random sequence of parts
+            size_t len = 0;
+            for (size_t count = rand() % 32; count > 0; --count)
+            {
+                const char *p = parts[rand() % nparts];
+                size_t n = ::strlen(p);
+                ::memcpy(&buf[len], p, n);
+                len    += n;
+            }
+
+            // Decode reference string code point by code point
+            ref.clear();
+            const char *src = buf;
+            size_t nsrc = len;
+            lsp_utf32_t cp;
+            while ((cp = read_utf8_streaming(&src, &nsrc, true)) != LSP_UTF32_EOF)
+                UTEST_ASSERT(ref.append(lsp_wchar_t(cp)));
+
+            UTEST_ASSERT(s.set_utf8(buf, len));
+            UTEST_ASSERT(s.equals(&ref));
+
+            // Encode back and decode again
+            const char *utf8 = s.get_utf8();
+            UTEST_ASSERT(utf8 != NULL);
+            UTEST_ASSERT(tmp.set_utf8(utf8));
+            UTEST_ASSERT(tmp.equals(&ref));
+
+            // Encode part of the string
+            if (s.length() > 2)
+            {
+                utf8 = s.get_utf8(1, s.length() - 1);
+                UTEST_ASSERT(utf8 != NULL);
+                UTEST_ASSERT(tmp.set_utf8(utf8));
+                UTEST_ASSERT(tmp.equals(&ref, 1, ref.length() - 1));
+            }
+        }
+
+        // Long ASCII string crosses internal buffer boundaries
+        s.clear();
+        for (size_t i=0; i<5000; ++i)
+            UTEST_ASSERT(s.append(lsp_wchar_t((i % 100 == 99) ? 0x42f : 'a' + (i % 26))));
+        const char *utf8 = s.get_utf8();
+        UTEST_ASSERT(utf8 != NULL);
+        UTEST_ASSERT(::strlen(utf8) == 5050);
+        UTEST_ASSERT(tmp.set_utf8(utf8));
+        UTEST_ASSERT(tmp.equals(&s));
+
+        // Excess capacity reserved for multi-byte sequences should be released
+        s.clear();
+        for (size_t i=0; i<1000; ++i)
+            UTEST_ASSERT(s.append(lsp_wchar_t(0x20ac)));
+        UTEST_ASSERT((utf8 = s.get_utf8()) != NULL);
+        UTEST_ASSERT(::strlen(utf8) == 3000);
+        UTEST_ASSERT(tmp.set_utf8(utf8));
+        UTEST_ASSERT(tmp.equals(&s));
+        UTEST_ASSERT(tmp.capacity() < 1500);
+    }
+
+    static ssize_t naive_index_of(const LSPString *s, size_t first, size_t last, const LSPString *p, bool reverse)
+    {
+        ssize_t res = -1;
+        for (size_t i=first; (i + p->length()) <= last; ++i)
+        {
+            size_t j = 0;
+            while ((j < p->length()) && (s->char_at(i + j) == p->char_at(j)))
+                ++j;
+            if (j < p->length())
+                continue;
+            res     = i;
+            if (!reverse)
+                break;
+        }
+        return res;
+    }
+
+    static int naive_compare(const LSPString *a, const LSPString *b, bool nocase)
+    {
+        size_t n = lsp_min(a->length(), b->length());
+        for (size_t i=0; i<n; ++i)
+        {
+            lsp_wchar_t ca = a->char_at(i), cb = b->char_at(i);
+            if (nocase)
+            {
+                ca  = towlower(ca);
+                cb  = towlower(cb);
+            }
+            if (ca != cb)
+                return (ca < cb) ? -1 : 1;
+        }
+        if (a->length() == b->length())
+            return 0;
+        return (a->length() < b->length()) ? -1 : 1;
+    }
+
+    static size_t naive_match(const LSPString *s, const LSPString *p, size_t index, bool nocase)
+    {
+        size_t i = 0;
+        for ( ; ((index + i) < s->length()) && (i < p->length()); ++i)
+        {
+            lsp_wchar_t ca = s->char_at(index + i), cb = p->char_at(i);
+            if ((nocase) ? (towlower(ca) != towlower(cb)) : (ca != cb))
+                break;
+        }
+        return i;
+    }
+
+    static inline int sign(int x)
+    {
+        return (x > 0) ? 1 : (x < 0) ? -1 : 0;
+    }
+
+    void test_search()
+    {
+        printf("Testing search and comparison of strings...\n");
+
+        static const lsp_wchar_t alphabet[] = { 'a', 'b', 'A', 'B', 'z', 0x42f, 0x44f, 0x1f3bc };
+        const size_t nchars = sizeof(alphabet) / sizeof(alphabet[0]);
+
+        LSPString s, p, q;
+
+        srand(0x1234);
+        for (size_t iter=0; iter<5000; ++iter)
+        {
+            // Generate the string and the pattern
+            s.clear();
+            p.clear();
+            for (size_t n = rand() % 100; n > 0; --n)
+                UTEST_ASSERT(s.append(alphabet[rand() % ((iter & 1) ? 3 : nchars)]));
+            if ((s.length() > 0) && (rand() % 2))
+            {
+                size_t first = rand() % s.length();
+                size_t last = first + rand() % (s.length() - first + 1);
+                UTEST_ASSERT(p.set(&s, first, last));
+            }
+            else
+            {
+                for (size_t n = rand() % 6; n > 0; --n)
+                    UTEST_ASSERT(p.append(alphabet[rand() % nchars]));
+            }
+            size_t len = s.length();
+
+            // Substring search
+            if (p.length() > 0)
+            {
+                UTEST_ASSERT(s.index_of(&p) == naive_index_of(&s, 0, len, &p, false));
+                UTEST_ASSERT(s.rindex_of(&p) == naive_index_of(&s, 0, len, &p, true));
+                if (len > 0)
+                {
+                    size_t start = rand() % len;
+                    UTEST_ASSERT(s.index_of(start, &p) == naive_index_of(&s, start, len, &p, false));
+                    UTEST_ASSERT(s.rindex_of(start, &p) == naive_index_of(&s, 0, start, &p, true));
+                }
+            }
+
+            // Character search
+            lsp_wchar_t ch = alphabet[rand() % nchars];
+            UTEST_ASSERT(p.set(ch));
+            UTEST_ASSERT(s.index_of(ch) == naive_index_of(&s, 0, len, &p, false));
+            UTEST_ASSERT(s.rindex_of(ch) == naive_index_of(&s, 0, len, &p, true));
+            if (len > 0)
+            {
+                size_t start = rand() % len;
+                UTEST_ASSERT(s.index_of(start, ch) == naive_index_of(&s, start, len, &p, false));
+                UTEST_ASSERT(s.rindex_of(start, ch) == naive_index_of(&s, 0, start + 1, &p, true));
+            }
+
+            // Comparison with modified copy
+            UTEST_ASSERT(q.set(&s));
+            if ((len > 0) && (rand() % 2))
+                UTEST_ASSERT(q.set_at(rand() % len, alphabet[rand() % nchars]));
+            if (rand() % 4 == 0)
+                UTEST_ASSERT(q.append(alphabet[rand() % nchars]));
+            if ((rand() % 2) && (q.length() > 0))
+                q.toupper(rand() % q.length());
+
+            UTEST_ASSERT(sign(s.compare_to(&q)) == naive_compare(&s, &q, false));
+            UTEST_ASSERT(sign(s.compare_to_nocase(&q)) == naive_compare(&s, &q, true));
+            UTEST_ASSERT(s.equals(&q) == (naive_compare(&s, &q, false) == 0));
+            UTEST_ASSERT(s.equals_nocase(&q) == (naive_compare(&s, &q, true) == 0));
+
+            size_t index = (len > 0) ? rand() % len : 0;
+            UTEST_ASSERT(s.match(&q, index) == naive_match(&s, &q, index, false));
+            UTEST_ASSERT(s.match_nocase(&q, index) == naive_match(&s, &q, index, true));
+
+            // Hashing
+            UTEST_ASSERT(s.hash() == LSPString::hash(s.characters(), s.length()));
+            if (s.equals(&q))
+                UTEST_ASSERT(s.hash() == q.hash());
+        }
+    }
+
+    void test_scratch()
+    {
+        printf("Testing conversion into scratch buffers...\n");
+
+        LSPString s, tmp;
+        LSPStringScratch buf;
+        UTEST_ASSERT(s.set_utf8("Test string \xd0\xaf \xf0\x9f\x8e\xbc"));
+
+        // Conversion into the scratch buffer does not use the temporary buffer of the string
+        const char *utf8 = s.to_utf8(&buf);
+        UTEST_ASSERT(utf8 != NULL);
+        UTEST_ASSERT(::strcmp(utf8, "Test string \xd0\xaf \xf0\x9f\x8e\xbc") == 0);
+        UTEST_ASSERT(buf.size() == ::strlen(utf8) + 1);
+        UTEST_ASSERT(s.temporal_capacity() == 0);
+
+        utf8 = s.to_utf8(&buf, 5, 11);
+        UTEST_ASSERT(utf8 != NULL);
+        UTEST_ASSERT(::strcmp(utf8, "string") == 0);
+
+        const lsp_utf16_t *utf16 = s.to_utf16(&buf);
+        UTEST_ASSERT(utf16 != NULL);
+        UTEST_ASSERT(tmp.set_utf16(utf16));
+        UTEST_ASSERT(tmp.equals(&s));
+
+        const char *ascii = s.to_ascii(&buf, 0, 4);
+        UTEST_ASSERT(ascii != NULL);
+        UTEST_ASSERT(::strcmp(ascii, "Test") == 0);
+
+        const char *native = s.to_native(&buf);
+        UTEST_ASSERT(native != NULL);
+        UTEST_ASSERT(tmp.set_native(native));
+        UTEST_ASSERT(tmp.equals(&s));
+        UTEST_ASSERT(s.temporal_capacity() == 0);
+
+        // Clear and release the scratch buffer
+        size_t capacity = buf.capacity();
+        UTEST_ASSERT(capacity > 0);
+        buf.clear();
+        UTEST_ASSERT(buf.size() == 0);
+        UTEST_ASSERT(buf.capacity() == capacity);
+        buf.truncate();
+        UTEST_ASSERT(buf.capacity() == 0);
+        UTEST_ASSERT(buf.data() == NULL);
+
+        // Clone does not use the temporary buffer of the string
+        size_t bytes = 0;
+        char *clone = s.clone_utf8(&bytes);
+        UTEST_ASSERT(clone != NULL);
+        UTEST_ASSERT(bytes == ::strlen(clone) + 1);
+        UTEST_ASSERT(tmp.set_utf8(clone));
+        UTEST_ASSERT(tmp.equals(&s));
+        UTEST_ASSERT(s.temporal_capacity() == 0);
+        ::free(clone);
+
+        // Release temporary buffer of the string
+        UTEST_ASSERT(s.get_utf8() != NULL);
+        UTEST_ASSERT(s.temporal_capacity() > 0);
+        s.release_temp();
+        UTEST_ASSERT(s.temporal_capacity() == 0);
+
+        // Release temporary buffers of all strings
+        UTEST_ASSERT(s.get_utf8() != NULL);
+        UTEST_ASSERT(tmp.get_utf16() != NULL);
+        size_t used = s.temporal_capacity() + tmp.temporal_capacity();
+        UTEST_ASSERT(LSPString::release_all_temp() >= used);
+        UTEST_ASSERT(s.temporal_capacity() == 0);
+        UTEST_ASSERT(tmp.temporal_capacity() == 0);
+
+        utf8 = s.get_utf8();
+        UTEST_ASSERT(utf8 != NULL);
+        UTEST_ASSERT(::strcmp(utf8, "Test string \xd0\xaf \xf0\x9f\x8e\xbc") == 0);
+    }
+
     UTEST_MAIN
     {
         test_basic();
         test_start_end();
         test_base_hashing();
         test_hash_key();
+        test_short_strings();
+        test_utf8_conversion();
+        test_search();
+        test_scratch();
     }
 UTEST_END;
 
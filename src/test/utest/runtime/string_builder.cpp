@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/runtime/LSPStringBuilder.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("runtime.runtime", string_builder)
+
+    void test_basic()
+    {
+        printf("Testing basic operations...\n");
+
+        LSPStringBuilder sb;
+        LSPString s, tmp;
+
+        UTEST_ASSERT(sb.is_empty());
+        UTEST_ASSERT(sb.flatten(&s));
+        UTEST_ASSERT(s.is_empty());
+
+        UTEST_ASSERT(tmp.set_ascii("some text"));
+        UTEST_ASSERT(sb.append_ascii(" world"));
+        UTEST_ASSERT(sb.prepend_ascii("hello"));
+        UTEST_ASSERT(sb.append(':'));
+        UTEST_ASSERT(sb.append(&tmp, 4));
+        UTEST_ASSERT(sb.prepend(&tmp, 0, 5));
+        UTEST_ASSERT(sb.prepend_utf8("\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 "));
+        UTEST_ASSERT(sb.append_utf8(" \xf0\x9f\x8e\xbc"));
+        UTEST_ASSERT(!sb.append(&tmp, 20));
+
+        UTEST_ASSERT(sb.flatten(&s));
+        UTEST_ASSERT(s.equals_utf8("\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 some hello world: text \xf0\x9f\x8e\xbc"));
+        UTEST_ASSERT(sb.length() == s.length());
+
+        // Append to the existing string
+        UTEST_ASSERT(tmp.set_ascii(">>"));
+        UTEST_ASSERT(sb.append_to(&tmp));
+        UTEST_ASSERT(tmp.length() == s.length() + 2);
+        UTEST_ASSERT(tmp.ends_with(&s));
+
+        // Swap and clear
+        LSPStringBuilder sb2;
+        sb2.swap(&sb);
+        UTEST_ASSERT(sb.is_empty());
+        UTEST_ASSERT(sb2.length() == s.length());
+        sb2.clear();
+        UTEST_ASSERT(sb2.is_empty());
+        UTEST_ASSERT(sb2.flatten(&s));
+        UTEST_ASSERT(s.is_empty());
+    }
+
+    void test_random()
+    {
+        printf("Testing random sequence of operations...\n");
+
+        LSPStringBuilder sb;
+        LSPString ref, tmp, s;
+
+        srand(0x4321);
+        for (size_t iter=0; iter<20000; ++iter)
+        {
+            // Generate the piece of data
+            tmp.clear();
+            size_t len = (rand() % 16 == 0) ? rand() % 3000 : rand() % 8;
+            for (size_t i=0; i<len; ++i)
+                UTEST_ASSERT(tmp.append(lsp_wchar_t('a' + rand() % 26)));
+
+            switch (rand() % 4)
+            {
+                case 0:
+                    UTEST_ASSERT(sb.append(&tmp));
+                    UTEST_ASSERT(ref.append(&tmp));
+                    break;
+                case 1:
+                    UTEST_ASSERT(sb.prepend(&tmp));
+                    UTEST_ASSERT(ref.prepend(&tmp));
+                    break;
+                case 2:
+                    UTEST_ASSERT(sb.append(lsp_wchar_t(0x400 + iter % 0x100)));
+                    UTEST_ASSERT(ref.append(lsp_wchar_t(0x400 + iter % 0x100)));
+                    break;
+                default:
+                    UTEST_ASSERT(sb.prepend(lsp_wchar_t(0x400 + iter % 0x100)));
+                    UTEST_ASSERT(ref.prepend(lsp_wchar_t(0x400 + iter % 0x100)));
+                    break;
+            }
+            UTEST_ASSERT(sb.length() == ref.length());
+
+            if ((iter % 1000) == 0)
+            {
+                UTEST_ASSERT(sb.flatten(&s));
+                UTEST_ASSERT(s.equals(&ref));
+            }
+        }
+
+        UTEST_ASSERT(sb.flatten(&s));
+        UTEST_ASSERT(s.equals(&ref));
+    }
+
+    UTEST_MAIN
+    {
+        test_basic();
+        test_random();
+    }
+
+UTEST_END;
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/runtime/StringPool.h>
+#include <lsp-plug.in/fmt/json/Parser.h>
+#include <lsp-plug.in/fmt/xml/PullParser.h>
+#include <lsp-plug.in/fmt/config/PullParser.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("runtime.runtime", string_pool)
+
+    void test_intern()
+    {
+        StringPool pool;
+        LSPString tmp;
+
+        printf("Testing interning of strings...\n");
+
+        UTEST_ASSERT(pool.size() == 0);
+        UTEST_ASSERT(pool.lookup_ascii("abc") == NULL);
+
+        const LSPString *a = pool.intern_ascii("abc");
+        const LSPString *b = pool.intern_utf8("def");
+        const LSPString *e = pool.intern_ascii("");
+        UTEST_ASSERT((a != NULL) && (b != NULL) && (e != NULL));
+        UTEST_ASSERT((a != b) && (a != e) && (b != e));
+        UTEST_ASSERT(a->equals_ascii("abc"));
+        UTEST_ASSERT(b->equals_ascii("def"));
+        UTEST_ASSERT(e->is_empty());
+        UTEST_ASSERT(pool.size() == 3);
+
+        UTEST_ASSERT(tmp.set_ascii("abc"));
+        UTEST_ASSERT(pool.intern(&tmp) == a);
+        UTEST_ASSERT(pool.intern(tmp.characters(), tmp.length()) == a);
+        UTEST_ASSERT(pool.intern_utf8("abc") == a);
+        UTEST_ASSERT(pool.intern_ascii("def") == b);
+        UTEST_ASSERT(pool.intern_ascii("") == e);
+        UTEST_ASSERT(pool.lookup(&tmp) == a);
+        UTEST_ASSERT(pool.lookup_ascii("def") == b);
+        UTEST_ASSERT(pool.lookup_ascii("abcd") == NULL);
+        UTEST_ASSERT(pool.size() == 3);
+
+        pool.clear();
+        UTEST_ASSERT(pool.size() == 0);
+        UTEST_ASSERT(pool.lookup_ascii("abc") == NULL);
+        UTEST_ASSERT(pool.intern_ascii("abc") != NULL);
+        UTEST_ASSERT(pool.size() == 1);
+    }
+
+    void test_many()
+    {
+        StringPool pool;
+        LSPString tmp;
+        lltl::parray<LSPString> list;
+        const size_t n = 10000;
+
+        printf("Testing interning of %d strings...\n", int(n));
+
+        for (size_t i=0; i<n; ++i)
+        {
+            UTEST_ASSERT(tmp.fmt_ascii("key_%d", int(i)));
+            const LSPString *s = pool.intern(&tmp);
+            UTEST_ASSERT(s != NULL);
+            UTEST_ASSERT(s->equals(&tmp));
+            UTEST_ASSERT(list.add(const_cast<LSPString *>(s)));
+        }
+        UTEST_ASSERT(pool.size() == n);
+
+        // All strings should survive the growth of the index
+        for (size_t i=0; i<n; ++i)
+        {
+            UTEST_ASSERT(tmp.fmt_ascii("key_%d", int(i)));
+            UTEST_ASSERT(pool.lookup(&tmp) == list.uget(i));
+            UTEST_ASSERT(pool.intern(&tmp) == list.uget(i));
+            UTEST_ASSERT(pool.get(i) == list.uget(i));
+        }
+        UTEST_ASSERT(pool.size() == n);
+    }
+
+    void test_json()
+    {
+        StringPool pool;
+        json::Parser p;
+        json::event_t ev;
+        const LSPString *names[4];
+        size_t count = 0;
+
+        printf("Testing interning of JSON property names...\n");
+
+        UTEST_ASSERT(p.wrap("[{\"a\": 1, \"b\": 2}, {\"a\": 3, \"b\": 4}]", json::JSON_LEGACY, "UTF-8") == STATUS_OK);
+        UTEST_ASSERT(p.interned_name() == NULL);
+        p.set_pool(&pool);
+        UTEST_ASSERT(p.pool() == &pool);
+
+        while (p.read_next(&ev) == STATUS_OK)
+        {
+            if (ev.type == json::JE_PROPERTY)
+            {
+                UTEST_ASSERT(count < 4);
+                names[count] = p.interned_name();
+                UTEST_ASSERT(names[count] != NULL);
+                UTEST_ASSERT(names[count]->equals(&ev.sValue));
+                ++count;
+            }
+            else
+            {
+                UTEST_ASSERT(p.interned_name() == NULL);
+            }
+        }
+        UTEST_ASSERT(p.close() == STATUS_OK);
+
+        UTEST_ASSERT(count == 4);
+        UTEST_ASSERT(names[0] == names[2]);
+        UTEST_ASSERT(names[1] == names[3]);
+        UTEST_ASSERT(names[0] != names[1]);
+        UTEST_ASSERT(pool.size() == 2);
+
+        // The parser should produce the same events with and without the pool
+        static const char *json5 = "{a: 'x', 'b': {\"\": [1, {a: null}]}, c: 2.5}";
+        json::Parser q;
+        json::event_t qev;
+        pool.clear();
+        UTEST_ASSERT(p.wrap(json5, json::JSON_VERSION5, "UTF-8") == STATUS_OK);
+        UTEST_ASSERT(q.wrap(json5, json::JSON_VERSION5, "UTF-8") == STATUS_OK);
+        p.set_pool(&pool);
+
+        while (true)
+        {
+            status_t res = p.read_next(&ev);
+            UTEST_ASSERT(q.read_next(&qev) == res);
+            if (res != STATUS_OK)
+            {
+                UTEST_ASSERT(res == STATUS_EOF);
+                break;
+            }
+            UTEST_ASSERT(ev.type == qev.type);
+            if ((ev.type == json::JE_PROPERTY) || (ev.type == json::JE_STRING))
+            {
+                UTEST_ASSERT(ev.sValue.equals(&qev.sValue));
+            }
+            if (ev.type == json::JE_PROPERTY)
+            {
+                UTEST_ASSERT(p.interned_name() == pool.lookup(&qev.sValue));
+                UTEST_ASSERT(p.get_current(&ev) == STATUS_OK);
+                UTEST_ASSERT(ev.sValue.equals(&qev.sValue));
+            }
+        }
+        UTEST_ASSERT(p.close() == STATUS_OK);
+        UTEST_ASSERT(q.close() == STATUS_OK);
+        UTEST_ASSERT(pool.size() == 4);
+
+        // Single-quoted property names are not allowed by legacy JSON
+        UTEST_ASSERT(p.wrap("{'a': 1}", json::JSON_LEGACY, "UTF-8") == STATUS_OK);
+        p.set_pool(&pool);
+        UTEST_ASSERT(p.read_next(&ev) == STATUS_OK);
+        UTEST_ASSERT(p.read_next(&ev) == STATUS_BAD_TOKEN);
+        UTEST_ASSERT(p.close() == STATUS_OK);
+    }
+
+    void test_xml()
+    {
+        StringPool pool;
+        xml::PullParser p;
+        status_t token;
+        const LSPString *names[6];
+        size_t count = 0;
+
+        printf("Testing interning of XML names...\n");
+
+        UTEST_ASSERT(p.wrap("<root><item id=\"1\"/><item id=\"2\"></item></root>", "UTF-8") == STATUS_OK);
+        UTEST_ASSERT(p.set_pool(&pool) == STATUS_OK);
+
+        while ((token = p.read_next()) >= 0)
+        {
+            if (token == xml::XT_END_DOCUMENT)
+                break;
+            if ((token == xml::XT_START_ELEMENT) || (token == xml::XT_ATTRIBUTE))
+            {
+                UTEST_ASSERT(count < 6);
+                names[count] = p.interned_name();
+                UTEST_ASSERT(names[count] != NULL);
+                UTEST_ASSERT(names[count]->equals(p.name()));
+                ++count;
+            }
+            else if (token == xml::XT_END_ELEMENT)
+            {
+                UTEST_ASSERT(p.interned_name() == pool.lookup(p.name()));
+            }
+            else
+            {
+                UTEST_ASSERT(p.interned_name() == NULL);
+            }
+        }
+        UTEST_ASSERT(token == xml::XT_END_DOCUMENT);
+        UTEST_ASSERT(p.close() == STATUS_OK);
+
+        UTEST_ASSERT(count == 5);
+        UTEST_ASSERT(names[1] == names[3]);
+        UTEST_ASSERT(names[2] == names[4]);
+        UTEST_ASSERT(names[0] != names[1]);
+        UTEST_ASSERT(pool.size() == 3);
+
+        // The pool can not be changed while some element is open
+        UTEST_ASSERT(p.wrap("<root><item/></root>", "UTF-8") == STATUS_OK);
+        UTEST_ASSERT(p.set_pool(&pool) == STATUS_OK);
+        UTEST_ASSERT(p.read_next() == xml::XT_START_DOCUMENT);
+        UTEST_ASSERT(p.read_next() == xml::XT_START_ELEMENT);
+        UTEST_ASSERT(p.set_pool(NULL) == STATUS_BAD_STATE);
+        UTEST_ASSERT(p.pool() == &pool);
+        UTEST_ASSERT(p.close() == STATUS_OK);
+
+        // Errors should be detected with interned names too
+        UTEST_ASSERT(p.wrap("<root a=\"1\" a=\"2\"/>", "UTF-8") == STATUS_OK);
+        UTEST_ASSERT(p.set_pool(&pool) == STATUS_OK);
+        while ((token = p.read_next()) >= 0) { }
+        UTEST_ASSERT(token == -STATUS_CORRUPTED);
+        UTEST_ASSERT(p.close() == STATUS_OK);
+
+        UTEST_ASSERT(p.wrap("<root><item></root></item>", "UTF-8") == STATUS_OK);
+        UTEST_ASSERT(p.set_pool(&pool) == STATUS_OK);
+        while ((token = p.read_next()) >= 0) { }
+        UTEST_ASSERT(token == -STATUS_CORRUPTED);
+        UTEST_ASSERT(p.close() == STATUS_OK);
+    }
+
+    void test_config()
+    {
+        StringPool pool;
+        config::PullParser p;
+        const LSPString *names[3];
+        size_t count = 0;
+
+        printf("Testing interning of configuration parameter names...\n");
+
+        UTEST_ASSERT(p.wrap("a=1\nb=2\na=3\n", "UTF-8") == STATUS_OK);
+        p.set_pool(&pool);
+
+        while (p.next() == STATUS_OK)
+        {
+            UTEST_ASSERT(count < 3);
+            names[count] = p.interned_name();
+            UTEST_ASSERT(names[count] != NULL);
+            UTEST_ASSERT(names[count]->equals(&p.current()->name));
+            ++count;
+        }
+        UTEST_ASSERT(p.close() == STATUS_OK);
+
+        UTEST_ASSERT(count == 3);
+        UTEST_ASSERT(names[0] == names[2]);
+        UTEST_ASSERT(names[0] != names[1]);
+        UTEST_ASSERT(pool.size() == 2);
+
+        // Long names reuse the buffer of the previous parameter
+        static const char *keys[] = { "long_parameter_name_1", "b", "another_long_parameter_name" };
+        config::param_t param;
+        UTEST_ASSERT(p.wrap("long_parameter_name_1=1\nb=\"x\"\nanother_long_parameter_name=2.5\n", "UTF-8") == STATUS_OK);
+        p.set_pool(&pool);
+        for (size_t i=0; i<3; ++i)
+        {
+            UTEST_ASSERT(p.next(&param) == STATUS_OK);
+            UTEST_ASSERT(param.name.equals_ascii(keys[i]));
+            UTEST_ASSERT(p.current()->name.equals_ascii(keys[i]));
+            UTEST_ASSERT(p.interned_name() == pool.lookup_ascii(keys[i]));
+        }
+        UTEST_ASSERT(p.next(&param) == STATUS_EOF);
+        UTEST_ASSERT(p.close() == STATUS_OK);
+    }
+
+    UTEST_MAIN
+    {
+        test_intern();
+        test_many();
+        test_json();
+        test_xml();
+        test_config();
+    }
+
+UTEST_END